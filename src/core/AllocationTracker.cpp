@@ -0,0 +1,94 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace scummredux {
+
+    namespace {
+        std::atomic<uint64_t> s_allocations = 0;
+        std::atomic<uint64_t> s_deallocations = 0;
+        std::atomic<uint64_t> s_bytesAllocated = 0;
+
+        void* allocate(std::size_t size) {
+            AllocationTracker::recordAllocation(size);
+            if (size == 0) size = 1;
+
+            void* ptr = std::malloc(size);
+            if (!ptr) throw std::bad_alloc();
+            return ptr;
+        }
+
+        void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+            AllocationTracker::recordAllocation(size);
+            if (size == 0) size = 1;
+
+            const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+            void* ptr = _aligned_malloc(size, align);
+#else
+            // aligned_alloc requires the size to be a multiple of the alignment
+            void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+            if (!ptr) throw std::bad_alloc();
+            return ptr;
+        }
+
+        void deallocate(void* ptr) {
+            if (!ptr) return;
+            AllocationTracker::recordDeallocation();
+            std::free(ptr);
+        }
+
+        void deallocateAligned(void* ptr) {
+            if (!ptr) return;
+            AllocationTracker::recordDeallocation();
+#ifdef _WIN32
+            _aligned_free(ptr);
+#else
+            std::free(ptr);
+#endif
+        }
+    }
+
+    AllocationTracker::Snapshot AllocationTracker::snapshot() {
+        Snapshot result;
+        result.allocations = s_allocations.load(std::memory_order_relaxed);
+        result.deallocations = s_deallocations.load(std::memory_order_relaxed);
+        result.bytesAllocated = s_bytesAllocated.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    void AllocationTracker::recordAllocation(uint64_t size) {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void AllocationTracker::recordDeallocation() {
+        s_deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+} // namespace scummredux
+
+// Global allocation functions
+void* operator new(std::size_t size) { return scummredux::allocate(size); }
+void* operator new[](std::size_t size) { return scummredux::allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return scummredux::allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return scummredux::allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment) { return scummredux::allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return scummredux::allocateAligned(size, alignment); }
+
+void operator delete(void* ptr) noexcept { scummredux::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { scummredux::deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { scummredux::deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { scummredux::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { scummredux::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { scummredux::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { scummredux::deallocateAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { scummredux::deallocateAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { scummredux::deallocateAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { scummredux::deallocateAligned(ptr); }
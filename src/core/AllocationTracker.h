@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace scummredux {
+
+    // Process-wide heap allocation counters, fed by the global operator new/delete
+    // replacements in AllocationTracker.cpp. Counting is always on and costs one
+    // relaxed atomic increment per call.
+    class AllocationTracker {
+    public:
+        struct Snapshot {
+            uint64_t allocations = 0;
+            uint64_t deallocations = 0;
+            uint64_t bytesAllocated = 0;
+        };
+
+        static Snapshot snapshot();
+
+        static void recordAllocation(uint64_t size);
+        static void recordDeallocation();
+    };
+
+} // namespace scummredux
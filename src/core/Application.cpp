@@ -1,22 +1,37 @@
 #include "Application.h"
 #include "Settings.h"
+#include "DrawStats.h"
+#include "InputRecorder.h"
+#include "JobSystem.h"
+#include "TextureCache.h"
+#include "TraceRecorder.h"
 #include "../ui/StyleManager.h"
+#include "../ui/FontManager.h"
+#include "../ui/ScaleManager.h"
+#include "../res/icons/MaterialSymbols.h"
+#include "../scumm/GameManager.h"
 #include "../utils/Events.hpp"
 #include "../views/ExplorerView.h"
 #include "../views/EditorView.h"
 #include "../views/PropertiesView.h"
 #include "../views/ConsoleView.h"
+#include "../views/RoomView.h"
+#include "../views/CostumeView.h"
+#include "../views/ReferencesView.h"
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 #include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
 
 namespace scummredux {
 
-    Application::Application() {
+    Application::Application(ApplicationOptions options)
+        : m_options(std::move(options)) {
         // Load settings first
         Settings::getInstance().load();
     }
@@ -32,26 +47,41 @@ namespace scummredux {
 
         try {
             ConsoleView::info("Initializing SCUMM Redux...");
-
-            // Initialize window
-            m_window = std::make_unique<Window>();
-            if (!m_window->initialize()) {
-                ConsoleView::error("Failed to initialize window");
-                return false;
+            View::setVerbose(m_options.verbose);
+
+            if (m_options.headless) {
+                // No window, no GL context: ImGui runs against a null renderer
+                initializeHeadlessImGui();
+                ConsoleView::success("ImGui initialized (headless)");
+            } else {
+                // Initialize window
+                m_window = std::make_unique<Window>();
+                if (!m_window->initialize()) {
+                    ConsoleView::error("Failed to initialize window");
+                    return false;
+                }
+                ConsoleView::success("Window initialized");
+
+                // Fonts and style are built for the monitor's content scale from the start
+                ScaleManager::getInstance().initialize(m_window->getDPIScale());
+
+                // Initialize ImGui
+                initializeImGui();
+                ConsoleView::success("ImGui initialized");
+
+                // Initialize style manager and apply theme
+                StyleManager::getInstance().setupFonts();
+                StyleManager::getInstance().applyCurrentTheme();
+                ConsoleView::success("Style system initialized");
             }
-            ConsoleView::success("Window initialized");
-
-            // Initialize ImGui
-            initializeImGui();
-            ConsoleView::success("ImGui initialized");
 
-            // Initialize style manager and apply theme
-            StyleManager::getInstance().setupFonts();
-            StyleManager::getInstance().applyCurrentTheme();
-            ConsoleView::success("Style system initialized");
+            TextureCache::getInstance().initialize(m_options.headless);
 
             // Create window decorator
             m_windowDecorator = std::make_unique<WindowDecorator>(m_window.get());
+            m_windowDecorator->getTitleBar()->addButton("save", {ICON_MS_SAVE, "Save game (writes every unsaved edit)", [] {
+                GameManager::getInstance().save();
+            }, false});
             ConsoleView::success("Window decorator created");
 
             // Setup views
@@ -100,9 +130,78 @@ namespace scummredux {
         }
     }
 
+    void Application::initializeHeadlessImGui() {
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+        io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+        io.ConfigWindowsMoveFromTitleBarOnly = true;
+        io.IniFilename = nullptr;
+        io.LogFilename = nullptr;
+
+        // Null renderer: draw data is built and inspected but never submitted
+        io.BackendPlatformName = "scummredux_headless";
+        io.BackendRendererName = "scummredux_null";
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        // A replay brings its own display size and time step
+        if (!m_options.replayPath.empty()) {
+            if (!m_options.inputScript.empty()) {
+                throw std::runtime_error("--input and --replay cannot be combined");
+            }
+
+            auto replay = std::make_unique<ReplayInputSource>();
+            if (!replay->load(m_options.replayPath)) {
+                throw std::runtime_error("Failed to load input recording: " + m_options.replayPath);
+            }
+            m_options.width = (int)replay->getDisplaySize().x;
+            m_options.height = (int)replay->getDisplaySize().y;
+            m_options.fixedDeltaTime = replay->getDeltaTime();
+            if (m_options.frameCount <= 0) {
+                m_options.frameCount = (int)replay->getFrameCount();
+            }
+            m_inputSource = std::move(replay);
+        }
+
+        io.DisplaySize = ImVec2((float)m_options.width, (float)m_options.height);
+        io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+        io.DeltaTime = (float)m_options.fixedDeltaTime;
+
+        ScaleManager::getInstance().initialize(1.0f);
+        StyleManager::getInstance().setupFonts();
+        StyleManager::getInstance().applyCurrentTheme();
+
+        uploadFontAtlas();
+
+        if (!m_options.inputScript.empty()) {
+            auto script = std::make_unique<ScriptedInputSource>();
+            if (!script->load(m_options.inputScript)) {
+                throw std::runtime_error("Failed to load input script: " + m_options.inputScript);
+            }
+            m_inputSource = std::move(script);
+        }
+    }
+
+    void Application::uploadFontAtlas() {
+        if (m_options.headless) {
+            // Rasterize the atlas on the CPU; the texture id only has to be non-null
+            unsigned char* pixels = nullptr;
+            int width = 0, height = 0;
+            ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+            ImGui::GetIO().Fonts->SetTexID((ImTextureID)(intptr_t)1);
+            return;
+        }
+
+        ImGui_ImplOpenGL3_DestroyFontsTexture();
+        ImGui_ImplOpenGL3_CreateFontsTexture();
+    }
+
     void Application::shutdownImGui() {
-        ImGui_ImplOpenGL3_Shutdown();
-        ImGui_ImplGlfw_Shutdown();
+        if (!m_options.headless) {
+            ImGui_ImplOpenGL3_Shutdown();
+            ImGui_ImplGlfw_Shutdown();
+        }
         ImGui::DestroyContext();
     }
 
@@ -114,6 +213,9 @@ namespace scummredux {
         viewManager.addView<EditorView>();
         viewManager.addView<PropertiesView>();
         viewManager.addView<ConsoleView>();
+        viewManager.addView<RoomView>();
+        viewManager.addView<CostumeView>();
+        viewManager.addView<ReferencesView>();
 
         ConsoleView::info("Created " + std::to_string(viewManager.getViews().size()) + " views");
     }
@@ -134,7 +236,7 @@ namespace scummredux {
 
         // Handle theme change events
         EventThemeChanged::subscribe([](const ThemeChangedEvent& event) {
-            ConsoleView::info("Theme changed to: " + event.themeName);
+            ConsoleView::info("Theme changed to: " + ThemeRegistry::getInstance().getName(event.theme));
         });
 
         // Handle view events
@@ -153,12 +255,27 @@ namespace scummredux {
             return -1;
         }
 
+        if (!m_options.recordPath.empty()) {
+            const ImVec2 size = m_options.headless ? ImVec2((float)m_options.width, (float)m_options.height)
+                                                   : m_window->getSize();
+            if (InputRecorder::getInstance().start(m_options.recordPath, size, (float)m_options.fixedDeltaTime)) {
+                ConsoleView::info("Recording input to " + m_options.recordPath);
+            } else {
+                ConsoleView::error("Failed to start input recording: " + m_options.recordPath);
+            }
+        }
+
+        if (m_options.headless) {
+            return runHeadless();
+        }
+
         ConsoleView::info("Starting main loop...");
 
-        m_lastFrameTime = glfwGetTime();
+        m_lastFrameTime = getTime();
 
         // Main loop
         while (!m_window->shouldClose() && !m_shouldClose) {
+            SCUMM_TRACE_SCOPE("Frame", "frame");
             handleEvents();
             update();
             render();
@@ -168,13 +285,67 @@ namespace scummredux {
         return 0;
     }
 
+    int Application::runHeadless() {
+        if (m_options.frameCount <= 0) {
+            m_options.frameCount = DEFAULT_HEADLESS_FRAMES;
+        }
+        ConsoleView::info("Running " + std::to_string(m_options.frameCount) + " headless frames...");
+
+        m_benchmark.reserve(m_options.frameCount);
+        DrawStats::getInstance().resetTotals();
+        m_lastFrameTime = getTime();
+
+        for (m_frameIndex = 0; m_frameIndex < (uint64_t)m_options.frameCount && !m_shouldClose; m_frameIndex++) {
+            SCUMM_TRACE_SCOPE("Frame", "frame");
+
+            m_benchmark.beginFrame();
+            handleEvents();
+            update();
+            render();
+            m_benchmark.endFrame();
+        }
+
+        ConsoleView::success("Headless run complete: " + std::to_string(m_benchmark.getFrameCount()) + " frames");
+
+        // stdout carries the log, so the JSON only ever goes to its own file
+        if (m_options.reportPath.empty()) {
+            ConsoleView::info("No benchmark report written (pass --report <file>)");
+        } else if (m_benchmark.save(m_options.reportPath)) {
+            ConsoleView::success("Benchmark report written to " + m_options.reportPath);
+        } else {
+            ConsoleView::error("Failed to write benchmark report: " + m_options.reportPath);
+            return -1;
+        }
+
+        return 0;
+    }
+
+    double Application::getTime() const {
+        if (m_options.headless) {
+            // Simulated clock so headless runs are deterministic
+            return m_frameIndex * m_options.fixedDeltaTime;
+        }
+        return glfwGetTime();
+    }
+
     void Application::handleEvents() {
+        SCUMM_TRACE_SCOPE("HandleEvents", "frame");
+
+        if (m_options.headless) {
+            if (m_inputSource) {
+                m_inputSource->apply(ImGui::GetIO(), m_frameIndex);
+            }
+            return;
+        }
+
         m_window->pollEvents();
     }
 
     void Application::update() {
+        SCUMM_TRACE_SCOPE("Update", "frame");
+
         // Calculate delta time
-        double currentTime = glfwGetTime();
+        double currentTime = getTime();
         m_deltaTime = currentTime - m_lastFrameTime;
         m_lastFrameTime = currentTime;
 
@@ -186,15 +357,32 @@ namespace scummredux {
             m_fpsUpdateTime = currentTime;
         }
 
+        // Hand finished background work back to the UI before views update
+        JobSystem::getInstance().drainMainThread();
+
+        // The title shows the open game, marked while its overlay holds unsaved edits
+        auto& game = GameManager::getInstance();
+        TitleBar* titleBar = m_windowDecorator->getTitleBar();
+        titleBar->setProjectInfo(game.getName(), game.hasUnsavedChanges());
+        titleBar->setButtonEnabled("save", game.hasUnsavedChanges());
+
         // Post frame begin event
         EventFrameBegin::post({});
+
+        // Views have queued this frame's new textures by now
+        TextureCache::getInstance().update();
     }
 
     void Application::render() {
+        SCUMM_TRACE_SCOPE("Render", "frame");
+
         beginFrame();
 
         // Main rendering
-        m_windowDecorator->render();
+        {
+            SCUMM_TRACE_SCOPE("DrawViews", "frame");
+            m_windowDecorator->render();
+        }
 
         endFrame();
 
@@ -203,15 +391,45 @@ namespace scummredux {
     }
 
     void Application::beginFrame() {
+        SCUMM_TRACE_SCOPE("BeginFrame", "frame");
+
+        // Scale changes and glyphs requested during the previous frame are applied between frames
+        ScaleManager::getInstance().update();
+        if (FontManager::getInstance().rebuildIfNeeded()) {
+            uploadFontAtlas();
+        }
+
+        if (m_options.headless) {
+            ImGui::GetIO().DeltaTime = (float)m_options.fixedDeltaTime;
+            InputRecorder::getInstance().captureFrame();
+            ImGui::NewFrame();
+            return;
+        }
+
         // Start ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
+
+        // The platform backend has queued this frame's input by now
+        InputRecorder::getInstance().captureFrame();
         ImGui::NewFrame();
     }
 
     void Application::endFrame() {
+        SCUMM_TRACE_SCOPE("EndFrame", "frame");
+
         // Render ImGui
-        ImGui::Render();
+        {
+            SCUMM_TRACE_SCOPE("ImGui::Render", "frame");
+            ImGui::Render();
+        }
+
+        // Inspect the draw data before the backend consumes it
+        DrawStats::getInstance().collect(ImGui::GetDrawData());
+
+        if (m_options.headless) {
+            return; // Null renderer
+        }
 
         // Setup viewport
         int display_w, display_h;
@@ -221,9 +439,13 @@ namespace scummredux {
         // Clear and render with solid background (fixed transparency)
         glClearColor(0.11f, 0.11f, 0.14f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            SCUMM_TRACE_SCOPE("RenderDrawData", "frame");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
         // Swap buffers
+        SCUMM_TRACE_SCOPE("SwapBuffers", "frame");
         m_window->swapBuffers();
     }
 
@@ -244,20 +466,35 @@ namespace scummredux {
 
         ConsoleView::info("Shutting down application...");
 
-        // Save settings
-        Settings::getInstance().save();
-        ConsoleView::info("Settings saved");
+        // Stop background work before the data it reads goes away
+        GameManager::getInstance().close();
+        JobSystem::getInstance().shutdown();
+
+        // Finish any trace or input recording still in progress
+        TraceRecorder::getInstance().stop();
+        InputRecorder::getInstance().stop();
+
+        // Save settings (headless runs never touch the user's settings)
+        if (!m_options.headless) {
+            Settings::getInstance().save();
+            ConsoleView::info("Settings saved");
+        }
 
         // Cleanup components
         m_windowDecorator.reset();
         
+        // Textures go while the GL context is still alive
+        TextureCache::getInstance().shutdown();
+
         // Shutdown ImGui
         shutdownImGui();
         ConsoleView::info("ImGui shutdown complete");
 
         // Shutdown window
-        m_window.reset();
-        ConsoleView::info("Window shutdown complete");
+        if (m_window) {
+            m_window.reset();
+            ConsoleView::info("Window shutdown complete");
+        }
 
         m_initialized = false;
         ConsoleView::success("Application shutdown complete");
@@ -4,13 +4,30 @@
 #include "../ui/WindowDecorator.h"
 #include "../views/ViewManager.h"  // CORRIGIDO: era ../ui/ViewManager.h
 #include "../ui/StyleManager.h"
+#include "InputSource.h"
+#include "BenchmarkReport.h"
 #include <memory>
+#include <string>
 
 namespace scummredux {
 
+    struct ApplicationOptions {
+        // Headless mode runs the full view stack without a window or GL context
+        bool headless = false;
+        int frameCount = 0;             // Frames to run in headless mode (0 = replay length or 600)
+        int width = 1280;               // Virtual display size in headless mode
+        int height = 720;
+        double fixedDeltaTime = 1.0 / 60.0;
+        std::string inputScript;        // ScriptedInputSource file fed in headless mode
+        std::string replayPath;         // Recorded input stream replayed in headless mode
+        std::string recordPath;         // Record ImGui input to this file from the first frame
+        std::string reportPath;         // Benchmark JSON output ("" = no report)
+        bool verbose = false;           // Views print per-frame debug output to stdout
+    };
+
     class Application {
     public:
-        Application();
+        explicit Application(ApplicationOptions options = {});
         ~Application();
 
         // Main application lifecycle
@@ -21,6 +38,7 @@ namespace scummredux {
         // Application control
         void requestClose() { m_shouldClose = true; }
         bool shouldClose() const { return m_shouldClose; }
+        bool isHeadless() const { return m_options.headless; }
 
         // Component access
         Window* getWindow() const { return m_window.get(); }
@@ -29,6 +47,10 @@ namespace scummredux {
 
     private:
         void initializeImGui();
+        void initializeHeadlessImGui();
+        void uploadFontAtlas();
+        int runHeadless();
+        double getTime() const;
         void shutdownImGui();
         void setupViews();
         void setupEventHandlers();
@@ -43,6 +65,8 @@ namespace scummredux {
         void endFrame();
         void drawMainContent();
 
+        ApplicationOptions m_options;
+
         // Core components
         std::unique_ptr<Window> m_window;
         std::unique_ptr<WindowDecorator> m_windowDecorator;
@@ -58,6 +82,13 @@ namespace scummredux {
         double m_fpsUpdateTime = 0.0;
         float m_currentFPS = 0.0f;
 
+        // Headless runs
+        std::unique_ptr<InputSource> m_inputSource;
+        BenchmarkReport m_benchmark;
+        uint64_t m_frameIndex = 0;
+
+        static constexpr int DEFAULT_HEADLESS_FRAMES = 600;
+
         // Settings (removed unused m_showDemo and m_showFPS)
         // These can be re-added when needed
     };
@@ -0,0 +1,109 @@
+#include "BenchmarkReport.h"
+#include "DrawStats.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+namespace scummredux {
+
+    namespace {
+        template<typename T>
+        double percentile(std::vector<T> values, double fraction) {
+            if (values.empty()) return 0.0;
+            const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * (values.size() - 1) + 0.5));
+            std::nth_element(values.begin(), values.begin() + index, values.end());
+            return static_cast<double>(values[index]);
+        }
+
+        template<typename T>
+        void writeDistribution(std::ostream& out, const std::vector<T>& values) {
+            const double sum = std::accumulate(values.begin(), values.end(), 0.0);
+            const double mean = values.empty() ? 0.0 : sum / values.size();
+            const auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+
+            out << "{\"mean\": " << mean
+                << ", \"min\": " << (values.empty() ? 0.0 : static_cast<double>(*minIt))
+                << ", \"max\": " << (values.empty() ? 0.0 : static_cast<double>(*maxIt))
+                << ", \"p50\": " << percentile(values, 0.50)
+                << ", \"p95\": " << percentile(values, 0.95)
+                << ", \"p99\": " << percentile(values, 0.99)
+                << ", \"total\": " << sum << "}";
+        }
+    }
+
+    void BenchmarkReport::reserve(size_t frameCount) {
+        // Reserved up front so sampling does not show up in the allocation counts
+        m_frameTimesMs.reserve(frameCount);
+        m_frameAllocations.reserve(frameCount);
+        m_frameBytes.reserve(frameCount);
+    }
+
+    void BenchmarkReport::beginFrame() {
+        m_frameStartAllocations = AllocationTracker::snapshot();
+        m_frameStart = std::chrono::steady_clock::now();
+    }
+
+    void BenchmarkReport::endFrame() {
+        const auto frameEnd = std::chrono::steady_clock::now();
+        const auto allocations = AllocationTracker::snapshot();
+
+        m_frameTimesMs.push_back(std::chrono::duration<double, std::milli>(frameEnd - m_frameStart).count());
+        m_frameAllocations.push_back(allocations.allocations - m_frameStartAllocations.allocations);
+        m_frameBytes.push_back(allocations.bytesAllocated - m_frameStartAllocations.bytesAllocated);
+    }
+
+    void BenchmarkReport::writeJson(std::ostream& out) const {
+        const auto& drawStats = DrawStats::getInstance();
+        const auto& totals = drawStats.getTotals();
+        const auto& peak = drawStats.getPeak();
+        const double drawFrames = std::max<double>(1.0, static_cast<double>(drawStats.getFrameCount()));
+
+        out << std::fixed << std::setprecision(4);
+        out << "{\n";
+        out << "  \"frames\": " << m_frameTimesMs.size() << ",\n";
+        out << "  \"frame_time_ms\": ";
+        writeDistribution(out, m_frameTimesMs);
+        out << ",\n  \"allocations_per_frame\": ";
+        writeDistribution(out, m_frameAllocations);
+        out << ",\n  \"allocated_bytes_per_frame\": ";
+        writeDistribution(out, m_frameBytes);
+        out << ",\n  \"draw\": {\n";
+        out << "    \"lists_per_frame\": " << totals.drawLists / drawFrames << ",\n";
+        out << "    \"commands_per_frame\": " << totals.commands / drawFrames << ",\n";
+        out << "    \"vertices_per_frame\": " << totals.vertices / drawFrames << ",\n";
+        out << "    \"indices_per_frame\": " << totals.indices / drawFrames << ",\n";
+        out << "    \"texture_switches_per_frame\": " << totals.textureSwitches / drawFrames << ",\n";
+        out << "    \"peak\": {\"lists\": " << peak.drawLists << ", \"commands\": " << peak.commands
+            << ", \"vertices\": " << peak.vertices << ", \"indices\": " << peak.indices
+            << ", \"texture_switches\": " << peak.textureSwitches << "},\n";
+
+        // Heaviest windows of the last frame
+        out << "    \"windows\": [";
+        const auto& lists = drawStats.getLists();
+        for (size_t i = 0; i < lists.size() && i < MAX_REPORTED_WINDOWS; i++) {
+            std::string owner;
+            for (char c : lists[i].owner) {
+                if (c == '"' || c == '\\') owner += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) owner += c;
+            }
+            out << (i ? ",\n      " : "\n      ") << "{\"owner\": \"" << owner << "\", \"commands\": " << lists[i].commands
+                << ", \"vertices\": " << lists[i].vertices << ", \"indices\": " << lists[i].indices
+                << ", \"texture_switches\": " << lists[i].textureSwitches << "}";
+        }
+        out << "\n    ]\n";
+        out << "  }\n";
+        out << "}\n";
+    }
+
+    bool BenchmarkReport::save(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        writeJson(file);
+        return true;
+    }
+
+} // namespace scummredux
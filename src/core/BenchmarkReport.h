@@ -0,0 +1,36 @@
+#pragma once
+
+#include "AllocationTracker.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Per-frame timing and allocation samples of a headless run, written out as JSON
+    class BenchmarkReport {
+    public:
+        void reserve(size_t frameCount);
+
+        void beginFrame();
+        void endFrame();
+
+        size_t getFrameCount() const { return m_frameTimesMs.size(); }
+
+        void writeJson(std::ostream& out) const;
+        bool save(const std::string& path) const;
+
+    private:
+        std::vector<double> m_frameTimesMs;
+        std::vector<uint64_t> m_frameAllocations;
+        std::vector<uint64_t> m_frameBytes;
+
+        std::chrono::steady_clock::time_point m_frameStart;
+        AllocationTracker::Snapshot m_frameStartAllocations;
+
+        static constexpr size_t MAX_REPORTED_WINDOWS = 10;
+    };
+
+} // namespace scummredux
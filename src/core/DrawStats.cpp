@@ -0,0 +1,90 @@
+#include "DrawStats.h"
+#include <algorithm>
+
+namespace scummredux {
+
+    DrawStats& DrawStats::getInstance() {
+        static DrawStats instance;
+        return instance;
+    }
+
+    void DrawStats::collect(const ImDrawData* drawData) {
+        m_frame = {};
+
+        if (!drawData || !drawData->Valid) {
+            m_lists.clear();
+            return;
+        }
+
+        const int listCount = drawData->CmdListsCount;
+        if (m_lists.size() < static_cast<size_t>(listCount)) {
+            m_lists.resize(listCount);
+        }
+
+        // Texture state carries over between lists, like it does in the backend
+        ImTextureID currentTexture = ImTextureID();
+        bool hasTexture = false;
+
+        for (int i = 0; i < listCount; i++) {
+            const ImDrawList* drawList = drawData->CmdLists[i];
+            auto& list = m_lists[i];
+
+            list.owner.assign(drawList->_OwnerName ? drawList->_OwnerName : "(unnamed)");
+            list.vertices = static_cast<uint32_t>(drawList->VtxBuffer.Size);
+            list.indices = static_cast<uint32_t>(drawList->IdxBuffer.Size);
+            list.commands = 0;
+            list.textureSwitches = 0;
+
+            for (const ImDrawCmd& cmd : drawList->CmdBuffer) {
+                if (cmd.UserCallback != nullptr) {
+                    continue;
+                }
+
+                list.commands++;
+
+                const ImTextureID texture = cmd.GetTexID();
+                if (!hasTexture || texture != currentTexture) {
+                    if (hasTexture) {
+                        list.textureSwitches++;
+                    }
+                    currentTexture = texture;
+                    hasTexture = true;
+                }
+            }
+
+            m_frame.commands += list.commands;
+            m_frame.vertices += list.vertices;
+            m_frame.indices += list.indices;
+            m_frame.textureSwitches += list.textureSwitches;
+        }
+
+        m_lists.resize(listCount);
+        m_frame.drawLists = static_cast<uint32_t>(listCount);
+
+        // Heaviest lists first
+        std::sort(m_lists.begin(), m_lists.end(), [](const ListStats& a, const ListStats& b) {
+            return a.vertices > b.vertices;
+        });
+
+        m_totals.drawLists += m_frame.drawLists;
+        m_totals.commands += m_frame.commands;
+        m_totals.vertices += m_frame.vertices;
+        m_totals.indices += m_frame.indices;
+        m_totals.textureSwitches += m_frame.textureSwitches;
+
+        m_peak.drawLists = std::max(m_peak.drawLists, m_frame.drawLists);
+        m_peak.commands = std::max(m_peak.commands, m_frame.commands);
+        m_peak.vertices = std::max(m_peak.vertices, m_frame.vertices);
+        m_peak.indices = std::max(m_peak.indices, m_frame.indices);
+        m_peak.textureSwitches = std::max(m_peak.textureSwitches, m_frame.textureSwitches);
+
+        m_frameCount++;
+    }
+
+    void DrawStats::resetTotals() {
+        m_totals = {};
+        m_peak = {};
+        m_frameCount = 0;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <imgui.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // CPU-side statistics of the ImGui draw data submitted each frame.
+    // Collected right before the renderer backend consumes the draw lists.
+    class DrawStats {
+    public:
+        struct ListStats {
+            std::string owner;          // Window that produced the draw list
+            uint32_t commands = 0;
+            uint32_t vertices = 0;
+            uint32_t indices = 0;
+            uint32_t textureSwitches = 0;
+        };
+
+        struct FrameStats {
+            uint64_t drawLists = 0;
+            uint64_t commands = 0;
+            uint64_t vertices = 0;
+            uint64_t indices = 0;
+            uint64_t textureSwitches = 0;
+        };
+
+        static DrawStats& getInstance();
+
+        void collect(const ImDrawData* drawData);
+        void resetTotals();
+
+        // Last collected frame
+        const FrameStats& getFrame() const { return m_frame; }
+        const std::vector<ListStats>& getLists() const { return m_lists; }
+
+        // Accumulated since the last resetTotals()
+        const FrameStats& getTotals() const { return m_totals; }
+        const FrameStats& getPeak() const { return m_peak; }
+        uint64_t getFrameCount() const { return m_frameCount; }
+
+    private:
+        DrawStats() = default;
+
+        FrameStats m_frame;
+        FrameStats m_totals;
+        FrameStats m_peak;
+        uint64_t m_frameCount = 0;
+
+        // Reused between frames to avoid per-frame allocations
+        std::vector<ListStats> m_lists;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,580 @@
+#include "FileTree.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace scummredux {
+
+    namespace {
+        // Directories first, then by name
+        bool entryLess(const FileTree::Entry& a, const FileTree::Entry& b) {
+            if (a.isDirectory != b.isDirectory) {
+                return a.isDirectory;
+            }
+            return a.name < b.name;
+        }
+
+        FileTree::Entry makeTombstone() {
+            FileTree::Entry entry;
+            entry.removed = true;
+            return entry;
+        }
+    }
+
+    FileTree::~FileTree() {
+        stopScanner();
+    }
+
+    void FileTree::open(const std::filesystem::path& root) {
+        stopScanner();
+
+        m_root = root;
+        m_entries.clear();
+        m_queuedChanges.clear();
+        m_update = {};
+        m_nextIndex = ROOT_INDEX + 1;
+        m_generation++;
+
+        Entry rootEntry;
+        rootEntry.name = root.filename().empty() ? root.string() : root.filename().string();
+        rootEntry.isDirectory = true;
+        m_entries.push_back(std::move(rootEntry));
+
+        m_cancel = false;
+        enqueue(ROOT_INDEX, false);
+        m_scanner = std::thread(&FileTree::scannerMain, this);
+    }
+
+    void FileTree::close() {
+        stopScanner();
+
+        m_root.clear();
+        m_entries.clear();
+        m_queuedChanges.clear();
+        m_update = {};
+        m_generation++;
+    }
+
+    void FileTree::rescan() {
+        if (isOpen()) {
+            open(m_root);
+        }
+    }
+
+    void FileTree::stopScanner() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_cancel = true;
+        }
+        m_wake.notify_all();
+        if (m_scanner.joinable()) {
+            m_scanner.join();
+        }
+
+        std::lock_guard lock(m_mutex);
+        m_queue.clear();
+        m_pendingBatches.clear();
+        m_hasPending = false;
+        m_outstanding = 0;
+    }
+
+    void FileTree::enqueue(uint32_t directory, bool replace) {
+        PendingDirectory pending{directory, m_entries[directory].depth, replace, getPath(directory)};
+        {
+            std::lock_guard lock(m_mutex);
+            // A relist that has not started yet will already see the latest contents
+            if (replace && std::any_of(m_queue.begin(), m_queue.end(), [directory](const PendingDirectory& queued) {
+                    return queued.index == directory && queued.replace;
+                })) {
+                return;
+            }
+            m_queue.push_back(std::move(pending));
+            m_outstanding++;
+        }
+        m_wake.notify_one();
+    }
+
+    void FileTree::applyChanges(std::vector<FileChange> changes) {
+        if (m_queuedChanges.empty()) {
+            m_queuedChanges = std::move(changes);
+        } else {
+            m_queuedChanges.insert(m_queuedChanges.end(), std::make_move_iterator(changes.begin()),
+                                   std::make_move_iterator(changes.end()));
+        }
+    }
+
+    const FileTree::Update& FileTree::poll(size_t maxEntries) {
+        m_update.directories.clear();
+        m_update.moved.clear();
+        m_update.removed.clear();
+
+        if (!m_queuedChanges.empty()) {
+            applyQueuedChanges();
+        }
+
+        if (!m_hasPending.load(std::memory_order_relaxed)) {
+            return m_update;
+        }
+
+        SCUMM_TRACE_SCOPE("FileTree::poll", "io");
+
+        // Take whole batches until the budget is used up
+        std::deque<Batch> batches;
+        {
+            std::lock_guard lock(m_mutex);
+            size_t taken = 0;
+            while (!m_pendingBatches.empty() && (taken == 0 || taken < maxEntries)) {
+                taken += m_pendingBatches.front().entries.size();
+                batches.push_back(std::move(m_pendingBatches.front()));
+                m_pendingBatches.pop_front();
+            }
+            m_hasPending = !m_pendingBatches.empty();
+        }
+
+        for (auto& batch : batches) {
+            // Directory deleted (or replaced) while it was being listed
+            if (batch.directory >= m_entries.size() || m_entries[batch.directory].removed) {
+                continue;
+            }
+
+            if (batch.replace) {
+                replaceChildren(batch.directory, std::move(batch.entries));
+                continue;
+            }
+
+            // Indices were reserved by the scanner; earlier reservations may still be in flight
+            const auto count = static_cast<uint32_t>(batch.entries.size());
+            if (m_entries.size() < batch.first + count) {
+                m_entries.resize(batch.first + count, makeTombstone());
+            }
+            std::move(batch.entries.begin(), batch.entries.end(), m_entries.begin() + batch.first);
+
+            Entry& directory = m_entries[batch.directory];
+            directory.firstChild = batch.first;
+            directory.childCount = count;
+            directory.scanned = true;
+            m_update.directories.push_back(batch.directory);
+        }
+
+        return m_update;
+    }
+
+    void FileTree::prioritize(uint32_t directory) {
+        std::lock_guard lock(m_mutex);
+        auto it = std::find_if(m_queue.begin(), m_queue.end(), [directory](const PendingDirectory& pending) {
+            return pending.index == directory;
+        });
+        if (it != m_queue.end() && it != m_queue.begin()) {
+            PendingDirectory pending = std::move(*it);
+            m_queue.erase(it);
+            m_queue.push_front(std::move(pending));
+        }
+    }
+
+    std::filesystem::path FileTree::getPath(uint32_t index) const {
+        if (index == ROOT_INDEX || index >= m_entries.size()) {
+            return m_root;
+        }
+
+        // Walk up to the root, then join the names top-down
+        std::vector<const std::string*> names;
+        for (uint32_t current = index; current != ROOT_INDEX; current = m_entries[current].parent) {
+            names.push_back(&m_entries[current].name);
+        }
+
+        std::filesystem::path path = m_root;
+        for (auto it = names.rbegin(); it != names.rend(); ++it) {
+            path /= **it;
+        }
+        return path;
+    }
+
+    uint32_t FileTree::find(const std::filesystem::path& path) const {
+        if (!isOpen()) {
+            return INVALID_INDEX;
+        }
+
+        const auto relative = path.lexically_relative(m_root);
+        if (relative.empty()) {
+            return INVALID_INDEX;
+        }
+
+        uint32_t current = ROOT_INDEX;
+        for (const auto& part : relative) {
+            const std::string name = part.string();
+            if (name.empty() || name == ".") {
+                continue;
+            }
+
+            const Entry& directory = m_entries[current];
+            if (name == ".." || !directory.isDirectory || !directory.scanned) {
+                return INVALID_INDEX;
+            }
+
+            uint32_t match = INVALID_INDEX;
+            for (uint32_t i = 0; i < directory.childCount; i++) {
+                if (m_entries[directory.firstChild + i].name == name) {
+                    match = directory.firstChild + i;
+                    break;
+                }
+            }
+            if (match == INVALID_INDEX) {
+                return INVALID_INDEX;
+            }
+            current = match;
+        }
+        return current;
+    }
+
+    void FileTree::applyQueuedChanges() {
+        SCUMM_TRACE_SCOPE("FileTree::applyChanges", "io");
+
+        std::vector<FileChange> changes;
+        changes.swap(m_queuedChanges);
+
+        // Group the changes by parent directory so each child range is rebuilt once
+        std::unordered_map<uint32_t, DirectoryDelta> deltas;
+        std::unordered_map<std::string, uint32_t> directories;
+        auto resolveDirectory = [&](const std::filesystem::path& path) {
+            auto [it, inserted] = directories.try_emplace(path.string(), INVALID_INDEX);
+            if (inserted) {
+                const uint32_t index = find(path);
+                if (index != INVALID_INDEX && m_entries[index].isDirectory && m_entries[index].scanned) {
+                    it->second = index;
+                }
+            }
+            return it->second;
+        };
+
+        for (auto& change : changes) {
+            const uint32_t parent = resolveDirectory(change.path.parent_path());
+            const std::string name = change.path.filename().string();
+
+            switch (change.type) {
+                case FileChange::Type::Created: {
+                    if (parent == INVALID_INDEX) break;
+                    Entry entry;
+                    entry.name = name;
+                    entry.size = change.size;
+                    entry.isDirectory = change.isDirectory;
+                    deltas[parent].added.push_back(std::move(entry));
+                    break;
+                }
+                case FileChange::Type::Deleted:
+                    if (parent != INVALID_INDEX) {
+                        deltas[parent].removed.push_back(name);
+                    }
+                    break;
+                case FileChange::Type::Modified:
+                    if (parent != INVALID_INDEX && !change.isDirectory) {
+                        deltas[parent].modified.emplace_back(name, change.size);
+                    }
+                    break;
+                case FileChange::Type::Renamed: {
+                    // Moving a directory carries its scanned subtree along
+                    Entry entry;
+                    entry.isDirectory = change.isDirectory;
+                    entry.size = change.size;
+
+                    const uint32_t oldParent = resolveDirectory(change.oldPath.parent_path());
+                    if (oldParent != INVALID_INDEX) {
+                        const uint32_t previous = find(change.oldPath);
+                        if (previous != INVALID_INDEX && parent != INVALID_INDEX) {
+                            entry = m_entries[previous];
+                            m_entries[previous].firstChild = INVALID_INDEX;
+                            m_entries[previous].childCount = 0;
+                            m_entries[previous].scanned = false;
+                            deltas[parent].renamed.emplace_back(name, previous);
+                        }
+                        deltas[oldParent].removed.push_back(change.oldPath.filename().string());
+                    }
+                    if (parent != INVALID_INDEX) {
+                        entry.name = name;
+                        deltas[parent].added.push_back(std::move(entry));
+                    }
+                    break;
+                }
+                case FileChange::Type::Rescan: {
+                    const uint32_t directory = resolveDirectory(change.path);
+                    if (directory != INVALID_INDEX) {
+                        enqueue(directory, true);
+                    }
+                    break;
+                }
+                case FileChange::Type::Overflow:
+                    break;  // Handled by the owner with a full rescan
+            }
+        }
+
+        // Deepest first: rebuilding a parent moves its child directories to new indices
+        std::vector<std::pair<uint32_t, DirectoryDelta*>> order;
+        order.reserve(deltas.size());
+        for (auto& [directory, delta] : deltas) {
+            order.emplace_back(directory, &delta);
+        }
+        std::sort(order.begin(), order.end(), [this](const auto& a, const auto& b) {
+            return m_entries[a.first].depth > m_entries[b.first].depth;
+        });
+
+        for (auto& [directory, delta] : order) {
+            if (!m_entries[directory].removed) {
+                applyDelta(directory, *delta);
+            }
+        }
+    }
+
+    void FileTree::applyDelta(uint32_t directory, DirectoryDelta& delta) {
+        const uint32_t first = m_entries[directory].firstChild;
+        const uint32_t count = m_entries[directory].childCount;
+
+        std::unordered_map<std::string_view, uint64_t> modified;
+        for (const auto& [name, size] : delta.modified) {
+            modified[name] = size;
+        }
+
+        // Content changes only: update sizes in place
+        if (delta.added.empty() && delta.removed.empty()) {
+            for (uint32_t i = first; i < first + count; i++) {
+                auto it = modified.find(m_entries[i].name);
+                if (it != modified.end()) {
+                    m_entries[i].size = it->second;
+                }
+            }
+            return;
+        }
+
+        // Later additions win over earlier ones and over existing entries of the same name
+        std::unordered_map<std::string_view, size_t> added;
+        for (size_t i = 0; i < delta.added.size(); i++) {
+            added[delta.added[i].name] = i;
+        }
+        const std::unordered_set<std::string_view> removed(delta.removed.begin(), delta.removed.end());
+
+        std::vector<Entry> children;
+        children.reserve(count + delta.added.size());
+        for (uint32_t i = first; i < first + count; i++) {
+            const Entry& entry = m_entries[i];
+            if (removed.contains(entry.name) || added.contains(entry.name)) {
+                continue;
+            }
+            children.push_back(entry);
+            if (auto it = modified.find(entry.name); it != modified.end()) {
+                children.back().size = it->second;
+            }
+        }
+        for (size_t i = 0; i < delta.added.size(); i++) {
+            if (added[delta.added[i].name] == i) {
+                children.push_back(delta.added[i]);
+            }
+        }
+
+        std::unordered_map<std::string_view, uint32_t> renamed;
+        for (const auto& [name, previous] : delta.renamed) {
+            renamed[name] = previous;
+        }
+        replaceChildren(directory, std::move(children), renamed);
+    }
+
+    void FileTree::replaceChildren(uint32_t directory, std::vector<Entry> children,
+                                   const std::unordered_map<std::string_view, uint32_t>& renamed) {
+        const uint32_t oldFirst = m_entries[directory].firstChild;
+        const uint32_t oldCount = m_entries[directory].scanned ? m_entries[directory].childCount : 0;
+        const auto depth = static_cast<uint16_t>(m_entries[directory].depth + 1);
+
+        for (auto& child : children) {
+            child.parent = directory;
+            child.depth = depth;
+            child.isHidden = !child.name.empty() && child.name[0] == '.';
+            child.removed = false;
+        }
+        std::sort(children.begin(), children.end(), entryLess);
+
+        // Allocate before taking views into the old names (growing the vector moves them)
+        const auto count = static_cast<uint32_t>(children.size());
+        const uint32_t first = allocate(count);
+
+        std::unordered_map<std::string_view, uint32_t> previous;
+        previous.reserve(oldCount);
+        for (uint32_t i = oldFirst; i < oldFirst + oldCount; i++) {
+            previous[m_entries[i].name] = i;
+        }
+
+        // Same name survives: keep its subtree and report the index move
+        std::vector<uint8_t> survived(oldCount, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            Entry& child = children[i];
+            if (auto it = renamed.find(child.name); it != renamed.end()) {
+                // Renamed or moved here: the view state follows it from its old index
+                m_update.moved.emplace_back(it->second, first + i);
+                if (child.isDirectory) {
+                    std::replace(m_update.directories.begin(), m_update.directories.end(), it->second, first + i);
+                }
+            } else if (auto it = previous.find(child.name); it != previous.end()) {
+                const Entry& old = m_entries[it->second];
+                if (child.isDirectory && old.isDirectory && child.firstChild == INVALID_INDEX && old.scanned) {
+                    child.firstChild = old.firstChild;
+                    child.childCount = old.childCount;
+                    child.scanned = true;
+                }
+                survived[it->second - oldFirst] = 1;
+                m_update.moved.emplace_back(it->second, first + i);
+
+                // Keep earlier updates in this poll pointing at the live entry
+                if (child.isDirectory) {
+                    std::replace(m_update.directories.begin(), m_update.directories.end(), it->second, first + i);
+                }
+            }
+            m_entries[first + i] = std::move(child);
+        }
+
+        for (uint32_t i = 0; i < oldCount; i++) {
+            Entry& old = m_entries[oldFirst + i];
+            if (survived[i]) {
+                old.removed = true;
+                old.firstChild = INVALID_INDEX;
+                old.childCount = 0;
+            } else {
+                removeSubtree(oldFirst + i);
+            }
+        }
+
+        Entry& entry = m_entries[directory];
+        entry.firstChild = first;
+        entry.childCount = count;
+        entry.scanned = true;
+        m_update.directories.push_back(directory);
+
+        // Adopted subtrees point at their new parent; new directories still need listing
+        for (uint32_t i = first; i < first + count; i++) {
+            const Entry& child = m_entries[i];
+            if (!child.isDirectory) {
+                continue;
+            }
+            if (child.firstChild != INVALID_INDEX) {
+                reparentChildren(i);
+            } else if (!child.scanned) {
+                enqueue(i, false);
+            }
+        }
+    }
+
+    void FileTree::reparentChildren(uint32_t directory) {
+        std::vector<uint32_t> stack = {directory};
+        while (!stack.empty()) {
+            const uint32_t current = stack.back();
+            stack.pop_back();
+
+            const Entry& entry = m_entries[current];
+            const auto depth = static_cast<uint16_t>(entry.depth + 1);
+            for (uint32_t i = entry.firstChild; i < entry.firstChild + entry.childCount; i++) {
+                Entry& child = m_entries[i];
+                child.parent = current;
+                // Deeper levels only change when the subtree moved to another depth
+                if (child.depth != depth) {
+                    child.depth = depth;
+                    if (child.isDirectory && child.scanned) {
+                        stack.push_back(i);
+                    }
+                }
+            }
+        }
+    }
+
+    void FileTree::removeSubtree(uint32_t index) {
+        std::vector<uint32_t> stack = {index};
+        while (!stack.empty()) {
+            const uint32_t current = stack.back();
+            stack.pop_back();
+
+            Entry& entry = m_entries[current];
+            entry.removed = true;
+            m_update.removed.push_back(current);
+
+            if (entry.isDirectory && entry.scanned && entry.firstChild != INVALID_INDEX) {
+                for (uint32_t i = entry.firstChild; i < entry.firstChild + entry.childCount; i++) {
+                    stack.push_back(i);
+                }
+            }
+        }
+    }
+
+    uint32_t FileTree::allocate(uint32_t count) {
+        const uint32_t first = m_nextIndex.fetch_add(count);
+        if (m_entries.size() < first + count) {
+            m_entries.resize(first + count, makeTombstone());
+        }
+        return first;
+    }
+
+    void FileTree::scannerMain() {
+        TraceRecorder::getInstance().setThreadName("FileScanner");
+
+        for (;;) {
+            PendingDirectory directory;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_cancel.load() || !m_queue.empty(); });
+                if (m_cancel.load()) {
+                    break;
+                }
+                directory = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            SCUMM_TRACE_SCOPE("ScanDirectory", "io");
+
+            Batch batch;
+            batch.directory = directory.index;
+            batch.first = INVALID_INDEX;
+            batch.replace = directory.replace;
+
+            std::error_code ec;
+            const auto options = std::filesystem::directory_options::skip_permission_denied;
+            for (std::filesystem::directory_iterator it(directory.path, options, ec), end; !ec && it != end; it.increment(ec)) {
+                const auto& item = *it;
+
+                Entry entry;
+                entry.name = item.path().filename().string();
+                entry.parent = directory.index;
+                entry.depth = static_cast<uint16_t>(directory.depth + 1);
+                entry.isHidden = !entry.name.empty() && entry.name[0] == '.';
+
+                // Symlinked directories are listed but never followed (no cycles)
+                std::error_code statusError;
+                entry.isDirectory = item.is_directory(statusError) && !item.is_symlink(statusError);
+                if (!entry.isDirectory) {
+                    entry.size = item.file_size(statusError);
+                    if (statusError) {
+                        entry.size = 0;
+                    }
+                }
+
+                batch.entries.push_back(std::move(entry));
+            }
+
+            std::sort(batch.entries.begin(), batch.entries.end(), entryLess);
+
+            // Relistings get their indices on the main thread, which merges them
+            if (!batch.replace) {
+                batch.first = m_nextIndex.fetch_add(static_cast<uint32_t>(batch.entries.size()));
+            }
+
+            std::lock_guard lock(m_mutex);
+            if (!batch.replace) {
+                for (uint32_t i = 0; i < batch.entries.size(); i++) {
+                    const Entry& entry = batch.entries[i];
+                    if (entry.isDirectory) {
+                        m_queue.push_back({batch.first + i, entry.depth, false, directory.path / entry.name});
+                        m_outstanding++;
+                    }
+                }
+            }
+            m_pendingBatches.push_back(std::move(batch));
+            m_hasPending = true;
+            m_outstanding--;
+        }
+    }
+
+} // namespace scummredux
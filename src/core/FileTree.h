@@ -0,0 +1,143 @@
+#pragma once
+
+#include "FileWatcher.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace scummredux {
+
+    // Flat, index-based project tree. Entries live in one vector; every directory's
+    // children are a contiguous index range. A background std::filesystem scanner walks
+    // the tree breadth-first and streams one batch per directory, which poll() appends
+    // on the main thread, so large game folders load without blocking the UI.
+    // File changes replace a directory's child range with a new one at the end of the
+    // vector; the old slots become tombstones until the next full scan.
+    class FileTree {
+    public:
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+        static constexpr uint32_t ROOT_INDEX = 0;
+
+        struct Entry {
+            std::string name;
+            uint32_t parent = INVALID_INDEX;
+            uint32_t firstChild = INVALID_INDEX;
+            uint32_t childCount = 0;
+            uint64_t size = 0;
+            uint16_t depth = 0;
+            bool isDirectory = false;
+            bool isHidden = false;
+            bool scanned = false;       // Directory children are known
+            bool removed = false;       // Tombstone (or a slot still being scanned)
+        };
+
+        // What the last poll() changed
+        struct Update {
+            std::vector<uint32_t> directories;                      // Children arrived or were replaced (current indices)
+            std::vector<std::pair<uint32_t, uint32_t>> moved;       // Surviving entries: old -> new index
+                                                                    // (renamed ones are also in removed)
+            std::vector<uint32_t> removed;                          // Entries (and subtrees) that are gone
+
+            bool empty() const { return directories.empty() && moved.empty() && removed.empty(); }
+        };
+
+        FileTree() = default;
+        ~FileTree();
+
+        FileTree(const FileTree&) = delete;
+        FileTree& operator=(const FileTree&) = delete;
+
+        // Starts scanning a new root (the previous scan is cancelled)
+        void open(const std::filesystem::path& root);
+        void close();
+        void rescan();
+
+        // Queues watcher deltas; they are applied by the next poll()
+        void applyChanges(std::vector<FileChange> changes);
+
+        // Main thread: applies queued changes and finished batches (up to roughly
+        // maxEntries per call)
+        const Update& poll(size_t maxEntries = DEFAULT_POLL_BUDGET);
+
+        // Moves a queued directory to the front of the scan (e.g. when expanded)
+        void prioritize(uint32_t directory);
+
+        // Queries
+        bool isOpen() const { return !m_entries.empty(); }
+        bool isScanning() const { return m_outstanding.load(std::memory_order_relaxed) > 0 || m_hasPending.load(std::memory_order_relaxed); }
+        size_t size() const { return m_entries.size(); }
+        const Entry& get(uint32_t index) const { return m_entries[index]; }
+        const std::filesystem::path& getRoot() const { return m_root; }
+        std::filesystem::path getPath(uint32_t index) const;
+        uint32_t find(const std::filesystem::path& path) const;
+        uint32_t getGeneration() const { return m_generation; }
+
+    private:
+        struct Batch {
+            uint32_t directory;
+            uint32_t first;
+            bool replace;               // Relisting of a known directory (indices not assigned yet)
+            std::vector<Entry> entries;
+        };
+
+        struct PendingDirectory {
+            uint32_t index;
+            uint16_t depth;
+            bool replace;
+            std::filesystem::path path;
+        };
+
+        struct DirectoryDelta {
+            std::vector<Entry> added;
+            std::vector<std::string> removed;
+            std::vector<std::pair<std::string, uint64_t>> modified;
+            std::vector<std::pair<std::string, uint32_t>> renamed;      // New name -> the entry it was
+        };
+
+        void stopScanner();
+        void scannerMain();
+        void enqueue(uint32_t directory, bool replace);
+
+        // Main thread mutations
+        void applyQueuedChanges();
+        void applyDelta(uint32_t directory, DirectoryDelta& delta);
+        void replaceChildren(uint32_t directory, std::vector<Entry> children,
+                             const std::unordered_map<std::string_view, uint32_t>& renamed = {});
+        void reparentChildren(uint32_t directory);
+        void removeSubtree(uint32_t index);
+        uint32_t allocate(uint32_t count);
+
+        std::filesystem::path m_root;
+        std::vector<Entry> m_entries;
+        std::vector<FileChange> m_queuedChanges;
+        Update m_update;
+        uint32_t m_generation = 0;
+
+        // Indices are handed out to both the scanner and the main thread
+        std::atomic<uint32_t> m_nextIndex = ROOT_INDEX + 1;
+
+        // Scanner thread
+        std::thread m_scanner;
+        std::atomic<bool> m_cancel = false;
+        std::atomic<uint32_t> m_outstanding = 0;    // Queued or in-flight directories
+
+        // Shared with the scanner (guarded by m_mutex)
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<Batch> m_pendingBatches;
+        std::deque<PendingDirectory> m_queue;
+        std::atomic<bool> m_hasPending = false;
+
+        static constexpr size_t DEFAULT_POLL_BUDGET = 8192;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,463 @@
+#include "FileWatcher.h"
+#include "TraceRecorder.h"
+#include "../views/ConsoleView.h"
+#include <algorithm>
+#include <cerrno>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace scummredux {
+
+    namespace {
+#ifdef __linux__
+        constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                        IN_CLOSE_WRITE | IN_ONLYDIR | IN_EXCL_UNLINK;
+#endif
+
+        std::string parentOf(const std::string& path) {
+            const auto pos = path.find_last_of('/');
+            return pos == std::string::npos ? std::string() : path.substr(0, pos);
+        }
+
+        std::string join(const std::string& directory, const std::string& name) {
+            return (std::filesystem::path(directory) / name).string();
+        }
+    }
+
+    FileWatcher::~FileWatcher() {
+        stop();
+    }
+
+    void FileWatcher::start(const std::filesystem::path& root) {
+        stop();
+
+        m_root = root;
+        m_stop = false;
+        m_limitReached = false;
+        m_limitReported = false;
+
+#ifdef __linux__
+        m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_fd < 0) {
+            ConsoleView::warning("inotify unavailable, polling the project for changes");
+        }
+#endif
+
+        m_thread = std::thread(&FileWatcher::watcherMain, this);
+    }
+
+    void FileWatcher::stop() {
+        m_stop = true;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+
+#ifdef __linux__
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+#endif
+        m_fd = -1;
+
+        std::lock_guard lock(m_mutex);
+        m_watches.clear();
+        m_newPolled.clear();
+        m_ready.clear();
+        m_pending.clear();
+        m_moves.clear();
+        m_polled.clear();
+        m_overflow = false;
+    }
+
+    void FileWatcher::watchDirectory(const std::filesystem::path& directory) {
+        if (!isRunning()) {
+            return;
+        }
+
+        std::lock_guard lock(m_mutex);
+        addWatch(directory.string());
+    }
+
+    std::vector<FileChange> FileWatcher::poll() {
+        if (m_limitReached.load(std::memory_order_relaxed) && !m_limitReported) {
+            m_limitReported = true;
+            ConsoleView::warning("inotify watch limit reached; remaining directories are polled "
+                                 "(raise fs.inotify.max_user_watches to avoid this)");
+        }
+
+        std::vector<FileChange> changes;
+        std::lock_guard lock(m_mutex);
+        changes.swap(m_ready);
+        return changes;
+    }
+
+    bool FileWatcher::addWatch(const std::string& directory) {
+        // Caller holds m_mutex
+#ifdef __linux__
+        if (m_fd >= 0 && !m_limitReached.load(std::memory_order_relaxed)) {
+            const int wd = inotify_add_watch(m_fd, directory.c_str(), WATCH_MASK);
+            if (wd >= 0) {
+                m_watches[wd] = directory;
+                return true;
+            }
+            if (errno != ENOSPC) {
+                return false;   // Vanished or unreadable
+            }
+            m_limitReached = true;
+        }
+#endif
+        m_newPolled.push_back(directory);
+        return false;
+    }
+
+    void FileWatcher::renameWatches(const std::string& from, const std::string& to) {
+        // Caller holds m_mutex
+        for (auto& [wd, path] : m_watches) {
+            if (path == from || (path.starts_with(from) && path[from.size()] == '/')) {
+                path = to + path.substr(from.size());
+            }
+        }
+    }
+
+    void FileWatcher::watcherMain() {
+        TraceRecorder::getInstance().setThreadName("FileWatcher");
+        m_lastPoll = Clock::now();
+
+        while (!m_stop.load(std::memory_order_relaxed)) {
+#ifdef __linux__
+            if (m_fd >= 0) {
+                pollfd descriptor{m_fd, POLLIN, 0};
+                if (::poll(&descriptor, 1, WAIT_TIMEOUT_MS) > 0) {
+                    readEvents();
+                }
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS));
+            }
+#else
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS));
+#endif
+
+            const auto now = Clock::now();
+            if (now - m_lastPoll >= POLL_INTERVAL) {
+                scanPolledDirectories();
+                m_lastPoll = now;
+            }
+
+            // Publish once the storm settles, but never hold changes back for too long
+            const bool hasEvents = !m_pending.empty() || !m_moves.empty() || m_overflow;
+            if (hasEvents && (now - m_lastEvent >= QUIET_PERIOD || now - m_firstEvent >= MAX_LATENCY)) {
+                publish();
+            }
+        }
+    }
+
+    void FileWatcher::readEvents() {
+#ifdef __linux__
+        SCUMM_TRACE_SCOPE("FileWatcher::readEvents", "io");
+
+        alignas(inotify_event) char buffer[64 * 1024];
+        for (;;) {
+            const ssize_t length = read(m_fd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+
+            std::lock_guard lock(m_mutex);
+            for (const char* ptr = buffer; ptr < buffer + length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    if (!m_overflow && m_pending.empty() && m_moves.empty()) {
+                        m_firstEvent = Clock::now();
+                    }
+                    m_overflow = true;
+                    m_lastEvent = Clock::now();
+                    continue;
+                }
+
+                auto watch = m_watches.find(event->wd);
+                if (watch == m_watches.end()) {
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    m_watches.erase(watch);
+                    continue;
+                }
+                if (event->len == 0) {
+                    continue;
+                }
+
+                const std::string path = watch->second + '/' + event->name;
+                const bool isDirectory = (event->mask & IN_ISDIR) != 0;
+
+                if (event->mask & IN_CREATE) {
+                    record(FileChange::Type::Created, path, isDirectory);
+                    if (isDirectory) {
+                        addWatch(path);
+                    }
+                } else if (event->mask & IN_DELETE) {
+                    record(FileChange::Type::Deleted, path, isDirectory);
+                } else if (event->mask & IN_CLOSE_WRITE) {
+                    record(FileChange::Type::Modified, path, false);
+                } else if (event->mask & IN_MOVED_FROM) {
+                    if (m_pending.empty() && m_moves.empty()) {
+                        m_firstEvent = Clock::now();
+                    }
+                    m_moves[event->cookie] = {path, isDirectory};
+                    m_lastEvent = Clock::now();
+                } else if (event->mask & IN_MOVED_TO) {
+                    auto move = m_moves.find(event->cookie);
+                    if (move != m_moves.end()) {
+                        recordMove(move->second.path, path, isDirectory);
+                        if (isDirectory) {
+                            renameWatches(move->second.path, path);
+                        }
+                        m_moves.erase(move);
+                    } else {
+                        // Moved in from outside the project
+                        record(FileChange::Type::Created, path, isDirectory);
+                        if (isDirectory) {
+                            addWatch(path);
+                        }
+                    }
+                }
+            }
+        }
+#endif
+    }
+
+    void FileWatcher::scanPolledDirectories() {
+        {
+            std::lock_guard lock(m_mutex);
+            for (auto& directory : m_newPolled) {
+                m_polled.try_emplace(std::move(directory));
+            }
+            m_newPolled.clear();
+        }
+
+        if (m_polled.empty()) {
+            return;
+        }
+
+        SCUMM_TRACE_SCOPE("FileWatcher::scanPolledDirectories", "io");
+
+        for (auto it = m_polled.begin(); it != m_polled.end() && !m_stop.load(std::memory_order_relaxed);) {
+            const std::string& directory = it->first;
+            DirectorySnapshot& snapshot = it->second;
+
+            // Creating, deleting or renaming an entry bumps the directory's mtime
+            std::error_code ec;
+            const auto time = std::filesystem::last_write_time(directory, ec);
+            if (ec) {
+                it = m_polled.erase(it);    // Gone; the parent's diff reports it
+                continue;
+            }
+            if (snapshot.baseline && time == snapshot.time) {
+                ++it;
+                continue;
+            }
+
+            std::unordered_map<std::string, ChildState> children;
+            const auto options = std::filesystem::directory_options::skip_permission_denied;
+            for (std::filesystem::directory_iterator entry(directory, options, ec), end; !ec && entry != end; entry.increment(ec)) {
+                std::error_code statusError;
+                ChildState state;
+                state.isDirectory = entry->is_directory(statusError) && !entry->is_symlink(statusError);
+                state.time = entry->last_write_time(statusError);
+                state.size = state.isDirectory ? 0 : entry->file_size(statusError);
+                if (statusError) {
+                    state.size = 0;
+                }
+                children.emplace(entry->path().filename().string(), state);
+            }
+
+            // The first listing only establishes the baseline
+            if (snapshot.baseline) {
+                for (const auto& [name, state] : children) {
+                    auto previous = snapshot.children.find(name);
+                    if (previous == snapshot.children.end()) {
+                        record(FileChange::Type::Created, join(directory, name), state.isDirectory);
+                    } else if (!state.isDirectory && (previous->second.time != state.time || previous->second.size != state.size)) {
+                        record(FileChange::Type::Modified, join(directory, name), false);
+                    }
+                }
+                for (const auto& [name, state] : snapshot.children) {
+                    if (!children.contains(name)) {
+                        record(FileChange::Type::Deleted, join(directory, name), state.isDirectory);
+                    }
+                }
+            }
+
+            snapshot.time = time;
+            snapshot.children = std::move(children);
+            snapshot.baseline = true;
+            ++it;
+        }
+    }
+
+    void FileWatcher::record(FileChange::Type type, const std::string& path, bool isDirectory) {
+        const auto now = Clock::now();
+        if (m_pending.empty() && m_moves.empty() && !m_overflow) {
+            m_firstEvent = now;
+        }
+        m_lastEvent = now;
+
+        auto it = m_pending.find(path);
+        if (it == m_pending.end()) {
+            m_pending.emplace(path, PendingChange{type, {}, isDirectory});
+            return;
+        }
+
+        // Fold the new event into what is already pending for this path
+        PendingChange& pending = it->second;
+        pending.isDirectory = isDirectory;
+        switch (type) {
+            case FileChange::Type::Created:
+                if (pending.type == FileChange::Type::Deleted) {
+                    pending.type = FileChange::Type::Modified;     // Replaced
+                }
+                break;
+            case FileChange::Type::Deleted:
+                if (pending.type == FileChange::Type::Created) {
+                    m_pending.erase(it);                           // Temporary file
+                } else if (pending.type == FileChange::Type::Renamed) {
+                    const std::string origin = std::move(pending.oldPath);
+                    m_pending.erase(it);
+                    record(FileChange::Type::Deleted, origin, isDirectory);
+                } else {
+                    pending.type = FileChange::Type::Deleted;
+                }
+                break;
+            case FileChange::Type::Modified:
+                if (pending.type == FileChange::Type::Deleted) {
+                    pending.type = FileChange::Type::Modified;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void FileWatcher::recordMove(const std::string& from, const std::string& to, bool isDirectory) {
+        std::string origin = from;
+
+        auto it = m_pending.find(from);
+        if (it != m_pending.end()) {
+            if (it->second.type == FileChange::Type::Created) {
+                // Written and then moved into place: only the final name matters
+                m_pending.erase(it);
+                record(FileChange::Type::Created, to, isDirectory);
+                return;
+            }
+            if (it->second.type == FileChange::Type::Renamed) {
+                origin = std::move(it->second.oldPath);
+            }
+            m_pending.erase(it);
+        }
+
+        if (origin == to) {
+            record(FileChange::Type::Modified, to, isDirectory);
+            return;
+        }
+
+        record(FileChange::Type::Renamed, to, isDirectory);
+        PendingChange& pending = m_pending[to];
+        pending.type = FileChange::Type::Renamed;
+        pending.oldPath = std::move(origin);
+    }
+
+    void FileWatcher::publish() {
+        SCUMM_TRACE_SCOPE("FileWatcher::publish", "io");
+
+        std::vector<FileChange> changes;
+
+        if (m_overflow) {
+            // Events were dropped by the kernel, nothing pending can be trusted
+            FileChange change;
+            change.type = FileChange::Type::Overflow;
+            change.path = m_root;
+            change.isDirectory = true;
+            changes.push_back(std::move(change));
+        } else {
+            // Moves whose destination never arrived left the project
+            for (const auto& [cookie, move] : m_moves) {
+                record(FileChange::Type::Deleted, move.path, move.isDirectory);
+            }
+            m_moves.clear();
+
+            // Directories hit by a storm are relisted once instead of patched entry by entry
+            std::unordered_map<std::string, size_t> perDirectory;
+            for (const auto& [path, pending] : m_pending) {
+                perDirectory[parentOf(path)]++;
+            }
+            auto isStorm = [&](const std::string& directory) {
+                auto it = perDirectory.find(directory);
+                return it != perDirectory.end() && it->second > STORM_THRESHOLD;
+            };
+            for (const auto& [directory, count] : perDirectory) {
+                if (count > STORM_THRESHOLD) {
+                    FileChange change;
+                    change.type = FileChange::Type::Rescan;
+                    change.path = directory;
+                    change.isDirectory = true;
+                    changes.push_back(std::move(change));
+                }
+            }
+
+            for (auto& [path, pending] : m_pending) {
+                FileChange change;
+                change.type = pending.type;
+                change.path = path;
+                change.oldPath = pending.oldPath;
+                change.isDirectory = pending.isDirectory;
+
+                if (isStorm(parentOf(path))) {
+                    // The relist picks up the new name; only the old one needs removing
+                    if (change.type == FileChange::Type::Renamed && !isStorm(parentOf(pending.oldPath))) {
+                        change.type = FileChange::Type::Deleted;
+                        change.path = std::move(change.oldPath);
+                        change.oldPath.clear();
+                        changes.push_back(std::move(change));
+                    }
+                    continue;
+                }
+
+                if (change.type != FileChange::Type::Deleted && !change.isDirectory) {
+                    std::error_code ec;
+                    change.size = std::filesystem::file_size(change.path, ec);
+                    if (ec) {
+                        // Already gone again; a later event reports the deletion
+                        if (change.type != FileChange::Type::Renamed) {
+                            continue;
+                        }
+                        change.size = 0;
+                    }
+                }
+
+                changes.push_back(std::move(change));
+            }
+
+            std::sort(changes.begin(), changes.end(), [](const FileChange& a, const FileChange& b) {
+                return a.path < b.path;
+            });
+        }
+
+        m_pending.clear();
+        m_moves.clear();
+        m_overflow = false;
+
+        if (changes.empty()) {
+            return;
+        }
+
+        std::lock_guard lock(m_mutex);
+        m_ready.insert(m_ready.end(), std::make_move_iterator(changes.begin()),
+                       std::make_move_iterator(changes.end()));
+    }
+
+} // namespace scummredux
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // One coalesced change reported by the FileWatcher
+    struct FileChange {
+        enum class Type : uint8_t {
+            Created,
+            Deleted,
+            Modified,
+            Renamed,    // path is the new location, oldPath the previous one
+            Rescan,     // Too many changes in this directory, relist it instead
+            Overflow    // Events were lost, the whole tree must be rescanned
+        };
+
+        Type type = Type::Modified;
+        std::filesystem::path path;
+        std::filesystem::path oldPath;
+        uint64_t size = 0;
+        bool isDirectory = false;
+    };
+
+    // Watches the directories of a project for changes. On Linux every directory gets an
+    // inotify watch; when the watch limit is exhausted (and on other platforms) the
+    // remaining directories are polled by comparing modification times instead.
+    // Raw events are coalesced on the watcher thread until the tree has been quiet for a
+    // moment, so storms like a batch extraction arrive as a few deltas (or one Rescan per
+    // directory) instead of tens of thousands of events.
+    class FileWatcher {
+    public:
+        FileWatcher() = default;
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        void start(const std::filesystem::path& root);
+        void stop();
+
+        // Main thread: starts watching a directory once its contents are known
+        void watchDirectory(const std::filesystem::path& directory);
+
+        // Main thread: takes the changes published since the last call
+        std::vector<FileChange> poll();
+
+        bool isRunning() const { return m_thread.joinable(); }
+        bool isPolling() const { return m_fd < 0 || m_limitReached.load(std::memory_order_relaxed); }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct PendingChange {
+            FileChange::Type type;
+            std::string oldPath;
+            bool isDirectory;
+        };
+
+        struct PendingMove {
+            std::string path;
+            bool isDirectory;
+        };
+
+        struct ChildState {
+            std::filesystem::file_time_type time;
+            uint64_t size;
+            bool isDirectory;
+        };
+
+        struct DirectorySnapshot {
+            std::filesystem::file_time_type time;
+            std::unordered_map<std::string, ChildState> children;
+            bool baseline = false;
+        };
+
+        void watcherMain();
+        bool addWatch(const std::string& directory);
+        void readEvents();
+        void scanPolledDirectories();
+        void renameWatches(const std::string& from, const std::string& to);
+
+        // Coalescing (watcher thread only)
+        void record(FileChange::Type type, const std::string& path, bool isDirectory);
+        void recordMove(const std::string& from, const std::string& to, bool isDirectory);
+        void publish();
+
+        std::filesystem::path m_root;
+        std::thread m_thread;
+        std::atomic<bool> m_stop = false;
+        std::atomic<bool> m_limitReached = false;
+        bool m_limitReported = false;
+        int m_fd = -1;
+
+        // Shared with the watcher thread (guarded by m_mutex)
+        std::mutex m_mutex;
+        std::unordered_map<int, std::string> m_watches;
+        std::vector<std::string> m_newPolled;
+        std::vector<FileChange> m_ready;
+
+        // Watcher thread state
+        std::unordered_map<std::string, PendingChange> m_pending;
+        std::unordered_map<uint32_t, PendingMove> m_moves;
+        std::unordered_map<std::string, DirectorySnapshot> m_polled;
+        bool m_overflow = false;
+        Clock::time_point m_firstEvent;
+        Clock::time_point m_lastEvent;
+        Clock::time_point m_lastPoll;
+
+        static constexpr auto QUIET_PERIOD = std::chrono::milliseconds(100);
+        static constexpr auto MAX_LATENCY = std::chrono::milliseconds(1000);
+        static constexpr auto POLL_INTERVAL = std::chrono::milliseconds(2000);
+        static constexpr int WAIT_TIMEOUT_MS = 50;
+        static constexpr size_t STORM_THRESHOLD = 512;  // Changes per directory before it is relisted
+    };
+
+} // namespace scummredux
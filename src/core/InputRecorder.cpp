@@ -0,0 +1,353 @@
+#include "InputRecorder.h"
+#include "../views/ConsoleView.h"
+#include <imgui_internal.h>
+#include <bit>
+#include <cstring>
+#include <iterator>
+
+namespace scummredux {
+
+    using namespace inputstream;
+
+    namespace {
+        void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value) | 0x80);
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        void writeU16(std::vector<uint8_t>& out, uint16_t value) {
+            out.push_back(static_cast<uint8_t>(value));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        void writeF32(std::vector<uint8_t>& out, float value) {
+            const auto bits = std::bit_cast<uint32_t>(value);
+            for (int i = 0; i < 4; i++) {
+                out.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+            }
+        }
+
+        class Reader {
+        public:
+            explicit Reader(const std::vector<uint8_t>& data) : m_data(data) {}
+
+            bool good() const { return m_good; }
+            bool atEnd() const { return m_pos >= m_data.size(); }
+
+            uint8_t u8() {
+                if (m_pos >= m_data.size()) { m_good = false; return 0; }
+                return m_data[m_pos++];
+            }
+
+            uint16_t u16() {
+                uint16_t lo = u8();
+                return lo | static_cast<uint16_t>(u8() << 8);
+            }
+
+            float f32() {
+                uint32_t bits = 0;
+                for (int i = 0; i < 4; i++) {
+                    bits |= static_cast<uint32_t>(u8()) << (i * 8);
+                }
+                return std::bit_cast<float>(bits);
+            }
+
+            uint64_t varint() {
+                uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    const uint8_t byte = u8();
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) return value;
+                }
+                m_good = false;
+                return 0;
+            }
+
+        private:
+            const std::vector<uint8_t>& m_data;
+            size_t m_pos = 0;
+            bool m_good = true;
+        };
+    }
+
+    // InputRecorder
+
+    InputRecorder& InputRecorder::getInstance() {
+        static InputRecorder instance;
+        return instance;
+    }
+
+    InputRecorder::~InputRecorder() {
+        stop();
+    }
+
+    bool InputRecorder::start(const std::string& path, const ImVec2& displaySize, float deltaTime) {
+        if (m_recording) {
+            return false;
+        }
+
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open()) {
+            return false;
+        }
+
+        m_path = path;
+        m_frame = 0;
+        m_lastWrittenFrame = 0;
+        m_eventCount = 0;
+        m_lastEventId = 0;
+        m_buffer.clear();
+
+        m_buffer.insert(m_buffer.end(), std::begin(MAGIC), std::end(MAGIC));
+        writeU16(m_buffer, VERSION);
+        writeU16(m_buffer, static_cast<uint16_t>(displaySize.x));
+        writeU16(m_buffer, static_cast<uint16_t>(displaySize.y));
+        writeF32(m_buffer, deltaTime);
+
+        m_recording = true;
+        return true;
+    }
+
+    void InputRecorder::stop() {
+        if (!m_recording) {
+            return;
+        }
+
+        // Terminating empty frame records the length of the session
+        m_frameEvents.clear();
+        writeFrame(m_frame - m_lastWrittenFrame, m_frameEvents);
+        flushBuffer();
+
+        m_file.close();
+        m_recording = false;
+    }
+
+    void InputRecorder::captureFrame() {
+        if (!m_recording) {
+            return;
+        }
+
+        m_frameEvents.clear();
+
+        // With input trickling NewFrame() leaves some events queued for the next frame;
+        // ids only grow, so anything at or below the last one was recorded already
+        for (const ImGuiInputEvent& input : GImGui->InputEventsQueue) {
+            if (input.EventId <= m_lastEventId) {
+                continue;
+            }
+            m_lastEventId = input.EventId;
+
+            Event event;
+            switch (input.Type) {
+                case ImGuiInputEventType_MousePos:
+                    event.type = EventType::MousePos;
+                    event.x = input.MousePos.PosX;
+                    event.y = input.MousePos.PosY;
+                    break;
+                case ImGuiInputEventType_MouseWheel:
+                    event.type = EventType::MouseWheel;
+                    event.x = input.MouseWheel.WheelX;
+                    event.y = input.MouseWheel.WheelY;
+                    break;
+                case ImGuiInputEventType_MouseButton:
+                    event.type = EventType::MouseButton;
+                    event.code = static_cast<uint32_t>(input.MouseButton.Button);
+                    event.down = input.MouseButton.Down;
+                    break;
+                case ImGuiInputEventType_Key:
+                    event.type = EventType::Key;
+                    event.code = static_cast<uint32_t>(input.Key.Key);
+                    event.down = input.Key.Down;
+                    event.x = input.Key.AnalogValue;
+                    break;
+                case ImGuiInputEventType_Text:
+                    event.type = EventType::Text;
+                    event.code = input.Text.Char;
+                    break;
+                case ImGuiInputEventType_Focus:
+                    event.type = EventType::Focus;
+                    event.down = input.AppFocused.Focused;
+                    break;
+                default:
+                    continue; // Viewport hover events are platform specific
+            }
+            m_frameEvents.push_back(event);
+        }
+
+        if (!m_frameEvents.empty()) {
+            writeFrame(m_frame - m_lastWrittenFrame, m_frameEvents);
+            m_lastWrittenFrame = m_frame;
+            m_eventCount += m_frameEvents.size();
+        }
+
+        m_frame++;
+
+        if (m_buffer.size() >= FLUSH_THRESHOLD) {
+            flushBuffer();
+        }
+    }
+
+    void InputRecorder::writeFrame(uint64_t frameDelta, const std::vector<Event>& events) {
+        writeVarint(m_buffer, frameDelta);
+        writeVarint(m_buffer, events.size());
+
+        for (const auto& event : events) {
+            m_buffer.push_back(static_cast<uint8_t>(event.type));
+            switch (event.type) {
+                case EventType::MousePos:
+                case EventType::MouseWheel:
+                    writeF32(m_buffer, event.x);
+                    writeF32(m_buffer, event.y);
+                    break;
+                case EventType::MouseButton:
+                    m_buffer.push_back(static_cast<uint8_t>(event.code) | (event.down ? 0x80 : 0));
+                    break;
+                case EventType::Key:
+                    writeVarint(m_buffer, event.code);
+                    m_buffer.push_back(event.down ? 1 : 0);
+                    writeF32(m_buffer, event.x);
+                    break;
+                case EventType::Text:
+                    writeVarint(m_buffer, event.code);
+                    break;
+                case EventType::Focus:
+                    m_buffer.push_back(event.down ? 1 : 0);
+                    break;
+            }
+        }
+    }
+
+    void InputRecorder::flushBuffer() {
+        m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+        m_file.flush();
+        m_buffer.clear();
+    }
+
+    // ReplayInputSource
+
+    bool ReplayInputSource::load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            ConsoleView::error("Failed to open input recording: " + path);
+            return false;
+        }
+
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Reader reader(data);
+
+        char magic[4];
+        for (char& c : magic) {
+            c = static_cast<char>(reader.u8());
+        }
+        if (!reader.good() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+            ConsoleView::error("Not an input recording: " + path);
+            return false;
+        }
+
+        if (reader.u16() != VERSION) {
+            ConsoleView::error("Unsupported input recording version: " + path);
+            return false;
+        }
+
+        m_displaySize.x = reader.u16();
+        m_displaySize.y = reader.u16();
+        m_deltaTime = reader.f32();
+
+        m_frames.clear();
+        m_events.clear();
+        m_nextFrame = 0;
+
+        uint64_t frame = 0;
+        while (!reader.atEnd() && reader.good()) {
+            frame += reader.varint();
+            const uint64_t count = reader.varint();
+
+            Frame entry{frame, static_cast<uint32_t>(m_events.size()), static_cast<uint32_t>(count)};
+
+            for (uint64_t i = 0; i < count && reader.good(); i++) {
+                Event event;
+                event.type = static_cast<EventType>(reader.u8());
+                switch (event.type) {
+                    case EventType::MousePos:
+                    case EventType::MouseWheel:
+                        event.x = reader.f32();
+                        event.y = reader.f32();
+                        break;
+                    case EventType::MouseButton: {
+                        const uint8_t value = reader.u8();
+                        event.code = value & 0x7F;
+                        event.down = (value & 0x80) != 0;
+                        break;
+                    }
+                    case EventType::Key:
+                        event.code = static_cast<uint32_t>(reader.varint());
+                        event.down = reader.u8() != 0;
+                        event.x = reader.f32();
+                        break;
+                    case EventType::Text:
+                        event.code = static_cast<uint32_t>(reader.varint());
+                        break;
+                    case EventType::Focus:
+                        event.down = reader.u8() != 0;
+                        break;
+                    default:
+                        ConsoleView::error("Corrupt input recording: " + path);
+                        return false;
+                }
+                m_events.push_back(event);
+            }
+
+            if (count > 0) {
+                m_frames.push_back(entry);
+            }
+        }
+
+        if (!reader.good()) {
+            ConsoleView::error("Truncated input recording: " + path);
+            return false;
+        }
+
+        m_frameCount = frame;
+        ConsoleView::info("Loaded input recording: " + std::to_string(m_events.size()) + " events over " +
+                          std::to_string(m_frameCount) + " frames");
+        return true;
+    }
+
+    void ReplayInputSource::apply(ImGuiIO& io, uint64_t frame) {
+        while (m_nextFrame < m_frames.size() && m_frames[m_nextFrame].frame <= frame) {
+            const auto& entry = m_frames[m_nextFrame++];
+
+            for (uint32_t i = 0; i < entry.eventCount; i++) {
+                const auto& event = m_events[entry.firstEvent + i];
+                switch (event.type) {
+                    case EventType::MousePos:
+                        io.AddMousePosEvent(event.x, event.y);
+                        break;
+                    case EventType::MouseWheel:
+                        io.AddMouseWheelEvent(event.x, event.y);
+                        break;
+                    case EventType::MouseButton:
+                        io.AddMouseButtonEvent(static_cast<int>(event.code), event.down);
+                        break;
+                    case EventType::Key:
+                        io.AddKeyAnalogEvent(static_cast<ImGuiKey>(event.code), event.down, event.x);
+                        break;
+                    case EventType::Text:
+                        io.AddInputCharacter(event.code);
+                        break;
+                    case EventType::Focus:
+                        io.AddFocusEvent(event.down);
+                        break;
+                }
+            }
+        }
+    }
+
+    bool ReplayInputSource::isFinished(uint64_t frame) const {
+        return frame >= m_frameCount;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "InputSource.h"
+#include <imgui.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Compact binary stream of ImGui IO events (.srin):
+    //   header: "SRIN", u16 version, u16 display width, u16 display height, f32 delta time
+    //   frames: varint frame delta, varint event count, events
+    //   event:  u8 type, type-specific payload (varints and little-endian f32)
+    // The stream ends with an empty frame marking the recording length.
+    namespace inputstream {
+        constexpr char MAGIC[4] = {'S', 'R', 'I', 'N'};
+        constexpr uint16_t VERSION = 1;
+
+        enum class EventType : uint8_t {
+            MousePos = 1,
+            MouseWheel = 2,
+            MouseButton = 3,
+            Key = 4,
+            Text = 5,
+            Focus = 6
+        };
+
+        struct Event {
+            EventType type = EventType::MousePos;
+            float x = 0.0f, y = 0.0f;    // Mouse position / wheel / key analog value
+            uint32_t code = 0;           // Button, ImGuiKey or codepoint
+            bool down = false;           // Button / key state, focus state
+        };
+    }
+
+    // Captures the ImGui input queue every frame, right before ImGui::NewFrame()
+    class InputRecorder {
+    public:
+        static constexpr float DEFAULT_DELTA_TIME = 1.0f / 60.0f;
+
+        static InputRecorder& getInstance();
+
+        bool start(const std::string& path, const ImVec2& displaySize, float deltaTime = DEFAULT_DELTA_TIME);
+        void stop();
+        bool isRecording() const { return m_recording; }
+        const std::string& getPath() const { return m_path; }
+        uint64_t getFrameCount() const { return m_frame; }
+        uint64_t getEventCount() const { return m_eventCount; }
+
+        // Called once per frame with the events ImGui is about to process
+        void captureFrame();
+
+    private:
+        InputRecorder() = default;
+        ~InputRecorder();
+
+        void writeFrame(uint64_t frameDelta, const std::vector<inputstream::Event>& events);
+        void flushBuffer();
+
+        bool m_recording = false;
+        std::string m_path;
+        std::ofstream m_file;
+        std::vector<uint8_t> m_buffer;
+        std::vector<inputstream::Event> m_frameEvents;
+
+        uint64_t m_frame = 0;
+        uint64_t m_lastWrittenFrame = 0;
+        uint64_t m_eventCount = 0;
+        uint32_t m_lastEventId = 0;     // Newest event written; trickled events stay queued
+
+        static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+    };
+
+    // Feeds a recorded stream back into ImGui, frame by frame
+    class ReplayInputSource : public InputSource {
+    public:
+        bool load(const std::string& path);
+
+        void apply(ImGuiIO& io, uint64_t frame) override;
+        bool isFinished(uint64_t frame) const override;
+
+        uint64_t getFrameCount() const { return m_frameCount; }
+        ImVec2 getDisplaySize() const { return m_displaySize; }
+        float getDeltaTime() const { return m_deltaTime; }
+
+    private:
+        struct Frame {
+            uint64_t frame;
+            uint32_t firstEvent;
+            uint32_t eventCount;
+        };
+
+        std::vector<Frame> m_frames;
+        std::vector<inputstream::Event> m_events;
+        size_t m_nextFrame = 0;
+        uint64_t m_frameCount = 0;
+        ImVec2 m_displaySize;
+        float m_deltaTime = 1.0f / 60.0f;
+    };
+
+} // namespace scummredux
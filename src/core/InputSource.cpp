@@ -0,0 +1,172 @@
+#include "InputSource.h"
+#include "../views/ViewManager.h"
+#include "../views/ConsoleView.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace scummredux {
+
+    bool ScriptedInputSource::load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            ConsoleView::error("Failed to open input script: " + path);
+            return false;
+        }
+
+        m_events.clear();
+        m_next = 0;
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            if (!parseLine(line, lineNumber)) {
+                ConsoleView::error("Invalid input script line " + std::to_string(lineNumber) + ": " + line);
+                return false;
+            }
+        }
+
+        // Keep script order for events on the same frame
+        std::stable_sort(m_events.begin(), m_events.end(), [](const ScriptEvent& a, const ScriptEvent& b) {
+            return a.frame < b.frame;
+        });
+
+        ConsoleView::info("Loaded " + std::to_string(m_events.size()) + " scripted input events from " + path);
+        return true;
+    }
+
+    bool ScriptedInputSource::parseLine(const std::string& line, int lineNumber) {
+        std::istringstream stream(line);
+
+        std::string first;
+        if (!(stream >> first) || first[0] == '#') {
+            return true; // Blank line or comment
+        }
+
+        ScriptEvent event;
+        try {
+            event.frame = std::stoull(first);
+        } catch (...) {
+            return false;
+        }
+
+        std::string command;
+        if (!(stream >> command)) {
+            return false;
+        }
+
+        if (command == "mouse") {
+            event.type = Type::MousePos;
+            if (!(stream >> event.x >> event.y)) return false;
+        } else if (command == "down" || command == "up" || command == "click") {
+            event.type = Type::MouseButton;
+            stream >> event.button;
+            event.down = command != "up";
+            if (command == "click") {
+                ScriptEvent release = event;
+                release.frame++;
+                release.down = false;
+                m_events.push_back(event);
+                m_events.push_back(release);
+                return true;
+            }
+        } else if (command == "wheel") {
+            event.type = Type::MouseWheel;
+            if (!(stream >> event.x >> event.y)) return false;
+        } else if (command == "key" || command == "press") {
+            std::string name, state;
+            if (!(stream >> name)) return false;
+
+            event.type = Type::Key;
+            event.key = keyFromName(name);
+            if (event.key == ImGuiKey_None) return false;
+
+            if (command == "press") {
+                event.down = true;
+                ScriptEvent release = event;
+                release.frame++;
+                release.down = false;
+                m_events.push_back(event);
+                m_events.push_back(release);
+                return true;
+            }
+
+            if (!(stream >> state) || (state != "down" && state != "up")) return false;
+            event.down = state == "down";
+        } else if (command == "text" || command == "console") {
+            event.type = command == "text" ? Type::Text : Type::Console;
+            std::getline(stream >> std::ws, event.text);
+            if (event.text.empty()) return false;
+        } else {
+            return false;
+        }
+
+        m_events.push_back(event);
+        return true;
+    }
+
+    void ScriptedInputSource::apply(ImGuiIO& io, uint64_t frame) {
+        while (m_next < m_events.size() && m_events[m_next].frame <= frame) {
+            const auto& event = m_events[m_next++];
+
+            switch (event.type) {
+                case Type::MousePos:
+                    io.AddMousePosEvent(event.x, event.y);
+                    break;
+                case Type::MouseButton:
+                    io.AddMouseButtonEvent(event.button, event.down);
+                    break;
+                case Type::MouseWheel:
+                    io.AddMouseWheelEvent(event.x, event.y);
+                    break;
+                case Type::Key:
+                    io.AddKeyEvent(event.key, event.down);
+                    break;
+                case Type::Text:
+                    io.AddInputCharactersUTF8(event.text.c_str());
+                    break;
+                case Type::Console:
+                    if (auto* console = ViewManager::getInstance().getView<ConsoleView>("Console")) {
+                        console->executeCommand(event.text);
+                    }
+                    break;
+            }
+        }
+    }
+
+    bool ScriptedInputSource::isFinished(uint64_t frame) const {
+        return m_next >= m_events.size();
+    }
+
+    ImGuiKey ScriptedInputSource::keyFromName(const std::string& name) {
+        static const std::unordered_map<std::string, ImGuiKey> s_keys = {
+            {"tab", ImGuiKey_Tab},           {"left", ImGuiKey_LeftArrow},
+            {"right", ImGuiKey_RightArrow},  {"up", ImGuiKey_UpArrow},
+            {"down", ImGuiKey_DownArrow},    {"pageup", ImGuiKey_PageUp},
+            {"pagedown", ImGuiKey_PageDown}, {"home", ImGuiKey_Home},
+            {"end", ImGuiKey_End},           {"insert", ImGuiKey_Insert},
+            {"delete", ImGuiKey_Delete},     {"backspace", ImGuiKey_Backspace},
+            {"space", ImGuiKey_Space},       {"enter", ImGuiKey_Enter},
+            {"escape", ImGuiKey_Escape},     {"ctrl", ImGuiMod_Ctrl},
+            {"shift", ImGuiMod_Shift},       {"alt", ImGuiMod_Alt},
+        };
+
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+        auto it = s_keys.find(lower);
+        if (it != s_keys.end()) {
+            return it->second;
+        }
+
+        // Single letters map to ImGuiKey_A..ImGuiKey_Z
+        if (lower.size() == 1 && lower[0] >= 'a' && lower[0] <= 'z') {
+            return static_cast<ImGuiKey>(ImGuiKey_A + (lower[0] - 'a'));
+        }
+
+        return ImGuiKey_None;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <imgui.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Feeds input into ImGui when there is no platform backend (headless runs)
+    class InputSource {
+    public:
+        virtual ~InputSource() = default;
+
+        // Queue the input events belonging to the given frame
+        virtual void apply(ImGuiIO& io, uint64_t frame) = 0;
+
+        // True once every event has been delivered
+        virtual bool isFinished(uint64_t frame) const = 0;
+    };
+
+    // Text script of timed input events, one per line:
+    //   <frame> mouse <x> <y>
+    //   <frame> down|up|click [button]
+    //   <frame> wheel <dx> <dy>
+    //   <frame> key <name> down|up
+    //   <frame> press <name>          (down now, up on the next frame)
+    //   <frame> text <characters...>
+    //   <frame> console <command...>  (runs a ConsoleView command)
+    // Empty lines and lines starting with '#' are ignored.
+    class ScriptedInputSource : public InputSource {
+    public:
+        bool load(const std::string& path);
+
+        void apply(ImGuiIO& io, uint64_t frame) override;
+        bool isFinished(uint64_t frame) const override;
+
+        size_t getEventCount() const { return m_events.size(); }
+
+        static ImGuiKey keyFromName(const std::string& name);
+
+    private:
+        enum class Type {
+            MousePos,
+            MouseButton,
+            MouseWheel,
+            Key,
+            Text,
+            Console
+        };
+
+        struct ScriptEvent {
+            uint64_t frame = 0;
+            Type type = Type::MousePos;
+            float x = 0.0f, y = 0.0f;
+            int button = 0;
+            ImGuiKey key = ImGuiKey_None;
+            bool down = false;
+            std::string text;
+        };
+
+        bool parseLine(const std::string& line, int lineNumber);
+
+        std::vector<ScriptEvent> m_events; // Sorted by frame
+        size_t m_next = 0;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,325 @@
+#include "JobSystem.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace scummredux {
+
+    namespace {
+        constexpr size_t NOT_A_WORKER = SIZE_MAX;
+        constexpr size_t PRIORITY_COUNT = 2;
+        thread_local size_t t_workerIndex = NOT_A_WORKER;
+
+        void runGuarded(const std::function<void()>& job) {
+            try {
+                job();
+            } catch (const std::exception& e) {
+                std::cerr << "Exception in job: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Unknown exception in job" << std::endl;
+            }
+        }
+    } // namespace
+
+    JobSystem& JobSystem::getInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    JobSystem::JobSystem() {
+        const size_t count = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t i = 0; i < count; i++) {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+        for (size_t i = 0; i < count; i++) {
+            m_workers[i]->thread = std::thread(&JobSystem::workerMain, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        shutdown();
+    }
+
+    void JobSystem::shutdown() {
+        if (m_stopping.exchange(true)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_all();
+
+        for (auto& worker : m_workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+    }
+
+    JobSystem::Handle JobSystem::submit(Job job, Options options) {
+        auto node = std::make_shared<Node>();
+        node->job = std::move(job);
+        node->priority = options.priority;
+        node->counter = options.counter;
+        if (options.token) {
+            node->token = *options.token;
+        }
+        if (node->counter) {
+            node->counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // The extra count keeps the node from being released while dependencies are registered
+        node->unfinishedDependencies.store(1, std::memory_order_relaxed);
+        for (const Handle& dependency : options.dependencies) {
+            if (!dependency) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(dependency->mutex);
+            if (!dependency->finished) {
+                dependency->dependents.push_back(node);
+                node->unfinishedDependencies.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        m_waiting.fetch_add(1, std::memory_order_relaxed);
+        if (node->unfinishedDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_waiting.fetch_sub(1, std::memory_order_relaxed);
+            enqueue(node);
+        }
+        return node;
+    }
+
+    void JobSystem::enqueue(const Handle& node) {
+        const size_t priority = static_cast<size_t>(node->priority);
+
+        // Workers keep their own jobs; everyone else spreads them round-robin
+        const size_t queue = t_workerIndex != NOT_A_WORKER ? t_workerIndex
+                                                           : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+        // Counted before it is visible, so m_queued never drops below the real depth
+        m_queued[priority].fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(m_workers[queue]->mutex);
+            m_workers[queue]->queues[priority].push_back(node);
+        }
+
+        // Taking the lock orders this against a worker about to sleep
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_one();
+    }
+
+    void JobSystem::finish(const Handle& node) {
+        std::vector<Handle> dependents;
+        {
+            std::lock_guard<std::mutex> lock(node->mutex);
+            node->finished = true;
+            dependents.swap(node->dependents);
+        }
+        node->job = nullptr;    // Release captured state early; handles may live on
+
+        for (const Handle& dependent : dependents) {
+            if (dependent->unfinishedDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                m_waiting.fetch_sub(1, std::memory_order_relaxed);
+                enqueue(dependent);
+            }
+        }
+
+        m_completed.fetch_add(1, std::memory_order_relaxed);
+        if (node->counter) {
+            node->counter->m_pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void JobSystem::wait(JobCounter& counter) {
+        while (!counter.isDone()) {
+            if (!tryRun(t_workerIndex, t_workerIndex == NOT_A_WORKER ? &counter : nullptr)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& fn, JobPriority priority) {
+        if (count == 0) {
+            return;
+        }
+
+        // A few chunks per worker keeps stealing effective without per-item overhead
+        const size_t chunks = std::min(count, m_workers.size() * 4);
+        const size_t chunkSize = (count + chunks - 1) / chunks;
+
+        JobCounter counter;
+        for (size_t begin = 0; begin < count; begin += chunkSize) {
+            const size_t end = std::min(count, begin + chunkSize);
+            submit([&fn, begin, end] {
+                for (size_t i = begin; i < end; i++) {
+                    fn(i);
+                }
+            }, &counter, priority);
+        }
+        wait(counter);
+    }
+
+    void JobSystem::runOnMainThread(Job job) {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        m_mainQueue.push_back(std::move(job));
+    }
+
+    JobSystem::Handle JobSystem::continueOnMainThread(const Handle& dependency, Job job, const CancellationToken* token) {
+        std::optional<CancellationToken> captured;
+        if (token) {
+            captured = *token;
+        }
+
+        Options options;
+        options.priority = JobPriority::Interactive;
+        options.token = token;
+        options.dependencies = {dependency};
+        return submit([this, job = std::move(job), captured]() mutable {
+            // Cancellation is checked again on the main thread: it may come in between
+            runOnMainThread([job = std::move(job), captured] {
+                if (!captured || !captured->isCancelled()) {
+                    job();
+                }
+            });
+        }, std::move(options));
+    }
+
+    void JobSystem::drainMainThread() {
+        {
+            std::lock_guard<std::mutex> lock(m_mainMutex);
+            m_mainRunning.swap(m_mainQueue);
+        }
+
+        // Continuations may queue more; those run next frame
+        for (Job& job : m_mainRunning) {
+            runGuarded(job);
+        }
+        m_mainRunning.clear();
+
+        sampleUtilization();
+    }
+
+    void JobSystem::sampleUtilization() {
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - m_sampleTime).count();
+        if (elapsed < SAMPLE_INTERVAL_SECONDS) {
+            return;
+        }
+
+        const uint64_t busy = m_busyNanoseconds.load(std::memory_order_relaxed);
+        const double capacity = elapsed * 1e9 * static_cast<double>(m_workers.size());
+        m_utilization = static_cast<float>(std::clamp(static_cast<double>(busy - m_sampleBusy) / capacity, 0.0, 1.0));
+        m_sampleBusy = busy;
+        m_sampleTime = now;
+    }
+
+    JobSystem::Stats JobSystem::getStats() const {
+        Stats stats;
+        stats.workers = m_workers.size();
+        stats.queuedInteractive = m_queued[static_cast<size_t>(JobPriority::Interactive)].load(std::memory_order_relaxed);
+        stats.queuedBatch = m_queued[static_cast<size_t>(JobPriority::Batch)].load(std::memory_order_relaxed);
+        stats.waiting = m_waiting.load(std::memory_order_relaxed);
+        stats.completed = m_completed.load(std::memory_order_relaxed);
+        stats.utilization = m_utilization;
+        {
+            std::lock_guard<std::mutex> lock(m_mainMutex);
+            stats.mainThreadQueued = m_mainQueue.size();
+        }
+        return stats;
+    }
+
+    void JobSystem::workerMain(size_t index) {
+        t_workerIndex = index;
+        TraceRecorder::getInstance().setThreadName("Worker " + std::to_string(index));
+
+        auto hasWork = [this] {
+            return m_queued[0].load(std::memory_order_acquire) > 0 || m_queued[1].load(std::memory_order_acquire) > 0;
+        };
+
+        while (!m_stopping.load(std::memory_order_relaxed)) {
+            if (tryRun(index)) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [&] {
+                return hasWork() || m_stopping.load(std::memory_order_relaxed);
+            });
+        }
+    }
+
+    bool JobSystem::tryRun(size_t self, const JobCounter* only) {
+        // All interactive work (own, then stolen) goes before any batch work
+        for (size_t priority = 0; priority < PRIORITY_COUNT; priority++) {
+            Handle node;
+            if ((self != NOT_A_WORKER && popOwn(self, priority, node)) || steal(self, priority, node, only)) {
+                m_queued[priority].fetch_sub(1, std::memory_order_relaxed);
+                run(node);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool JobSystem::popOwn(size_t self, size_t priority, Handle& node) {
+        Worker& worker = *m_workers[self];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        auto& queue = worker.queues[priority];
+        if (queue.empty()) {
+            return false;
+        }
+        node = std::move(queue.back());
+        queue.pop_back();
+        return true;
+    }
+
+    bool JobSystem::steal(size_t self, size_t priority, Handle& node, const JobCounter* only) {
+        const size_t count = m_workers.size();
+        const size_t start = self != NOT_A_WORKER ? self + 1 : 0;
+        for (size_t i = 0; i < count; i++) {
+            const size_t victim = (start + i) % count;
+            if (victim == self) {
+                continue;
+            }
+
+            Worker& worker = *m_workers[victim];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (only) {
+                // Oldest job of that counter, wherever it is in the queue
+                const auto it = std::find_if(queue.begin(), queue.end(), [only](const Handle& queued) {
+                    return queued->counter == only;
+                });
+                if (it != queue.end()) {
+                    node = std::move(*it);
+                    queue.erase(it);
+                    return true;
+                }
+            } else if (!queue.empty()) {
+                node = std::move(queue.front());
+                queue.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void JobSystem::run(const Handle& node) {
+        if (!node->token || !node->token->isCancelled()) {
+            const auto start = std::chrono::steady_clock::now();
+            runGuarded(node->job);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            // Utilization is a share of the workers' time; a waiting UI thread is not one
+            if (t_workerIndex != NOT_A_WORKER) {
+                m_busyNanoseconds.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                                            std::memory_order_relaxed);
+            }
+        }
+        finish(node);
+    }
+
+} // namespace scummredux
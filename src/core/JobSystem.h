@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace scummredux {
+
+    // Interactive jobs (something the user is waiting on) always run before batch work
+    enum class JobPriority : uint8_t {
+        Interactive,
+        Batch
+    };
+
+    // Counts outstanding jobs of one batch; wait() lets the caller help run jobs
+    class JobCounter {
+    public:
+        bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+        size_t getPending() const { return m_pending.load(std::memory_order_relaxed); }
+
+    private:
+        friend class JobSystem;
+        std::atomic<size_t> m_pending = 0;
+    };
+
+    // Shared cancel flag. Jobs submitted with a cancelled token are skipped (their
+    // counters and dependents still complete); running jobs may poll it to stop early.
+    class CancellationToken {
+    public:
+        CancellationToken() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+        void cancel() { m_flag->store(true, std::memory_order_relaxed); }
+        bool isCancelled() const { return m_flag->load(std::memory_order_relaxed); }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_flag;
+    };
+
+    // Work-stealing thread pool, one worker per hardware thread. Each worker owns a
+    // deque per priority: jobs submitted from a worker go to its own deque (LIFO,
+    // cache-warm), idle workers steal the oldest job from the others. Jobs can wait on
+    // other jobs, and results are handed back to the UI through main-thread
+    // continuations that Application::update drains once per frame.
+    class JobSystem {
+    public:
+        using Job = std::function<void()>;
+
+        struct Node;
+        using Handle = std::shared_ptr<Node>;
+
+        struct Options {
+            JobPriority priority = JobPriority::Batch;
+            JobCounter* counter = nullptr;
+            const CancellationToken* token = nullptr;
+            std::vector<Handle> dependencies;       // Runs after all of these finished
+        };
+
+        struct Stats {
+            size_t workers = 0;
+            size_t queuedInteractive = 0;
+            size_t queuedBatch = 0;
+            size_t waiting = 0;                     // Submitted, dependencies not done yet
+            size_t mainThreadQueued = 0;
+            uint64_t completed = 0;
+            float utilization = 0.0f;               // Busy share of all workers, last sample window
+        };
+
+        static JobSystem& getInstance();
+
+        Handle submit(Job job, Options options);
+        Handle submit(Job job, JobCounter* counter = nullptr, JobPriority priority = JobPriority::Batch) {
+            return submit(std::move(job), Options{priority, counter, nullptr, {}});
+        }
+
+        // Blocks until the counter reaches zero. Workers run any queued job meanwhile;
+        // other threads (the UI) only help with the counter's own jobs, so they never
+        // pick up unrelated batch work.
+        void wait(JobCounter& counter);
+
+        // Runs fn(i) for every i in [0, count) and returns once all calls finished
+        void parallelFor(size_t count, const std::function<void(size_t)>& fn, JobPriority priority = JobPriority::Batch);
+
+        // Main-thread continuations
+        void runOnMainThread(Job job);
+        Handle continueOnMainThread(const Handle& dependency, Job job, const CancellationToken* token = nullptr);
+        void drainMainThread();
+
+        Stats getStats() const;
+        size_t getWorkerCount() const { return m_workers.size(); }
+        void shutdown();
+
+    private:
+        JobSystem();
+        ~JobSystem();
+
+        struct Worker {
+            std::deque<Handle> queues[2];       // Indexed by JobPriority
+            std::mutex mutex;
+            std::thread thread;
+        };
+
+        void enqueue(const Handle& node);
+        void finish(const Handle& node);
+
+        void workerMain(size_t index);
+        bool tryRun(size_t self, const JobCounter* only = nullptr);
+        bool popOwn(size_t self, size_t priority, Handle& node);
+        bool steal(size_t self, size_t priority, Handle& node, const JobCounter* only);
+        void run(const Handle& node);
+        void sampleUtilization();
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::atomic<size_t> m_nextQueue = 0;
+        std::atomic<size_t> m_queued[2] = {0, 0};
+        std::atomic<size_t> m_waiting = 0;
+        std::atomic<uint64_t> m_completed = 0;
+        std::atomic<bool> m_stopping = false;
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wake;
+
+        mutable std::mutex m_mainMutex;
+        std::vector<Job> m_mainQueue;
+        std::vector<Job> m_mainRunning;         // Swapped with m_mainQueue while draining
+
+        // Utilization: busy time summed over workers (not helping waiters), sampled from the main thread
+        std::atomic<uint64_t> m_busyNanoseconds = 0;
+        uint64_t m_sampleBusy = 0;
+        std::chrono::steady_clock::time_point m_sampleTime = std::chrono::steady_clock::now();
+        float m_utilization = 0.0f;
+
+        static constexpr double SAMPLE_INTERVAL_SECONDS = 0.5;
+    };
+
+    struct JobSystem::Node {
+        Job job;
+        JobPriority priority = JobPriority::Batch;
+        JobCounter* counter = nullptr;
+        std::optional<CancellationToken> token;
+
+        // Dependency bookkeeping (guarded by mutex)
+        std::mutex mutex;
+        std::vector<Handle> dependents;
+        std::atomic<uint32_t> unfinishedDependencies = 0;
+        bool finished = false;
+
+        bool isFinished() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return finished;
+        }
+    };
+
+} // namespace scummredux
@@ -0,0 +1,162 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace scummredux {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_mode = other.m_mode;
+            m_open = std::exchange(other.m_open, false);
+#ifdef _WIN32
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::open(const std::filesystem::path& path, Mode mode) {
+        close();
+
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        m_mode = mode;
+        m_size = static_cast<size_t>(size.QuadPart);
+        if (m_size == 0) {
+            // Empty files can't be mapped but are still valid
+            CloseHandle(file);
+            m_open = true;
+            return true;
+        }
+
+        const DWORD protect = mode == Mode::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY;
+        HANDLE mapping = CreateFileMappingW(file, nullptr, protect, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            m_size = 0;
+            return false;
+        }
+
+        const DWORD access = mode == Mode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+        void* view = MapViewOfFile(mapping, access, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            m_size = 0;
+            return false;
+        }
+
+        m_mapping = mapping;
+        m_data = static_cast<uint8_t*>(view);
+        m_open = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        m_data = nullptr;
+        m_mapping = nullptr;
+        m_size = 0;
+        m_open = false;
+    }
+
+    size_t MappedFile::getPageSize() {
+        static const size_t pageSize = [] {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return static_cast<size_t>(info.dwPageSize);
+        }();
+        return pageSize;
+    }
+
+#else
+
+    bool MappedFile::open(const std::filesystem::path& path, Mode mode) {
+        close();
+
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            ::close(fd);
+            return false;
+        }
+
+        m_mode = mode;
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size == 0) {
+            // Empty files can't be mapped but are still valid
+            ::close(fd);
+            m_open = true;
+            return true;
+        }
+
+        const int protect = mode == Mode::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* view = mmap(nullptr, m_size, protect, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            m_size = 0;
+            return false;
+        }
+
+        m_data = static_cast<uint8_t*>(view);
+        m_open = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_data) {
+            munmap(m_data, m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_open = false;
+    }
+
+    size_t MappedFile::getPageSize() {
+        static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return pageSize;
+    }
+
+#endif
+
+} // namespace scummredux
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace scummredux {
+
+    // Read-only memory mapping of a whole file. The CopyOnWrite mode maps the pages
+    // privately writable: writes (e.g. in-place decryption) never reach the disk and
+    // only the touched pages get copied.
+    class MappedFile {
+    public:
+        enum class Mode {
+            ReadOnly,
+            CopyOnWrite
+        };
+
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const std::filesystem::path& path, Mode mode = Mode::ReadOnly);
+        void close();
+
+        bool isOpen() const { return m_open; }
+        bool isWritable() const { return m_mode == Mode::CopyOnWrite; }
+        const uint8_t* data() const { return m_data; }
+        uint8_t* mutableData() { return m_mode == Mode::CopyOnWrite ? m_data : nullptr; }   // CopyOnWrite only
+        size_t size() const { return m_size; }
+
+        static size_t getPageSize();
+
+    private:
+        uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        Mode m_mode = Mode::ReadOnly;
+        bool m_open = false;
+#ifdef _WIN32
+        void* m_mapping = nullptr;
+#endif
+    };
+
+} // namespace scummredux
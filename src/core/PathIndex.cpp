@@ -0,0 +1,407 @@
+#include "PathIndex.h"
+#include "JobSystem.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstring>
+#include <unordered_set>
+
+namespace scummredux {
+
+    namespace {
+        constexpr int32_t NO_MATCH = INT32_MIN;
+
+        // Scoring weights
+        constexpr int32_t SCORE_MATCH = 16;
+        constexpr int32_t BONUS_BOUNDARY = 24;      // Start of a path segment or word
+        constexpr int32_t BONUS_CONSECUTIVE = 12;
+        constexpr int32_t BONUS_FILE_NAME = 8;      // Matched character is in the file name
+        constexpr int32_t BONUS_NAME_ONLY = 48;     // Whole pattern matched inside the file name
+        constexpr int32_t PENALTY_GAP_START = 5;
+        constexpr int32_t PENALTY_GAP = 1;
+
+        constexpr std::array<char, 256> makeLowerTable() {
+            std::array<char, 256> table{};
+            for (int c = 0; c < 256; c++) {
+                table[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+            }
+            return table;
+        }
+        constexpr auto LOWER = makeLowerTable();
+
+        inline char lower(char c) {
+            return LOWER[static_cast<unsigned char>(c)];
+        }
+
+        // One bit per character class; a path can only match if it has every bit of the pattern
+        inline uint64_t charBit(char c) {
+            const char l = lower(c);
+            if (l >= 'a' && l <= 'z') return 1ull << (l - 'a');
+            if (l >= '0' && l <= '9') return 1ull << (26 + l - '0');
+            switch (l) {
+                case '/': return 1ull << 36;
+                case '.': return 1ull << 37;
+                case '_': return 1ull << 38;
+                case '-': return 1ull << 39;
+                default: return 1ull << 63;
+            }
+        }
+
+        inline bool isSeparator(char c) {
+            return c == '/' || c == '_' || c == '-' || c == '.' || c == ' ';
+        }
+
+        inline bool isBoundary(const char* text, size_t index) {
+            if (index == 0) {
+                return true;
+            }
+            const char previous = text[index - 1];
+            const char current = text[index];
+            return isSeparator(previous) ||
+                   (previous >= 'a' && previous <= 'z' && current >= 'A' && current <= 'Z');
+        }
+    }
+
+    void PathIndex::clear() {
+        m_text.clear();
+        m_folded.clear();
+        m_offsets.clear();
+        m_lengths.clear();
+        m_nameOffsets.clear();
+        m_masks.clear();
+        m_entries.clear();
+        m_slots.clear();
+        m_deadSlots = 0;
+        m_generation++;
+    }
+
+    void PathIndex::update(const FileTree& tree, const FileTree::Update& update) {
+        if (tree.getGeneration() != m_treeGeneration) {
+            clear();
+            m_treeGeneration = tree.getGeneration();
+        }
+        if (update.empty()) {
+            return;
+        }
+
+        SCUMM_TRACE_SCOPE("PathIndex::update", "search");
+
+        for (uint32_t entry : update.removed) {
+            removeFile(entry);
+        }
+
+        // Entries that survived a relisting keep their path, only the index changes.
+        // Renamed ones are also in removed: their paths are added again below.
+        const std::unordered_set<uint32_t> gone(update.removed.begin(), update.removed.end());
+        std::unordered_set<uint32_t> movedTo;
+        movedTo.reserve(update.moved.size());
+        for (const auto& [from, to] : update.moved) {
+            if (gone.contains(from)) {
+                continue;
+            }
+            movedTo.insert(to);
+            auto it = m_slots.find(from);
+            if (it != m_slots.end()) {
+                const uint32_t slot = it->second;
+                m_slots.erase(it);
+                m_slots[to] = slot;
+                m_entries[slot] = to;
+            }
+        }
+
+        for (uint32_t directory : update.directories) {
+            if (tree.get(directory).removed) {
+                continue;
+            }
+
+            const FileTree::Entry& parent = tree.get(directory);
+            const std::string prefix = relativePath(tree, directory);
+            for (uint32_t child = parent.firstChild; child < parent.firstChild + parent.childCount; child++) {
+                if (movedTo.contains(child)) {
+                    continue;
+                }
+
+                const FileTree::Entry& entry = tree.get(child);
+                if (!entry.isDirectory) {
+                    addFile(child, prefix, entry.name);
+                } else if (entry.scanned && entry.firstChild != FileTree::INVALID_INDEX) {
+                    // A renamed directory brought its subtree along: every path below changed
+                    addChildren(tree, child, true);
+                }
+            }
+        }
+
+        if (m_deadSlots > COMPACT_THRESHOLD && m_deadSlots > m_slots.size()) {
+            compact();
+        }
+        m_generation++;
+    }
+
+    std::vector<PathIndex::Match> PathIndex::query(std::string_view pattern, size_t maxResults) const {
+        SCUMM_TRACE_SCOPE("PathIndex::query", "search");
+
+        std::vector<Match> results;
+        if (maxResults == 0) {
+            return results;
+        }
+
+        // Case-insensitive; spaces only separate words for the user
+        std::string lowered;
+        uint64_t mask = 0;
+        for (char c : pattern) {
+            if (c != ' ') {
+                lowered.push_back(lower(c));
+                mask |= charBit(c);
+            }
+        }
+
+        const size_t count = m_entries.size();
+        if (lowered.empty()) {
+            for (uint32_t slot = 0; slot < count && results.size() < maxResults; slot++) {
+                if (m_entries[slot] != FileTree::INVALID_INDEX) {
+                    results.push_back({slot, m_entries[slot], 0});
+                }
+            }
+            return results;
+        }
+
+        // While typing, every match of the new pattern also matched the shorter one
+        const bool refine = m_cacheGeneration == m_generation && !m_cachePattern.empty() &&
+                            lowered.starts_with(m_cachePattern);
+        const std::vector<uint32_t>* candidates = refine ? &m_cacheMatches : nullptr;
+        const size_t total = candidates ? candidates->size() : count;
+
+        // Each worker keeps its own top-N in a min-heap plus every matching slot
+        auto worse = [](const Match& a, const Match& b) { return a.score > b.score; };
+        auto scan = [&](size_t begin, size_t end, std::vector<Match>& top, std::vector<uint32_t>& matches) {
+            top.reserve(maxResults);
+            for (size_t i = begin; i < end; i++) {
+                const uint32_t slot = candidates ? (*candidates)[i] : static_cast<uint32_t>(i);
+                if (m_entries[slot] == FileTree::INVALID_INDEX || (m_masks[slot] & mask) != mask) {
+                    continue;
+                }
+
+                const int32_t value = score(slot, lowered);
+                if (value == NO_MATCH) {
+                    continue;
+                }
+                matches.push_back(slot);
+
+                if (top.size() < maxResults) {
+                    top.push_back({slot, m_entries[slot], value});
+                    std::push_heap(top.begin(), top.end(), worse);
+                } else if (value > top.front().score) {
+                    std::pop_heap(top.begin(), top.end(), worse);
+                    top.back() = {slot, m_entries[slot], value};
+                    std::push_heap(top.begin(), top.end(), worse);
+                }
+            }
+        };
+
+        auto& jobs = JobSystem::getInstance();
+        const size_t workers = std::clamp<size_t>(total / PARALLEL_THRESHOLD, 1, jobs.getWorkerCount());
+
+        std::vector<uint32_t> matches;
+        if (workers == 1) {
+            scan(0, total, results, matches);
+        } else {
+            std::vector<std::vector<Match>> partialTop(workers);
+            std::vector<std::vector<uint32_t>> partialMatches(workers);
+            const size_t chunk = (total + workers - 1) / workers;
+            jobs.parallelFor(workers, [&](size_t i) {
+                scan(i * chunk, std::min(total, (i + 1) * chunk), partialTop[i], partialMatches[i]);
+            }, JobPriority::Interactive);
+
+            for (size_t i = 0; i < workers; i++) {
+                results.insert(results.end(), partialTop[i].begin(), partialTop[i].end());
+                matches.insert(matches.end(), partialMatches[i].begin(), partialMatches[i].end());
+            }
+        }
+
+        m_cachePattern = std::move(lowered);
+        m_cacheMatches = std::move(matches);
+        m_cacheGeneration = m_generation;
+
+        // Best score first; ties go to shorter paths
+        std::sort(results.begin(), results.end(), [this](const Match& a, const Match& b) {
+            if (a.score != b.score) {
+                return a.score > b.score;
+            }
+            if (m_lengths[a.slot] != m_lengths[b.slot]) {
+                return m_lengths[a.slot] < m_lengths[b.slot];
+            }
+            return a.slot < b.slot;
+        });
+        if (results.size() > maxResults) {
+            results.resize(maxResults);
+        }
+        return results;
+    }
+
+    int32_t PathIndex::score(uint32_t slot, std::string_view pattern) const {
+        const char* text = m_text.data() + m_offsets[slot];
+        const char* folded = m_folded.data() + m_offsets[slot];
+        const size_t length = m_lengths[slot];
+        const size_t nameStart = m_nameOffsets[slot];
+
+        // Forward pass (memchr per pattern character): earliest position where the
+        // whole pattern has been seen
+        size_t end = 0;
+        for (char c : pattern) {
+            const void* found = std::memchr(folded + end, c, length - end);
+            if (!found) {
+                return NO_MATCH;
+            }
+            end = static_cast<const char*>(found) - folded + 1;
+        }
+
+        // Backward pass: tightest window ending there
+        size_t start = end;
+        for (size_t remaining = pattern.size(); remaining > 0;) {
+            start--;
+            if (folded[start] == pattern[remaining - 1]) {
+                remaining--;
+            }
+        }
+
+        int32_t total = 0;
+        bool previousMatched = false;
+        size_t matched = 0;
+        for (size_t i = start; i < end && matched < pattern.size(); i++) {
+            if (folded[i] == pattern[matched]) {
+                total += SCORE_MATCH;
+                if (isBoundary(text, i)) total += BONUS_BOUNDARY;
+                if (previousMatched) total += BONUS_CONSECUTIVE;
+                if (i >= nameStart) total += BONUS_FILE_NAME;
+                previousMatched = true;
+                matched++;
+            } else {
+                total -= previousMatched ? PENALTY_GAP_START : PENALTY_GAP;
+                previousMatched = false;
+            }
+        }
+
+        if (start >= nameStart) {
+            total += BONUS_NAME_ONLY;
+        }
+        return total - static_cast<int32_t>(length / 8);
+    }
+
+    void PathIndex::addFile(uint32_t entry, std::string_view directory, const std::string& name) {
+        removeFile(entry);
+
+        const size_t length = directory.empty() ? name.size() : directory.size() + 1 + name.size();
+        if (length > UINT16_MAX) {
+            return;
+        }
+
+        const auto offset = static_cast<uint32_t>(m_text.size());
+        if (!directory.empty()) {
+            m_text.append(directory);
+            m_text.push_back('/');
+        }
+        m_text.append(name);
+
+        uint64_t mask = 0;
+        for (size_t i = offset; i < m_text.size(); i++) {
+            mask |= charBit(m_text[i]);
+            m_folded.push_back(lower(m_text[i]));
+        }
+
+        const auto slot = static_cast<uint32_t>(m_entries.size());
+        m_offsets.push_back(offset);
+        m_lengths.push_back(static_cast<uint16_t>(length));
+        m_nameOffsets.push_back(static_cast<uint16_t>(length - name.size()));
+        m_masks.push_back(mask);
+        m_entries.push_back(entry);
+        m_slots[entry] = slot;
+    }
+
+    void PathIndex::addChildren(const FileTree& tree, uint32_t directory, bool recursive) {
+        std::vector<std::pair<uint32_t, std::string>> stack;
+        stack.emplace_back(directory, relativePath(tree, directory));
+
+        while (!stack.empty()) {
+            auto [current, prefix] = std::move(stack.back());
+            stack.pop_back();
+
+            const FileTree::Entry& parent = tree.get(current);
+            for (uint32_t child = parent.firstChild; child < parent.firstChild + parent.childCount; child++) {
+                const FileTree::Entry& entry = tree.get(child);
+                if (!entry.isDirectory) {
+                    addFile(child, prefix, entry.name);
+                } else if (recursive && entry.scanned && entry.firstChild != FileTree::INVALID_INDEX) {
+                    stack.emplace_back(child, prefix.empty() ? entry.name : prefix + '/' + entry.name);
+                }
+            }
+        }
+    }
+
+    void PathIndex::removeFile(uint32_t entry) {
+        auto it = m_slots.find(entry);
+        if (it == m_slots.end()) {
+            return;
+        }
+
+        m_entries[it->second] = FileTree::INVALID_INDEX;
+        m_slots.erase(it);
+        m_deadSlots++;
+    }
+
+    void PathIndex::compact() {
+        SCUMM_TRACE_SCOPE("PathIndex::compact", "search");
+
+        std::string text;
+        std::string folded;
+        text.reserve(m_text.size());
+        folded.reserve(m_folded.size());
+        std::vector<uint32_t> offsets;
+        std::vector<uint16_t> lengths;
+        std::vector<uint16_t> nameOffsets;
+        std::vector<uint64_t> masks;
+        std::vector<uint32_t> entries;
+
+        m_slots.clear();
+        for (size_t slot = 0; slot < m_entries.size(); slot++) {
+            if (m_entries[slot] == FileTree::INVALID_INDEX) {
+                continue;
+            }
+
+            m_slots[m_entries[slot]] = static_cast<uint32_t>(entries.size());
+            offsets.push_back(static_cast<uint32_t>(text.size()));
+            text.append(m_text, m_offsets[slot], m_lengths[slot]);
+            folded.append(m_folded, m_offsets[slot], m_lengths[slot]);
+            lengths.push_back(m_lengths[slot]);
+            nameOffsets.push_back(m_nameOffsets[slot]);
+            masks.push_back(m_masks[slot]);
+            entries.push_back(m_entries[slot]);
+        }
+
+        m_text = std::move(text);
+        m_folded = std::move(folded);
+        m_offsets = std::move(offsets);
+        m_lengths = std::move(lengths);
+        m_nameOffsets = std::move(nameOffsets);
+        m_masks = std::move(masks);
+        m_entries = std::move(entries);
+        m_deadSlots = 0;
+    }
+
+    std::string PathIndex::relativePath(const FileTree& tree, uint32_t directory) const {
+        std::vector<const std::string*> names;
+        for (uint32_t current = directory; current != FileTree::ROOT_INDEX; current = tree.get(current).parent) {
+            names.push_back(&tree.get(current).name);
+        }
+
+        std::string path;
+        for (auto it = names.rbegin(); it != names.rend(); ++it) {
+            if (!path.empty()) {
+                path.push_back('/');
+            }
+            path += **it;
+        }
+        return path;
+    }
+
+} // namespace scummredux
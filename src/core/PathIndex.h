@@ -0,0 +1,75 @@
+#pragma once
+
+#include "FileTree.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // Fuzzy file finder over every file the FileTree knows about. Relative paths are
+    // packed into one arena with a per-path character-set mask, so a query first
+    // rejects paths missing any of its characters with a single AND and only scores the
+    // rest (subsequence match with boundary/filename bonuses). Scoring is split across
+    // JobSystem workers once the index is large, and a pattern that extends the previous
+    // one only rescores the previous matches. Kept in sync incrementally from FileTree
+    // updates.
+    class PathIndex {
+    public:
+        struct Match {
+            uint32_t slot;
+            uint32_t entry;     // FileTree index
+            int32_t score;
+        };
+
+        // Applies one FileTree::poll() result; a new tree generation rebuilds from scratch
+        void update(const FileTree& tree, const FileTree::Update& update);
+        void clear();
+
+        // Best matches first. An empty pattern returns the first maxResults paths.
+        std::vector<Match> query(std::string_view pattern, size_t maxResults = DEFAULT_MAX_RESULTS) const;
+
+        // Relative path of a match (valid until the next update)
+        std::string_view getPath(uint32_t slot) const { return {m_text.data() + m_offsets[slot], m_lengths[slot]}; }
+        std::string_view getFileName(uint32_t slot) const { return getPath(slot).substr(m_nameOffsets[slot]); }
+
+        size_t size() const { return m_slots.size(); }
+        uint32_t getGeneration() const { return m_generation; }
+
+        static constexpr size_t DEFAULT_MAX_RESULTS = 100;
+
+    private:
+        void addFile(uint32_t entry, std::string_view directory, const std::string& name);
+        void addChildren(const FileTree& tree, uint32_t directory, bool recursive);
+        void removeFile(uint32_t entry);
+        void compact();
+
+        std::string relativePath(const FileTree& tree, uint32_t directory) const;
+        int32_t score(uint32_t slot, std::string_view pattern) const;
+
+        // Slot storage (structure of arrays, dead slots have INVALID_INDEX entries)
+        std::string m_text;
+        std::string m_folded;                   // Lower-cased copy used for matching
+        std::vector<uint32_t> m_offsets;
+        std::vector<uint16_t> m_lengths;
+        std::vector<uint16_t> m_nameOffsets;
+        std::vector<uint64_t> m_masks;
+        std::vector<uint32_t> m_entries;
+
+        std::unordered_map<uint32_t, uint32_t> m_slots;     // FileTree index -> slot
+        size_t m_deadSlots = 0;
+        uint32_t m_treeGeneration = 0;
+        uint32_t m_generation = 0;
+
+        // Matches of the previous query, narrowed further while the user keeps typing
+        mutable std::string m_cachePattern;
+        mutable std::vector<uint32_t> m_cacheMatches;
+        mutable uint32_t m_cacheGeneration = UINT32_MAX;
+
+        static constexpr size_t PARALLEL_THRESHOLD = 32768;    // Slots per worker thread
+        static constexpr size_t COMPACT_THRESHOLD = 4096;
+    };
+
+} // namespace scummredux
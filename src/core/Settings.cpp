@@ -22,6 +22,7 @@ namespace scummredux {
 
         // UI defaults
         set(UI::DARK_THEME, true);
+        set(UI::THEME, std::string("Dark"));
         set(UI::ACCENT_COLOR, ImVec4(0.43f, 0.43f, 0.50f, 1.0f));
         set(UI::FONT_SIZE, 14.0f);
         set(UI::SHOW_TITLE_BAR, true);
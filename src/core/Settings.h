@@ -45,11 +45,13 @@ namespace scummredux {
             static constexpr const char* WINDOW_POS_Y = "app.window.pos_y";
             static constexpr const char* SHOW_DOCKSPACE = "app.ui.show_dockspace";
             static constexpr const char* APP_NAME = "app.name";
+            static constexpr const char* PROJECT_ROOT = "app.project_root";
         };
 
         // UI settings
         struct UI {
             static constexpr const char* DARK_THEME = "ui.dark_theme";
+            static constexpr const char* THEME = "ui.theme";
             static constexpr const char* ACCENT_COLOR = "ui.accent_color";
             static constexpr const char* FONT_SIZE = "ui.font_size";
             static constexpr const char* SHOW_TITLE_BAR = "ui.show_title_bar";
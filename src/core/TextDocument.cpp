@@ -0,0 +1,37 @@
+#include "TextDocument.h"
+#include <algorithm>
+
+namespace scummredux {
+
+    void TextDocument::clear() {
+        m_text.clear();
+        m_lineStarts.clear();
+        m_offsets.clear();
+        m_maxLineLength = 0;
+        m_complete = true;
+    }
+
+    void TextDocument::appendLine(std::string_view text, uint32_t offset) {
+        m_lineStarts.push_back(static_cast<uint32_t>(m_text.size()));
+        m_offsets.push_back(offset);
+        m_text.append(text);
+        m_text.push_back('\n');
+        m_maxLineLength = std::max(m_maxLineLength, text.size());
+    }
+
+    std::string_view TextDocument::getLine(size_t line) const {
+        const size_t start = m_lineStarts[line];
+        const size_t end = line + 1 < m_lineStarts.size() ? m_lineStarts[line + 1] : m_text.size();
+        return std::string_view(m_text).substr(start, end - start - 1);
+    }
+
+    size_t TextDocument::findLine(uint32_t offset) const {
+        // Lines without an offset sort after everything; they only trail a document
+        const auto it = std::upper_bound(m_offsets.begin(), m_offsets.end(), offset);
+        if (it == m_offsets.begin()) {
+            return NO_LINE;
+        }
+        return static_cast<size_t>(it - m_offsets.begin()) - 1;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scummredux {
+
+    // Text kept as lines in one arena, built by appending so a producer can stream
+    // into it while it is shown. Lines generated from binary data carry the source
+    // offset they came from; offsets never decrease down the document, so mapping
+    // an offset back to its line is a binary search.
+    class TextDocument {
+    public:
+        static constexpr uint32_t NO_OFFSET = UINT32_MAX;
+
+        void clear();
+        void appendLine(std::string_view text, uint32_t offset = NO_OFFSET);
+
+        size_t getLineCount() const { return m_lineStarts.size(); }
+        std::string_view getLine(size_t line) const;
+        uint32_t getLineOffset(size_t line) const { return m_offsets[line]; }
+
+        // Last line at or before offset (the instruction containing it), or NO_LINE
+        size_t findLine(uint32_t offset) const;
+
+        // Whether the producer has finished appending
+        bool isComplete() const { return m_complete; }
+        void setComplete(bool complete) { m_complete = complete; }
+
+        // The whole text, one '\n' after every line
+        const std::string& getText() const { return m_text; }
+        size_t getMaxLineLength() const { return m_maxLineLength; }
+
+        static constexpr size_t NO_LINE = SIZE_MAX;
+
+    private:
+        std::string m_text;
+        std::vector<uint32_t> m_lineStarts;
+        std::vector<uint32_t> m_offsets;        // NO_OFFSET for lines with no source
+        size_t m_maxLineLength = 0;
+        bool m_complete = true;
+    };
+
+} // namespace scummredux
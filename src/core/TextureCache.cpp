@@ -0,0 +1,217 @@
+#include "TextureCache.h"
+#include "TraceRecorder.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+
+// Not in the OpenGL 1.1 headers some platforms ship
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+namespace scummredux {
+
+    TextureCache& TextureCache::getInstance() {
+        static TextureCache instance;
+        return instance;
+    }
+
+    void TextureCache::initialize(bool headless) {
+        m_headless = headless;
+    }
+
+    void TextureCache::shutdown() {
+        for (auto& [key, entry] : m_entries) {
+            destroy(entry);
+        }
+        m_entries.clear();
+        m_lru.clear();
+        m_uploads.clear();
+        m_residentBytes = 0;
+    }
+
+    bool TextureCache::get(Key key, Texture& texture) {
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return false;
+        }
+
+        // Pending textures are touched too: whoever asks for one is about to show it
+        Entry& entry = it->second;
+        entry.lastUsedFrame = m_frame;
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+        if (!entry.isReady()) {
+            return false;
+        }
+
+        texture.id = (ImTextureID)(intptr_t)entry.texture;
+        texture.width = entry.width;
+        texture.height = entry.height;
+        return true;
+    }
+
+    void TextureCache::submit(Key key, uint16_t width, uint16_t height, std::vector<uint32_t> pixels) {
+        if (width == 0 || height == 0 || pixels.size() < static_cast<size_t>(width) * height) {
+            return;
+        }
+        remove(key);
+
+        m_lru.push_front(key);
+        Entry& entry = m_entries[key];
+        entry.width = width;
+        entry.height = height;
+        entry.pixels = std::move(pixels);
+        entry.lastUsedFrame = m_frame;
+        entry.lru = m_lru.begin();
+        m_uploads.push_back(key);
+        m_residentBytes += entry.bytes();
+    }
+
+    void TextureCache::remove(Key key) {
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return;
+        }
+        if (!it->second.isReady()) {
+            m_uploads.remove(key);
+        }
+        m_lru.erase(it->second.lru);
+        m_residentBytes -= it->second.bytes();
+        destroy(it->second);
+        m_entries.erase(it);
+    }
+
+    bool TextureCache::updateRows(Key key, uint16_t first, uint16_t count, const uint32_t* pixels) {
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end() || !it->second.isReady()) {
+            return false;
+        }
+
+        const Entry& entry = it->second;
+        if (count == 0 || first >= entry.height) {
+            return true;
+        }
+        count = std::min<uint16_t>(count, entry.height - first);
+        if (!m_headless) {
+            glBindTexture(GL_TEXTURE_2D, entry.texture);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first, entry.width, count, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        m_uploadedThisFrame += static_cast<size_t>(entry.width) * count * 4;
+        return true;
+    }
+
+    bool TextureCache::updatePending(Key key, uint16_t width, uint16_t height, const uint32_t* pixels) {
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end() || it->second.isReady()) {
+            return false;
+        }
+
+        Entry& entry = it->second;
+        if (entry.width != width || entry.height != height) {
+            return false;
+        }
+        std::copy(pixels, pixels + static_cast<size_t>(width) * height, entry.pixels.begin());
+        if (entry.uploadedRows > 0 && !m_headless) {
+            glBindTexture(GL_TEXTURE_2D, entry.texture);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, entry.width, entry.uploadedRows, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        m_uploadedThisFrame += static_cast<size_t>(entry.width) * entry.uploadedRows * 4;
+        return true;
+    }
+
+    void TextureCache::update() {
+        SCUMM_TRACE_SCOPE("TextureCache::update", "textures");
+
+        // Anything drawn last frame is still on screen and stays
+        evict();
+        m_frame++;
+
+        // Live updates since the last frame already used part of the budget
+        size_t uploaded = std::min(m_uploadedThisFrame, m_uploadBudget);
+        while (!m_uploads.empty() && uploaded < m_uploadBudget) {
+            Entry& entry = m_entries.at(m_uploads.front());
+            uploaded += upload(entry, m_uploadBudget - uploaded);
+            if (!entry.isReady()) {
+                break;
+            }
+            m_uploads.pop_front();
+        }
+        m_uploadedLastFrame = std::max(uploaded, m_uploadedThisFrame);
+        m_uploadedThisFrame = 0;
+    }
+
+    size_t TextureCache::upload(Entry& entry, size_t budget) {
+        if (entry.texture == 0) {
+            if (m_headless) {
+                entry.texture = m_nextPlaceholder++;
+            } else {
+                GLuint texture = 0;
+                glGenTextures(1, &texture);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, entry.width, entry.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+                entry.texture = texture;
+            }
+        }
+
+        // At least one row, so a texture wider than the budget still makes progress
+        const size_t rowBytes = static_cast<size_t>(entry.width) * 4;
+        const size_t rows = std::clamp<size_t>(budget / rowBytes, 1, entry.height - entry.uploadedRows);
+        if (!m_headless) {
+            glBindTexture(GL_TEXTURE_2D, entry.texture);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, entry.uploadedRows, entry.width, static_cast<GLsizei>(rows), GL_RGBA,
+                            GL_UNSIGNED_BYTE, entry.pixels.data() + static_cast<size_t>(entry.uploadedRows) * entry.width);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
+        entry.uploadedRows = static_cast<uint16_t>(entry.uploadedRows + rows);
+        if (entry.isReady()) {
+            std::vector<uint32_t>().swap(entry.pixels);
+        }
+        return rows * rowBytes;
+    }
+
+    void TextureCache::evict() {
+        auto it = m_lru.end();
+        while (m_residentBytes > m_memoryBudget && it != m_lru.begin()) {
+            --it;
+            Entry& entry = m_entries.at(*it);
+            if (entry.lastUsedFrame >= m_frame) {
+                continue;       // On screen
+            }
+
+            const Key key = *it;
+            it = std::next(it);
+            remove(key);
+            m_evictions++;
+        }
+    }
+
+    void TextureCache::destroy(Entry& entry) {
+        if (entry.texture != 0 && !m_headless) {
+            const GLuint texture = entry.texture;
+            glDeleteTextures(1, &texture);
+        }
+        entry.texture = 0;
+    }
+
+    TextureCache::Stats TextureCache::getStats() const {
+        Stats stats;
+        stats.textures = m_entries.size();
+        stats.pendingUploads = m_uploads.size();
+        stats.residentBytes = m_residentBytes;
+        stats.memoryBudget = m_memoryBudget;
+        stats.uploadedLastFrame = m_uploadedLastFrame;
+        stats.uploadBudget = m_uploadBudget;
+        stats.evictions = m_evictions;
+        return stats;
+    }
+
+} // namespace scummredux
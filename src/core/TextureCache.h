@@ -0,0 +1,112 @@
+#pragma once
+
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // GPU textures for decoded resources, keyed by the caller. Pixels handed over with
+    // submit() are uploaded by update() a few rows at a time under a per-frame byte
+    // budget, so a burst of new textures never stalls a frame. Textures are kept in
+    // LRU order and the least recently drawn ones are deleted once the memory budget
+    // is exceeded. Main thread only.
+    class TextureCache {
+    public:
+        using Key = uint64_t;
+
+        struct Texture {
+            ImTextureID id = ImTextureID();
+            uint16_t width = 0;
+            uint16_t height = 0;
+        };
+
+        struct Stats {
+            size_t textures = 0;
+            size_t pendingUploads = 0;
+            size_t residentBytes = 0;
+            size_t memoryBudget = 0;
+            size_t uploadedLastFrame = 0;
+            size_t uploadBudget = 0;
+            uint64_t evictions = 0;
+        };
+
+        static TextureCache& getInstance();
+
+        // Headless runs have no GL context: textures get placeholder ids, uploads are
+        // only accounted
+        void initialize(bool headless);
+
+        // Deletes every texture; call while the GL context is still current
+        void shutdown();
+
+        // Fully uploaded texture for key; marks it as used this frame
+        bool get(Key key, Texture& texture);
+
+        // Queued or uploaded
+        bool contains(Key key) const { return m_entries.count(key) != 0; }
+
+        // Queues RGBA pixels (width * height) for upload, replacing any texture of key
+        void submit(Key key, uint16_t width, uint16_t height, std::vector<uint32_t> pixels);
+        void remove(Key key);
+
+        // Re-uploads rows [first, first + count) of a ready texture right away, from
+        // pixels pointing at row first; counted against this frame's upload budget.
+        // Returns false if key is not uploaded yet
+        bool updateRows(Key key, uint16_t first, uint16_t count, const uint32_t* pixels);
+
+        // Replaces the pixels (width * height) of a queued texture, keeping its place in
+        // the upload queue; rows already uploaded are re-uploaded right away. Returns
+        // false if key is not queued or has another size
+        bool updatePending(Key key, uint16_t width, uint16_t height, const uint32_t* pixels);
+
+        // Once per frame, before drawing: uploads within the budget, evicts to the memory budget
+        void update();
+
+        void setMemoryBudget(size_t bytes) { m_memoryBudget = bytes; }
+        void setUploadBudget(size_t bytesPerFrame) { m_uploadBudget = bytesPerFrame; }
+        Stats getStats() const;
+
+        static constexpr size_t DEFAULT_MEMORY_BUDGET = 96u << 20;
+        static constexpr size_t DEFAULT_UPLOAD_BUDGET = 512u << 10;
+
+    private:
+        TextureCache() = default;
+
+        struct Entry {
+            uint32_t texture = 0;               // GL name (or placeholder id)
+            uint16_t width = 0;
+            uint16_t height = 0;
+            std::vector<uint32_t> pixels;       // Released once uploaded
+            uint16_t uploadedRows = 0;
+            uint64_t lastUsedFrame = 0;
+            std::list<Key>::iterator lru;       // Front is the most recently used
+
+            bool isReady() const { return uploadedRows == height; }
+            size_t bytes() const { return static_cast<size_t>(width) * height * 4; }
+        };
+
+        // Returns the bytes uploaded
+        size_t upload(Entry& entry, size_t budget);
+        void evict();
+        void destroy(Entry& entry);
+
+        std::unordered_map<Key, Entry> m_entries;
+        std::list<Key> m_lru;
+        std::list<Key> m_uploads;               // Upload order (FIFO)
+        bool m_headless = false;
+        uint32_t m_nextPlaceholder = 1;
+
+        uint64_t m_frame = 0;
+        size_t m_residentBytes = 0;
+        size_t m_uploadedLastFrame = 0;
+        size_t m_uploadedThisFrame = 0;         // By updateRows() since the last update()
+        uint64_t m_evictions = 0;
+        size_t m_memoryBudget = DEFAULT_MEMORY_BUDGET;
+        size_t m_uploadBudget = DEFAULT_UPLOAD_BUDGET;
+    };
+
+} // namespace scummredux
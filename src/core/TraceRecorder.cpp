@@ -0,0 +1,263 @@
+#include "TraceRecorder.h"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace scummredux {
+
+    namespace {
+        void writeJsonString(std::ofstream& file, const std::string& str) {
+            file << '"';
+            for (char c : str) {
+                switch (c) {
+                    case '"':  file << "\\\""; break;
+                    case '\\': file << "\\\\"; break;
+                    case '\n': file << "\\n"; break;
+                    case '\t': file << "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                            file << escaped;
+                        } else {
+                            file << c;
+                        }
+                }
+            }
+            file << '"';
+        }
+    }
+
+    TraceRecorder& TraceRecorder::getInstance() {
+        static TraceRecorder instance;
+        return instance;
+    }
+
+    TraceRecorder::~TraceRecorder() {
+        stop();
+    }
+
+    uint64_t TraceRecorder::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool TraceRecorder::start(const std::string& path) {
+        if (isRecording()) {
+            return false;
+        }
+
+        m_file.open(path, std::ios::out | std::ios::trunc);
+        if (!m_file.is_open()) {
+            std::cerr << "Failed to open trace file: " << path << std::endl;
+            return false;
+        }
+
+        m_path = path;
+        m_file << std::fixed << std::setprecision(3);
+        m_file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        m_firstEvent = true;
+        m_eventsWritten = 0;
+        m_nameCache.clear();
+
+        // Drop anything buffered since the previous session
+        {
+            std::lock_guard lock(m_buffersMutex);
+            for (auto& buffer : m_buffers) {
+                std::lock_guard bufferLock(buffer->mutex);
+                buffer->events.clear();
+                buffer->nameWritten = false;
+            }
+        }
+
+        m_startTime = now();
+        m_stopRequested = false;
+        m_recording = true;
+        m_flushThread = std::thread(&TraceRecorder::flushThreadMain, this);
+
+        return true;
+    }
+
+    void TraceRecorder::stop() {
+        if (!isRecording()) {
+            return;
+        }
+
+        m_recording = false;
+        {
+            std::lock_guard lock(m_flushMutex);
+            m_stopRequested = true;
+        }
+        m_flushCondition.notify_one();
+
+        if (m_flushThread.joinable()) {
+            m_flushThread.join();
+        }
+
+        m_file << "\n]}\n";
+        m_file.close();
+    }
+
+    TraceRecorder::ThreadBuffer& TraceRecorder::getThreadBuffer() {
+        thread_local std::shared_ptr<ThreadBuffer> t_threadBuffer;
+
+        if (!t_threadBuffer) {
+            auto buffer = std::make_shared<ThreadBuffer>();
+            buffer->events.reserve(1024);
+
+            std::lock_guard lock(m_buffersMutex);
+            buffer->threadId = m_nextThreadId++;
+            m_buffers.push_back(buffer);
+            t_threadBuffer = buffer;
+        }
+
+        return *t_threadBuffer;
+    }
+
+    void TraceRecorder::push(const TraceEvent& event) {
+        auto& buffer = getThreadBuffer();
+        std::lock_guard lock(buffer.mutex);
+        buffer.events.push_back(event);
+    }
+
+    void TraceRecorder::recordComplete(const char* name, const char* category, uint64_t startNs, uint64_t endNs, bool typeName) {
+        if (!isRecording()) return;
+        push({name, category, startNs, endNs - startNs, 0.0, Phase::Complete, typeName});
+    }
+
+    void TraceRecorder::recordInstant(const char* name, const char* category) {
+        if (!isRecording()) return;
+        push({name, category, now(), 0, 0.0, Phase::Instant, false});
+    }
+
+    void TraceRecorder::recordCounter(const char* name, double value) {
+        if (!isRecording()) return;
+        push({name, "counter", now(), 0, value, Phase::Counter, false});
+    }
+
+    void TraceRecorder::setThreadName(const std::string& name) {
+        auto& buffer = getThreadBuffer();
+        std::lock_guard lock(buffer.mutex);
+        buffer.threadName = name;
+        buffer.nameWritten = false;
+    }
+
+    void TraceRecorder::flushThreadMain() {
+        setThreadName("Trace Flush");
+
+        bool stopping = false;
+        while (!stopping) {
+            {
+                std::unique_lock lock(m_flushMutex);
+                m_flushCondition.wait_for(lock, FLUSH_INTERVAL, [this]() { return m_stopRequested; });
+                stopping = m_stopRequested;
+            }
+
+            const uint64_t flushStart = now();
+            flush();
+            push({"TraceFlush", "trace", flushStart, now() - flushStart, 0.0, Phase::Complete, false});
+        }
+
+        // Pick up the final flush span and anything posted while stopping
+        flush();
+    }
+
+    void TraceRecorder::flush() {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            std::lock_guard lock(m_buffersMutex);
+            buffers = m_buffers;
+        }
+
+        for (auto& buffer : buffers) {
+            std::string threadName;
+            bool writeName = false;
+
+            m_scratch.clear();
+            {
+                std::lock_guard lock(buffer->mutex);
+                m_scratch.swap(buffer->events);
+                if (!buffer->nameWritten && !buffer->threadName.empty()) {
+                    threadName = buffer->threadName;
+                    buffer->nameWritten = writeName = true;
+                }
+            }
+
+            if (writeName) {
+                m_file << (m_firstEvent ? "" : ",\n");
+                m_file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+                writeJsonString(m_file, threadName);
+                m_file << "}}";
+                m_firstEvent = false;
+            }
+
+            for (const auto& event : m_scratch) {
+                writeEvent(event, buffer->threadId);
+            }
+        }
+
+        m_file.flush();
+    }
+
+    void TraceRecorder::writeEvent(const TraceEvent& event, uint32_t threadId) {
+        // Spans that started before recording began are dropped
+        if (event.timestamp < m_startTime) {
+            return;
+        }
+
+        const double timestampUs = (event.timestamp - m_startTime) / 1000.0;
+
+        m_file << (m_firstEvent ? "" : ",\n");
+        m_file << "{\"name\":";
+        writeJsonString(m_file, resolveName(event.name, event.typeName));
+        m_file << ",\"cat\":\"" << event.category << "\",\"pid\":1,\"tid\":" << threadId << ",\"ts\":" << timestampUs;
+
+        switch (event.phase) {
+            case Phase::Complete:
+                m_file << ",\"ph\":\"X\",\"dur\":" << (event.duration / 1000.0) << "}";
+                break;
+            case Phase::Instant:
+                m_file << ",\"ph\":\"i\",\"s\":\"t\"}";
+                break;
+            case Phase::Counter:
+                m_file << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+                break;
+        }
+
+        m_firstEvent = false;
+        m_eventsWritten.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const std::string& TraceRecorder::resolveName(const char* name, bool typeName) {
+        auto it = m_nameCache.find(name);
+        if (it != m_nameCache.end()) {
+            return it->second;
+        }
+
+        std::string resolved = name;
+        if (typeName) {
+#if defined(__GNUG__)
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+            if (status == 0 && demangled) {
+                resolved = demangled;
+            }
+            std::free(demangled);
+#endif
+            // Keep "Event<WindowResizeEvent>" readable
+            const std::string prefix = "scummredux::";
+            for (size_t pos; (pos = resolved.find(prefix)) != std::string::npos;) {
+                resolved.erase(pos, prefix.length());
+            }
+        }
+
+        return m_nameCache.emplace(name, std::move(resolved)).first->second;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // Records frame phases, job spans and event dispatches as Chrome Trace Event JSON
+    // (loadable in chrome://tracing and ui.perfetto.dev). Events are buffered per thread
+    // and written to disk by a background flush thread, so recording never blocks on I/O.
+    class TraceRecorder {
+    public:
+        static TraceRecorder& getInstance();
+
+        // Recording control
+        bool start(const std::string& path);
+        void stop();
+        bool isRecording() const { return m_recording.load(std::memory_order_relaxed); }
+        const std::string& getPath() const { return m_path; }
+        uint64_t getEventCount() const { return m_eventsWritten.load(std::memory_order_relaxed); }
+
+        // Event recording (safe to call from any thread)
+        void recordComplete(const char* name, const char* category, uint64_t startNs, uint64_t endNs, bool typeName = false);
+        void recordInstant(const char* name, const char* category);
+        void recordCounter(const char* name, double value);
+
+        // Names the calling thread in the trace viewer
+        void setThreadName(const std::string& name);
+
+        // Monotonic timestamp in nanoseconds
+        static uint64_t now();
+
+    private:
+        TraceRecorder() = default;
+        ~TraceRecorder();
+
+        enum class Phase : uint8_t {
+            Complete,
+            Instant,
+            Counter
+        };
+
+        struct TraceEvent {
+            const char* name;
+            const char* category;
+            uint64_t timestamp;
+            uint64_t duration;
+            double value;
+            Phase phase;
+            bool typeName; // name is a mangled typeid() name
+        };
+
+        struct ThreadBuffer {
+            uint32_t threadId = 0;
+            std::string threadName;
+            bool nameWritten = false;
+            std::mutex mutex;
+            std::vector<TraceEvent> events;
+        };
+
+        ThreadBuffer& getThreadBuffer();
+        void push(const TraceEvent& event);
+
+        void flushThreadMain();
+        void flush();
+        void writeEvent(const TraceEvent& event, uint32_t threadId);
+        const std::string& resolveName(const char* name, bool typeName);
+
+        std::atomic<bool> m_recording = false;
+        std::string m_path;
+        uint64_t m_startTime = 0;
+
+        // Registered per-thread buffers (kept alive after their thread exits)
+        std::mutex m_buffersMutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+        uint32_t m_nextThreadId = 1;
+
+        // Flush thread state
+        std::thread m_flushThread;
+        std::mutex m_flushMutex;
+        std::condition_variable m_flushCondition;
+        bool m_stopRequested = false;
+
+        // Output (only touched by the flush thread while recording)
+        std::ofstream m_file;
+        bool m_firstEvent = true;
+        std::vector<TraceEvent> m_scratch;
+        std::unordered_map<const char*, std::string> m_nameCache;
+        std::atomic<uint64_t> m_eventsWritten = 0;
+
+        static constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(100);
+    };
+
+    // RAII span: records a complete event covering the lifetime of the scope
+    class TraceScope {
+    public:
+        TraceScope(const char* name, const char* category, bool typeName = false)
+            : m_name(name), m_category(category), m_typeName(typeName) {
+            if (TraceRecorder::getInstance().isRecording()) {
+                m_start = TraceRecorder::now();
+            }
+        }
+
+        ~TraceScope() {
+            if (m_start != 0) {
+                TraceRecorder::getInstance().recordComplete(m_name, m_category, m_start, TraceRecorder::now(), m_typeName);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        const char* m_name;
+        const char* m_category;
+        bool m_typeName;
+        uint64_t m_start = 0;
+    };
+
+} // namespace scummredux
+
+#define SCUMM_TRACE_CONCAT_IMPL(a, b) a##b
+#define SCUMM_TRACE_CONCAT(a, b) SCUMM_TRACE_CONCAT_IMPL(a, b)
+
+// Name and category must outlive the recording (string literals)
+#define SCUMM_TRACE_SCOPE(name, category) \
+    ::scummredux::TraceScope SCUMM_TRACE_CONCAT(traceScope_, __LINE__)(name, category)
@@ -238,6 +238,7 @@ namespace scummredux {
         glfwSetWindowFocusCallback(m_window, windowFocusCallback);
         glfwSetWindowCloseCallback(m_window, windowCloseCallback);
         glfwSetFramebufferSizeCallback(m_window, framebufferSizeCallback);
+        glfwSetWindowContentScaleCallback(m_window, contentScaleCallback);
         glfwSetKeyCallback(m_window, keyCallback);
         glfwSetMouseButtonCallback(m_window, mouseButtonCallback);
         glfwSetCursorPosCallback(m_window, cursorPosCallback);
@@ -430,6 +431,11 @@ namespace scummredux {
         glViewport(0, 0, width, height);
     }
 
+    void Window::contentScaleCallback(GLFWwindow* window, float xscale, float yscale) {
+        // Window moved to a monitor with a different DPI
+        EventContentScaleChanged::post({xscale, yscale});
+    }
+
     void Window::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
         // Key events handled by ImGui
     }
@@ -88,6 +88,7 @@ namespace scummredux {
         static void windowFocusCallback(GLFWwindow* window, int focused);
         static void windowCloseCallback(GLFWwindow* window);
         static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+        static void contentScaleCallback(GLFWwindow* window, float xscale, float yscale);
         static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
         static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
         static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
@@ -1,14 +1,67 @@
 #include "core/Application.h"
+#include "core/TraceRecorder.h"
 #include "views/ConsoleView.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <exception>
+#include <string>
 
 using namespace scummredux;
 
-int main() {
+static void printUsage() {
+    std::cout << "Usage: SCUMM-Redux [options]\n"
+              << "  --trace <file>     Record a Chrome trace to <file>\n"
+              << "  --headless         Run without a window or GL context\n"
+              << "  --frames <n>       Number of frames to run in headless mode\n"
+              << "  --size <w>x<h>     Virtual display size in headless mode\n"
+              << "  --input <file>     Scripted input fed in headless mode\n"
+              << "  --record <file>    Record ImGui input events to <file>\n"
+              << "  --replay <file>    Replay recorded input in headless mode\n"
+              << "  --report <file>    Write the headless benchmark report to <file> as JSON\n"
+              << "  --verbose          Print the views' per-frame debug output\n";
+}
+
+int main(int argc, char** argv) {
+    ApplicationOptions options;
+
+    // Command line options
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--trace" && hasValue) {
+            TraceRecorder::getInstance().start(argv[++i]);
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--frames" && hasValue) {
+            options.frameCount = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                printUsage();
+                return -1;
+            }
+        } else if (arg == "--input" && hasValue) {
+            options.inputScript = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+            options.headless = true;
+        } else if (arg == "--report" && hasValue) {
+            options.reportPath = argv[++i];
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : -1;
+        }
+    }
+
     try {
         // Create and run application
-        Application app;
+        Application app(options);
         return app.run();
 
     } catch (const std::exception& e) {
@@ -0,0 +1,248 @@
+#include "BlockIndex.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace scummredux {
+
+    namespace {
+
+        constexpr char CACHE_MAGIC[4] = {'S', 'R', 'B', 'I'};
+
+        uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull) {
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ data[i]) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        uint32_t readLE32(const uint8_t* data) {
+            return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                   (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        }
+
+    } // namespace
+
+    bool BlockIndex::open(ResourceFile& file, const std::filesystem::path& cacheDirectory) {
+        close();
+
+        Key key;
+        if (!file.isOpen() || !makeKey(file, key)) {
+            return false;
+        }
+
+        const std::filesystem::path cachePath = getCachePath(file, cacheDirectory);
+        if (load(cachePath, key)) {
+            m_cached = true;
+        } else {
+            build(file);
+            m_records = m_built;
+
+            std::error_code ec;
+            std::filesystem::create_directories(cacheDirectory, ec);
+            save(cachePath, key);
+        }
+
+        m_cacheFile = cachePath;
+        m_contentKey = fnv1a(reinterpret_cast<const uint8_t*>(&key.fileSize), sizeof(key.fileSize));
+        m_contentKey = fnv1a(reinterpret_cast<const uint8_t*>(&key.modifiedTime), sizeof(key.modifiedTime), m_contentKey);
+        m_contentKey = fnv1a(reinterpret_cast<const uint8_t*>(&key.contentHash), sizeof(key.contentHash), m_contentKey);
+        m_contentKey = fnv1a(&key.encryptionKey, sizeof(key.encryptionKey), m_contentKey);
+        m_open = true;
+        return true;
+    }
+
+    void BlockIndex::close() {
+        m_records = {};
+        m_built.clear();
+        m_built.shrink_to_fit();
+        m_mapped.close();
+        m_cacheFile.clear();
+        m_contentKey = 0;
+        m_open = false;
+        m_cached = false;
+    }
+
+    uint32_t BlockIndex::findByOffset(uint32_t offset) const {
+        const auto it = std::lower_bound(m_records.begin(), m_records.end(), offset, [](const Record& record, uint32_t value) {
+            return record.offset < value;
+        });
+        return it != m_records.end() && it->offset == offset ? static_cast<uint32_t>(it - m_records.begin()) : INVALID_INDEX;
+    }
+
+    uint32_t BlockIndex::findContaining(uint32_t offset) const {
+        const auto it = std::upper_bound(m_records.begin(), m_records.end(), offset, [](uint32_t value, const Record& record) {
+            return value < record.offset;
+        });
+        if (it == m_records.begin()) {
+            return INVALID_INDEX;
+        }
+
+        // The last block starting at or before offset, or one of its ancestors
+        uint32_t index = static_cast<uint32_t>(it - m_records.begin()) - 1;
+        while (index != INVALID_INDEX && offset >= m_records[index].offset + m_records[index].size) {
+            index = m_records[index].parent;
+        }
+        return index;
+    }
+
+    bool BlockIndex::makeKey(ResourceFile& file, Key& key) {
+        std::error_code ec;
+        const auto modified = std::filesystem::last_write_time(file.getPath(), ec);
+        if (ec) {
+            return false;
+        }
+
+        // Size and mtime catch almost every change; hashing the head and tail catches
+        // files replaced with the same size and a preserved timestamp without reading
+        // the whole file
+        const size_t size = file.size();
+        const size_t sample = std::min(size, HASH_SAMPLE_SIZE);
+        const auto head = file.view(0, sample);
+        const auto tail = file.view(size - sample, sample);
+
+        key.fileSize = size;
+        key.modifiedTime = static_cast<int64_t>(modified.time_since_epoch().count());
+        key.contentHash = fnv1a(tail.data(), tail.size(), fnv1a(head.data(), head.size()));
+        key.encryptionKey = file.getKey();
+        return true;
+    }
+
+    std::filesystem::path BlockIndex::getCachePath(const ResourceFile& file, const std::filesystem::path& cacheDirectory) {
+        std::error_code ec;
+        const std::string absolute = std::filesystem::absolute(file.getPath(), ec).string();
+        const uint64_t hash = fnv1a(reinterpret_cast<const uint8_t*>(absolute.data()), absolute.size());
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.blocks", static_cast<unsigned long long>(hash));
+        return cacheDirectory / (file.getPath().filename().string() + "-" + name);
+    }
+
+    bool BlockIndex::load(const std::filesystem::path& path, const Key& key) {
+        if (!m_mapped.open(path)) {
+            return false;
+        }
+
+        FileHeader header;
+        if (m_mapped.size() < sizeof(header)) {
+            m_mapped.close();
+            return false;
+        }
+        std::memcpy(&header, m_mapped.data(), sizeof(header));
+
+        const bool valid = std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                           header.version == VERSION && header.fileSize == key.fileSize &&
+                           header.modifiedTime == key.modifiedTime && header.contentHash == key.contentHash &&
+                           header.encryptionKey == key.encryptionKey &&
+                           m_mapped.size() == sizeof(header) + size_t(header.count) * sizeof(Record);
+        if (!valid) {
+            m_mapped.close();
+            return false;
+        }
+
+        m_records = {reinterpret_cast<const Record*>(m_mapped.data() + sizeof(header)), header.count};
+
+        // Guard the links against a damaged cache file
+        for (uint32_t i = 0; i < header.count; i++) {
+            const Record& record = m_records[i];
+            if ((record.parent != INVALID_INDEX && record.parent >= i) ||
+                (record.nextSibling != INVALID_INDEX && (record.nextSibling <= i || record.nextSibling >= header.count)) ||
+                uint64_t(record.offset) + record.size > key.fileSize) {
+                m_records = {};
+                m_mapped.close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool BlockIndex::save(const std::filesystem::path& path, const Key& key) const {
+        FileHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = VERSION;
+        header.fileSize = key.fileSize;
+        header.modifiedTime = key.modifiedTime;
+        header.contentHash = key.contentHash;
+        header.count = static_cast<uint32_t>(m_records.size());
+        header.encryptionKey = key.encryptionKey;
+
+        // Written aside and renamed, so a reader never maps a half-written file
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                return false;
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(m_records.data()), static_cast<std::streamsize>(m_records.size_bytes()));
+            if (!out) {
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temporary, path, ec);
+        return !ec;
+    }
+
+    void BlockIndex::build(ResourceFile& file) {
+        m_built.clear();
+
+        std::unordered_map<uint32_t, uint16_t> roomNumbers;     // ROOM offset -> room number (from LOFF)
+        uint16_t nextRoom = 1;
+
+        auto add = [&](const Chunk& chunk, uint32_t parent, uint16_t room, uint16_t depth) {
+            m_built.push_back({chunk.tag, chunk.offset, chunk.size, parent, INVALID_INDEX, room, depth});
+            return static_cast<uint32_t>(m_built.size() - 1);
+        };
+
+        auto visit = [&](auto&& self, const Chunk& chunk, uint32_t index) -> void {
+            if (!ResourceFile::isContainer(chunk.tag)) {
+                return;
+            }
+
+            // The room offset table precedes the rooms it describes
+            if (chunk.tag == tags::LECF) {
+                const Chunk loff = file.findChild(chunk, tags::LOFF);
+                const auto data = loff.valid() ? file.data(loff) : std::span<const uint8_t>{};
+                if (!data.empty()) {
+                    const size_t count = std::min<size_t>(data[0], (data.size() - 1) / 5);
+                    for (size_t i = 0; i < count; i++) {
+                        roomNumbers[readLE32(&data[1 + i * 5 + 1])] = data[1 + i * 5];
+                    }
+                }
+            }
+
+            uint32_t previous = INVALID_INDEX;
+            file.forEachChild(chunk, [&](const Chunk& child) {
+                uint16_t room = m_built[index].room;
+                if (child.tag == tags::LFLF) {
+                    const auto it = roomNumbers.find(child.dataOffset());
+                    room = it != roomNumbers.end() ? it->second : nextRoom;
+                    nextRoom = static_cast<uint16_t>(room + 1);
+                }
+
+                const uint32_t childIndex = add(child, index, room, static_cast<uint16_t>(m_built[index].depth + 1));
+                if (previous != INVALID_INDEX) {
+                    m_built[previous].nextSibling = childIndex;
+                }
+                previous = childIndex;
+                self(self, child, childIndex);
+            });
+        };
+
+        uint32_t previous = INVALID_INDEX;
+        for (const Chunk& chunk : file.getTopLevel()) {
+            const uint32_t index = add(chunk, INVALID_INDEX, 0, 0);
+            if (previous != INVALID_INDEX) {
+                m_built[previous].nextSibling = index;
+            }
+            previous = index;
+            visit(visit, chunk, index);
+        }
+    }
+
+} // namespace scummredux
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ResourceFile.h"
+#include "../core/MappedFile.h"
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace scummredux {
+
+    // Every block of one resource file, flattened in file order (pre-order, so records
+    // are sorted by offset and a block's descendants directly follow it). Built with
+    // one pass over the block headers, then saved to a cache file that later opens
+    // just map: the records are used in place, no parsing.
+    class BlockIndex {
+    public:
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        struct Record {
+            ChunkTag tag;
+            uint32_t offset;
+            uint32_t size;
+            uint32_t parent;            // Record index, INVALID_INDEX for top-level blocks
+            uint32_t nextSibling;       // Record index, INVALID_INDEX for the last child
+            uint16_t room;              // Owning room number, 0 outside LFLF blocks
+            uint16_t depth;
+
+            Chunk toChunk() const { return {tag, offset, size}; }
+        };
+        static_assert(sizeof(Record) == 24, "Records are stored as-is in the cache file");
+
+        BlockIndex() = default;
+
+        BlockIndex(const BlockIndex&) = delete;
+        BlockIndex& operator=(const BlockIndex&) = delete;
+
+        // Maps the cached index for this file if it is still valid, otherwise builds
+        // and caches a new one
+        bool open(ResourceFile& file, const std::filesystem::path& cacheDirectory);
+        void close();
+
+        bool isOpen() const { return m_open; }
+        bool isCached() const { return m_cached; }
+
+        // Where the index is cached, and a hash of what it was validated against (file
+        // size, time and sampled content): derived caches stored next to it keep both
+        const std::filesystem::path& getCacheFile() const { return m_cacheFile; }
+        uint64_t getContentKey() const { return m_contentKey; }
+
+        size_t size() const { return m_records.size(); }
+        const Record& get(uint32_t index) const { return m_records[index]; }
+        std::span<const Record> getRecords() const { return m_records; }
+
+        uint32_t getFirstChild(uint32_t index) const {
+            return index + 1 < m_records.size() && m_records[index + 1].parent == index ? index + 1 : INVALID_INDEX;
+        }
+
+        // Record that starts at offset, or the innermost one containing it
+        uint32_t findByOffset(uint32_t offset) const;
+        uint32_t findContaining(uint32_t offset) const;
+
+    private:
+        struct Key {
+            uint64_t fileSize;
+            int64_t modifiedTime;
+            uint64_t contentHash;
+            uint8_t encryptionKey;
+        };
+
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t fileSize;
+            int64_t modifiedTime;
+            uint64_t contentHash;
+            uint32_t count;
+            uint8_t encryptionKey;
+            uint8_t reserved[3];
+        };
+        static_assert(sizeof(FileHeader) == 40);
+
+        static bool makeKey(ResourceFile& file, Key& key);
+        static std::filesystem::path getCachePath(const ResourceFile& file, const std::filesystem::path& cacheDirectory);
+
+        bool load(const std::filesystem::path& path, const Key& key);
+        bool save(const std::filesystem::path& path, const Key& key) const;
+        void build(ResourceFile& file);
+
+        MappedFile m_mapped;                // Cache file backing m_records
+        std::vector<Record> m_built;        // Or a freshly built index
+        std::span<const Record> m_records;
+        std::filesystem::path m_cacheFile;
+        uint64_t m_contentKey = 0;
+        bool m_open = false;
+        bool m_cached = false;
+
+        static constexpr uint32_t VERSION = 1;
+        static constexpr size_t HASH_SAMPLE_SIZE = 64 * 1024;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace scummredux {
+
+    // Four-character block tag packed big-endian, so tags compare like their text
+    using ChunkTag = uint32_t;
+
+    constexpr ChunkTag makeTag(const char (&name)[5]) {
+        return (static_cast<ChunkTag>(static_cast<uint8_t>(name[0])) << 24) |
+               (static_cast<ChunkTag>(static_cast<uint8_t>(name[1])) << 16) |
+               (static_cast<ChunkTag>(static_cast<uint8_t>(name[2])) << 8) |
+               static_cast<ChunkTag>(static_cast<uint8_t>(name[3]));
+    }
+
+    inline std::string tagToString(ChunkTag tag) {
+        std::string text(4, ' ');
+        for (int i = 0; i < 4; i++) {
+            const char c = static_cast<char>((tag >> (24 - i * 8)) & 0xFF);
+            text[i] = (c >= 0x20 && c < 0x7F) ? c : '?';
+        }
+        return text;
+    }
+
+    // Common block tags
+    namespace tags {
+        inline constexpr ChunkTag LECF = makeTag("LECF");
+        inline constexpr ChunkTag LOFF = makeTag("LOFF");
+        inline constexpr ChunkTag LFLF = makeTag("LFLF");
+        inline constexpr ChunkTag ROOM = makeTag("ROOM");
+        inline constexpr ChunkTag RMHD = makeTag("RMHD");
+        inline constexpr ChunkTag RMIM = makeTag("RMIM");
+        inline constexpr ChunkTag RMIH = makeTag("RMIH");
+        inline constexpr ChunkTag CLUT = makeTag("CLUT");
+        inline constexpr ChunkTag PALS = makeTag("PALS");
+        inline constexpr ChunkTag WRAP = makeTag("WRAP");
+        inline constexpr ChunkTag OFFS = makeTag("OFFS");
+        inline constexpr ChunkTag APAL = makeTag("APAL");
+        inline constexpr ChunkTag CYCL = makeTag("CYCL");
+        inline constexpr ChunkTag TRNS = makeTag("TRNS");
+        inline constexpr ChunkTag SMAP = makeTag("SMAP");
+        inline constexpr ChunkTag OBIM = makeTag("OBIM");
+        inline constexpr ChunkTag IMHD = makeTag("IMHD");
+        inline constexpr ChunkTag OBCD = makeTag("OBCD");
+        inline constexpr ChunkTag CDHD = makeTag("CDHD");
+        inline constexpr ChunkTag VERB = makeTag("VERB");
+        inline constexpr ChunkTag OBNA = makeTag("OBNA");
+        inline constexpr ChunkTag EXCD = makeTag("EXCD");
+        inline constexpr ChunkTag ENCD = makeTag("ENCD");
+        inline constexpr ChunkTag NLSC = makeTag("NLSC");
+        inline constexpr ChunkTag LSCR = makeTag("LSCR");
+        inline constexpr ChunkTag BOXD = makeTag("BOXD");
+        inline constexpr ChunkTag BOXM = makeTag("BOXM");
+        inline constexpr ChunkTag SCAL = makeTag("SCAL");
+        inline constexpr ChunkTag SCRP = makeTag("SCRP");
+        inline constexpr ChunkTag SOUN = makeTag("SOUN");
+        inline constexpr ChunkTag COST = makeTag("COST");
+        inline constexpr ChunkTag AKOS = makeTag("AKOS");
+        inline constexpr ChunkTag AKHD = makeTag("AKHD");
+        inline constexpr ChunkTag AKPL = makeTag("AKPL");
+        inline constexpr ChunkTag AKOF = makeTag("AKOF");
+        inline constexpr ChunkTag AKCI = makeTag("AKCI");
+        inline constexpr ChunkTag AKCD = makeTag("AKCD");
+        inline constexpr ChunkTag AKCH = makeTag("AKCH");
+        inline constexpr ChunkTag AKSQ = makeTag("AKSQ");
+        inline constexpr ChunkTag CHAR = makeTag("CHAR");
+        inline constexpr ChunkTag RNAM = makeTag("RNAM");
+        inline constexpr ChunkTag MAXS = makeTag("MAXS");
+        inline constexpr ChunkTag DROO = makeTag("DROO");
+        inline constexpr ChunkTag DSCR = makeTag("DSCR");
+        inline constexpr ChunkTag DSOU = makeTag("DSOU");
+        inline constexpr ChunkTag DCOS = makeTag("DCOS");
+        inline constexpr ChunkTag DCHR = makeTag("DCHR");
+        inline constexpr ChunkTag DOBJ = makeTag("DOBJ");
+        inline constexpr ChunkTag AARY = makeTag("AARY");
+    } // namespace tags
+
+    // A block inside a resource file: 4-byte tag, 4-byte big-endian size (header
+    // included), then the payload. Offsets are absolute file offsets.
+    struct Chunk {
+        static constexpr uint32_t HEADER_SIZE = 8;
+
+        ChunkTag tag = 0;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+
+        bool valid() const { return tag != 0; }
+        uint32_t dataOffset() const { return offset + HEADER_SIZE; }
+        uint32_t dataSize() const { return size - HEADER_SIZE; }
+        uint32_t end() const { return offset + size; }
+    };
+
+} // namespace scummredux
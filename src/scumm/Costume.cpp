@@ -0,0 +1,556 @@
+#include "Costume.h"
+#include "Chunk.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace scummredux {
+
+    namespace {
+        constexpr size_t HEADER_SIZE = 8;
+        constexpr size_t FRAME_INFO_SIZE = 12;      // width, height, rel x/y, move x/y
+        constexpr size_t AKOF_ENTRY_SIZE = 6;       // AKCD offset (32), AKCI offset (16)
+        constexpr uint16_t MAX_FRAME_SIZE = 1024;
+        constexpr uint8_t TRANSPARENT = 255;        // BOMP and bit stream frames
+
+        // Classic command bytes
+        constexpr uint8_t CMD_SOUND = 0x78;
+        constexpr uint8_t CMD_STOP = 0x79;
+        constexpr uint8_t CMD_START = 0x7A;
+        constexpr uint8_t CMD_EMPTY = 0x7B;
+        constexpr uint8_t CMD_COUNTER = 0x7C;
+
+        // AKOS sequence commands this player steps through
+        constexpr uint16_t AKC_RETURN = 0xC001;
+        constexpr uint16_t AKC_JUMP = 0xC030;
+        constexpr uint16_t AKC_END_SEQUENCE = 0xC0FF;
+        constexpr uint16_t AKC_FIRST_COMMAND = 0xC000;
+
+        // AKCH limb codes
+        constexpr uint8_t AKCH_CLEAR = 1;
+        constexpr uint8_t AKCH_NO_LOOP = 3;
+        constexpr uint8_t AKCH_STOP = 4;
+        constexpr uint8_t AKCH_START = 5;
+
+        uint32_t readBE32(std::span<const uint8_t> data, size_t offset) {
+            return (static_cast<uint32_t>(data[offset]) << 24) | (data[offset + 1] << 16) | (data[offset + 2] << 8) |
+                   data[offset + 3];
+        }
+
+        void setBit(BitMask& mask, size_t x, size_t y) {
+            mask.row(y)[x >> 3] |= static_cast<uint8_t>(0x80 >> (x & 7));
+        }
+    } // namespace
+
+    bool Costume::load(std::span<const uint8_t> block, std::string& error) {
+        if (block.size() < HEADER_SIZE) {
+            error = "truncated costume";
+            return false;
+        }
+        m_data.assign(block.begin(), block.end());
+        m_palette.clear();
+        m_animationCount = 0;
+
+        const ChunkTag tag = readBE32(block, 0);
+        if (tag == tags::COST) {
+            m_format = Format::Classic;
+            m_codec = 1;
+
+            // v6 payloads keep the old 6-byte header (size, "CO"); v5 folded it into the block header
+            m_newHeader = m_data.size() >= 14 && m_data[12] == 'C' && m_data[13] == 'O';
+            m_base = m_newHeader ? HEADER_SIZE : 2;
+            if (m_data.size() < m_base + 8) {
+                error = "truncated costume";
+                return false;
+            }
+
+            const uint8_t format = m_data[m_base + 7] & 0x7F;
+            size_t colors = 0;
+            switch (format) {
+                case 0x58:
+                case 0x60:
+                    colors = 16;
+                    break;
+                case 0x59:
+                case 0x61:
+                    colors = 32;
+                    break;
+                default: {
+                    char message[48];
+                    std::snprintf(message, sizeof(message), "unsupported costume format 0x%02X", format);
+                    error = message;
+                    return false;
+                }
+            }
+
+            const size_t tables = m_base + 8 + colors;
+            m_animationCount = m_data[m_base + 6] + 1;
+            if (m_data.size() < tables + 34 + m_animationCount * 2) {
+                error = "truncated costume";
+                return false;
+            }
+            m_palette.assign(m_data.begin() + m_base + 8, m_data.begin() + tables);
+            m_commands = m_base + readLE16(tables);
+            m_frameOffsets = tables + 2;
+            m_animOffsets = tables + 34;
+            return true;
+        }
+
+        if (tag != tags::AKOS) {
+            error = "not a costume (" + tagToString(tag) + ")";
+            return false;
+        }
+
+        m_format = Format::Akos;
+        size_t akhd = 0;
+        size_t akhdSize = 0;
+        m_akch = m_aksq = m_aksqSize = m_akof = m_akofSize = m_akci = m_akcd = 0;
+        for (size_t offset = HEADER_SIZE; offset + HEADER_SIZE <= m_data.size();) {
+            const ChunkTag child = readBE32(m_data, offset);
+            const size_t size = readBE32(m_data, offset + 4);
+            if (size < HEADER_SIZE || offset + size > m_data.size()) {
+                break;
+            }
+
+            const size_t payload = offset + HEADER_SIZE;
+            if (child == tags::AKHD) {
+                akhd = payload;
+                akhdSize = size - HEADER_SIZE;
+            } else if (child == tags::AKPL) {
+                m_palette.assign(m_data.begin() + payload, m_data.begin() + offset + size);
+            } else if (child == tags::AKCH) {
+                m_akch = payload;
+            } else if (child == tags::AKSQ) {
+                m_aksq = payload;
+                m_aksqSize = size - HEADER_SIZE;
+            } else if (child == tags::AKOF) {
+                m_akof = payload;
+                m_akofSize = size - HEADER_SIZE;
+            } else if (child == tags::AKCI) {
+                m_akci = payload;
+            } else if (child == tags::AKCD) {
+                m_akcd = payload;
+            }
+            offset += size;
+        }
+
+        if (akhdSize < 10 || !m_akch || !m_aksq || !m_akof || !m_akci || !m_akcd) {
+            error = "incomplete AKOS";
+            return false;
+        }
+        m_animationCount = readLE16(akhd + 4);
+        m_codec = readLE16(akhd + 8);
+        if (m_codec != 1 && m_codec != 5 && m_codec != 16) {
+            error = "unsupported AKOS codec " + std::to_string(m_codec);
+            return false;
+        }
+        return true;
+    }
+
+    bool Costume::locateFrame(size_t limb, uint16_t frame, size_t& header, size_t& pixels) const {
+        if (m_format == Format::Classic) {
+            const uint16_t table = limb < LIMBS ? readLE16(m_frameOffsets + limb * 2) : 0;
+            if (table == 0) {
+                return false;
+            }
+            header = m_base + readLE16(m_base + table + frame * 2);
+            pixels = header + FRAME_INFO_SIZE;
+        } else {
+            const size_t entry = m_akof + static_cast<size_t>(frame) * AKOF_ENTRY_SIZE;
+            if (entry + AKOF_ENTRY_SIZE > m_akof + m_akofSize) {
+                return false;
+            }
+            pixels = m_akcd + readLE32(entry);
+            header = m_akci + readLE16(entry + 4);
+        }
+        return header + FRAME_INFO_SIZE <= m_data.size() && pixels < m_data.size();
+    }
+
+    bool Costume::getFrameInfo(size_t limb, uint16_t frame, FrameInfo& info) const {
+        size_t header = 0;
+        size_t pixels = 0;
+        if (!locateFrame(limb, frame, header, pixels)) {
+            return false;
+        }
+        info.width = readLE16(header);
+        info.height = readLE16(header + 2);
+        info.relX = static_cast<int16_t>(readLE16(header + 4));
+        info.relY = static_cast<int16_t>(readLE16(header + 6));
+        info.moveX = static_cast<int16_t>(readLE16(header + 8));
+        info.moveY = static_cast<int16_t>(readLE16(header + 10));
+        return info.width > 0 && info.height > 0 && info.width <= MAX_FRAME_SIZE && info.height <= MAX_FRAME_SIZE;
+    }
+
+    bool Costume::decodeFrame(size_t limb, uint16_t frame, IndexedImage& image, BitMask& opaque, FrameInfo& info) const {
+        size_t header = 0;
+        size_t pixels = 0;
+        if (!getFrameInfo(limb, frame, info) || !locateFrame(limb, frame, header, pixels)) {
+            return false;
+        }
+
+        image.resize(info.width, info.height);
+        opaque.resize(info.width, info.height);
+        switch (m_format == Format::Classic ? 1 : m_codec) {
+            case 1:
+                return decodeRLE(pixels, info, image, opaque);
+            case 5:
+                return decodeBOMP(pixels, info, image, opaque);
+            case 16:
+                return decodeBitStream(pixels, info, image, opaque);
+            default:
+                return false;
+        }
+    }
+
+    // Column-major runs: color in the high bits of a byte, length in the low ones
+    // (0: the next byte); color 0 is transparent
+    bool Costume::decodeRLE(size_t offset, const FrameInfo& info, IndexedImage& image, BitMask& opaque) const {
+        const unsigned shift = m_palette.size() >= 64 ? 2 : m_palette.size() >= 32 ? 3 : 4;
+        const uint8_t lengthMask = static_cast<uint8_t>(0xFF >> (8 - shift));
+
+        size_t x = 0;
+        size_t y = 0;
+        while (offset < m_data.size()) {
+            const uint8_t code = m_data[offset++];
+            const uint8_t color = code >> shift;
+            size_t length = code & lengthMask;
+            if (length == 0) {
+                length = at(offset++);
+                length = length ? length : 256;
+            }
+
+            const uint8_t index = color < m_palette.size() ? m_palette[color] : color;
+            for (; length > 0; length--) {
+                if (color != 0) {
+                    image.row(y)[x] = index;
+                    setBit(opaque, x, y);
+                }
+                if (++y == info.height) {
+                    y = 0;
+                    if (++x == info.width) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Rows of BOMP runs, each prefixed with its byte size: (n - 1) << 1 | 1 then a
+    // color repeats it n times, (n - 1) << 1 copies n colors
+    bool Costume::decodeBOMP(size_t offset, const FrameInfo& info, IndexedImage& image, BitMask& opaque) const {
+        auto put = [&](size_t x, size_t y, uint8_t color) {
+            const uint8_t index = color != TRANSPARENT && color < m_palette.size() ? m_palette[color] : color;
+            if (x < info.width && index != TRANSPARENT) {
+                image.row(y)[x] = index;
+                setBit(opaque, x, y);
+            }
+        };
+
+        for (size_t y = 0; y < info.height; y++) {
+            if (offset + 2 > m_data.size()) {
+                return false;
+            }
+            const size_t end = std::min(offset + 2 + readLE16(offset), m_data.size());
+            offset += 2;
+
+            size_t x = 0;
+            while (x < info.width && offset < end) {
+                const uint8_t code = m_data[offset++];
+                const size_t count = (code >> 1) + 1;
+                if (code & 1) {
+                    const uint8_t color = at(offset++);
+                    for (size_t i = 0; i < count; i++) {
+                        put(x++, y, color);
+                    }
+                } else {
+                    for (size_t i = 0; i < count && offset < end; i++) {
+                        put(x++, y, m_data[offset++]);
+                    }
+                }
+            }
+            offset = end;
+        }
+        return true;
+    }
+
+    // AKOS codec 16: row-major, one color carried from pixel to pixel. Per pixel,
+    // LSB-first: 0 keeps it; 01 + shift bits loads a new one; 11 + 3 bits adds -4..3
+    // to it, or (value 4) repeats it for the next byte's count of pixels
+    bool Costume::decodeBitStream(size_t offset, const FrameInfo& info, IndexedImage& image, BitMask& opaque) const {
+        if (offset + 4 > m_data.size()) {
+            return false;
+        }
+        const unsigned shift = m_data[offset];
+        const uint8_t colorMask = static_cast<uint8_t>((1u << std::min(shift, 8u)) - 1);
+        uint8_t color = m_data[offset + 1];
+        uint32_t bits = readLE16(offset + 2);
+        unsigned available = 16;
+        size_t position = offset + 4;
+
+        auto fill = [&] {
+            if (available <= 8) {
+                bits |= static_cast<uint32_t>(at(position++)) << available;
+                available += 8;
+            }
+        };
+        auto eat = [&](unsigned count) {
+            available -= count;
+            bits >>= count;
+        };
+
+        bool repeating = false;
+        uint8_t repeat = 0;
+        for (size_t y = 0; y < info.height; y++) {
+            for (size_t x = 0; x < info.width; x++) {
+                const uint8_t index = color != TRANSPARENT && color < m_palette.size() ? m_palette[color] : color;
+                if (index != TRANSPARENT) {
+                    image.row(y)[x] = index;
+                    setBit(opaque, x, y);
+                }
+
+                if (repeating) {
+                    repeating = --repeat != 0;
+                    continue;
+                }
+                fill();
+                const uint32_t code = bits & 3;
+                if (!(code & 1)) {
+                    eat(1);
+                } else if (code & 2) {
+                    eat(2);
+                    const uint32_t delta = bits & 7;
+                    eat(3);
+                    if (delta != 4) {
+                        color = static_cast<uint8_t>(color + delta - 4);
+                    } else {
+                        repeating = true;
+                        fill();
+                        repeat = static_cast<uint8_t>((bits & 0xFF) - 1);
+                        eat(8);
+                        fill();
+                    }
+                } else {
+                    eat(2);
+                    fill();
+                    color = static_cast<uint8_t>(bits & colorMask);
+                    eat(shift);
+                    fill();
+                }
+            }
+        }
+        return position <= m_data.size() + 2;
+    }
+
+    void CostumePlayer::start(const Costume& costume, size_t animation) {
+        m_costume = &costume;
+        m_limbs = {};
+        m_unsupported = false;
+        if (animation >= costume.getAnimationCount()) {
+            return;
+        }
+
+        size_t entry = 0;
+        if (costume.m_format == Costume::Format::Classic) {
+            entry = costume.m_base + costume.readLE16(costume.m_animOffsets + animation * 2);
+            if (entry == costume.m_base) {
+                return;
+            }
+        } else {
+            const uint16_t offset = costume.readLE16(costume.m_akch + animation * 2);
+            if (offset == 0) {
+                return;
+            }
+            entry = costume.m_akch + offset;
+        }
+
+        const uint16_t mask = costume.readLE16(entry);
+        entry += 2;
+        for (size_t index = 0; index < Costume::LIMBS; index++) {
+            if (!(mask & (0x8000 >> index))) {
+                continue;
+            }
+            Limb& limb = m_limbs[index];
+
+            if (costume.m_format == Costume::Format::Classic) {
+                // Start in the command list, then length (bit 7: play once)
+                const uint16_t start = costume.readLE16(entry);
+                entry += 2;
+                if (start == 0xFFFF) {
+                    continue;
+                }
+                const uint8_t extra = costume.at(entry++);
+                const uint8_t command = costume.at(costume.m_commands + start);
+                if (command == CMD_START || command == CMD_STOP) {
+                    limb.stopped = command == CMD_STOP;
+                    continue;
+                }
+                limb = {true, false, !(extra & 0x80), start, static_cast<uint16_t>(start + (extra & 0x7F)), start};
+            } else {
+                const uint8_t code = costume.at(entry++);
+                if (code == AKCH_CLEAR || code == AKCH_STOP || code == AKCH_START) {
+                    limb.stopped = code == AKCH_STOP;
+                    continue;
+                }
+                const uint16_t start = costume.readLE16(entry);
+                const uint16_t length = costume.readLE16(entry + 2);
+                entry += 4;
+                limb = {true, false, code != AKCH_NO_LOOP, start, static_cast<uint16_t>(start + length), start};
+            }
+        }
+    }
+
+    bool CostumePlayer::getFrame(uint16_t position, uint16_t& frame) const {
+        const Costume& costume = *m_costume;
+        if (costume.m_format == Costume::Format::Classic) {
+            const uint8_t code = costume.at(costume.m_commands + position) & 0x7F;
+            const bool sound = costume.m_newHeader ? code >= 0x71 && code <= CMD_SOUND : code == CMD_SOUND;
+            if (sound || code == CMD_STOP || code == CMD_START || code == CMD_EMPTY || code == CMD_COUNTER) {
+                return false;
+            }
+            frame = code;
+            return true;
+        }
+
+        if (position >= costume.m_aksqSize) {
+            return false;
+        }
+        const size_t offset = costume.m_aksq + position;
+        uint16_t code = costume.at(offset);
+        if (code & 0x80) {
+            code = costume.readBE16(offset);
+        }
+        if (code >= AKC_FIRST_COMMAND) {
+            return false;
+        }
+        frame = code & 0xFFF;
+        return true;
+    }
+
+    uint16_t CostumePlayer::getLength(uint16_t position) const {
+        const Costume& costume = *m_costume;
+        if (costume.m_format == Costume::Format::Classic) {
+            return 1;
+        }
+        const size_t offset = costume.m_aksq + position;
+        if (!(costume.at(offset) & 0x80)) {
+            return 1;
+        }
+        const uint16_t code = costume.readBE16(offset);
+        if (code < AKC_FIRST_COMMAND || code == AKC_RETURN || code == AKC_END_SEQUENCE) {
+            return 2;
+        }
+        return code == AKC_JUMP ? 4 : 0;        // 0: a command this player does not know
+    }
+
+    void CostumePlayer::step() {
+        if (!m_costume) {
+            return;
+        }
+        for (Limb& limb : m_limbs) {
+            if (limb.active && !limb.stopped) {
+                advance(limb);
+            }
+        }
+    }
+
+    void CostumePlayer::advance(Limb& limb) {
+        const Costume& costume = *m_costume;
+        uint16_t position = limb.position;
+        const size_t guard = static_cast<size_t>(limb.end - limb.start) + 2;
+
+        if (costume.m_format == Costume::Format::Classic) {
+            // Counter and sound cells are passed over unless they are the whole range
+            for (size_t i = 0; i < guard; i++) {
+                if (limb.loop) {
+                    position = position >= limb.end ? limb.start : position + 1;
+                } else if (position != limb.end) {
+                    position++;
+                }
+                uint16_t frame = 0;
+                const uint8_t code = costume.at(costume.m_commands + position) & 0x7F;
+                if (getFrame(position, frame) || code == CMD_EMPTY || limb.start == limb.end) {
+                    break;
+                }
+            }
+            limb.position = position;
+            return;
+        }
+
+        for (size_t i = 0; i < guard; i++) {
+            const size_t offset = costume.m_aksq + position;
+            const uint16_t code = (costume.at(offset) & 0x80) ? costume.readBE16(offset) : costume.at(offset);
+            uint16_t next = 0;
+            if (code == AKC_JUMP) {
+                next = costume.readBE16(offset + 2);
+            } else if (code == AKC_RETURN || code == AKC_END_SEQUENCE) {
+                next = limb.start;
+            } else if (const uint16_t length = getLength(position)) {
+                next = static_cast<uint16_t>(position + length);
+            } else {
+                m_unsupported = true;
+                return;                     // Holds the last frame
+            }
+
+            if (next > limb.end || next < limb.start) {
+                if (!limb.loop) {
+                    return;
+                }
+                next = limb.start;
+            }
+            position = next;
+
+            uint16_t frame = 0;
+            if (getFrame(position, frame)) {
+                limb.position = position;
+                return;
+            }
+        }
+    }
+
+    std::vector<CostumePlayer::LimbFrame> CostumePlayer::getFrames() const {
+        std::vector<LimbFrame> frames;
+        if (!m_costume) {
+            return frames;
+        }
+        for (size_t index = 0; index < Costume::LIMBS; index++) {
+            const Limb& limb = m_limbs[index];
+            uint16_t frame = 0;
+            if (limb.active && !limb.stopped && getFrame(limb.position, frame)) {
+                frames.push_back({static_cast<uint8_t>(index), frame});
+            }
+        }
+        return frames;
+    }
+
+    std::vector<CostumePlayer::LimbFrame> CostumePlayer::getAllFrames() const {
+        std::vector<LimbFrame> frames;
+        if (!m_costume) {
+            return frames;
+        }
+        for (size_t index = 0; index < Costume::LIMBS; index++) {
+            const Limb& limb = m_limbs[index];
+            if (!limb.active) {
+                continue;
+            }
+            for (uint16_t position = limb.start; position <= limb.end;) {
+                uint16_t frame = 0;
+                if (getFrame(position, frame)) {
+                    const LimbFrame entry{static_cast<uint8_t>(index), frame};
+                    const bool seen = std::any_of(frames.begin(), frames.end(), [&](const LimbFrame& other) {
+                        return other.limb == entry.limb && other.frame == entry.frame;
+                    });
+                    if (!seen) {
+                        frames.push_back(entry);
+                    }
+                }
+                const uint16_t length = getLength(position);
+                if (length == 0 || position + length > 0xFFFF) {
+                    break;
+                }
+                position = static_cast<uint16_t>(position + length);
+            }
+        }
+        return frames;
+    }
+
+} // namespace scummredux
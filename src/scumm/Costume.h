@@ -0,0 +1,131 @@
+#pragma once
+
+#include "SmapDecoder.h"
+#include "ZPlane.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // An actor costume: up to 16 limbs, each playing a sequence of frames. Two
+    // formats are understood:
+    //     COST (v5/v6)  anim table -> per-limb ranges of a command byte list; frames
+    //                   are column-major RLE in 16 or 32 colors of the costume palette
+    //     AKOS (v7+)    AKCH anim table -> ranges of the AKSQ sequence; frames in
+    //                   AKCD through AKOF/AKCI, codec 1 (costume RLE), 5 (BOMP rows)
+    //                   or 16 (bit stream)
+    // Frames decode to room palette indices plus an opaque mask.
+    class Costume {
+    public:
+        enum class Format : uint8_t {
+            Classic,
+            Akos
+        };
+
+        // Placement of a frame relative to the actor (CostumeInfo / AKCI)
+        struct FrameInfo {
+            uint16_t width = 0;
+            uint16_t height = 0;
+            int16_t relX = 0;
+            int16_t relY = 0;
+            int16_t moveX = 0;
+            int16_t moveY = 0;
+        };
+
+        static constexpr size_t LIMBS = 16;
+
+        // Whole block, header included; the bytes are copied
+        bool load(std::span<const uint8_t> block, std::string& error);
+
+        Format getFormat() const { return m_format; }
+        size_t getAnimationCount() const { return m_animationCount; }
+        size_t getColorCount() const { return m_palette.size(); }
+        uint16_t getCodec() const { return m_codec; }
+
+        bool getFrameInfo(size_t limb, uint16_t frame, FrameInfo& info) const;
+        bool decodeFrame(size_t limb, uint16_t frame, IndexedImage& image, BitMask& opaque, FrameInfo& info) const;
+
+    private:
+        friend class CostumePlayer;
+
+        // Where a frame's header and pixels are
+        bool locateFrame(size_t limb, uint16_t frame, size_t& header, size_t& pixels) const;
+        bool decodeRLE(size_t offset, const FrameInfo& info, IndexedImage& image, BitMask& opaque) const;
+        bool decodeBOMP(size_t offset, const FrameInfo& info, IndexedImage& image, BitMask& opaque) const;
+        bool decodeBitStream(size_t offset, const FrameInfo& info, IndexedImage& image, BitMask& opaque) const;
+
+        uint8_t at(size_t offset) const { return offset < m_data.size() ? m_data[offset] : 0; }
+        uint16_t readLE16(size_t offset) const { return static_cast<uint16_t>(at(offset) | (at(offset + 1) << 8)); }
+        uint16_t readBE16(size_t offset) const { return static_cast<uint16_t>((at(offset) << 8) | at(offset + 1)); }
+        uint32_t readLE32(size_t offset) const { return readLE16(offset) | (static_cast<uint32_t>(readLE16(offset + 2)) << 16); }
+
+        Format m_format = Format::Classic;
+        std::vector<uint8_t> m_data;        // The whole block
+        std::vector<uint8_t> m_palette;     // Costume color -> room palette index
+        size_t m_animationCount = 0;
+        uint16_t m_codec = 1;
+
+        // Classic: offsets are relative to m_base
+        size_t m_base = 0;
+        size_t m_animOffsets = 0;           // LE16 per animation
+        size_t m_frameOffsets = 0;          // LE16 per limb
+        size_t m_commands = 0;              // Command bytes
+        bool m_newHeader = false;           // v6 layout: sound commands 0x71-0x78
+
+        // AKOS: payload offsets of the sub-blocks
+        size_t m_akch = 0;
+        size_t m_aksq = 0;
+        size_t m_aksqSize = 0;
+        size_t m_akof = 0;
+        size_t m_akofSize = 0;
+        size_t m_akci = 0;
+        size_t m_akcd = 0;
+    };
+
+    // Steps the limb sequences of one costume animation, like the engine's
+    // increaseAnims: each step moves every running limb to its next frame, skipping
+    // commands and looping (or holding) at the end of its range
+    class CostumePlayer {
+    public:
+        struct LimbFrame {
+            uint8_t limb = 0;
+            uint16_t frame = 0;
+        };
+
+        void start(const Costume& costume, size_t animation);
+        void step();
+
+        // Limbs showing a frame right now, in drawing order
+        std::vector<LimbFrame> getFrames() const;
+
+        // Every frame the animation can show, for prefetching and bounds
+        std::vector<LimbFrame> getAllFrames() const;
+
+        // Steps reach no frame the player understands (unknown AKOS commands)
+        bool hasUnsupported() const { return m_unsupported; }
+
+    private:
+        struct Limb {
+            bool active = false;
+            bool stopped = false;
+            bool loop = true;
+            uint16_t start = 0;
+            uint16_t end = 0;               // Inclusive
+            uint16_t position = 0;
+        };
+
+        // Frame at position, or false for a command / empty cell
+        bool getFrame(uint16_t position, uint16_t& frame) const;
+        uint16_t getLength(uint16_t position) const;
+        void advance(Limb& limb);
+
+        const Costume* m_costume = nullptr;
+        std::array<Limb, Costume::LIMBS> m_limbs;
+        bool m_unsupported = false;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,72 @@
+#include "CostumeFrameCache.h"
+
+namespace scummredux {
+
+    void CostumeFrameCache::reset(const Costume* costume) {
+        m_costume = costume;
+        m_entries.clear();
+        m_lru.clear();
+        m_bytes = 0;
+    }
+
+    const CostumeFrameCache::Frame* CostumeFrameCache::get(uint8_t limb, uint16_t frame, uint32_t paletteId,
+                                                           const Palette& palette) {
+        if (!m_costume) {
+            return nullptr;
+        }
+
+        const uint64_t key = makeKey(limb, frame, paletteId);
+        const auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            m_hits++;
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+            return it->second.valid ? &it->second.frame : nullptr;
+        }
+
+        m_misses++;
+        m_lru.push_front(key);
+        Entry& entry = m_entries[key];
+        entry.lru = m_lru.begin();
+        entry.valid = m_costume->decodeFrame(limb, frame, m_image, m_opaque, entry.frame.info);
+        if (entry.valid) {
+            // Palette lookup for the whole frame, then the uncovered pixels go transparent
+            std::vector<uint32_t>& pixels = entry.frame.pixels;
+            pixels.resize(m_image.pixels.size());
+            palette.toRGBA(m_image.pixels.data(), pixels.data(), pixels.size());
+            for (size_t y = 0; y < m_image.height; y++) {
+                const uint8_t* bits = m_opaque.row(y);
+                uint32_t* row = pixels.data() + y * m_image.width;
+                for (size_t x = 0; x < m_image.width; x++) {
+                    if (!(bits[x >> 3] & (0x80 >> (x & 7)))) {
+                        row[x] = 0;
+                    }
+                }
+            }
+        }
+        m_bytes += getBytes(entry);
+        evict(key);
+        return entry.valid ? &entry.frame : nullptr;
+    }
+
+    void CostumeFrameCache::evict(uint64_t keep) {
+        while (m_bytes > m_budget && !m_lru.empty() && m_lru.back() != keep) {
+            const auto it = m_entries.find(m_lru.back());
+            m_bytes -= getBytes(it->second);
+            m_entries.erase(it);
+            m_lru.pop_back();
+            m_evictions++;
+        }
+    }
+
+    CostumeFrameCache::Stats CostumeFrameCache::getStats() const {
+        Stats stats;
+        stats.frames = m_entries.size();
+        stats.bytes = m_bytes;
+        stats.budget = m_budget;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        stats.evictions = m_evictions;
+        return stats;
+    }
+
+} // namespace scummredux
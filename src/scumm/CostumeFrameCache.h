@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Costume.h"
+#include "Palette.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // Decoded RGBA frames of one costume, keyed by (limb, frame, palette), so an
+    // animation decodes each of its frames once however long it plays. Frames are
+    // kept in LRU order under a byte budget; transparent pixels have alpha 0.
+    class CostumeFrameCache {
+    public:
+        struct Frame {
+            Costume::FrameInfo info;
+            std::vector<uint32_t> pixels;
+        };
+
+        struct Stats {
+            size_t frames = 0;
+            size_t bytes = 0;
+            size_t budget = 0;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+        };
+
+        // Drops every frame; the cache then serves costume (which must outlive it)
+        void reset(const Costume* costume);
+
+        // Decodes on a miss. Null for frames that do not decode. The pointer stays
+        // valid until the next get().
+        const Frame* get(uint8_t limb, uint16_t frame, uint32_t paletteId, const Palette& palette);
+
+        void setBudget(size_t bytes) { m_budget = bytes; }
+        Stats getStats() const;
+
+        static constexpr size_t DEFAULT_BUDGET = 8u << 20;
+
+    private:
+        struct Entry {
+            Frame frame;
+            bool valid = false;             // Failed decodes are remembered too
+            std::list<uint64_t>::iterator lru;
+        };
+
+        static uint64_t makeKey(uint8_t limb, uint16_t frame, uint32_t paletteId) {
+            return (static_cast<uint64_t>(paletteId) << 32) | (static_cast<uint64_t>(limb) << 16) | frame;
+        }
+        static size_t getBytes(const Entry& entry) { return entry.frame.pixels.size() * 4 + sizeof(Entry); }
+
+        void evict(uint64_t keep);
+
+        const Costume* m_costume = nullptr;
+        std::unordered_map<uint64_t, Entry> m_entries;
+        std::list<uint64_t> m_lru;          // Front is the most recently used
+        size_t m_bytes = 0;
+        size_t m_budget = DEFAULT_BUDGET;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+
+        // Decode scratch, reused between misses
+        IndexedImage m_image;
+        BitMask m_opaque;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,72 @@
+#include "GameArchive.h"
+#include <cctype>
+
+namespace scummredux {
+
+    namespace {
+
+        std::filesystem::path withDisk(const std::filesystem::path& path, int disk) {
+            std::string extension = path.extension().string();
+            extension.back() = static_cast<char>('0' + disk);
+
+            std::filesystem::path result = path;
+            result.replace_extension(extension);
+            return result;
+        }
+
+    } // namespace
+
+    bool GameArchive::isResourcePath(const std::filesystem::path& path) {
+        const std::string extension = path.extension().string();
+        if (extension.size() != 4) {
+            return false;
+        }
+
+        std::string stem = extension.substr(1, 2);
+        for (char& c : stem) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        const bool digit = std::isdigit(static_cast<unsigned char>(extension.back())) != 0;
+        return digit && (stem == "00" || stem == "la" || stem == "he");
+    }
+
+    std::filesystem::path GameArchive::getIndexPath(const std::filesystem::path& path) {
+        return withDisk(path, 0);
+    }
+
+    bool GameArchive::open(const std::filesystem::path& path) {
+        close();
+
+        if (!isResourcePath(path)) {
+            return false;
+        }
+
+        m_index = std::make_unique<ResourceFile>();
+        if (!m_index->open(withDisk(path, 0))) {
+            m_index.reset();
+            return false;
+        }
+
+        // Data files are numbered from 1 and stop at the first missing disk
+        for (int disk = 1; disk <= MAX_DISKS; disk++) {
+            const std::filesystem::path diskPath = withDisk(path, disk);
+            std::error_code ec;
+            if (!std::filesystem::is_regular_file(diskPath, ec)) {
+                break;
+            }
+
+            auto file = std::make_unique<ResourceFile>();
+            if (!file->open(diskPath)) {
+                break;
+            }
+            m_disks.push_back(std::move(file));
+        }
+        return true;
+    }
+
+    void GameArchive::close() {
+        m_index.reset();
+        m_disks.clear();
+    }
+
+} // namespace scummredux
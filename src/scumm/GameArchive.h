@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ResourceFile.h"
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace scummredux {
+
+    // A game's index file together with its data files. The extensions follow the
+    // "disk number in the last character" scheme every SCUMM 5+ release uses:
+    // MONKEY2.000 / MONKEY2.001, MONKEY.LA0 / MONKEY.LA1..LA3, game.he0 / game.he1.
+    class GameArchive {
+    public:
+        // Accepts either the index or any data file
+        bool open(const std::filesystem::path& path);
+        void close();
+
+        bool isOpen() const { return m_index && m_index->isOpen(); }
+        ResourceFile& getIndex() { return *m_index; }
+        size_t getDiskCount() const { return m_disks.size(); }
+        ResourceFile* getDisk(size_t disk) { return disk >= 1 && disk <= m_disks.size() ? m_disks[disk - 1].get() : nullptr; }
+
+        static bool isResourcePath(const std::filesystem::path& path);
+        static std::filesystem::path getIndexPath(const std::filesystem::path& path);
+
+    private:
+        std::unique_ptr<ResourceFile> m_index;
+        std::vector<std::unique_ptr<ResourceFile>> m_disks;
+
+        static constexpr int MAX_DISKS = 9;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,341 @@
+#include "GameManager.h"
+#include "../core/TraceRecorder.h"
+#include "../utils/Events.hpp"
+#include "../views/ConsoleView.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace scummredux {
+
+    GameManager& GameManager::getInstance() {
+        static GameManager instance;
+        return instance;
+    }
+
+    bool GameManager::open(const std::filesystem::path& path) {
+        close();
+
+        const auto start = std::chrono::steady_clock::now();
+        if (GameArchive::isResourcePath(path)) {
+            // An in-place save cut short is undone before anything is mapped
+            size_t restored = 0;
+            std::string error;
+            if (!ResourceOverlay::recover(GameArchive::getIndexPath(path), restored, error)) {
+                ConsoleView::error("Cannot undo an interrupted save of " + path.filename().string() + ": " + error);
+                return false;
+            }
+            if (restored != 0) {
+                ConsoleView::warning("Undid an interrupted save: restored " + std::to_string(restored) + " blocks");
+            }
+        }
+        if (!m_archive.open(path)) {
+            ConsoleView::error("Not a SCUMM resource file: " + path.string());
+            return false;
+        }
+
+        m_files.push_back(&m_archive.getIndex());
+        for (size_t disk = 1; disk <= m_archive.getDiskCount(); disk++) {
+            m_files.push_back(m_archive.getDisk(disk));
+        }
+
+        size_t blocks = 0;
+        size_t cached = 0;
+        for (ResourceFile* file : m_files) {
+            auto index = std::make_unique<BlockIndex>();
+            if (!index->open(*file, getCacheDirectory())) {
+                ConsoleView::error("Failed to index " + file->getPath().string());
+                close();
+                return false;
+            }
+            blocks += index->size();
+            cached += index->isCached() ? 1 : 0;
+            m_indices.push_back(std::move(index));
+        }
+
+        const auto records = m_indices[0]->getRecords();
+        const bool hasArrays = std::any_of(records.begin(), records.end(), [](const BlockIndex::Record& record) {
+            return record.depth == 0 && record.tag == tags::AARY;
+        });
+        m_scriptVersion = hasArrays ? ScriptVersion::V6 : ScriptVersion::V5;
+        m_overlay.reset(m_files.size());
+        if (!m_strandedPath.empty() && m_strandedPath == path) {
+            if (m_stranded.getFileCount() == m_files.size()) {
+                m_overlay = std::move(m_stranded);
+                ConsoleView::info("Restored " + std::to_string(m_overlay.getBlockCount()) + " unsaved block edits of a failed save");
+            }
+            m_stranded.reset(0);
+            m_strandedPath.clear();
+        }
+
+        m_path = path;
+        m_name = path.stem().string();
+        m_generation++;
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        char message[160];
+        std::snprintf(message, sizeof(message), "Opened %s (v%d scripts): %zu files, %zu blocks (%zu of %zu indices cached) in %.2f ms",
+                      m_name.c_str(), static_cast<int>(m_scriptVersion), m_files.size(), blocks, cached, m_files.size(), ms);
+        ConsoleView::info(message);
+
+        indexReferences();
+        return true;
+    }
+
+    void GameManager::indexReferences() {
+        m_references.clear();
+        for (size_t file = 0; file < m_files.size(); file++) {
+            m_references.push_back(std::make_unique<ReferenceIndex>());
+        }
+
+        // Scripts are disassembled per file in parallel; only the worker touches the
+        // indices until the continuation marks them ready
+        auto& jobs = JobSystem::getInstance();
+        const CancellationToken token = m_closeToken;
+        const auto start = std::chrono::steady_clock::now();
+        JobSystem::Options options;
+        options.counter = &m_fileJobs;
+        options.token = &m_closeToken;
+        const auto handle = jobs.submit([this, token] {
+            SCUMM_TRACE_SCOPE("indexReferences", "scripts");
+            for (size_t file = 1; file < m_files.size(); file++) {
+                if (!m_references[file]->open(*m_files[file], *m_indices[file], m_scriptVersion, token)) {
+                    return;
+                }
+            }
+        }, options);
+
+        const uint32_t generation = m_generation;
+        jobs.continueOnMainThread(handle, [this, generation, start] {
+            if (generation != m_generation) {
+                return;
+            }
+            size_t symbols = 0;
+            size_t uses = 0;
+            size_t cached = 0;
+            for (size_t file = 1; file < m_references.size(); file++) {
+                const ReferenceIndex& index = *m_references[file];
+                if (!index.isOpen()) {
+                    ConsoleView::warning("Failed to index the script references of " + m_files[file]->getPath().string());
+                    return;
+                }
+                symbols += index.getSymbolCount();
+                uses += index.getPostingCount();
+                cached += index.isCached() ? 1 : 0;
+            }
+            m_referencesReady = true;
+
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            char message[160];
+            std::snprintf(message, sizeof(message), "Indexed script references: %zu symbols, %zu uses (%zu of %zu cached) in %.1f ms",
+                          symbols, uses, cached, m_references.size() - 1, ms);
+            ConsoleView::info(message);
+        }, &m_closeToken);
+    }
+
+    std::vector<GameManager::ScriptReference> GameManager::findReferences(ReferenceIndex::SymbolKind kind, uint16_t number) const {
+        std::vector<ScriptReference> references;
+        if (!m_referencesReady) {
+            return references;
+        }
+        for (size_t file = 1; file < m_references.size(); file++) {
+            for (const ReferenceIndex::Posting& posting : m_references[file]->find(kind, number)) {
+                references.push_back({file, posting.record, posting.offset});
+            }
+        }
+        return references;
+    }
+
+    std::vector<RoomPipeline::Room> GameManager::getRooms() {
+        std::vector<RoomPipeline::Room> rooms;
+        for (size_t file = 1; file < m_files.size(); file++) {
+            const BlockIndex& index = *m_indices[file];
+            for (uint32_t record = 0; record < index.size(); record++) {
+                const BlockIndex::Record& block = index.get(record);
+                if (block.tag == tags::LFLF) {
+                    rooms.push_back({m_files[file], file, block.toChunk(), block.room});
+                }
+            }
+        }
+        return rooms;
+    }
+
+    void GameManager::decodeRooms() {
+        if (!isOpen()) {
+            ConsoleView::error("No game is open");
+            return;
+        }
+        m_rooms.start(getRooms());
+    }
+
+    std::vector<ScriptPipeline::Script> GameManager::getScripts() {
+        std::vector<ScriptPipeline::Script> scripts;
+        for (size_t file = 1; file < m_files.size(); file++) {
+            const BlockIndex& index = *m_indices[file];
+            for (uint32_t record = 0; record < index.size(); record++) {
+                const BlockIndex::Record& block = index.get(record);
+                if (ScriptDisassembler::isScriptBlock(block.tag)) {
+                    scripts.push_back({m_files[file], file, record, block.toChunk()});
+                }
+            }
+        }
+        return scripts;
+    }
+
+    void GameManager::decompileScripts() {
+        if (!isOpen()) {
+            ConsoleView::error("No game is open");
+            return;
+        }
+        m_scripts.start(getScripts(), m_scriptVersion, getScriptCachePath());
+    }
+
+    void GameManager::decompileScript(const ScriptDisassembler& script, std::function<void(ScriptPipeline::Listing)> done) {
+        // Tabs outlive the game they were opened from; their output has no cache to go to
+        m_scripts.decompile(script, isOpen() ? getScriptCachePath() : std::filesystem::path(), std::move(done));
+    }
+
+    bool GameManager::editBlock(size_t file, uint32_t record, std::span<const uint8_t> block, std::string& error) {
+        if (!isOpen() || file == 0 || file >= m_files.size() || record >= m_indices[file]->size()) {
+            error = "no such block in the open game";
+            return false;
+        }
+        const BlockIndex::Record& target = m_indices[file]->get(record);
+        const auto original = m_files[file]->view(target.offset, target.size);
+        if (!m_overlay.set(file, *m_indices[file], record, original, block, error)) {
+            return false;
+        }
+
+        char message[160];
+        if (m_overlay.find(file, target.offset)) {
+            std::snprintf(message, sizeof(message), "Edited %s at 0x%08X (%+lld bytes), %zu unsaved blocks",
+                          tagToString(target.tag).c_str(), target.offset,
+                          static_cast<long long>(block.size()) - static_cast<long long>(target.size), m_overlay.getBlockCount());
+        } else {
+            std::snprintf(message, sizeof(message), "%s at 0x%08X is as on disk, %zu unsaved blocks",
+                          tagToString(target.tag).c_str(), target.offset, m_overlay.getBlockCount());
+        }
+        ConsoleView::info(message);
+        return true;
+    }
+
+    std::span<const uint8_t> GameManager::readBlock(size_t file, uint32_t record) {
+        if (!isOpen() || file >= m_files.size() || record >= m_indices[file]->size()) {
+            return {};
+        }
+        const BlockIndex::Record& block = m_indices[file]->get(record);
+        if (const ResourceOverlay::Block* edit = m_overlay.find(file, block.offset)) {
+            return edit->bytes;
+        }
+        return m_files[file]->view(block.offset, block.size);
+    }
+
+    bool GameManager::save() {
+        if (!isOpen()) {
+            ConsoleView::error("No game is open");
+            return false;
+        }
+        if (!m_overlay.isDirty()) {
+            ConsoleView::info(m_name + " has no unsaved changes");
+            return true;
+        }
+
+        // Written while the originals are mapped, swapped in once nothing is
+        const auto start = std::chrono::steady_clock::now();
+        ResourceOverlay saved = std::move(m_overlay);
+        m_overlay.reset(m_files.size());
+        std::string error;
+        if (!saved.prepare(m_files, m_indices, error)) {
+            m_overlay = std::move(saved);
+            ConsoleView::error("Cannot save " + m_name + ": " + error);
+            return false;
+        }
+
+        const std::filesystem::path path = m_path;
+        const std::string name = m_name;
+        const auto objectStates = m_objectStates;
+        close();
+        const bool committed = saved.commit(error);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!committed) {
+            ConsoleView::error("Cannot save " + name + ": " + error);
+            if (saved.isInPlace() || !saved.isCommitted()) {
+                // Same-size blocks can be written again over whatever is on disk, and a
+                // streamed save that put the originals back left nothing moved: either way
+                // the edits still fit the files and wait for the next open
+                m_stranded = std::move(saved);
+                m_strandedPath = path;
+            }
+        }
+        if (!open(path)) {
+            ConsoleView::error("Cannot open " + name + " again after saving");
+            return false;
+        }
+        m_objectStates = objectStates;
+        m_objectStateRevision++;
+        if (!committed) {
+            return false;
+        }
+
+        char message[192];
+        if (saved.isInPlace()) {
+            std::snprintf(message, sizeof(message), "Saved %s: %zu blocks (%.1f KB) written in place to %zu files in %.2f ms",
+                          name.c_str(), saved.getBlockCount(), static_cast<double>(saved.getWrittenBytes()) / 1024.0,
+                          saved.getWrittenFileCount(), ms);
+        } else {
+            std::snprintf(message, sizeof(message), "Saved %s: %zu blocks, %zu files (%.1f MB) written, %zu offsets fixed up in %.2f ms",
+                          name.c_str(), saved.getBlockCount(), saved.getWrittenFileCount(),
+                          static_cast<double>(saved.getWrittenBytes()) / (1024.0 * 1024.0), saved.getFixupCount(), ms);
+        }
+        ConsoleView::success(message);
+        EventGameSaved::post({saved});
+        return true;
+    }
+
+    uint16_t GameManager::getObjectState(uint16_t object) const {
+        const auto it = m_objectStates.find(object);
+        return it != m_objectStates.end() ? it->second : 0;
+    }
+
+    void GameManager::setObjectState(uint16_t object, uint16_t state) {
+        if (getObjectState(object) == state) {
+            return;
+        }
+        if (state == 0) {
+            m_objectStates.erase(object);
+        } else {
+            m_objectStates[object] = state;
+        }
+        m_objectStateRevision++;
+    }
+
+    void GameManager::update() {
+        m_rooms.poll();
+        m_scripts.poll();
+    }
+
+    void GameManager::close() {
+        // The room jobs read the mapped files: stop them before unmapping
+        m_rooms.reset();
+        m_scripts.reset();
+        m_closeToken.cancel();
+        JobSystem::getInstance().wait(m_fileJobs);
+        m_closeToken = CancellationToken();
+        if (m_overlay.isDirty()) {
+            ConsoleView::warning("Discarded " + std::to_string(m_overlay.getBlockCount()) + " unsaved block edits of " + m_name);
+        }
+        m_overlay.reset(0);
+        m_references.clear();
+        m_referencesReady = false;
+        m_indices.clear();
+        m_files.clear();
+        m_archive.close();
+        m_path.clear();
+        m_name.clear();
+        m_scriptVersion = ScriptVersion::V5;
+        m_objectStates.clear();
+        m_objectStateRevision++;
+        m_generation++;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "BlockIndex.h"
+#include "GameArchive.h"
+#include "ReferenceIndex.h"
+#include "ResourceOverlay.h"
+#include "RoomPipeline.h"
+#include "ScriptDisassembler.h"
+#include "ScriptPipeline.h"
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // The game currently loaded into the editor: its resource files and a block index
+    // for each of them (file 0 is the index file, 1..n the data disks)
+    class GameManager {
+    public:
+        static GameManager& getInstance();
+
+        // Accepts the index or any data file of a game
+        bool open(const std::filesystem::path& path);
+        void close();
+
+        bool isOpen() const { return m_archive.isOpen(); }
+        const std::string& getName() const { return m_name; }
+        GameArchive& getArchive() { return m_archive; }
+
+        size_t getFileCount() const { return m_files.size(); }
+        ResourceFile& getFile(size_t file) { return *m_files[file]; }
+        const BlockIndex& getBlockIndex(size_t file) const { return *m_indices[file]; }
+
+        // Bytecode flavour: v6 games are told apart by the AARY block in their index
+        ScriptVersion getScriptVersion() const { return m_scriptVersion; }
+
+        // Every LFLF block of the data files, in file order
+        std::vector<RoomPipeline::Room> getRooms();
+
+        // Changes with every open/close, so caches keyed by it never mix games
+        uint32_t getGeneration() const { return m_generation; }
+
+        // Jobs outside the pipeline that read the mapped files count on this counter
+        // and check the token; close() cancels them and waits before unmapping
+        JobCounter& getFileJobs() { return m_fileJobs; }
+        const CancellationToken& getCloseToken() const { return m_closeToken; }
+
+        // Object states as the scripts would set them (the IMnn shown, 0 for none),
+        // edited by hand for previews. The revision changes with every edit.
+        uint16_t getObjectState(uint16_t object) const;
+        void setObjectState(uint16_t object, uint16_t state);
+        uint32_t getObjectStateRevision() const { return m_objectStateRevision; }
+
+        // Background decoding of every room (see RoomPipeline)
+        void decodeRooms();
+        RoomPipeline& getRoomPipeline() { return m_rooms; }
+
+        // Every script block of the data files, and background decompiling of them all
+        std::vector<ScriptPipeline::Script> getScripts();
+        void decompileScripts();
+        ScriptPipeline& getScriptPipeline() { return m_scripts; }
+
+        // Decompiled source of a loaded script, shared with the batch cache; done runs on
+        // the main thread, at once on a cache hit (see ScriptPipeline::decompile)
+        void decompileScript(const ScriptDisassembler& script, std::function<void(ScriptPipeline::Listing)> done);
+
+        // Which scripts use a variable, object, room or script number. The indices are
+        // built (or mapped from the cache) in the background after open; queries find
+        // nothing until they are ready.
+        struct ScriptReference {
+            size_t file;
+            uint32_t record;            // Script block in the file's BlockIndex
+            uint32_t offset;            // Instruction, block-relative
+        };
+        bool areReferencesReady() const { return m_referencesReady; }
+        std::vector<ScriptReference> findReferences(ReferenceIndex::SymbolKind kind, uint16_t number) const;
+
+        // Edited blocks stay in an overlay over the mapped files until save(). readBlock()
+        // sees the edits; rooms, references and the batch decompiler read the files
+        // as they are on disk. The original bytes drop an edit again.
+        bool editBlock(size_t file, uint32_t record, std::span<const uint8_t> block, std::string& error);
+        std::span<const uint8_t> readBlock(size_t file, uint32_t record);
+        bool hasUnsavedChanges() const { return m_overlay.isDirty(); }
+        const ResourceOverlay& getOverlay() const { return m_overlay; }
+
+        // Streams every changed file anew next to the original, swaps them in and
+        // reopens the game; EventGameSaved tells open views where their blocks went
+        bool save();
+
+        // Main thread, once per frame
+        void update();
+
+        static std::filesystem::path getCacheDirectory() { return "cache/blocks"; }
+        std::filesystem::path getScriptCachePath() const { return std::filesystem::path("cache/scripts") / (m_name + ".scripts"); }
+
+    private:
+        GameManager() = default;
+
+        void indexReferences();
+
+        GameArchive m_archive;
+        std::filesystem::path m_path;       // As opened
+        std::string m_name;
+        std::vector<ResourceFile*> m_files;
+        std::vector<std::unique_ptr<BlockIndex>> m_indices;
+        std::vector<std::unique_ptr<ReferenceIndex>> m_references;     // Per file; the index file has no scripts
+        bool m_referencesReady = false;
+        RoomPipeline m_rooms;
+        ScriptPipeline m_scripts;
+        uint32_t m_generation = 0;
+        ScriptVersion m_scriptVersion = ScriptVersion::V5;
+        JobCounter m_fileJobs;
+        CancellationToken m_closeToken;
+        std::unordered_map<uint16_t, uint16_t> m_objectStates;
+        uint32_t m_objectStateRevision = 0;
+        ResourceOverlay m_overlay;
+        ResourceOverlay m_stranded;         // Edits of a failed save, taken up by the next open() of its path
+        std::filesystem::path m_strandedPath;
+    };
+
+} // namespace scummredux
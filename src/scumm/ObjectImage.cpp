@@ -0,0 +1,98 @@
+#include "ObjectImage.h"
+#include <algorithm>
+
+namespace scummredux {
+
+    namespace {
+        // IMHD: id, image count, z-plane count, flags, unused, x, y, width, height
+        constexpr size_t IMHD_SIZE = 16;
+
+        uint16_t readLE16(const uint8_t* data) {
+            return static_cast<uint16_t>(data[0] | (data[1] << 8));
+        }
+
+        // "IM0A" -> 10; IMHD is not an image
+        int getStateNumber(ChunkTag tag) {
+            if ((tag >> 16) != (makeTag("IM00") >> 16) || tag == tags::IMHD) {
+                return -1;
+            }
+            auto digit = [](char c) {
+                return c >= '0' && c <= '9' ? c - '0' : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+            };
+            const int high = digit(static_cast<char>((tag >> 8) & 0xFF));
+            const int low = digit(static_cast<char>(tag & 0xFF));
+            return high < 0 || low < 0 ? -1 : high * 16 + low;
+        }
+
+        bool loadState(ResourceFile& file, const Chunk& image, const ObjectImage& object, uint8_t transparentColor,
+                       ObjectImage::State& state, std::string& error) {
+            const Chunk smap = file.findChild(image, tags::SMAP);
+            if (!smap.valid()) {
+                error = "missing SMAP in " + tagToString(image.tag);
+                return false;
+            }
+
+            // Transparent strips skip their transparent pixels, so those keep the fill
+            state.image.resize(object.width, object.height, transparentColor);
+            const SmapDecoder::Result result = SmapDecoder::decode(file.view(smap.offset, smap.size), state.image, false,
+                                                                   transparentColor);
+            if (!result.ok()) {
+                error = result.error.empty() ? tagToString(image.tag) + ": undecodable strips" : result.error;
+                return false;
+            }
+
+            state.opaque.resize(object.width, object.height, true);
+            for (size_t strip = 0; strip < result.codecs.size(); strip++) {
+                if (!SmapDecoder::getCodecInfo(result.codecs[strip]).transparent) {
+                    continue;
+                }
+                const size_t left = strip * SmapDecoder::STRIP_WIDTH;
+                const size_t right = std::min<size_t>(left + SmapDecoder::STRIP_WIDTH, object.width);
+                for (size_t y = 0; y < object.height; y++) {
+                    const uint8_t* pixels = state.image.row(y);
+                    uint8_t bits = 0;
+                    for (size_t x = left; x < right; x++) {
+                        bits |= pixels[x] != transparentColor ? 0x80 >> (x - left) : 0;
+                    }
+                    state.opaque.row(y)[strip] = bits;
+                }
+            }
+
+            state.zplanes = ZPlaneDecoder::loadAll(file, image, object.width, object.height);
+            return true;
+        }
+    } // namespace
+
+    bool ObjectImage::load(ResourceFile& file, const Chunk& obim, uint8_t transparentColor, ObjectImage& object,
+                           std::string& error) {
+        const Chunk imhd = file.findChild(obim, tags::IMHD);
+        const auto header = imhd.valid() ? file.data(imhd) : std::span<const uint8_t>{};
+        if (header.size() < IMHD_SIZE) {
+            error = "missing IMHD";
+            return false;
+        }
+        object.id = readLE16(header.data());
+        object.x = static_cast<int16_t>(readLE16(header.data() + 8));
+        object.y = static_cast<int16_t>(readLE16(header.data() + 10));
+        object.width = readLE16(header.data() + 12);
+        object.height = readLE16(header.data() + 14);
+        object.states.clear();
+        if (object.width == 0 || object.height == 0) {
+            return true;                    // Hotspot without an image
+        }
+
+        bool ok = true;
+        file.forEachChild(obim, [&](const Chunk& chunk) {
+            const int number = getStateNumber(chunk.tag);
+            if (number < 1 || !ok) {
+                return;
+            }
+            if (object.states.size() < static_cast<size_t>(number)) {
+                object.states.resize(number);
+            }
+            ok = loadState(file, chunk, object, transparentColor, object.states[number - 1], error);
+        });
+        return ok;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ResourceFile.h"
+#include "SmapDecoder.h"
+#include "ZPlane.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // The images of one room object (OBIM). An object shows the image of its
+    // current state (IMnn for state n) at a fixed place in the room; state 0 shows
+    // nothing. Each state carries its own z-planes, which replace the room's under it.
+    struct ObjectImage {
+        struct State {
+            IndexedImage image;
+            BitMask opaque;                 // Pixels the image actually covers
+            std::vector<BitMask> zplanes;
+        };
+
+        uint16_t id = 0;
+        std::string name;                   // From the matching OBCD, if any
+        int16_t x = 0;
+        int16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        std::vector<State> states;          // states[n - 1] is IMnn
+
+        // IMHD placement plus the SMAP and z-planes of every IMnn. Strips with
+        // transparent codecs leave transparentColor pixels out of the opaque mask.
+        static bool load(ResourceFile& file, const Chunk& obim, uint8_t transparentColor, ObjectImage& object,
+                         std::string& error);
+    };
+
+} // namespace scummredux
@@ -0,0 +1,129 @@
+#include "Palette.h"
+#include "../utils/Simd.h"
+#include <algorithm>
+
+namespace scummredux {
+
+    namespace {
+
+        void toRGBAScalar(const uint32_t* table, const uint8_t* indices, uint32_t* pixels, size_t count) {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                pixels[i] = table[indices[i]];
+                pixels[i + 1] = table[indices[i + 1]];
+                pixels[i + 2] = table[indices[i + 2]];
+                pixels[i + 3] = table[indices[i + 3]];
+            }
+            for (; i < count; i++) {
+                pixels[i] = table[indices[i]];
+            }
+        }
+
+#ifdef SCUMMREDUX_SIMD_X86
+
+        // Two independent 8-wide gathers per iteration hide most of their latency
+        SCUMMREDUX_TARGET_AVX2
+        void toRGBAAVX2(const uint32_t* table, const uint8_t* indices, uint32_t* pixels, size_t count) {
+            const int* base = reinterpret_cast<const int*>(table);
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+                const __m256i low = _mm256_cvtepu8_epi32(bytes);
+                const __m256i high = _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), _mm256_i32gather_epi32(base, low, 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i + 8), _mm256_i32gather_epi32(base, high, 4));
+            }
+            toRGBAScalar(table, indices + i, pixels + i, count - i);
+        }
+
+#endif
+
+#if defined(SCUMMREDUX_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+
+        // One 256-byte table per channel, looked up 64 entries at a time (TBL yields 0
+        // for out-of-range indices, so the four quarters can be OR-ed), then stored
+        // interleaved as RGBA
+        void toRGBANEON(const uint32_t* table, const uint8_t* indices, uint32_t* pixels, size_t count) {
+            alignas(16) uint8_t planes[4][Palette::SIZE];
+            for (size_t color = 0; color < Palette::SIZE; color++) {
+                for (size_t channel = 0; channel < 4; channel++) {
+                    planes[channel][color] = static_cast<uint8_t>(table[color] >> (8 * channel));
+                }
+            }
+
+            uint8x16x4_t quarters[4][4];
+            for (size_t channel = 0; channel < 4; channel++) {
+                for (size_t quarter = 0; quarter < 4; quarter++) {
+                    const uint8_t* source = planes[channel] + quarter * 64;
+                    quarters[channel][quarter] = {{vld1q_u8(source), vld1q_u8(source + 16), vld1q_u8(source + 32),
+                                                   vld1q_u8(source + 48)}};
+                }
+            }
+
+            const uint8x16_t step = vdupq_n_u8(64);
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const uint8x16_t index0 = vld1q_u8(indices + i);
+                const uint8x16_t index1 = vsubq_u8(index0, step);
+                const uint8x16_t index2 = vsubq_u8(index1, step);
+                const uint8x16_t index3 = vsubq_u8(index2, step);
+
+                uint8x16x4_t rgba;
+                for (size_t channel = 0; channel < 4; channel++) {
+                    const uint8x16_t a = vqtbl4q_u8(quarters[channel][0], index0);
+                    const uint8x16_t b = vqtbl4q_u8(quarters[channel][1], index1);
+                    const uint8x16_t c = vqtbl4q_u8(quarters[channel][2], index2);
+                    const uint8x16_t d = vqtbl4q_u8(quarters[channel][3], index3);
+                    rgba.val[channel] = vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d));
+                }
+                vst4q_u8(reinterpret_cast<uint8_t*>(pixels + i), rgba);
+            }
+            toRGBAScalar(table, indices + i, pixels + i, count - i);
+        }
+
+#define SCUMMREDUX_PALETTE_NEON 1
+#endif
+
+    } // namespace
+
+    Palette Palette::fromRGB(std::span<const uint8_t> rgb) {
+        Palette palette;
+        const size_t count = std::min(SIZE, rgb.size() / 3);
+        for (size_t i = 0; i < count; i++) {
+            palette.colors[i] = pack(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+        }
+        for (size_t i = count; i < SIZE; i++) {
+            palette.colors[i] = pack(0, 0, 0);
+        }
+        return palette;
+    }
+
+    bool Palette::load(ResourceFile& file, const Chunk& room, Palette& palette) {
+        Chunk block = file.findChild(room, tags::CLUT);
+        if (!block.valid()) {
+            const Chunk pals = file.findChild(room, tags::PALS);
+            const Chunk wrap = pals.valid() ? file.findChild(pals, tags::WRAP) : Chunk{};
+            block = wrap.valid() ? file.findChild(wrap, tags::APAL) : Chunk{};
+        }
+        if (!block.valid()) {
+            return false;
+        }
+
+        palette = fromRGB(file.data(block));
+        return true;
+    }
+
+    void Palette::toRGBA(const uint8_t* indices, uint32_t* pixels, size_t count) const {
+#if defined(SCUMMREDUX_SIMD_X86)
+        if (cpuHasAVX2()) {
+            toRGBAAVX2(colors.data(), indices, pixels, count);
+            return;
+        }
+#elif defined(SCUMMREDUX_PALETTE_NEON)
+        toRGBANEON(colors.data(), indices, pixels, count);
+        return;
+#endif
+        toRGBAScalar(colors.data(), indices, pixels, count);
+    }
+
+} // namespace scummredux
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ResourceFile.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace scummredux {
+
+    // 256 colors packed as RGBA bytes in memory (R in the low byte on little-endian
+    // targets), ready for GL_RGBA/GL_UNSIGNED_BYTE uploads
+    struct Palette {
+        static constexpr size_t SIZE = 256;
+
+        std::array<uint32_t, SIZE> colors{};
+
+        static constexpr uint32_t pack(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 0xFF) {
+            return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) | (static_cast<uint32_t>(b) << 16) |
+                   (static_cast<uint32_t>(a) << 24);
+        }
+
+        // 3 bytes per color; missing entries stay black
+        static Palette fromRGB(std::span<const uint8_t> rgb);
+
+        // The room's palette: CLUT (v5) or the first APAL of PALS (v6)
+        static bool load(ResourceFile& file, const Chunk& room, Palette& palette);
+
+        // Expands palette indices to RGBA pixels. Uses AVX2 gathers or NEON table
+        // lookups where available.
+        void toRGBA(const uint8_t* indices, uint32_t* pixels, size_t count) const;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,120 @@
+#include "PaletteCycler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace scummredux {
+
+    namespace {
+        constexpr size_t MAX_CYCLES = 16;
+
+        uint16_t readBE16(const uint8_t* data) {
+            return static_cast<uint16_t>((data[0] << 8) | data[1]);
+        }
+    } // namespace
+
+    std::vector<ColorCycle> PaletteCycler::parse(std::span<const uint8_t> data) {
+        std::vector<ColorCycle> cycles;
+        size_t position = 0;
+        while (position + 9 <= data.size() && data[position] != 0) {
+            const uint8_t index = data[position];
+            const uint16_t rate = readBE16(&data[position + 3]);
+            const uint16_t flags = readBE16(&data[position + 5]);
+            const uint8_t start = data[position + 7];
+            const uint8_t end = data[position + 8];
+            position += 9;
+
+            // Unused slots have no rate; the delay is in 60 Hz ticks
+            const uint16_t delay = rate ? static_cast<uint16_t>(16384 / rate) : 0;
+            if (index > MAX_CYCLES || delay == 0 || start >= end) {
+                continue;
+            }
+            cycles.push_back({start, end, delay, (flags & 2) != 0});
+        }
+        return cycles;
+    }
+
+    void PaletteCycler::reset(const Palette& base, std::vector<ColorCycle> cycles, const IndexedImage& image) {
+        m_palette = base;
+        m_cycles.clear();
+        if (cycles.size() > MAX_CYCLES) {
+            cycles.resize(MAX_CYCLES);
+        }
+
+        for (const ColorCycle& cycle : cycles) {
+            m_cycles.push_back({cycle, 0.0, {}});
+        }
+        scanRows(image);
+    }
+
+    void PaletteCycler::rescan(const IndexedImage& image) {
+        scanRows(image);
+    }
+
+    void PaletteCycler::scanRows(const IndexedImage& image) {
+        // Which cycles own each color, then one pass over the image for their rows
+        uint16_t owners[Palette::SIZE] = {};
+        for (size_t i = 0; i < m_cycles.size(); i++) {
+            for (size_t color = m_cycles[i].cycle.start; color <= m_cycles[i].cycle.end; color++) {
+                owners[color] |= static_cast<uint16_t>(1u << i);
+            }
+            m_cycles[i].rows = {};
+        }
+
+        for (uint16_t y = 0; y < image.height; y++) {
+            const uint8_t* row = image.row(y);
+            uint16_t used = 0;
+            for (size_t x = 0; x < image.width; x++) {
+                used |= owners[row[x]];
+            }
+            for (size_t i = 0; used != 0; i++, used >>= 1) {
+                if (used & 1) {
+                    m_cycles[i].rows.merge({y, 1});
+                }
+            }
+        }
+    }
+
+    void PaletteCycler::clear() {
+        m_cycles.clear();
+    }
+
+    PaletteCycler::Rows PaletteCycler::advance(double ticks) {
+        Rows dirty;
+        for (State& state : m_cycles) {
+            state.counter += ticks;
+            if (state.counter < state.cycle.delay) {
+                continue;
+            }
+
+            // Like the engine: one step per update, however late it is
+            state.counter = std::fmod(state.counter, static_cast<double>(state.cycle.delay));
+            rotate(state.cycle);
+            dirty.merge(state.rows);
+        }
+        return dirty;
+    }
+
+    PaletteCycler::Rows PaletteCycler::getCycledRows() const {
+        Rows rows;
+        for (const State& state : m_cycles) {
+            rows.merge(state.rows);
+        }
+        return rows;
+    }
+
+    void PaletteCycler::rotate(const ColorCycle& cycle) {
+        uint32_t* colors = m_palette.colors.data();
+        const size_t count = cycle.end - cycle.start;
+        if (cycle.reverse) {
+            const uint32_t first = colors[cycle.start];
+            std::memmove(colors + cycle.start, colors + cycle.start + 1, count * sizeof(uint32_t));
+            colors[cycle.end] = first;
+        } else {
+            const uint32_t last = colors[cycle.end];
+            std::memmove(colors + cycle.start + 1, colors + cycle.start, count * sizeof(uint32_t));
+            colors[cycle.start] = last;
+        }
+    }
+
+} // namespace scummredux
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Palette.h"
+#include "SmapDecoder.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace scummredux {
+
+    // One CYCL entry: colors [start, end] rotate by one slot every delay ticks (60 Hz)
+    struct ColorCycle {
+        uint8_t start = 0;
+        uint8_t end = 0;
+        uint16_t delay = 0;
+        bool reverse = false;
+    };
+
+    // Animates a room palette the way the engine does. The indexed image stays the
+    // source of truth: reset() records which rows use each cycle's colors, and every
+    // advance() reports the rows whose RGBA pixels changed, so only those are
+    // converted and re-uploaded.
+    class PaletteCycler {
+    public:
+        using Rows = RowRange;
+
+        // CYCL payload: entries of {index, 2 unknown bytes, BE16 rate, BE16 flags, start, end}
+        // terminated by a zero index
+        static std::vector<ColorCycle> parse(std::span<const uint8_t> data);
+
+        void reset(const Palette& base, std::vector<ColorCycle> cycles, const IndexedImage& image);
+        void clear();
+
+        // Steps every cycle whose delay elapsed; returns the image rows to refresh
+        Rows advance(double ticks);
+
+        // Rows touched by any cycle (what has to be refreshed after reset)
+        Rows getCycledRows() const;
+
+        // The image changed: finds the rows of every cycle again, keeping the
+        // rotated palette and the timing
+        void rescan(const IndexedImage& image);
+
+        bool isActive() const { return !m_cycles.empty(); }
+        const Palette& getPalette() const { return m_palette; }
+
+        static constexpr double TICKS_PER_SECOND = 60.0;
+
+    private:
+        struct State {
+            ColorCycle cycle;
+            double counter = 0.0;
+            Rows rows;                  // Image rows using the cycle's colors
+        };
+
+        void rotate(const ColorCycle& cycle);
+        void scanRows(const IndexedImage& image);
+
+        Palette m_palette;
+        std::vector<State> m_cycles;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,257 @@
+#include "ReferenceIndex.h"
+#include "../core/TraceRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace scummredux {
+
+    namespace {
+
+        constexpr char CACHE_MAGIC[4] = {'S', 'R', 'X', 'R'};
+
+        // Every possible symbol, for the dense counting arrays of a build
+        constexpr size_t SYMBOL_SPACE = (static_cast<size_t>(ScriptDisassembler::SymbolKind::Script) + 1) << 16;
+
+        bool sameUse(const ScriptDisassembler::Reference& a, const ScriptDisassembler::Reference& b) {
+            return a.kind == b.kind && a.number == b.number && a.offset == b.offset;
+        }
+
+    } // namespace
+
+    bool ReferenceIndex::open(ResourceFile& file, const BlockIndex& blocks, ScriptVersion version, const CancellationToken& token) {
+        close();
+        if (!blocks.isOpen()) {
+            return false;
+        }
+
+        const std::filesystem::path cachePath = getCachePath(blocks);
+        if (!cachePath.empty() && load(cachePath, blocks, version)) {
+            m_cached = true;
+        } else {
+            if (!build(file, blocks, version, token)) {
+                close();
+                return false;
+            }
+            m_symbols = m_builtSymbols;
+            m_starts = m_builtStarts;
+            m_postings = m_builtPostings;
+            if (!cachePath.empty()) {
+                save(cachePath, blocks, version);
+            }
+        }
+
+        m_open = true;
+        return true;
+    }
+
+    void ReferenceIndex::close() {
+        m_symbols = {};
+        m_starts = {};
+        m_postings = {};
+        m_builtSymbols = {};
+        m_builtStarts = {};
+        m_builtPostings = {};
+        m_mapped.close();
+        m_open = false;
+        m_cached = false;
+    }
+
+    std::span<const ReferenceIndex::Posting> ReferenceIndex::find(SymbolKind kind, uint16_t number) const {
+        const uint32_t symbol = makeSymbol(kind, number);
+        const auto it = std::lower_bound(m_symbols.begin(), m_symbols.end(), symbol);
+        if (it == m_symbols.end() || *it != symbol) {
+            return {};
+        }
+        const size_t index = static_cast<size_t>(it - m_symbols.begin());
+        return m_postings.subspan(m_starts[index], m_starts[index + 1] - m_starts[index]);
+    }
+
+    bool ReferenceIndex::parseKind(std::string_view name, SymbolKind& kind) {
+        for (const SymbolKind candidate : {SymbolKind::Variable, SymbolKind::BitVariable, SymbolKind::Object,
+                                           SymbolKind::Room, SymbolKind::Script}) {
+            if (name == getKindName(candidate)) {
+                kind = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* ReferenceIndex::getKindName(SymbolKind kind) {
+        switch (kind) {
+            case SymbolKind::Variable: return "var";
+            case SymbolKind::BitVariable: return "bit";
+            case SymbolKind::Object: return "object";
+            case SymbolKind::Room: return "room";
+            case SymbolKind::Script: return "script";
+        }
+        return "?";
+    }
+
+    std::string ReferenceIndex::formatSymbol(SymbolKind kind, uint16_t number) {
+        switch (kind) {
+            case SymbolKind::Variable: return "Var[" + std::to_string(number) + "]";
+            case SymbolKind::BitVariable: return "Bit[" + std::to_string(number) + "]";
+            case SymbolKind::Object: return "Object " + std::to_string(number);
+            case SymbolKind::Room: return "Room " + std::to_string(number);
+            case SymbolKind::Script: return "Script " + std::to_string(number);
+        }
+        return std::to_string(number);
+    }
+
+    std::filesystem::path ReferenceIndex::getCachePath(const BlockIndex& blocks) {
+        std::filesystem::path path = blocks.getCacheFile();
+        if (!path.empty()) {
+            path.replace_extension(".refs");
+        }
+        return path;
+    }
+
+    bool ReferenceIndex::build(ResourceFile& file, const BlockIndex& blocks, ScriptVersion version, const CancellationToken& token) {
+        SCUMM_TRACE_SCOPE("buildReferenceIndex", "scripts");
+        std::vector<uint32_t> scripts;
+        for (uint32_t record = 0; record < blocks.size(); record++) {
+            if (ScriptDisassembler::isScriptBlock(blocks.get(record).tag)) {
+                scripts.push_back(record);
+            }
+        }
+
+        // One list per script, each sorted by symbol with repeats in one instruction dropped
+        std::vector<std::vector<ScriptDisassembler::Reference>> found(scripts.size());
+        JobSystem::getInstance().parallelFor(scripts.size(), [&](size_t i) {
+            if (token.isCancelled()) {
+                return;
+            }
+            const BlockIndex::Record& block = blocks.get(scripts[i]);
+            ScriptDisassembler script;
+            std::string error;
+            if (!script.load(version, file.view(block.offset, block.size), error)) {
+                return;
+            }
+            auto& references = found[i];
+            script.collectReferences(references);
+            std::sort(references.begin(), references.end(), [](const auto& a, const auto& b) {
+                const uint32_t left = makeSymbol(a.kind, a.number);
+                const uint32_t right = makeSymbol(b.kind, b.number);
+                return left != right ? left < right : a.offset < b.offset;
+            });
+            references.erase(std::unique(references.begin(), references.end(), sameUse), references.end());
+        });
+        if (token.isCancelled()) {
+            return false;
+        }
+
+        // Counting sort into the flat layout; scripts go in record order, so every
+        // symbol's postings come out sorted by record, then offset
+        std::vector<uint32_t> counts(SYMBOL_SPACE, 0);
+        size_t total = 0;
+        for (const auto& references : found) {
+            for (const ScriptDisassembler::Reference& reference : references) {
+                counts[makeSymbol(reference.kind, reference.number)]++;
+            }
+            total += references.size();
+        }
+
+        m_builtSymbols.clear();
+        m_builtStarts.clear();
+        std::vector<uint32_t> cursors(SYMBOL_SPACE, 0);
+        uint32_t start = 0;
+        for (uint32_t symbol = 0; symbol < SYMBOL_SPACE; symbol++) {
+            if (counts[symbol] != 0) {
+                m_builtSymbols.push_back(symbol);
+                m_builtStarts.push_back(start);
+                cursors[symbol] = start;
+                start += counts[symbol];
+            }
+        }
+        m_builtStarts.push_back(start);
+
+        m_builtPostings.resize(total);
+        for (size_t i = 0; i < found.size(); i++) {
+            for (const ScriptDisassembler::Reference& reference : found[i]) {
+                m_builtPostings[cursors[makeSymbol(reference.kind, reference.number)]++] = {scripts[i], reference.offset};
+            }
+        }
+        return true;
+    }
+
+    bool ReferenceIndex::load(const std::filesystem::path& path, const BlockIndex& blocks, ScriptVersion version) {
+        if (!m_mapped.open(path)) {
+            return false;
+        }
+
+        FileHeader header;
+        if (m_mapped.size() < sizeof(header)) {
+            m_mapped.close();
+            return false;
+        }
+        std::memcpy(&header, m_mapped.data(), sizeof(header));
+
+        const size_t symbolBytes = size_t(header.symbolCount) * sizeof(uint32_t);
+        const size_t startBytes = (size_t(header.symbolCount) + 1) * sizeof(uint32_t);
+        const bool valid = std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                           header.version == VERSION && header.contentKey == blocks.getContentKey() &&
+                           header.scriptVersion == static_cast<uint8_t>(version) &&
+                           m_mapped.size() == sizeof(header) + symbolBytes + startBytes + size_t(header.postingCount) * sizeof(Posting);
+        if (!valid) {
+            m_mapped.close();
+            return false;
+        }
+
+        const uint8_t* data = m_mapped.data() + sizeof(header);
+        m_symbols = {reinterpret_cast<const uint32_t*>(data), header.symbolCount};
+        m_starts = {reinterpret_cast<const uint32_t*>(data + symbolBytes), header.symbolCount + size_t(1)};
+        m_postings = {reinterpret_cast<const Posting*>(data + symbolBytes + startBytes), header.postingCount};
+
+        // Guard the searches and the posting ranges against a damaged cache file
+        bool sound = m_starts.front() == 0 && m_starts.back() == header.postingCount;
+        for (size_t i = 0; sound && i < m_symbols.size(); i++) {
+            sound = m_starts[i] <= m_starts[i + 1] && (i == 0 || m_symbols[i - 1] < m_symbols[i]);
+        }
+        for (size_t i = 0; sound && i < m_postings.size(); i++) {
+            sound = m_postings[i].record < blocks.size() && m_postings[i].offset < blocks.get(m_postings[i].record).size;
+        }
+        if (!sound) {
+            m_symbols = {};
+            m_starts = {};
+            m_postings = {};
+            m_mapped.close();
+            return false;
+        }
+        return true;
+    }
+
+    bool ReferenceIndex::save(const std::filesystem::path& path, const BlockIndex& blocks, ScriptVersion version) const {
+        FileHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = VERSION;
+        header.contentKey = blocks.getContentKey();
+        header.symbolCount = static_cast<uint32_t>(m_symbols.size());
+        header.postingCount = static_cast<uint32_t>(m_postings.size());
+        header.scriptVersion = static_cast<uint8_t>(version);
+
+        // Written aside and renamed, so a reader never maps a half-written file
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                return false;
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(m_symbols.data()), static_cast<std::streamsize>(m_symbols.size_bytes()));
+            out.write(reinterpret_cast<const char*>(m_starts.data()), static_cast<std::streamsize>(m_starts.size_bytes()));
+            out.write(reinterpret_cast<const char*>(m_postings.data()), static_cast<std::streamsize>(m_postings.size_bytes()));
+            if (!out) {
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temporary, path, ec);
+        return !ec;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "BlockIndex.h"
+#include "ScriptDisassembler.h"
+#include "../core/JobSystem.h"
+#include "../core/MappedFile.h"
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scummredux {
+
+    // Where the scripts of one resource file use each global and bit variable, object,
+    // room and script number. Stored inverted and flat: sorted symbols, the start of
+    // each one's postings beside them, then all postings, so a query is one binary
+    // search. The arrays are cached next to the file's block index and, like it, used
+    // in place from the mapped file.
+    class ReferenceIndex {
+    public:
+        using SymbolKind = ScriptDisassembler::SymbolKind;
+
+        struct Posting {
+            uint32_t record;            // Script block in the file's BlockIndex
+            uint32_t offset;            // Instruction, block-relative
+        };
+        static_assert(sizeof(Posting) == 8, "Postings are stored as-is in the cache file");
+
+        ReferenceIndex() = default;
+
+        ReferenceIndex(const ReferenceIndex&) = delete;
+        ReferenceIndex& operator=(const ReferenceIndex&) = delete;
+
+        // Maps the cached index if it still matches the block index, otherwise
+        // disassembles every script in parallel and caches the result. Safe on a
+        // worker; false if cancelled.
+        bool open(ResourceFile& file, const BlockIndex& blocks, ScriptVersion version, const CancellationToken& token);
+        void close();
+
+        bool isOpen() const { return m_open; }
+        bool isCached() const { return m_cached; }
+
+        size_t getSymbolCount() const { return m_symbols.size(); }
+        size_t getPostingCount() const { return m_postings.size(); }
+
+        // Uses in record, then offset order
+        std::span<const Posting> find(SymbolKind kind, uint16_t number) const;
+
+        static uint32_t makeSymbol(SymbolKind kind, uint16_t number) {
+            return (static_cast<uint32_t>(kind) << 16) | number;
+        }
+
+        // "var", "bit", "object", "room", "script" as typed in the console
+        static bool parseKind(std::string_view name, SymbolKind& kind);
+        static const char* getKindName(SymbolKind kind);
+
+        // Var[12], Bit[3], Object 400, Room 7, Script 12
+        static std::string formatSymbol(SymbolKind kind, uint16_t number);
+
+    private:
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t contentKey;        // BlockIndex::getContentKey() it was built from
+            uint32_t symbolCount;
+            uint32_t postingCount;
+            uint8_t scriptVersion;
+            uint8_t reserved[7];
+        };
+        static_assert(sizeof(FileHeader) == 32);
+
+        static std::filesystem::path getCachePath(const BlockIndex& blocks);
+
+        bool load(const std::filesystem::path& path, const BlockIndex& blocks, ScriptVersion version);
+        bool save(const std::filesystem::path& path, const BlockIndex& blocks, ScriptVersion version) const;
+        bool build(ResourceFile& file, const BlockIndex& blocks, ScriptVersion version, const CancellationToken& token);
+
+        MappedFile m_mapped;                // Cache file backing the spans
+        std::vector<uint32_t> m_builtSymbols;   // Or a freshly built index
+        std::vector<uint32_t> m_builtStarts;
+        std::vector<Posting> m_builtPostings;
+        std::span<const uint32_t> m_symbols;
+        std::span<const uint32_t> m_starts;     // One more than symbols: postings of i are [starts[i], starts[i + 1])
+        std::span<const Posting> m_postings;
+        bool m_open = false;
+        bool m_cached = false;
+
+        static constexpr uint32_t VERSION = 1;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,201 @@
+#include "ResourceFile.h"
+#include "XorCipher.h"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <thread>
+
+namespace scummredux {
+
+    namespace {
+
+        uint32_t readBE32(const uint8_t* data) {
+            return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+                   (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+        }
+
+        // Tags are upper-case letters and digits, padded with spaces ("SOU ")
+        bool isTagChar(uint8_t c) {
+            return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == ' ';
+        }
+
+    } // namespace
+
+    bool ResourceFile::open(const std::filesystem::path& path, std::optional<uint8_t> key) {
+        close();
+
+        // Private writable pages: decryption happens in place without touching the file
+        if (!m_file.open(path, MappedFile::Mode::CopyOnWrite)) {
+            return false;
+        }
+
+        m_path = path;
+        m_key = key ? *key : detectKey(m_file.data(), m_file.size());
+
+        const size_t pageSize = MappedFile::getPageSize();
+        m_pageShift = static_cast<size_t>(std::countr_zero(pageSize));
+        m_pageCount = (m_file.size() + pageSize - 1) >> m_pageShift;
+        m_decodedPages = 0;
+        if (m_key != NO_KEY) {
+            m_pageStates = std::make_unique<std::atomic<uint8_t>[]>(m_pageCount);
+        }
+        return true;
+    }
+
+    void ResourceFile::close() {
+        m_file.close();
+        m_path.clear();
+        m_pageStates.reset();
+        m_pageCount = 0;
+        m_decodedPages = 0;
+        m_key = NO_KEY;
+    }
+
+    std::span<const uint8_t> ResourceFile::view(size_t offset, size_t size) {
+        if (!isOpen() || offset > m_file.size() || size > m_file.size() - offset) {
+            return {};
+        }
+        if (size == 0) {
+            return {m_file.data() + offset, 0};
+        }
+
+        if (m_key != NO_KEY) {
+            decodePages(offset >> m_pageShift, (offset + size - 1) >> m_pageShift);
+        }
+        return {m_file.data() + offset, size};
+    }
+
+    void ResourceFile::decodePages(size_t first, size_t last) {
+        auto claim = [this](size_t page) {
+            uint8_t expected = PAGE_ENCRYPTED;
+            return m_pageStates[page].compare_exchange_strong(expected, PAGE_DECODING, std::memory_order_acquire);
+        };
+
+        for (size_t page = first; page <= last;) {
+            if (m_pageStates[page].load(std::memory_order_acquire) == PAGE_READY) {
+                page++;
+                continue;
+            }
+
+            // Claim a run of consecutive encrypted pages and decode it with one kernel call
+            size_t runEnd = page;
+            while (runEnd <= last && claim(runEnd)) {
+                runEnd++;
+            }
+
+            if (runEnd == page) {
+                // Another thread is decoding this page
+                while (m_pageStates[page].load(std::memory_order_acquire) != PAGE_READY) {
+                    std::this_thread::yield();
+                }
+                page++;
+                continue;
+            }
+
+            const size_t begin = page << m_pageShift;
+            const size_t end = std::min(runEnd << m_pageShift, m_file.size());
+            XorCipher::apply(m_file.mutableData() + begin, end - begin, m_key);
+
+            for (size_t done = page; done < runEnd; done++) {
+                m_pageStates[done].store(PAGE_READY, std::memory_order_release);
+            }
+            m_decodedPages.fetch_add(runEnd - page, std::memory_order_relaxed);
+            page = runEnd;
+        }
+    }
+
+    uint8_t ResourceFile::detectKey(const uint8_t* data, size_t size) {
+        if (size < Chunk::HEADER_SIZE) {
+            return NO_KEY;
+        }
+
+        // The first block header must decode to a tag and a size that fits the file
+        for (uint8_t key : {NO_KEY, DEFAULT_KEY, uint8_t(0xFF)}) {
+            uint8_t header[Chunk::HEADER_SIZE];
+            for (size_t i = 0; i < Chunk::HEADER_SIZE; i++) {
+                header[i] = data[i] ^ key;
+            }
+
+            const uint32_t blockSize = readBE32(header + 4);
+            if (std::all_of(header, header + 4, isTagChar) && blockSize >= Chunk::HEADER_SIZE && blockSize <= size) {
+                return key;
+            }
+        }
+        return NO_KEY;
+    }
+
+    Chunk ResourceFile::readChunk(size_t offset) {
+        const auto header = view(offset, Chunk::HEADER_SIZE);
+        if (header.empty()) {
+            return {};
+        }
+
+        Chunk chunk;
+        chunk.tag = readBE32(header.data());
+        chunk.offset = static_cast<uint32_t>(offset);
+        chunk.size = readBE32(header.data() + 4);
+        if (chunk.size < Chunk::HEADER_SIZE || chunk.size > m_file.size() - offset ||
+            !std::all_of(header.begin(), header.begin() + 4, isTagChar)) {
+            return {};
+        }
+        return chunk;
+    }
+
+    std::vector<Chunk> ResourceFile::getTopLevel() {
+        std::vector<Chunk> chunks;
+        for (size_t offset = 0; offset + Chunk::HEADER_SIZE <= size();) {
+            const Chunk chunk = readChunk(offset);
+            if (!chunk.valid()) {
+                break;
+            }
+            chunks.push_back(chunk);
+            offset = chunk.end();
+        }
+        return chunks;
+    }
+
+    std::vector<Chunk> ResourceFile::getChildren(const Chunk& parent) {
+        std::vector<Chunk> children;
+        forEachChild(parent, [&](const Chunk& child) {
+            children.push_back(child);
+        });
+        return children;
+    }
+
+    Chunk ResourceFile::findChild(const Chunk& parent, ChunkTag tag) {
+        for (size_t offset = parent.dataOffset(); offset + Chunk::HEADER_SIZE <= parent.end();) {
+            const Chunk child = readChunk(offset);
+            if (!child.valid() || child.end() > parent.end()) {
+                break;
+            }
+            if (child.tag == tag) {
+                return child;
+            }
+            offset = child.end();
+        }
+        return {};
+    }
+
+    bool ResourceFile::isContainer(ChunkTag tag) {
+        switch (tag) {
+            case tags::LECF:
+            case tags::LFLF:
+            case tags::ROOM:
+            case tags::RMIM:
+            case tags::PALS:
+            case tags::WRAP:
+            case tags::OBIM:
+            case tags::OBCD:
+            case tags::AKOS:
+                return true;
+            default:
+                break;
+        }
+
+        // IM00..IMFF image blocks hold SMAP/BOMP and their ZPnn masks (but IMHD is a header)
+        const std::string name = tagToString(tag);
+        return name[0] == 'I' && name[1] == 'M' && std::isxdigit(static_cast<unsigned char>(name[2])) &&
+               std::isxdigit(static_cast<unsigned char>(name[3]));
+    }
+
+} // namespace scummredux
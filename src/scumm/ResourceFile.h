@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Chunk.h"
+#include "../core/MappedFile.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace scummredux {
+
+    // Memory-mapped SCUMM index or data file. Opening only maps the file; the XOR
+    // encryption is undone in place (on private copy-on-write pages) one page at a
+    // time, the first time a view touches it. Chunks are plain offsets and their
+    // payloads are spans straight into the mapping, so nothing is copied or decoded
+    // upfront. Views may be requested from any thread.
+    class ResourceFile {
+    public:
+        static constexpr uint8_t NO_KEY = 0x00;
+        static constexpr uint8_t DEFAULT_KEY = 0x69;     // v5/v6 and HE games
+
+        ResourceFile() = default;
+
+        ResourceFile(const ResourceFile&) = delete;
+        ResourceFile& operator=(const ResourceFile&) = delete;
+
+        // Without an explicit key the file's first tag decides between plain and 0x69
+        bool open(const std::filesystem::path& path, std::optional<uint8_t> key = std::nullopt);
+        void close();
+
+        bool isOpen() const { return m_file.isOpen(); }
+        const std::filesystem::path& getPath() const { return m_path; }
+        size_t size() const { return m_file.size(); }
+        uint8_t getKey() const { return m_key; }
+
+        // Decrypted bytes of [offset, offset + size); empty if out of range
+        std::span<const uint8_t> view(size_t offset, size_t size);
+        std::span<const uint8_t> data(const Chunk& chunk) { return view(chunk.dataOffset(), chunk.dataSize()); }
+
+        // Block headers; an invalid Chunk is returned for garbage or truncated blocks
+        Chunk readChunk(size_t offset);
+        std::vector<Chunk> getTopLevel();
+        std::vector<Chunk> getChildren(const Chunk& parent);
+        Chunk findChild(const Chunk& parent, ChunkTag tag);
+
+        template<typename Fn>
+        void forEachChild(const Chunk& parent, Fn&& fn) {
+            for (size_t offset = parent.dataOffset(); offset + Chunk::HEADER_SIZE <= parent.end();) {
+                const Chunk child = readChunk(offset);
+                if (!child.valid() || child.end() > parent.end()) {
+                    break;
+                }
+                fn(child);
+                offset = child.end();
+            }
+        }
+
+        // Blocks whose payload is a list of blocks
+        static bool isContainer(ChunkTag tag);
+
+        // Statistics
+        size_t getPageCount() const { return m_pageCount; }
+        size_t getDecodedPageCount() const { return m_decodedPages.load(std::memory_order_relaxed); }
+
+    private:
+        enum PageState : uint8_t {
+            PAGE_ENCRYPTED,
+            PAGE_DECODING,
+            PAGE_READY
+        };
+
+        void decodePages(size_t first, size_t last);
+        static uint8_t detectKey(const uint8_t* data, size_t size);
+
+        std::filesystem::path m_path;
+        MappedFile m_file;
+        uint8_t m_key = NO_KEY;
+
+        std::unique_ptr<std::atomic<uint8_t>[]> m_pageStates;
+        size_t m_pageCount = 0;
+        size_t m_pageShift = 12;
+        std::atomic<size_t> m_decodedPages = 0;
+    };
+
+} // namespace scummredux
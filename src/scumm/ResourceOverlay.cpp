@@ -0,0 +1,585 @@
+#include "ResourceOverlay.h"
+#include "XorCipher.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace scummredux {
+
+    namespace {
+
+        uint32_t readBE32(const uint8_t* data) {
+            return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+                   (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+        }
+
+        uint32_t readLE32(const uint8_t* data) {
+            return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                   (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        }
+
+        bool isResourceDirectory(ChunkTag tag) {
+            return tag == tags::DSCR || tag == tags::DSOU || tag == tags::DCOS || tag == tags::DCHR;
+        }
+
+        std::string formatOffset(uint32_t offset) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "0x%08X", offset);
+            return text;
+        }
+
+        constexpr char JOURNAL_MAGIC[4] = {'S', 'R', 'J', 'N'};
+
+        std::filesystem::path getJournalPath(const std::filesystem::path& indexPath) {
+            std::filesystem::path journal = indexPath;
+            journal += ".journal";
+            return journal;
+        }
+
+        template<typename T>
+        void appendValue(std::vector<uint8_t>& out, const T& value) {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        // Closing a stream leaves its data in the OS cache; this waits until it is on disk
+        bool syncFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+            const HANDLE handle = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            const bool synced = FlushFileBuffers(handle) != 0;
+            CloseHandle(handle);
+            return synced;
+#else
+            const int fd = ::open(path.c_str(), O_RDWR);
+            if (fd < 0) {
+                return false;
+            }
+            const bool synced = ::fsync(fd) == 0;
+            ::close(fd);
+            return synced;
+#endif
+        }
+
+        // Block bytes as they are on disk (encrypted), to write over a block or put it back
+        struct JournalEntry {
+            std::filesystem::path target;
+            uint64_t offset;
+            std::vector<uint8_t> bytes;
+        };
+
+        bool writeBlocks(const std::vector<JournalEntry>& entries, std::string& error) {
+            for (size_t begin = 0; begin < entries.size();) {
+                const std::filesystem::path& target = entries[begin].target;
+                std::fstream stream(target, std::ios::in | std::ios::out | std::ios::binary);
+                if (!stream) {
+                    error = "cannot open " + target.string() + " for writing";
+                    return false;
+                }
+                for (; begin < entries.size() && entries[begin].target == target; begin++) {
+                    stream.seekp(static_cast<std::streamoff>(entries[begin].offset));
+                    stream.write(reinterpret_cast<const char*>(entries[begin].bytes.data()),
+                                 static_cast<std::streamsize>(entries[begin].bytes.size()));
+                }
+                stream.close();
+                if (!stream || !syncFile(target)) {
+                    error = "failed to write " + target.string();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    } // namespace
+
+    void ResourceOverlay::reset(size_t fileCount) {
+        rollback();
+        m_files.assign(fileCount, {});
+        m_blockCount = 0;
+        m_committed = false;
+        m_fixupCount = 0;
+        m_writtenBytes = 0;
+        m_writtenFiles = 0;
+    }
+
+    bool ResourceOverlay::set(size_t file, const BlockIndex& blocks, uint32_t record, std::span<const uint8_t> original,
+                              std::span<const uint8_t> block, std::string& error) {
+        if (file >= m_files.size() || record >= blocks.size()) {
+            error = "no such block in the open game";
+            return false;
+        }
+        const BlockIndex::Record& target = blocks.get(record);
+        if (block.size() < Chunk::HEADER_SIZE || readBE32(block.data()) != target.tag || readBE32(block.data() + 4) != block.size()) {
+            error = "the new block does not have a " + tagToString(target.tag) + " header of its size";
+            return false;
+        }
+
+        // Blocks are nested or apart: an edit inside another one would be written twice
+        auto& edits = m_files[file];
+        for (const auto& [offset, edit] : edits) {
+            if (edit.record != record && offset < uint64_t(target.offset) + target.size && target.offset < uint64_t(offset) + edit.size) {
+                error = "it overlaps the edited " + tagToString(blocks.get(edit.record).tag) + " at " + formatOffset(offset);
+                return false;
+            }
+        }
+
+        const auto existing = edits.find(target.offset);
+        if (std::equal(original.begin(), original.end(), block.begin(), block.end())) {
+            if (existing != edits.end()) {
+                edits.erase(existing);
+                m_blockCount--;
+            }
+            return true;
+        }
+        if (existing == edits.end()) {
+            m_blockCount++;
+        }
+        edits[target.offset] = Block{record, target.offset, target.size, {block.begin(), block.end()}};
+        return true;
+    }
+
+    const ResourceOverlay::Block* ResourceOverlay::find(size_t file, uint32_t offset) const {
+        if (file >= m_files.size()) {
+            return nullptr;
+        }
+        const auto it = m_files[file].find(offset);
+        return it != m_files[file].end() ? &it->second : nullptr;
+    }
+
+    int64_t ResourceOverlay::getDelta(size_t file, uint64_t begin, uint64_t end) const {
+        int64_t delta = 0;
+        if (file < m_files.size()) {
+            const auto& edits = m_files[file];
+            for (auto it = edits.lower_bound(static_cast<uint32_t>(std::min<uint64_t>(begin, UINT32_MAX)));
+                 it != edits.end() && it->first < end; ++it) {
+                delta += static_cast<int64_t>(it->second.bytes.size()) - it->second.size;
+            }
+        }
+        return delta;
+    }
+
+    uint32_t ResourceOverlay::relocate(size_t file, uint32_t offset) const {
+        return static_cast<uint32_t>(offset + getDelta(file, 0, offset));
+    }
+
+    bool ResourceOverlay::prepare(std::span<ResourceFile* const> files, std::span<const std::unique_ptr<BlockIndex>> indices,
+                                  std::string& error) {
+        rollback();
+        m_inPlace = false;
+        m_committed = false;
+        m_fixupCount = 0;
+        m_writtenBytes = 0;
+        m_writtenFiles = 0;
+        if (files.size() != m_files.size() || indices.size() != m_files.size()) {
+            error = "the overlay does not belong to the open game";
+            return false;
+        }
+
+        // Same sizes move nothing: commit() writes the blocks over the old ones
+        const bool sameSize = std::all_of(m_files.begin(), m_files.end(), [](const auto& edits) {
+            return std::all_of(edits.begin(), edits.end(), [](const auto& edit) {
+                return edit.second.bytes.size() == edit.second.size;
+            });
+        });
+        if (sameSize) {
+            for (size_t file = 0; file < files.size(); file++) {
+                if (!m_files[file].empty()) {
+                    m_prepared.push_back({{}, files[file]->getPath(), {}, file, files[file]->size(), files[file]->getKey()});
+                    m_writtenFiles++;
+                }
+            }
+            m_indexPath = files[0]->getPath();
+            m_inPlace = true;
+            return true;
+        }
+
+        auto addBE32 = [](std::vector<Fixup>& fixups, uint64_t offset, uint32_t value) {
+            fixups.push_back({offset, {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+                                       static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)}});
+        };
+        auto addLE32 = [](std::vector<Fixup>& fixups, uint64_t offset, uint32_t value) {
+            fixups.push_back({offset, {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                                       static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)}});
+        };
+
+        struct Room {
+            size_t file;
+            uint32_t offset;
+        };
+        std::unordered_map<uint8_t, Room> rooms;
+        std::vector<std::vector<Fixup>> fixups(files.size());
+        for (size_t file = 1; file < files.size(); file++) {
+            ResourceFile& data = *files[file];
+            const BlockIndex& blocks = *indices[file];
+            if (data.size() + getDelta(file, 0, UINT64_MAX) > UINT32_MAX) {
+                error = data.getPath().filename().string() + " would outgrow 32-bit offsets";
+                return false;
+            }
+
+            // Every block around an edited one grows or shrinks with it
+            std::set<uint32_t> ancestors;
+            for (const auto& [offset, edit] : m_files[file]) {
+                for (uint32_t parent = blocks.get(edit.record).parent; parent != BlockIndex::INVALID_INDEX;
+                     parent = blocks.get(parent).parent) {
+                    ancestors.insert(parent);
+                }
+            }
+            for (uint32_t parent : ancestors) {
+                const BlockIndex::Record& ancestor = blocks.get(parent);
+                const int64_t delta = getDelta(file, ancestor.offset, uint64_t(ancestor.offset) + ancestor.size);
+                if (delta != 0) {
+                    addBE32(fixups[file], ancestor.offset + 4, static_cast<uint32_t>(ancestor.size + delta));
+                }
+            }
+
+            // Rooms move with the edits before them
+            for (const BlockIndex::Record& loff : blocks.getRecords()) {
+                if (loff.tag != tags::LOFF) {
+                    continue;
+                }
+                const auto payload = data.view(loff.offset + Chunk::HEADER_SIZE, loff.size - Chunk::HEADER_SIZE);
+                const size_t count = payload.empty() ? 0 : std::min<size_t>(payload[0], (payload.size() - 1) / 5);
+                for (size_t i = 0; i < count; i++) {
+                    const size_t entry = 1 + i * 5;
+                    const uint32_t offset = readLE32(&payload[entry + 1]);
+                    rooms[payload[entry]] = {file, offset};
+                    const int64_t delta = getDelta(file, 0, offset);
+                    if (delta != 0) {
+                        addLE32(fixups[file], loff.offset + Chunk::HEADER_SIZE + entry + 1, static_cast<uint32_t>(offset + delta));
+                    }
+                }
+            }
+        }
+
+        // Resource directories: LE16 count, a room byte each, then an LE32 offset from
+        // the room's start each; only edits between the two move a resource in its room
+        ResourceFile& index = *files[0];
+        for (const BlockIndex::Record& directory : indices[0]->getRecords()) {
+            if (directory.depth != 0 || !isResourceDirectory(directory.tag)) {
+                continue;
+            }
+            const auto payload = index.view(directory.offset + Chunk::HEADER_SIZE, directory.size - Chunk::HEADER_SIZE);
+            if (payload.size() < 2) {
+                continue;
+            }
+            const size_t count = std::min<size_t>(payload[0] | (payload[1] << 8), (payload.size() - 2) / 5);
+            for (size_t i = 0; i < count; i++) {
+                const auto room = rooms.find(payload[2 + i]);
+                if (room == rooms.end()) {
+                    continue;
+                }
+                const size_t entry = 2 + count + i * 4;
+                const uint32_t offset = readLE32(&payload[entry]);
+                const int64_t delta = getDelta(room->second.file, room->second.offset, uint64_t(room->second.offset) + offset);
+                if (delta != 0) {
+                    addLE32(fixups[0], directory.offset + Chunk::HEADER_SIZE + entry, static_cast<uint32_t>(offset + delta));
+                }
+            }
+        }
+
+        // Data files first, the index that locates their resources last
+        for (size_t i = 1; i <= files.size(); i++) {
+            const size_t file = i % files.size();
+            if (m_files[file].empty() && fixups[file].empty()) {
+                continue;
+            }
+            if (!writeFile(*files[file], file, fixups[file], error)) {
+                rollback();
+                return false;
+            }
+            m_fixupCount += fixups[file].size();
+            m_writtenFiles++;
+        }
+        return true;
+    }
+
+    bool ResourceOverlay::writeFile(ResourceFile& file, size_t index, const std::vector<Fixup>& fixups, std::string& error) {
+        // One ordered pass over the file; fixups inside an edited block give way to it
+        const auto& edits = m_files[index];
+        std::vector<Splice> splices;
+        for (const auto& [offset, edit] : edits) {
+            splices.push_back({offset, edit.size, edit.bytes});
+        }
+        for (const Fixup& fixup : fixups) {
+            auto edit = edits.upper_bound(static_cast<uint32_t>(fixup.offset));
+            if (edit != edits.begin() && fixup.offset < uint64_t(std::prev(edit)->first) + std::prev(edit)->second.size) {
+                continue;
+            }
+            splices.push_back({fixup.offset, sizeof(fixup.bytes), fixup.bytes});
+        }
+        std::sort(splices.begin(), splices.end(), [](const Splice& a, const Splice& b) {
+            return a.offset < b.offset;
+        });
+
+        std::filesystem::path temporary = file.getPath();
+        temporary += ".tmp";
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            error = "cannot create " + temporary.string();
+            return false;
+        }
+        std::filesystem::path backup = file.getPath();
+        backup += ".bak";
+        m_prepared.push_back({temporary, file.getPath(), backup, index, file.size(), file.getKey()});
+
+        // Resolved once: every chunk goes through the same SIMD kernel on its way out
+        const XorCipher::CopyFn encrypt = XorCipher::getCopy(XorCipher::getKernel());
+        std::vector<uint8_t> buffer(WRITE_CHUNK_SIZE);
+        auto write = [&](std::span<const uint8_t> plain) {
+            for (size_t done = 0; done < plain.size();) {
+                const size_t count = std::min(buffer.size(), plain.size() - done);
+                encrypt(plain.data() + done, buffer.data(), count, file.getKey());
+                stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(count));
+                done += count;
+            }
+            m_writtenBytes += plain.size();
+        };
+        auto copy = [&](uint64_t begin, uint64_t end) {
+            for (uint64_t position = begin; position < end;) {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(WRITE_CHUNK_SIZE, end - position));
+                const auto plain = file.view(position, count);
+                if (plain.size() != count) {
+                    return false;
+                }
+                write(plain);
+                position += count;
+            }
+            return true;
+        };
+
+        uint64_t position = 0;
+        bool copied = true;
+        for (const Splice& splice : splices) {
+            copied = copied && copy(position, splice.offset);
+            write(splice.bytes);
+            position = splice.offset + splice.size;
+        }
+        copied = copied && copy(position, file.size());
+        stream.close();
+        if (!copied || !stream || !syncFile(temporary)) {
+            error = "failed to write " + temporary.string();
+            return false;
+        }
+        return true;
+    }
+
+    bool ResourceOverlay::commit(std::string& error) {
+        return m_inPlace ? writeInPlace(error) : replaceFiles(error);
+    }
+
+    bool ResourceOverlay::writeJournal(std::string& error) const {
+        // Header, then per block: file name, offset, size and its bytes as on disk
+        std::vector<uint8_t> journal(std::begin(JOURNAL_MAGIC), std::end(JOURNAL_MAGIC));
+        appendValue(journal, JOURNAL_VERSION);
+        uint32_t count = 0;
+        for (const Prepared& prepared : m_prepared) {
+            count += static_cast<uint32_t>(m_files[prepared.file].size());
+        }
+        appendValue(journal, count);
+
+        std::vector<uint8_t> original;
+        for (const Prepared& prepared : m_prepared) {
+            std::ifstream in(prepared.target, std::ios::binary);
+            const std::string name = prepared.target.filename().string();
+            for (const auto& [offset, edit] : m_files[prepared.file]) {
+                original.resize(edit.size);
+                in.seekg(static_cast<std::streamoff>(offset));
+                in.read(reinterpret_cast<char*>(original.data()), static_cast<std::streamsize>(original.size()));
+                if (!in) {
+                    error = "cannot read " + prepared.target.string();
+                    return false;
+                }
+                appendValue(journal, static_cast<uint32_t>(name.size()));
+                journal.insert(journal.end(), name.begin(), name.end());
+                appendValue(journal, static_cast<uint64_t>(offset));
+                appendValue(journal, static_cast<uint32_t>(original.size()));
+                journal.insert(journal.end(), original.begin(), original.end());
+            }
+        }
+
+        const std::filesystem::path path = getJournalPath(m_indexPath);
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(journal.data()), static_cast<std::streamsize>(journal.size()));
+            if (!out) {
+                error = "cannot write " + path.string();
+                return false;
+            }
+        }
+        if (!syncFile(path)) {
+            error = "cannot write " + path.string();
+            return false;
+        }
+        return true;
+    }
+
+    bool ResourceOverlay::writeInPlace(std::string& error) {
+        for (const Prepared& prepared : m_prepared) {
+            std::error_code ec;
+            if (std::filesystem::file_size(prepared.target, ec) != prepared.size || ec) {
+                error = prepared.target.string() + " changed on disk since it was opened";
+                return false;
+            }
+        }
+
+        // Nothing is overwritten before the original bytes are safely on disk
+        std::error_code ec;
+        if (!writeJournal(error)) {
+            std::filesystem::remove(getJournalPath(m_indexPath), ec);
+            return false;
+        }
+
+        const XorCipher::CopyFn encrypt = XorCipher::getCopy(XorCipher::getKernel());
+        std::vector<JournalEntry> blocks;
+        for (const Prepared& prepared : m_prepared) {
+            for (const auto& [offset, edit] : m_files[prepared.file]) {
+                JournalEntry& block = blocks.emplace_back(JournalEntry{prepared.target, offset, std::vector<uint8_t>(edit.bytes.size())});
+                encrypt(edit.bytes.data(), block.bytes.data(), block.bytes.size(), prepared.key);
+            }
+        }
+
+        m_committed = true;
+        if (!writeBlocks(blocks, error)) {
+            size_t restored = 0;
+            std::string undoError;
+            if (recover(m_indexPath, restored, undoError)) {
+                m_committed = false;
+            } else {
+                error += "; " + undoError + ", the original blocks are kept in " + getJournalPath(m_indexPath).string();
+            }
+            return false;
+        }
+
+        std::filesystem::remove(getJournalPath(m_indexPath), ec);
+        for (const JournalEntry& block : blocks) {
+            m_writtenBytes += block.bytes.size();
+        }
+        m_prepared.clear();
+        return true;
+    }
+
+    bool ResourceOverlay::replaceFiles(std::string& error) {
+        // The originals stay as .bak until every new file is in place
+        std::error_code ec;
+        size_t backedUp = 0;
+        size_t replaced = 0;
+        for (; backedUp < m_prepared.size(); backedUp++) {
+            std::filesystem::rename(m_prepared[backedUp].target, m_prepared[backedUp].backup, ec);
+            if (ec) {
+                break;
+            }
+        }
+        for (; !ec && replaced < m_prepared.size(); replaced++) {
+            std::filesystem::rename(m_prepared[replaced].temporary, m_prepared[replaced].target, ec);
+            if (ec) {
+                break;
+            }
+        }
+
+        if (ec) {
+            const Prepared& failed = m_prepared[backedUp < m_prepared.size() ? backedUp : replaced];
+            error = "cannot replace " + failed.target.string() + ": " + ec.message();
+
+            // Put every original back over whatever took its place
+            bool restored = true;
+            for (size_t i = 0; i < backedUp; i++) {
+                std::error_code undo;
+                std::filesystem::rename(m_prepared[i].backup, m_prepared[i].target, undo);
+                restored = restored && !undo;
+            }
+            if (!restored) {
+                error += "; the originals could not all be restored and are left as .bak files";
+            }
+            m_committed = !restored;
+            rollback();
+            return false;
+        }
+
+        for (const Prepared& prepared : m_prepared) {
+            std::filesystem::remove(prepared.backup, ec);
+        }
+        m_committed = true;
+        m_prepared.clear();
+        return true;
+    }
+
+    bool ResourceOverlay::recover(const std::filesystem::path& indexPath, size_t& restored, std::string& error) {
+        restored = 0;
+        const std::filesystem::path journal = getJournalPath(indexPath);
+        std::ifstream in(journal, std::ios::binary);
+        if (!in) {
+            return true;
+        }
+        const std::vector<uint8_t> data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        in.close();
+
+        size_t position = 0;
+        auto read = [&](void* value, size_t size) {
+            if (data.size() - position < size) {
+                return false;
+            }
+            std::memcpy(value, data.data() + position, size);
+            position += size;
+            return true;
+        };
+
+        // A journal cut short was never synced, so no block was overwritten yet
+        std::vector<JournalEntry> entries;
+        char magic[4] = {};
+        uint32_t version = 0;
+        uint32_t count = 0;
+        bool complete = read(magic, sizeof(magic)) && std::memcmp(magic, JOURNAL_MAGIC, sizeof(magic)) == 0 &&
+                        read(&version, sizeof(version)) && version == JOURNAL_VERSION && read(&count, sizeof(count));
+        for (uint32_t i = 0; complete && i < count; i++) {
+            uint32_t length = 0;
+            uint32_t size = 0;
+            JournalEntry entry;
+            complete = read(&length, sizeof(length)) && length <= data.size() - position;
+            if (complete) {
+                entry.target = journal.parent_path() / std::string(data.begin() + position, data.begin() + position + length);
+                position += length;
+                complete = read(&entry.offset, sizeof(entry.offset)) && read(&size, sizeof(size)) && size <= data.size() - position;
+            }
+            if (complete) {
+                entry.bytes.assign(data.begin() + position, data.begin() + position + size);
+                position += size;
+                entries.push_back(std::move(entry));
+            }
+        }
+        complete = complete && position == data.size();
+
+        if (complete && !writeBlocks(entries, error)) {
+            return false;
+        }
+        restored = complete ? entries.size() : 0;
+        std::error_code ec;
+        std::filesystem::remove(journal, ec);
+        return true;
+    }
+
+    void ResourceOverlay::rollback() {
+        for (const Prepared& prepared : m_prepared) {
+            if (!prepared.temporary.empty()) {
+                std::error_code ec;
+                std::filesystem::remove(prepared.temporary, ec);
+            }
+        }
+        m_prepared.clear();
+    }
+
+} // namespace scummredux
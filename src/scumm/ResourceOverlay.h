@@ -0,0 +1,121 @@
+#pragma once
+
+#include "BlockIndex.h"
+#include "ResourceFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Edited blocks of the open game, kept in memory on top of the mapped files.
+    // Nothing touches the disk until a save, which takes one of two paths:
+    //
+    // - Every edit keeps its block's size: nothing else in the files moves, so the
+    //   blocks are written over the old bytes in place. This takes milliseconds
+    //   whatever the game's size. The original bytes go to a journal next to the
+    //   index file first (synced to disk before anything is overwritten); a failed
+    //   write puts them back, and recover() does the same after a crash.
+    // - Otherwise every changed file is streamed to a temporary file next to it in
+    //   one sequential pass (unchanged ranges are read from the mapping, edited
+    //   blocks from here, everything encrypted again on the way out). The originals
+    //   are then renamed to .bak, the new files take their place and the backups
+    //   go; if any rename fails the originals are put back. The new files are synced
+    //   to disk before the renames. This is atomic, but its time grows with the size of the changed files (the caller's thread waits
+    //   roughly a disk's sequential bandwidth per byte).
+    //
+    // Whatever locates a later block is fixed up on the way: the sizes of the blocks
+    // around an edited one, the LOFF room offsets and the index file's DSCR/DSOU/
+    // DCOS/DCHR resource offsets. Edited blocks may not contain one another.
+    class ResourceOverlay {
+    public:
+        struct Block {
+            uint32_t record;                // In the file's BlockIndex
+            uint32_t offset;                // Where it is on disk now
+            uint32_t size;                  // Its size on disk now
+            std::vector<uint8_t> bytes;     // New block, header included, plain
+        };
+
+        void reset(size_t fileCount);
+
+        // Records a new version of a block; the original bytes drop the edit again
+        bool set(size_t file, const BlockIndex& blocks, uint32_t record, std::span<const uint8_t> original,
+                 std::span<const uint8_t> block, std::string& error);
+        const Block* find(size_t file, uint32_t offset) const;
+
+        bool isDirty() const { return m_blockCount != 0; }
+        size_t getBlockCount() const { return m_blockCount; }
+
+        // Where a block at this offset of a file is once the edits are saved
+        uint32_t relocate(size_t file, uint32_t offset) const;
+
+        // Saving: prepare() writes the temporary files while the originals are still
+        // mapped, commit() swaps them in (or writes in place) once the game is closed.
+        // A failed prepare() leaves nothing behind; rollback() drops prepared files
+        // that were not used.
+        bool prepare(std::span<ResourceFile* const> files, std::span<const std::unique_ptr<BlockIndex>> indices,
+                     std::string& error);
+        bool commit(std::string& error);
+        void rollback();
+
+        // Before a game is opened: undoes an in-place save that was cut short, from the
+        // journal next to its index file. Counts the blocks put back; true if none were due.
+        static bool recover(const std::filesystem::path& indexPath, size_t& restored, std::string& error);
+
+        size_t getFileCount() const { return m_files.size(); }
+        bool isInPlace() const { return m_inPlace; }
+
+        // After a failed commit(): true if the files on disk changed all the same
+        bool isCommitted() const { return m_committed; }
+        size_t getFixupCount() const { return m_fixupCount; }
+        uint64_t getWrittenBytes() const { return m_writtenBytes; }
+        size_t getWrittenFileCount() const { return m_writtenFiles; }
+
+    private:
+        struct Splice {
+            uint64_t offset;
+            uint64_t size;                  // Bytes of the original it replaces
+            std::span<const uint8_t> bytes;
+        };
+
+        struct Fixup {
+            uint64_t offset;
+            uint8_t bytes[4];
+        };
+
+        struct Prepared {
+            std::filesystem::path temporary;    // Empty when written in place
+            std::filesystem::path target;
+            std::filesystem::path backup;
+            size_t file;
+            uint64_t size;                      // Of the target when prepared
+            uint8_t key;
+        };
+
+        int64_t getDelta(size_t file, uint64_t begin, uint64_t end) const;
+        bool writeFile(ResourceFile& file, size_t index, const std::vector<Fixup>& fixups, std::string& error);
+        bool writeJournal(std::string& error) const;
+        bool writeInPlace(std::string& error);
+        bool replaceFiles(std::string& error);
+
+        std::vector<std::map<uint32_t, Block>> m_files;     // Per file, by offset
+        size_t m_blockCount = 0;
+
+        std::vector<Prepared> m_prepared;
+        std::filesystem::path m_indexPath;     // Its journal sits next to it, see recover()
+        bool m_inPlace = false;
+        bool m_committed = false;
+        size_t m_fixupCount = 0;
+        uint64_t m_writtenBytes = 0;
+        size_t m_writtenFiles = 0;
+
+        static constexpr size_t WRITE_CHUNK_SIZE = 1024 * 1024;
+        static constexpr uint32_t JOURNAL_VERSION = 1;
+    };
+
+} // namespace scummredux
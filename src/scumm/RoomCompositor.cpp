@@ -0,0 +1,248 @@
+#include "RoomCompositor.h"
+#include "../utils/Simd.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace scummredux {
+
+    namespace {
+        // Rounded per-byte average, like _mm_avg_epu8
+        uint32_t average(uint32_t a, uint32_t b) {
+            return (a | b) - (((a ^ b) & 0xFEFEFEFEu) >> 1);
+        }
+
+        // count bits of source starting at sourceBit over destination from destinationBit;
+        // no source clears them
+        void copyBits(uint8_t* destination, size_t destinationBit, const uint8_t* source, size_t sourceBit, size_t count) {
+            size_t i = 0;
+            if (destinationBit % 8 == 0 && sourceBit % 8 == 0) {
+                const size_t bytes = count / 8;
+                if (source) {
+                    std::memcpy(destination + destinationBit / 8, source + sourceBit / 8, bytes);
+                } else {
+                    std::memset(destination + destinationBit / 8, 0, bytes);
+                }
+                i = bytes * 8;
+            }
+            for (; i < count; i++) {
+                const size_t to = destinationBit + i;
+                const size_t from = sourceBit + i;
+                const uint8_t bit = static_cast<uint8_t>(0x80 >> (to & 7));
+                if (source && (source[from >> 3] & (0x80 >> (from & 7)))) {
+                    destination[to >> 3] |= bit;
+                } else {
+                    destination[to >> 3] &= static_cast<uint8_t>(~bit);
+                }
+            }
+        }
+    } // namespace
+
+    void RoomCompositor::reset(std::shared_ptr<const RoomBackground> background) {
+        m_background = std::move(background);
+        const size_t objects = m_background ? m_background->objects.size() : 0;
+
+        // The engine draws the object list back to front
+        m_layers.assign(objects, Layer{});
+        m_layerOf.resize(objects);
+        for (size_t layer = 0; layer < objects; layer++) {
+            m_layers[layer].object = objects - 1 - layer;
+            m_layerOf[objects - 1 - layer] = layer;
+        }
+        m_firstStale = objects;
+        m_changed = {};
+        m_top = nullptr;
+    }
+
+    void RoomCompositor::clear() {
+        reset(nullptr);
+    }
+
+    bool RoomCompositor::setState(size_t object, uint16_t state) {
+        if (object >= m_layerOf.size()) {
+            return false;
+        }
+        const size_t index = m_layerOf[object];
+        Layer& layer = m_layers[index];
+        if (layer.state == state) {
+            return false;
+        }
+
+        const bool wasVisible = isVisible(layer);
+        layer.state = state;
+        if (!wasVisible && !isVisible(layer)) {
+            return false;
+        }
+        m_firstStale = std::min(m_firstStale, index);
+        m_changed.merge(getRows(m_background->objects[object]));
+        return true;
+    }
+
+    uint16_t RoomCompositor::getState(size_t object) const {
+        return object < m_layerOf.size() ? m_layers[m_layerOf[object]].state : 0;
+    }
+
+    RowRange RoomCompositor::compose() {
+        if (m_firstStale < m_layers.size()) {
+            const IndexedImage* image = &m_background->image;
+            const std::vector<BitMask>* zplanes = &m_background->zplanes;
+            m_top = nullptr;
+            for (size_t i = 0; i < m_firstStale; i++) {
+                if (isVisible(m_layers[i])) {
+                    m_top = &m_layers[i];
+                    image = &m_top->image;
+                    zplanes = &m_top->zplanes;
+                }
+            }
+
+            for (size_t i = m_firstStale; i < m_layers.size(); i++) {
+                Layer& layer = m_layers[i];
+                if (!isVisible(layer)) {
+                    layer.image = {};
+                    layer.zplanes.clear();
+                    continue;
+                }
+
+                // Copy assignment reuses the layer's buffers
+                layer.image = *image;
+                layer.zplanes = *zplanes;
+                const ObjectImage& object = m_background->objects[layer.object];
+                draw(object, object.states[layer.state - 1], layer);
+                m_top = &layer;
+                image = &layer.image;
+                zplanes = &layer.zplanes;
+            }
+            m_firstStale = m_layers.size();
+        }
+        return std::exchange(m_changed, RowRange{});
+    }
+
+    const IndexedImage& RoomCompositor::getImage() const {
+        return m_top ? m_top->image : m_background->image;
+    }
+
+    const std::vector<BitMask>& RoomCompositor::getZPlanes() const {
+        return m_top ? m_top->zplanes : m_background->zplanes;
+    }
+
+    bool RoomCompositor::isVisible(const Layer& layer) const {
+        if (layer.state == 0) {
+            return false;
+        }
+        const ObjectImage& object = m_background->objects[layer.object];
+        return layer.state <= object.states.size() && !object.states[layer.state - 1].image.pixels.empty();
+    }
+
+    RowRange RoomCompositor::getRows(const ObjectImage& object) const {
+        const int top = std::max<int>(object.y, 0);
+        const int bottom = std::min<int>(object.y + object.height, m_background->image.height);
+        return top < bottom ? RowRange{static_cast<uint16_t>(top), static_cast<uint16_t>(bottom - top)} : RowRange{};
+    }
+
+    void RoomCompositor::draw(const ObjectImage& object, const ObjectImage::State& state, Layer& layer) const {
+        const int left = std::max<int>(object.x, 0);
+        const int right = std::min<int>(object.x + object.width, layer.image.width);
+        const RowRange rows = getRows(object);
+        if (left >= right || rows.empty()) {
+            return;
+        }
+
+        const size_t sourceX = static_cast<size_t>(left - object.x);
+        const size_t count = static_cast<size_t>(right - left);
+        for (size_t y = rows.first; y < static_cast<size_t>(rows.first + rows.count); y++) {
+            const size_t sourceY = y - object.y;
+            blendRow(layer.image.row(y) + left, state.image.row(sourceY) + sourceX, state.opaque.row(sourceY), sourceX,
+                     count);
+
+            // The object's planes replace the room's under it; planes it lacks are cleared
+            for (size_t plane = 0; plane < layer.zplanes.size(); plane++) {
+                const uint8_t* source = plane < state.zplanes.size() ? state.zplanes[plane].row(sourceY) : nullptr;
+                copyBits(layer.zplanes[plane].row(y), left, source, sourceX, count);
+            }
+        }
+    }
+
+    void RoomCompositor::blendRow(uint8_t* destination, const uint8_t* source, const uint8_t* opaque, size_t bit,
+                                  size_t count) {
+        size_t i = 0;
+        if (bit % 8 == 0) {
+            // Two mask bytes widen to a 16-lane byte select
+            const uint8_t* bits = opaque + bit / 8;
+#if defined(SCUMMREDUX_SIMD_X86)
+            const __m128i lanes = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+            for (; i + 16 <= count; i += 16) {
+                const __m128i mask = _mm_unpacklo_epi64(_mm_set1_epi8(static_cast<char>(bits[i / 8])),
+                                                        _mm_set1_epi8(static_cast<char>(bits[i / 8 + 1])));
+                const __m128i select = _mm_cmpeq_epi8(_mm_and_si128(mask, lanes), lanes);
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                const __m128i background = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+                const __m128i blended = _mm_or_si128(_mm_and_si128(select, pixels), _mm_andnot_si128(select, background));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), blended);
+            }
+#elif defined(SCUMMREDUX_SIMD_NEON)
+            static const uint8_t LANES[16] = {0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1, 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1};
+            const uint8x16_t lanes = vld1q_u8(LANES);
+            for (; i + 16 <= count; i += 16) {
+                const uint8x16_t mask = vcombine_u8(vdup_n_u8(bits[i / 8]), vdup_n_u8(bits[i / 8 + 1]));
+                const uint8x16_t select = vtstq_u8(mask, lanes);
+                vst1q_u8(destination + i, vbslq_u8(select, vld1q_u8(source + i), vld1q_u8(destination + i)));
+            }
+#endif
+        }
+        for (; i < count; i++) {
+            const size_t index = bit + i;
+            if (opaque[index >> 3] & (0x80 >> (index & 7))) {
+                destination[i] = source[i];
+            }
+        }
+    }
+
+    void RoomCompositor::tintRow(uint32_t* pixels, const uint8_t* mask, size_t count, uint32_t color) {
+        size_t i = 0;
+#if defined(SCUMMREDUX_SIMD_X86)
+        const __m128i low = _mm_setr_epi32(0x80, 0x40, 0x20, 0x10);
+        const __m128i high = _mm_setr_epi32(8, 4, 2, 1);
+        const __m128i tint = _mm_set1_epi32(static_cast<int>(color));
+        for (; i + 8 <= count; i += 8) {
+            const uint8_t bits = mask[i / 8];
+            if (bits == 0) {
+                continue;
+            }
+            const __m128i broadcast = _mm_set1_epi32(bits);
+            for (int half = 0; half < 2; half++) {
+                const __m128i lanes = half ? high : low;
+                const __m128i select = _mm_cmpeq_epi32(_mm_and_si128(broadcast, lanes), lanes);
+                __m128i* target = reinterpret_cast<__m128i*>(pixels + i + half * 4);
+                const __m128i original = _mm_loadu_si128(target);
+                const __m128i tinted = _mm_avg_epu8(original, tint);
+                _mm_storeu_si128(target, _mm_or_si128(_mm_and_si128(select, tinted), _mm_andnot_si128(select, original)));
+            }
+        }
+#elif defined(SCUMMREDUX_SIMD_NEON)
+        static const uint32_t LANES[8] = {0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1};
+        const uint32x4_t low = vld1q_u32(LANES);
+        const uint32x4_t high = vld1q_u32(LANES + 4);
+        const uint8x16_t tint = vreinterpretq_u8_u32(vdupq_n_u32(color));
+        for (; i + 8 <= count; i += 8) {
+            const uint8_t bits = mask[i / 8];
+            if (bits == 0) {
+                continue;
+            }
+            const uint32x4_t broadcast = vdupq_n_u32(bits);
+            for (int half = 0; half < 2; half++) {
+                const uint32x4_t select = vtstq_u32(broadcast, half ? high : low);
+                uint32_t* target = pixels + i + half * 4;
+                const uint32x4_t original = vld1q_u32(target);
+                const uint32x4_t tinted = vreinterpretq_u32_u8(vrhaddq_u8(vreinterpretq_u8_u32(original), tint));
+                vst1q_u32(target, vbslq_u32(select, tinted, original));
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            if (mask[i >> 3] & (0x80 >> (i & 7))) {
+                pixels[i] = average(pixels[i], color);
+            }
+        }
+    }
+
+} // namespace scummredux
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ObjectImage.h"
+#include "RoomPipeline.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace scummredux {
+
+    // Draws a room's objects over its background in the engine's order, in palette
+    // indices so color cycling keeps working on the result. Every object is a layer
+    // caching the composite up to and including it (image and z-planes); changing an
+    // object's state only redraws the layers from that object on, and reports the
+    // rows whose pixels may have changed.
+    class RoomCompositor {
+    public:
+        void reset(std::shared_ptr<const RoomBackground> background);
+        void clear();
+
+        // Object index as in RoomBackground::objects; states past the last image hide it
+        bool setState(size_t object, uint16_t state);
+        uint16_t getState(size_t object) const;
+
+        // Brings the composite up to date; returns the rows changed since the last call
+        RowRange compose();
+
+        const IndexedImage& getImage() const;
+        const std::vector<BitMask>& getZPlanes() const;
+        const RoomBackground* getBackground() const { return m_background.get(); }
+
+        // Copies source pixels whose opaque bit (MSB first, starting at bit) is set
+        static void blendRow(uint8_t* destination, const uint8_t* source, const uint8_t* opaque, size_t bit, size_t count);
+
+        // Averages RGBA pixels whose mask bit is set with color
+        static void tintRow(uint32_t* pixels, const uint8_t* mask, size_t count, uint32_t color);
+
+    private:
+        struct Layer {
+            size_t object = 0;              // Index into RoomBackground::objects
+            uint16_t state = 0;
+            IndexedImage image;             // Unused while the object is hidden
+            std::vector<BitMask> zplanes;
+        };
+
+        bool isVisible(const Layer& layer) const;
+        RowRange getRows(const ObjectImage& object) const;
+        void draw(const ObjectImage& object, const ObjectImage::State& state, Layer& layer) const;
+
+        std::shared_ptr<const RoomBackground> m_background;
+        std::vector<Layer> m_layers;        // Drawing order: the first object ends up on top
+        std::vector<size_t> m_layerOf;      // Object index -> layer
+        size_t m_firstStale = 0;            // Layers from here on need redrawing
+        RowRange m_changed;
+        const Layer* m_top = nullptr;       // Last visible layer, the result
+    };
+
+} // namespace scummredux
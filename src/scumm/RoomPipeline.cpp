@@ -0,0 +1,291 @@
+#include "RoomPipeline.h"
+#include "../core/TraceRecorder.h"
+#include "../views/ConsoleView.h"
+#include <cstdio>
+
+namespace scummredux {
+
+    namespace {
+
+        uint16_t readLE16(const uint8_t* data) {
+            return static_cast<uint16_t>(data[0] | (data[1] << 8));
+        }
+
+        bool isImageTag(ChunkTag tag) {
+            const std::string name = tagToString(tag);
+            return name[0] == 'I' && name[1] == 'M' && name != "IMHD";
+        }
+
+        // RMHD: width, height, object count (little-endian words)
+        void parseHeader(ResourceFile& file, const Chunk& room, RoomInfo& info) {
+            const Chunk rmhd = file.findChild(room, tags::RMHD);
+            const auto data = rmhd.valid() ? file.data(rmhd) : std::span<const uint8_t>{};
+            if (data.size() < 4) {
+                info.error = "missing RMHD";
+                return;
+            }
+            info.width = readLE16(data.data());
+            info.height = readLE16(data.data() + 2);
+        }
+
+        Chunk findBackgroundImage(ResourceFile& file, const Chunk& room) {
+            const Chunk rmim = file.findChild(room, tags::RMIM);
+            return rmim.valid() ? file.findChild(rmim, makeTag("IM00")) : Chunk{};
+        }
+
+        Chunk findBackground(ResourceFile& file, const Chunk& room) {
+            const Chunk im00 = findBackgroundImage(file, room);
+            return im00.valid() ? file.findChild(im00, tags::SMAP) : Chunk{};
+        }
+
+        bool decodeImage(ResourceFile& file, const Chunk& room, const RoomInfo& info, IndexedImage& image,
+                         std::vector<uint8_t>* codecs, std::string& error) {
+            const Chunk smap = findBackground(file, room);
+            if (!smap.valid()) {
+                error = "missing SMAP";
+                return false;
+            }
+
+            image.resize(info.width, info.height);
+            SmapDecoder::Result result = SmapDecoder::decode(file.view(smap.offset, smap.size), image, false);
+            if (codecs) {
+                *codecs = std::move(result.codecs);
+            }
+            if (!result.error.empty()) {
+                error = result.error;
+            } else if (result.failedStrips > 0) {
+                error = std::to_string(result.failedStrips) + " undecodable strips";
+            }
+            return error.empty();
+        }
+
+        // Decodes the background once to validate every strip. Room jobs already run
+        // in parallel, so the strips of one room are decoded serially here.
+        void parseImage(ResourceFile& file, const Chunk& room, RoomInfo& info) {
+            IndexedImage image;
+            decodeImage(file, room, info, image, &info.stripCodecs, info.error);
+        }
+
+        void parseObjects(ResourceFile& file, const Chunk& room, RoomInfo& info) {
+            file.forEachChild(room, [&](const Chunk& chunk) {
+                if (chunk.tag == tags::OBCD) {
+                    RoomObject object;
+                    const Chunk cdhd = file.findChild(chunk, tags::CDHD);
+                    const auto header = cdhd.valid() ? file.data(cdhd) : std::span<const uint8_t>{};
+                    if (header.size() >= 2) {
+                        object.id = readLE16(header.data());
+                    }
+
+                    const Chunk obna = file.findChild(chunk, tags::OBNA);
+                    if (obna.valid()) {
+                        const auto name = file.data(obna);
+                        size_t length = 0;
+                        while (length < name.size() && name[length] != 0) {
+                            length++;
+                        }
+                        object.name.assign(reinterpret_cast<const char*>(name.data()), length);
+                    }
+                    info.objects.push_back(std::move(object));
+                } else if (chunk.tag == tags::OBIM) {
+                    const Chunk imhd = file.findChild(chunk, tags::IMHD);
+                    const auto header = imhd.valid() ? file.data(imhd) : std::span<const uint8_t>{};
+                    if (header.size() < 2) {
+                        return;
+                    }
+
+                    uint16_t images = 0;
+                    file.forEachChild(chunk, [&](const Chunk& child) {
+                        images += isImageTag(child.tag) ? 1 : 0;
+                    });
+
+                    // OBIM and OBCD blocks of one object share its id
+                    const uint16_t id = readLE16(header.data());
+                    for (RoomObject& object : info.objects) {
+                        if (object.id == id) {
+                            object.imageCount = images;
+                            return;
+                        }
+                    }
+                    info.objects.push_back({id, {}, images});
+                } else if (chunk.tag == tags::LSCR) {
+                    info.localScripts++;
+                }
+            });
+        }
+
+    } // namespace
+
+    RoomPipeline::~RoomPipeline() {
+        cancel();
+        waitForJobs();
+    }
+
+    RoomInfo RoomPipeline::decodeRoom(const Room& room) {
+        RoomInfo info;
+        info.number = room.number;
+        info.file = room.fileIndex;
+        info.offset = room.block.offset;
+
+        ResourceFile& file = *room.file;
+        const Chunk roomChunk = file.findChild(room.block, tags::ROOM);
+        if (!roomChunk.valid()) {
+            info.error = "missing ROOM";
+            return info;
+        }
+
+        parseHeader(file, roomChunk, info);
+        if (info.error.empty()) {
+            parseImage(file, roomChunk, info);
+        }
+        parseObjects(file, roomChunk, info);
+
+        file.forEachChild(room.block, [&](const Chunk& chunk) {
+            info.globalScripts += chunk.tag == tags::SCRP ? 1 : 0;
+        });
+        return info;
+    }
+
+    bool RoomPipeline::decodeBackground(const Room& room, RoomBackground& background, std::string& error) {
+        ResourceFile& file = *room.file;
+        const Chunk roomChunk = file.findChild(room.block, tags::ROOM);
+        if (!roomChunk.valid()) {
+            error = "missing ROOM";
+            return false;
+        }
+
+        RoomInfo info;
+        parseHeader(file, roomChunk, info);
+        if (!info.error.empty()) {
+            error = info.error;
+            return false;
+        }
+        if (!Palette::load(file, roomChunk, background.palette)) {
+            error = "missing palette";
+            return false;
+        }
+
+        // Rooms without CYCL simply do not animate
+        const Chunk cycl = file.findChild(roomChunk, tags::CYCL);
+        background.cycles = cycl.valid() ? PaletteCycler::parse(file.data(cycl)) : std::vector<ColorCycle>{};
+        if (!decodeImage(file, roomChunk, info, background.image, nullptr, error)) {
+            return false;
+        }
+        background.zplanes = ZPlaneDecoder::loadAll(file, findBackgroundImage(file, roomChunk), info.width, info.height);
+
+        const Chunk trns = file.findChild(roomChunk, tags::TRNS);
+        const auto transparent = trns.valid() ? file.data(trns) : std::span<const uint8_t>{};
+        background.transparentColor = transparent.empty() ? 0 : transparent[0];
+
+        // Object names live in OBCD, which parseObjects already pairs up by id
+        parseObjects(file, roomChunk, info);
+        background.objects.clear();
+        file.forEachChild(roomChunk, [&](const Chunk& chunk) {
+            if (chunk.tag != tags::OBIM) {
+                return;
+            }
+
+            // A broken object image only costs that object its states
+            ObjectImage object;
+            std::string objectError;
+            if (!ObjectImage::load(file, chunk, background.transparentColor, object, objectError)) {
+                object.states.clear();
+            }
+            for (const RoomObject& named : info.objects) {
+                if (named.id == object.id && !named.name.empty()) {
+                    object.name = named.name;
+                    break;
+                }
+            }
+            background.objects.push_back(std::move(object));
+        });
+        return true;
+    }
+
+    void RoomPipeline::start(std::vector<Room> rooms) {
+        cancel();
+        waitForJobs();
+
+        auto state = std::make_shared<State>();
+        state->rooms = std::move(rooms);
+        state->results.resize(state->rooms.size());
+        state->start = std::chrono::steady_clock::now();
+        m_state = state;
+        m_running = true;
+        m_reportedQuarter = 0;
+
+        auto& jobs = JobSystem::getInstance();
+        ConsoleView::info("Decoding " + std::to_string(state->rooms.size()) + " rooms on " +
+                          std::to_string(jobs.getWorkerCount()) + " workers");
+
+        // One job per room: each writes only its own result slot
+        JobSystem::Options options;
+        options.counter = &state->counter;
+        options.token = &state->token;
+        for (size_t i = 0; i < state->rooms.size(); i++) {
+            jobs.submit([state, i] {
+                SCUMM_TRACE_SCOPE("decodeRoom", "rooms");
+                state->results[i] = decodeRoom(state->rooms[i]);
+            }, options);
+        }
+    }
+
+    void RoomPipeline::cancel() {
+        if (m_state) {
+            m_state->token.cancel();
+        }
+    }
+
+    void RoomPipeline::reset() {
+        cancel();
+        waitForJobs();
+        m_state.reset();
+        m_rooms.clear();
+        m_running = false;
+    }
+
+    void RoomPipeline::waitForJobs() {
+        if (m_state) {
+            JobSystem::getInstance().wait(m_state->counter);
+        }
+    }
+
+    bool RoomPipeline::poll() {
+        if (!m_running) {
+            return false;
+        }
+
+        const size_t total = m_state->rooms.size();
+        const size_t completed = getCompleted();
+        if (!m_state->counter.isDone()) {
+            const size_t quarter = total ? completed * 4 / total : 0;
+            if (quarter > m_reportedQuarter && !m_state->token.isCancelled()) {
+                m_reportedQuarter = quarter;
+                ConsoleView::debug("Rooms: " + std::to_string(completed) + " of " + std::to_string(total));
+            }
+            return false;
+        }
+
+        m_running = false;
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_state->start).count();
+        if (m_state->token.isCancelled()) {
+            ConsoleView::warning("Room decoding cancelled");
+            return true;
+        }
+
+        m_rooms = std::move(m_state->results);
+        size_t failed = 0;
+        for (const RoomInfo& room : m_rooms) {
+            failed += room.error.empty() ? 0 : 1;
+        }
+
+        char message[128];
+        std::snprintf(message, sizeof(message), "Decoded %zu rooms in %.1f ms (%zu with errors)", m_rooms.size(), ms, failed);
+        if (failed == 0) {
+            ConsoleView::success(message);
+        } else {
+            ConsoleView::warning(message);
+        }
+        return true;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "ObjectImage.h"
+#include "Palette.h"
+#include "PaletteCycler.h"
+#include "ResourceFile.h"
+#include "SmapDecoder.h"
+#include "../core/JobSystem.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    struct RoomObject {
+        uint16_t id = 0;
+        std::string name;
+        uint16_t imageCount = 0;        // IMnn states in the OBIM block
+    };
+
+    // Everything a viewer needs to draw (and animate) a room background
+    struct RoomBackground {
+        IndexedImage image;
+        Palette palette;
+        std::vector<ColorCycle> cycles;
+        std::vector<BitMask> zplanes;       // ZP01.. of the background
+        std::vector<ObjectImage> objects;   // OBIM order
+        uint8_t transparentColor = 0;
+    };
+
+    // What the pipeline extracted from one LFLF block
+    struct RoomInfo {
+        uint16_t number = 0;
+        size_t file = 0;
+        uint32_t offset = 0;            // LFLF block offset
+        uint16_t width = 0;
+        uint16_t height = 0;
+        std::vector<uint8_t> stripCodecs;   // SMAP codec id of every 8-pixel strip
+        std::vector<RoomObject> objects;
+        uint16_t localScripts = 0;
+        uint16_t globalScripts = 0;
+        std::string error;              // Empty when the room parsed cleanly
+    };
+
+    // Decodes every room of a game in the background. Rooms are independent, so each
+    // one is a job on the work-stealing JobSystem running all stages (header, image,
+    // objects, scripts); uneven room sizes are balanced by stealing. Progress can be
+    // read every frame, cancel() makes the JobSystem skip the remaining jobs.
+    class RoomPipeline {
+    public:
+        struct Room {
+            ResourceFile* file;
+            size_t fileIndex;
+            Chunk block;                // LFLF
+            uint16_t number;
+        };
+
+        RoomPipeline() = default;
+        ~RoomPipeline();
+
+        RoomPipeline(const RoomPipeline&) = delete;
+        RoomPipeline& operator=(const RoomPipeline&) = delete;
+
+        void start(std::vector<Room> rooms);
+        void cancel();
+
+        // Cancels, waits for the in-flight jobs and drops all results
+        void reset();
+
+        // Main thread: reports completion; returns true on the frame the run finished
+        bool poll();
+
+        bool isRunning() const { return m_running; }
+        size_t getTotal() const { return m_state ? m_state->rooms.size() : 0; }
+        size_t getCompleted() const { return m_state ? m_state->rooms.size() - m_state->counter.getPending() : 0; }
+        float getProgress() const { return getTotal() ? float(getCompleted()) / float(getTotal()) : 0.0f; }
+
+        // Results of the last finished (not cancelled) run
+        const std::vector<RoomInfo>& getRooms() const { return m_rooms; }
+
+        static RoomInfo decodeRoom(const Room& room);
+
+        // Background image, palette, color cycles, z-planes and object images of one
+        // room, for viewers
+        static bool decodeBackground(const Room& room, RoomBackground& background, std::string& error);
+
+    private:
+        struct State {
+            std::vector<Room> rooms;
+            std::vector<RoomInfo> results;
+            CancellationToken token;
+            JobCounter counter;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        void waitForJobs();
+
+        std::shared_ptr<State> m_state;
+        std::vector<RoomInfo> m_rooms;
+        bool m_running = false;
+        size_t m_reportedQuarter = 0;
+    };
+
+} // namespace scummredux
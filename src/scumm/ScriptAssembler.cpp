@@ -0,0 +1,815 @@
+#include "ScriptAssembler.h"
+#include "ScriptOpcodes.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+
+namespace scummredux {
+
+    namespace {
+        using namespace bytecode;
+
+        constexpr int MAX_DEPTH = 4;        // Opcodes nested in v5 expressions, as the disassembler reads them
+
+        constexpr const char* OPERATORS[] = {"add", "sub", "mul", "div"};
+
+        std::string_view trim(std::string_view text) {
+            while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+                text.remove_prefix(1);
+            }
+            while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+        bool isHexDigit(char c) {
+            return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f');
+        }
+
+        bool parseHex(std::string_view text, uint32_t& value) {
+            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+            return ec == std::errc() && end == text.data() + text.size() && !text.empty();
+        }
+
+        // Decimal, optionally negative, or 0x hex
+        bool parseNumber(std::string_view text, int64_t& value) {
+            if (text.starts_with("0x") || text.starts_with("0X")) {
+                uint32_t hex = 0;
+                if (!parseHex(text.substr(2), hex)) {
+                    return false;
+                }
+                value = hex;
+                return true;
+            }
+            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            return ec == std::errc() && end == text.data() + text.size() && !text.empty();
+        }
+
+        // "#XX", the raw encoding the disassembler writes
+        bool parseRaw(std::string_view text, uint8_t& raw) {
+            uint32_t value = 0;
+            if (text.size() != 3 || text[0] != '#' || !parseHex(text.substr(1), value)) {
+                return false;
+            }
+            raw = static_cast<uint8_t>(value);
+            return true;
+        }
+
+        // Cuts a "; ..." comment that is not inside a string
+        std::string_view stripComment(std::string_view line) {
+            bool quoted = false;
+            for (size_t i = 0; i < line.size(); i++) {
+                if (quoted && line[i] == '\\') {
+                    i++;
+                } else if (line[i] == '"') {
+                    quoted = !quoted;
+                } else if (!quoted && line[i] == ';') {
+                    return line.substr(0, i);
+                }
+            }
+            return line;
+        }
+
+        // Items separated by commas outside brackets, parentheses and strings
+        std::vector<std::string_view> splitItems(std::string_view text) {
+            std::vector<std::string_view> items;
+            text = trim(text);
+            if (text.empty()) {
+                return items;
+            }
+            int depth = 0;
+            bool quoted = false;
+            size_t start = 0;
+            for (size_t i = 0; i < text.size(); i++) {
+                const char c = text[i];
+                if (quoted) {
+                    if (c == '\\') {
+                        i++;
+                    } else if (c == '"') {
+                        quoted = false;
+                    }
+                } else if (c == '"') {
+                    quoted = true;
+                } else if (c == '(' || c == '[') {
+                    depth++;
+                } else if (c == ')' || c == ']') {
+                    depth--;
+                } else if (c == ',' && depth == 0) {
+                    items.push_back(trim(text.substr(start, i - start)));
+                    start = i + 1;
+                }
+            }
+            items.push_back(trim(text.substr(start)));
+            return items;
+        }
+
+        // "name", "name#XX", then whatever follows
+        struct Mnemonic {
+            std::string_view name;
+            std::optional<uint8_t> raw;
+            std::string_view rest;
+        };
+
+        bool splitMnemonic(std::string_view text, Mnemonic& mnemonic) {
+            size_t end = 0;
+            while (end < text.size() && (std::isalnum(static_cast<unsigned char>(text[end])) || text[end] == '_')) {
+                end++;
+            }
+            if (end == 0) {
+                return false;
+            }
+            mnemonic.name = text.substr(0, end);
+            mnemonic.raw.reset();
+            if (end < text.size() && text[end] == '#') {
+                uint8_t raw = 0;
+                if (!parseRaw(text.substr(end, 3), raw)) {
+                    return false;
+                }
+                mnemonic.raw = raw;
+                end += 3;
+            }
+            mnemonic.rest = text.substr(end);
+            return true;
+        }
+
+        bool isVariable(std::string_view text) {
+            return text.starts_with("Var[") || text.starts_with("Local[") || text.starts_with("Bit[");
+        }
+
+        // "[a, b]" to its items
+        bool splitList(std::string_view text, std::vector<std::string_view>& items) {
+            if (text.size() < 2 || text.front() != '[' || text.back() != ']') {
+                return false;
+            }
+            items = splitItems(text.substr(1, text.size() - 2));
+            return true;
+        }
+
+        struct Jump {
+            size_t position;                // Of the word to write
+            uint32_t target;                // Offset in the listing's block
+            size_t line;
+        };
+
+        // The byte whose bits say variable or constant, taken from the top down
+        struct Params {
+            size_t index = 0;
+            uint8_t next = 0x80;
+        };
+
+        // Writes one instruction at a time; the first error sticks and the writers keep
+        // going harmlessly, like the decoder's overrun flag
+        class Encoder {
+        public:
+            Encoder(ScriptVersion version, std::vector<uint8_t>& out) : m_version(version), m_out(out) {}
+
+            void instruction(std::string_view text, int depth);
+
+            void byte(int64_t value) { m_out.push_back(static_cast<uint8_t>(value)); }
+            void word(int64_t value) {
+                byte(value & 0xFF);
+                byte((value >> 8) & 0xFF);
+            }
+
+            int64_t number(std::string_view text, int64_t min, int64_t max);
+            void target(std::string_view text);
+
+            void fail(std::string message) {
+                if (!m_failed) {
+                    m_failed = true;
+                    m_error = std::move(message);
+                }
+            }
+            bool hasFailed() const { return m_failed; }
+            const std::string& getError() const { return m_error; }
+
+            void setLine(size_t line) { m_line = line; }
+            std::vector<Jump>& getJumps() { return m_jumps; }
+
+        private:
+            const Opcode* find(const OpcodeTable& table, uint8_t mask, const Mnemonic& mnemonic, uint8_t& raw);
+            void operands(const Opcode& entry, Params& params, const std::vector<std::string_view>& args, int depth);
+            bool subOpcode(const SubOpcodes& subs, std::string_view text, bool inList, int depth);
+            void take(Params& params, bool set);
+
+            uint16_t variableNumber(std::string_view text);
+            void variable(std::string_view text);
+            void parameter(Params& params, std::string_view text, bool isWord);
+            void string(std::string_view text);
+            void list(std::string_view text);
+            void expression(std::string_view text, int depth);
+
+            ScriptVersion m_version;
+            std::vector<uint8_t>& m_out;
+            std::vector<Jump> m_jumps;
+            size_t m_line = 0;
+            bool m_failed = false;
+            std::string m_error;
+        };
+
+        const Opcode* Encoder::find(const OpcodeTable& table, uint8_t mask, const Mnemonic& mnemonic, uint8_t& raw) {
+            if (mnemonic.raw) {
+                const Opcode& entry = table[*mnemonic.raw & mask];
+                if (entry.name == nullptr || mnemonic.name != entry.name) {
+                    char message[64];
+                    std::snprintf(message, sizeof(message), "#%02X is not %.40s", *mnemonic.raw, std::string(mnemonic.name).c_str());
+                    fail(message);
+                    return nullptr;
+                }
+                raw = *mnemonic.raw;
+                return &entry;
+            }
+
+            // An alias is always written with its encoding, so the name alone means the first spec
+            for (size_t code = 0; code < table.size(); code++) {
+                const Opcode& entry = table[code];
+                if (entry.name != nullptr && !entry.alias && entry.code == code && mnemonic.name == entry.name) {
+                    raw = entry.code;
+                    return &entry;
+                }
+            }
+            fail("unknown opcode " + std::string(mnemonic.name));
+            return nullptr;
+        }
+
+        void Encoder::instruction(std::string_view text, int depth) {
+            Mnemonic mnemonic;
+            if (!splitMnemonic(text, mnemonic) || (!mnemonic.rest.empty() && mnemonic.rest.front() != ' ')) {
+                fail("expected an opcode");
+                return;
+            }
+            const OpcodeTable& table = m_version == ScriptVersion::V5 ? V5_OPCODES : V6_OPCODES;
+            uint8_t raw = 0;
+            const Opcode* entry = find(table, 0xFF, mnemonic, raw);
+            if (entry == nullptr) {
+                return;
+            }
+
+            const size_t at = m_out.size();
+            byte(raw);
+            Params params{at};
+            operands(*entry, params, splitItems(mnemonic.rest), depth);
+
+            // Parameter bits follow the operands; they must not turn it into another opcode
+            if (!m_failed && table[m_out[at]].code != entry->code) {
+                fail("the operands do not fit " + std::string(mnemonic.name));
+            }
+        }
+
+        void Encoder::take(Params& params, bool set) {
+            const uint8_t bit = params.next;
+            params.next >>= 1;
+            if (params.index >= m_out.size()) {
+                return;
+            }
+            if (set) {
+                m_out[params.index] |= bit;
+            } else {
+                m_out[params.index] &= static_cast<uint8_t>(~bit);
+            }
+        }
+
+        void Encoder::operands(const Opcode& entry, Params& params, const std::vector<std::string_view>& args, int depth) {
+            Params extra;
+            Params* current = &params;
+            size_t next = 0;
+            auto arg = [&]() -> std::string_view {
+                if (next >= args.size()) {
+                    fail(std::string(entry.name) + " takes more operands");
+                    return {};
+                }
+                return args[next++];
+            };
+
+            for (const char* letter = entry.operands; *letter && !m_failed; letter++) {
+                switch (*letter) {
+                    case 'p':
+                    case 'P':
+                        parameter(*current, arg(), *letter == 'P');
+                        break;
+                    case '_':
+                        current->next >>= 1;
+                        break;
+                    case 'o': {
+                        uint8_t raw = 0;
+                        if (!parseRaw(arg(), raw)) {
+                            fail("expected a #XX byte");
+                        }
+                        extra = Params{m_out.size()};
+                        byte(raw);
+                        current = &extra;
+                        break;
+                    }
+                    case 'r':
+                    case 'V':
+                        variable(arg());
+                        break;
+                    case 'B': {
+                        const uint16_t var = variableNumber(arg());
+                        if (var > 0xFF) {
+                            fail("variable does not fit a byte");
+                        }
+                        byte(var);
+                        break;
+                    }
+                    case 'W':
+                        word(variableNumber(arg()));
+                        break;
+                    case 'b':
+                        byte(number(arg(), 0, 0xFF));
+                        break;
+                    case 'w':
+                        word(number(arg(), INT16_MIN, UINT16_MAX));
+                        break;
+                    case 'd': {
+                        const int64_t value = number(arg(), 0, 0xFFFFFF);
+                        word(value & 0xFFFF);
+                        byte(value >> 16);
+                        break;
+                    }
+                    case 'j':
+                        target(arg());
+                        break;
+                    case 's':
+                        string(arg());
+                        break;
+                    case 'l':
+                        list(arg());
+                        break;
+                    case 'S':
+                        subOpcode(*entry.subs, arg(), false, depth);
+                        break;
+                    case 'L': {
+                        // Up to 0xFF, unless a sub-opcode that ends the list comes first
+                        bool last = false;
+                        while (next < args.size() && !m_failed) {
+                            last = subOpcode(*entry.subs, args[next++], true, depth);
+                            if (last && next < args.size()) {
+                                fail("nothing may follow the sub-opcode that ends the list");
+                            }
+                        }
+                        if (!last) {
+                            byte(0xFF);
+                        }
+                        break;
+                    }
+                    case '!':
+                        break;
+                    case 'e':
+                        expression(arg(), depth);
+                        break;
+                    case 'R': {
+                        // Words if bit 0x80 of the opcode is set, set here when a value needs it
+                        variable(arg());
+                        std::vector<std::string_view> values;
+                        if (!splitList(arg(), values) || values.empty() || values.size() > 256) {
+                            fail("expected [values], 1 to 256 of them");
+                            break;
+                        }
+                        std::vector<int64_t> numbers;
+                        for (std::string_view value : values) {
+                            numbers.push_back(number(value, INT16_MIN, UINT16_MAX));
+                        }
+                        const bool wide = std::any_of(numbers.begin(), numbers.end(), [](int64_t n) { return n < 0 || n > 0xFF; });
+                        if (wide) {
+                            m_out[params.index] |= 0x80;
+                        }
+                        byte(values.size() & 0xFF);
+                        for (int64_t value : numbers) {
+                            if (m_out[params.index] & 0x80) {
+                                word(value);
+                            } else {
+                                byte(value);
+                            }
+                        }
+                        break;
+                    }
+                    case 'Q': {
+                        byte(number(arg(), 0, 0xFF));
+                        std::vector<std::string_view> rooms;
+                        if (!splitList(arg(), rooms)) {
+                            fail("expected [rooms]");
+                            break;
+                        }
+                        for (std::string_view room : rooms) {
+                            byte(number(room, 1, 0xFF));
+                        }
+                        byte(0);
+                        break;
+                    }
+                    case 'D': {
+                        // Verb 0xFE (a constant) stops the sentence and has no objects
+                        const std::string_view verb = arg();
+                        if (isVariable(verb)) {
+                            take(*current, true);
+                            variable(verb);
+                        } else {
+                            take(*current, false);
+                            const int64_t value = number(verb, 0, 0xFF);
+                            byte(value);
+                            if (value == 0xFE) {
+                                break;
+                            }
+                        }
+                        parameter(*current, arg(), true);
+                        parameter(*current, arg(), true);
+                        break;
+                    }
+                    default:
+                        fail("bad operand spec");
+                        break;
+                }
+            }
+            if (next < args.size()) {
+                fail(std::string(entry.name) + " takes fewer operands");
+            }
+        }
+
+        bool Encoder::subOpcode(const SubOpcodes& subs, std::string_view text, bool inList, int depth) {
+            Mnemonic mnemonic;
+            if (!splitMnemonic(text, mnemonic)) {
+                fail("expected a sub-opcode");
+                return false;
+            }
+            std::string_view inner = mnemonic.rest;
+            if (!inner.empty()) {
+                if (inner.size() < 2 || inner.front() != '(' || inner.back() != ')') {
+                    fail("expected " + std::string(mnemonic.name) + "(...)");
+                    return false;
+                }
+                inner = inner.substr(1, inner.size() - 2);
+            }
+
+            uint8_t raw = 0;
+            const Opcode* entry = find(subs.table, subs.mask, mnemonic, raw);
+            if (entry == nullptr) {
+                return false;
+            }
+            const size_t at = m_out.size();
+            byte(raw);
+            Params params{at};
+            operands(*entry, params, splitItems(inner), depth);
+
+            if (!m_failed && subs.table[m_out[at] & subs.mask].code != entry->code) {
+                fail("the operands do not fit " + std::string(mnemonic.name));
+            }
+            if (inList && m_out[at] == 0xFF) {
+                fail("a 0xFF sub-opcode byte would end the list");
+            }
+            return std::strchr(entry->operands, '!') != nullptr;
+        }
+
+        int64_t Encoder::number(std::string_view text, int64_t min, int64_t max) {
+            int64_t value = 0;
+            if (!parseNumber(text, value)) {
+                fail("expected a number, not '" + std::string(text) + "'");
+                return 0;
+            }
+            if (value < min || value > max) {
+                fail(std::string(text) + " is out of range (" + std::to_string(min) + " to " + std::to_string(max) + ")");
+                return 0;
+            }
+            return value;
+        }
+
+        void Encoder::target(std::string_view text) {
+            uint32_t offset = 0;
+            if (text.size() < 2 || text[0] != '@' || !parseHex(text.substr(1), offset)) {
+                fail("expected a jump target (@XXXX)");
+            }
+            m_jumps.push_back({m_out.size(), offset, m_line});
+            word(0);
+        }
+
+        // Var[n], Local[n] or Bit[n] as the disassembler names them
+        uint16_t Encoder::variableNumber(std::string_view text) {
+            uint16_t flags = 0;
+            int64_t max = 0x3FFF;
+            size_t open = 0;
+            if (text.starts_with("Var[")) {
+                open = 3;
+            } else if (text.starts_with("Local[")) {
+                flags = 0x4000;
+                open = 5;
+            } else if (text.starts_with("Bit[")) {
+                flags = 0x8000;
+                max = 0x7FFF;
+                open = 3;
+            } else {
+                fail("expected a variable, not '" + std::string(text) + "'");
+                return 0;
+            }
+            if (text.back() != ']') {
+                fail("expected ']' after " + std::string(text));
+                return 0;
+            }
+            const uint16_t var = static_cast<uint16_t>(flags | number(text.substr(open + 1, text.size() - open - 2), 0, max));
+
+            // v5 spends 0x2000 on the index flag
+            if (m_version == ScriptVersion::V5 && (var & 0x2000)) {
+                fail(std::string(text) + " is out of range");
+            }
+            return var;
+        }
+
+        void Encoder::variable(std::string_view text) {
+            // v5: Var[n + k] and Var[n + Var[m]] carry an index, flagged with 0x2000
+            const size_t plus = text.find(" + ");
+            if (m_version != ScriptVersion::V5 || plus == std::string_view::npos) {
+                word(variableNumber(text));
+                return;
+            }
+            if (text.back() != ']') {
+                fail("expected ']' after " + std::string(text));
+                return;
+            }
+            const std::string base = std::string(text.substr(0, plus)) + "]";
+            const std::string_view index = trim(text.substr(plus + 3, text.size() - plus - 4));
+            word(variableNumber(base) | 0x2000);
+            if (isVariable(index)) {
+                word(variableNumber(index) | 0x2000);
+            } else {
+                const int64_t value = number(index, 0, UINT16_MAX);
+                if (value & 0x2000) {
+                    fail("index " + std::string(index) + " is out of range");
+                }
+                word(value);
+            }
+        }
+
+        void Encoder::parameter(Params& params, std::string_view text, bool isWord) {
+            if (isVariable(text)) {
+                take(params, true);
+                variable(text);
+                return;
+            }
+            take(params, false);
+            if (isWord) {
+                word(number(text, INT16_MIN, UINT16_MAX));
+            } else {
+                byte(number(text, 0, 0xFF));
+            }
+        }
+
+        void Encoder::string(std::string_view text) {
+            if (text.size() < 2 || text.front() != '"' || text.back() != '"') {
+                fail("expected a string");
+                return;
+            }
+            text = text.substr(1, text.size() - 2);
+            for (size_t i = 0; i < text.size(); i++) {
+                if (text[i] != '\\') {
+                    byte(static_cast<uint8_t>(text[i]));
+                    continue;
+                }
+                uint32_t code = 0;
+                if (i + 1 < text.size() && (text[i + 1] == '"' || text[i + 1] == '\\')) {
+                    byte(static_cast<uint8_t>(text[++i]));
+                } else if (i + 3 < text.size() && text[i + 1] == 'x' && parseHex(text.substr(i + 2, 2), code)) {
+                    byte(code);
+                    i += 3;
+                } else {
+                    fail("bad escape in string");
+                    return;
+                }
+            }
+            byte(0);
+        }
+
+        void Encoder::list(std::string_view text) {
+            // Word parameters, each behind its own parameter byte (canonically 0x01)
+            std::vector<std::string_view> items;
+            if (!splitList(text, items)) {
+                fail("expected [parameters]");
+                return;
+            }
+            for (std::string_view item : items) {
+                uint8_t raw = 0x01;
+                if (item.starts_with('#')) {
+                    if (!parseRaw(item.substr(0, 3), raw)) {
+                        fail("expected a #XX byte");
+                        return;
+                    }
+                    item = trim(item.substr(3));
+                }
+                Params params{m_out.size()};
+                byte(raw);
+                parameter(params, item, true);
+                if (m_out[params.index] == 0xFF) {
+                    fail("a 0xFF parameter byte would end the list");
+                }
+            }
+            byte(0xFF);
+        }
+
+        void Encoder::expression(std::string_view text, int depth) {
+            // Postfix: values, operators and nested opcodes whose result is pushed
+            if (depth >= MAX_DEPTH) {
+                fail("expression nested too deep");
+                return;
+            }
+            std::vector<std::string_view> items;
+            if (!splitList(text, items)) {
+                fail("expected [expression]");
+                return;
+            }
+            for (std::string_view item : items) {
+                std::optional<uint8_t> raw;
+                if (item.starts_with('#')) {
+                    uint8_t value = 0;
+                    if (!parseRaw(item.substr(0, 3), value)) {
+                        fail("expected a #XX byte");
+                        return;
+                    }
+                    raw = value;
+                    item = trim(item.substr(3));
+                }
+
+                const auto* op = std::find(std::begin(OPERATORS), std::end(OPERATORS), item);
+                uint8_t code = 1;
+                if (op != std::end(OPERATORS)) {
+                    code = static_cast<uint8_t>(2 + (op - std::begin(OPERATORS)));
+                } else if (item.starts_with('(')) {
+                    code = 6;
+                }
+                if (raw && (*raw & 0x1F) != code) {
+                    fail("#XX does not match the expression item " + std::string(item));
+                    return;
+                }
+
+                const size_t at = m_out.size();
+                byte(raw.value_or(code));
+                if (code == 1) {
+                    Params params{at};
+                    parameter(params, item, true);
+                } else if (code == 6) {
+                    if (item.size() < 2 || item.back() != ')') {
+                        fail("expected (opcode ...)");
+                        return;
+                    }
+                    instruction(item.substr(1, item.size() - 2), depth + 1);
+                }
+            }
+            byte(0xFF);
+        }
+
+        struct Label {
+            uint32_t offset;                // In the listing's block
+            uint32_t position;              // In the new one
+            size_t line;
+        };
+
+        // Where an offset of the old block went: a label's new position, or the same
+        // distance past the nearest label before it
+        uint32_t relocate(const std::vector<Label>& labels, uint32_t offset) {
+            if (offset >= 0x80000000u) {
+                return offset;              // Before the block
+            }
+            const auto it = std::upper_bound(labels.begin(), labels.end(), offset, [](uint32_t value, const Label& label) {
+                return value < label.offset;
+            });
+            if (it == labels.begin()) {
+                return offset;
+            }
+            const Label& label = *(it - 1);
+            return label.position + (offset - label.offset);
+        }
+
+    } // namespace
+
+    bool ScriptAssembler::assemble(ScriptVersion version, ChunkTag tag, std::string_view text, std::vector<uint8_t>& block,
+                                   std::string& error) {
+        block.assign(Chunk::HEADER_SIZE, 0);
+        m_errorLine = 0;
+
+        Encoder encoder(version, block);
+        std::vector<Label> labels;
+        std::vector<Label> pending;         // Labels of lines with nothing on them yet
+        std::vector<Jump> verbs;
+        bool inCode = false;
+        bool hasLocalScript = false;
+
+        auto fail = [&](size_t line, const std::string& message) {
+            m_errorLine = line;
+            error = "line " + std::to_string(line + 1) + ": " + message;
+            return false;
+        };
+
+        size_t line = 0;
+        for (size_t start = 0; start <= text.size(); line++) {
+            const size_t end = std::min(text.find('\n', start), text.size());
+            std::string_view body = trim(stripComment(text.substr(start, end - start)));
+            start = end + 1;
+            encoder.setLine(line);
+
+            // Label: the hex offset the disassembler put in front
+            size_t digits = 0;
+            while (digits < body.size() && digits < 8 && isHexDigit(body[digits])) {
+                digits++;
+            }
+            if (digits > 0 && digits < body.size() && body[digits] == ':') {
+                uint32_t offset = 0;
+                parseHex(body.substr(0, digits), offset);
+                pending.push_back({offset, 0, line});
+                body = trim(body.substr(digits + 1));
+            }
+            if (body.empty()) {
+                continue;
+            }
+
+            const bool isDirective = body.starts_with('.');
+            if (!isDirective && !inCode) {
+                // The header ends where the code starts: the verb table with its zero
+                if (tag == tags::LSCR && !hasLocalScript) {
+                    return fail(line, "an LSCR block starts with .localScript");
+                }
+                if (tag == tags::VERB) {
+                    encoder.byte(0);
+                }
+                inCode = true;
+            }
+            for (Label& label : pending) {
+                label.position = static_cast<uint32_t>(block.size());
+                labels.push_back(label);
+            }
+            pending.clear();
+
+            if (isDirective) {
+                if (inCode) {
+                    return fail(line, "directives come before the code");
+                }
+                const size_t space = body.find(' ');
+                const std::string_view directive = body.substr(0, space);
+                const std::vector<std::string_view> args =
+                    splitItems(space == std::string_view::npos ? std::string_view() : body.substr(space));
+                if (directive == ".localScript" && tag == tags::LSCR && !hasLocalScript && args.size() == 1) {
+                    encoder.byte(encoder.number(args[0], 0, 0xFF));
+                    hasLocalScript = true;
+                } else if (directive == ".verb" && tag == tags::VERB && args.size() == 2) {
+                    encoder.byte(encoder.number(args[0], 1, 0xFF));
+                    encoder.target(args[1]);
+                    verbs.push_back(encoder.getJumps().back());
+                    encoder.getJumps().pop_back();
+                } else {
+                    return fail(line, "unexpected " + std::string(directive) + " in a " + tagToString(tag) + " block");
+                }
+            } else if (body.starts_with("db ")) {
+                for (std::string_view item : splitItems(body.substr(3))) {
+                    encoder.byte(encoder.number(item, 0, 0xFF));
+                }
+            } else {
+                encoder.instruction(body, 0);
+            }
+            if (encoder.hasFailed()) {
+                return fail(line, encoder.getError());
+            }
+        }
+        if (tag == tags::VERB && !inCode) {
+            encoder.byte(0);
+        }
+        for (Label& label : pending) {
+            label.position = static_cast<uint32_t>(block.size());
+            labels.push_back(label);
+        }
+
+        // An offset may be labelled twice (a note and the bytes after it), but not moved apart
+        std::stable_sort(labels.begin(), labels.end(), [](const Label& a, const Label& b) {
+            return a.offset < b.offset;
+        });
+        for (size_t i = 1; i < labels.size(); i++) {
+            if (labels[i].offset == labels[i - 1].offset && labels[i].position != labels[i - 1].position) {
+                return fail(labels[i].line, "offset label used twice");
+            }
+        }
+
+        for (const Jump& jump : encoder.getJumps()) {
+            // Offsets wrap like the engine's, so targets before the block come out as they went in
+            const int64_t delta = static_cast<int32_t>(relocate(labels, jump.target) - static_cast<uint32_t>(jump.position + 2));
+            if (delta < INT16_MIN || delta > INT16_MAX) {
+                return fail(jump.line, "jump target is too far away");
+            }
+            block[jump.position] = static_cast<uint8_t>(delta & 0xFF);
+            block[jump.position + 1] = static_cast<uint8_t>((delta >> 8) & 0xFF);
+        }
+        for (const Jump& verb : verbs) {
+            const uint32_t entry = relocate(labels, verb.target);
+            if (entry > UINT16_MAX) {
+                return fail(verb.line, "verb entry point is out of range");
+            }
+            block[verb.position] = static_cast<uint8_t>(entry & 0xFF);
+            block[verb.position + 1] = static_cast<uint8_t>(entry >> 8);
+        }
+
+        const uint32_t size = static_cast<uint32_t>(block.size());
+        for (int i = 0; i < 4; i++) {
+            block[i] = static_cast<uint8_t>(tag >> (24 - i * 8));
+            block[4 + i] = static_cast<uint8_t>(size >> (24 - i * 8));
+        }
+        return true;
+    }
+
+} // namespace scummredux
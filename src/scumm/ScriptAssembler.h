@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Chunk.h"
+#include "ScriptDisassembler.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scummredux {
+
+    // Turns a ScriptDisassembler listing back into a script block. Every operand
+    // letter of the shared opcode tables is read the way the disassembler writes it,
+    // so an unedited listing assembles to the original bytes.
+    //
+    // The "XXXX:" offset in front of a line is a label: it names where the line was
+    // in the block the listing came from, and jump targets (@XXXX) and verb entry
+    // points are moved along with it. A target without a label of its own keeps its
+    // distance to the nearest label before it. Lines may be added without an offset,
+    // "; ..." is a comment and "db 0x.., 0x.." writes raw bytes.
+    class ScriptAssembler {
+    public:
+        // Whole block, header included. On failure error says why and getErrorLine()
+        // which line of the text (0-based).
+        bool assemble(ScriptVersion version, ChunkTag tag, std::string_view text, std::vector<uint8_t>& block,
+                      std::string& error);
+
+        size_t getErrorLine() const { return m_errorLine; }
+
+    private:
+        size_t m_errorLine = 0;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,686 @@
+#include "ScriptDecompiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace scummredux {
+
+    namespace {
+
+        using Instruction = ScriptDisassembler::Instruction;
+        using Flow = ScriptDisassembler::Flow;
+        using Line = ScriptDecompiler::Line;
+
+        constexpr size_t NO_BLOCK = SIZE_MAX;
+        constexpr int MAX_NESTING = 64;     // Deeper structures are left as gotos
+
+        // An expression that remembers its comparison, so negating it flips the
+        // operator instead of wrapping it in !( )
+        struct Condition {
+            std::string left;
+            const char* op = nullptr;       // Comparison; without one, left is everything
+            std::string right;
+            bool negated = false;
+        };
+
+        Condition value(std::string text) {
+            Condition condition;
+            condition.left = std::move(text);
+            return condition;
+        }
+
+        Condition negate(Condition condition) {
+            static constexpr const char* OPPOSITES[][2] = {{"==", "!="}, {"<", ">="}, {">", "<="}};
+            if (condition.op != nullptr && !condition.negated) {
+                for (const auto& pair : OPPOSITES) {
+                    if (std::strcmp(condition.op, pair[0]) == 0 || std::strcmp(condition.op, pair[1]) == 0) {
+                        condition.op = std::strcmp(condition.op, pair[0]) == 0 ? pair[1] : pair[0];
+                        return condition;
+                    }
+                }
+            }
+            condition.negated = !condition.negated;
+            return condition;
+        }
+
+        bool isSimple(const std::string& text) {
+            return text.find(' ') == std::string::npos;
+        }
+
+        // Nested: as the operand of another operator
+        std::string render(const Condition& condition, bool nested = false) {
+            std::string text = condition.left;
+            if (condition.op != nullptr) {
+                text += ' ';
+                text += condition.op;
+                text += ' ';
+                text += condition.right;
+            }
+            if (condition.negated) {
+                text = isSimple(text) ? "!" + text : "!(" + text + ")";
+            }
+            return nested && !isSimple(text) ? "(" + text + ")" : text;
+        }
+
+        // First item of an argument list and the rest. The first item of every list
+        // split here is a variable or a number, neither of which contains ", ".
+        std::pair<std::string, std::string> splitFirst(const std::string& args) {
+            const size_t comma = args.find(", ");
+            if (comma == std::string::npos) {
+                return {args, {}};
+            }
+            return {args.substr(0, comma), args.substr(comma + 2)};
+        }
+
+        // Items of a disassembled list, split at the top-level commas
+        std::vector<std::string> splitItems(const std::string& list) {
+            std::vector<std::string> items;
+            int depth = 0;
+            bool quoted = false;
+            size_t start = 0;
+            for (size_t i = 0; i < list.size(); i++) {
+                const char c = list[i];
+                if (quoted) {
+                    if (c == '\\') {
+                        i++;
+                    } else if (c == '"') {
+                        quoted = false;
+                    }
+                } else if (c == '"') {
+                    quoted = true;
+                } else if (c == '(' || c == '[') {
+                    depth++;
+                } else if (c == ')' || c == ']') {
+                    depth--;
+                } else if (c == ',' && depth == 0 && i + 1 < list.size() && list[i + 1] == ' ') {
+                    items.push_back(list.substr(start, i - start));
+                    start = i + 2;
+                    i++;
+                }
+            }
+            items.push_back(list.substr(start));
+            return items;
+        }
+
+        // "name args" (a nested opcode) as a call
+        std::string call(const std::string& text) {
+            const size_t space = text.find(' ');
+            if (space == std::string::npos) {
+                return text + "()";
+            }
+            return text.substr(0, space) + "(" + text.substr(space + 1) + ")";
+        }
+
+        // v5 expression bodies are postfix: [5, Var[3], add] becomes 5 + Var[3]
+        std::string infix(const std::string& list) {
+            if (list.size() < 2 || list.front() != '[' || list.back() != ']') {
+                return list;
+            }
+
+            static constexpr const char* OPERATORS[][2] = {{"add", "+"}, {"sub", "-"}, {"mul", "*"}, {"div", "/"}};
+            std::vector<Condition> stack;
+            for (std::string item : splitItems(list.substr(1, list.size() - 2))) {
+                // Non-canonical encodings do not change the meaning
+                if (item.size() > 4 && item[0] == '#' && item[3] == ' ') {
+                    item.erase(0, 4);
+                }
+
+                const char* op = nullptr;
+                for (const auto& pair : OPERATORS) {
+                    if (item == pair[0]) {
+                        op = pair[1];
+                    }
+                }
+                if (op != nullptr) {
+                    if (stack.size() < 2) {
+                        return list;
+                    }
+                    const Condition right = std::move(stack.back());
+                    stack.pop_back();
+                    Condition& left = stack.back();
+                    left = value(render(left, true) + " " + op + " " + render(right, true));
+                } else if (item.size() >= 2 && item.front() == '(' && item.back() == ')') {
+                    stack.push_back(value(call(item.substr(1, item.size() - 2))));
+                } else {
+                    stack.push_back(value(item));
+                }
+            }
+            return stack.size() == 1 ? render(stack.back()) : list;
+        }
+
+        // v5 branches fall through when their test holds
+        Condition conditionV5(const Instruction& instruction) {
+            const auto [a, b] = splitFirst(instruction.args);
+            switch (instruction.opcode) {
+                case 0x48: return {a, "==", b};             // isEqual
+                case 0x08: return {a, "!=", b};             // isNotEqual
+                case 0x78: return {a, "<", b};              // isGreater: the parameter is greater
+                case 0x04: return {a, "<=", b};             // isGreaterEqual
+                case 0x44: return {a, ">", b};              // isLess
+                case 0x38: return {a, ">=", b};             // isLessEqual
+                case 0x28: return {a, "==", "0"};           // equalZero
+                case 0xA8: return {a, "!=", "0"};           // notEqualZero
+                case 0x4F: return {"getState(" + a + ")", "==", b};
+                case 0x2F: return {"getState(" + a + ")", "!=", b};
+                case 0x1D: return value("classOfIs(" + instruction.args + ")");
+                default:   return value(instruction.name + "(" + instruction.args + ")");
+            }
+        }
+
+        std::string statementV5(const Instruction& instruction) {
+            if (!instruction.hasResult) {
+                return instruction.name + "(" + instruction.args + ")";
+            }
+            const auto [result, rest] = splitFirst(instruction.args);
+            switch (instruction.opcode) {
+                case 0x1A: return result + " = " + rest;        // move
+                case 0x5A: return result + " += " + rest;
+                case 0x3A: return result + " -= " + rest;
+                case 0x1B: return result + " *= " + rest;
+                case 0x5B: return result + " /= " + rest;
+                case 0x17: return result + " &= " + rest;
+                case 0x57: return result + " |= " + rest;
+                case 0x46: return result + "++";
+                case 0xC6: return result + "--";
+                case 0xAC: return result + " = " + infix(rest); // expression
+                default:   return result + " = " + instruction.name + "(" + rest + ")";
+            }
+        }
+
+        // Values a foldable v6 opcode pops, -1 for opcodes shown as calls
+        int popsV6(uint8_t opcode) {
+            switch (opcode) {
+                case 0x4E: case 0x4F: case 0x56: case 0x57:
+                    return 0;
+                case 0x06: case 0x07: case 0x0C: case 0x0D: case 0x1A: case 0xA7: case 0x42: case 0x43:
+                case 0x52: case 0x53: case 0x5A: case 0x5B: case 0x5C: case 0x5D:
+                    return 1;
+                case 0x0A: case 0x0B: case 0x46: case 0x47: case 0xD6: case 0xD7:
+                    return 2;
+                case 0x4A: case 0x4B:
+                    return 3;
+                default:
+                    return opcode >= 0x0E && opcode <= 0x19 ? 2 : -1;
+            }
+        }
+
+        const char* binaryOperatorV6(uint8_t opcode) {
+            static constexpr const char* OPERATORS[] = {"==", "!=", ">", "<", "<=", ">=", "+", "-", "*", "/", "&&", "||"};
+            if (opcode >= 0x0E && opcode <= 0x19) {
+                return OPERATORS[opcode - 0x0E];
+            }
+            return opcode == 0xD6 ? "&" : "|";
+        }
+
+        class Structurer {
+        public:
+            Structurer(const ScriptDisassembler& script, std::vector<Line>& lines) : m_script(script), m_lines(lines) {}
+
+            ScriptDecompiler::Stats run();
+
+        private:
+            struct BasicBlock {
+                uint32_t start = 0;
+                size_t first = 0;           // Instruction indices, inclusive
+                size_t last = 0;
+                size_t firstLine = NO_BLOCK;    // Output line it starts at
+                int depth = 0;
+            };
+
+            struct Statement {
+                uint32_t offset;
+                std::string text;
+            };
+
+            // A block's statements and, if it ends in a branch, the condition under
+            // which it falls through
+            struct BlockCode {
+                std::vector<Statement> statements;
+                Condition condition;
+            };
+
+            void decodeAll();
+            void buildBlocks();
+
+            size_t blockAt(uint32_t offset) const;
+            const Instruction& terminal(size_t block) const { return m_instructions[m_blocks[block].last]; }
+
+            BlockCode blockCode(size_t block) const;
+            void codeV6(const BasicBlock& block, BlockCode& code) const;
+
+            void region(size_t from, size_t to, int depth);
+            void beginBlock(size_t block, int depth);
+            void emit(int depth, uint32_t offset, std::string text);
+            void emitClose(int depth, const char* text = "}");
+            void emitGoto(int depth, uint32_t offset, const std::string& prefix, uint32_t target);
+            void insertMarks();
+
+            const ScriptDisassembler& m_script;
+            std::vector<Line>& m_lines;
+            std::vector<Instruction> m_instructions;
+            std::vector<BasicBlock> m_blocks;
+            std::vector<uint8_t> m_consumed;        // Terminal already part of an enclosing structure
+            std::vector<uint8_t> m_loopTried;
+            std::vector<Condition> m_loopConditions;    // Of consumed do-while branches
+            std::vector<uint32_t> m_gotoTargets;
+            uint32_t m_codeEnd = 0;
+            ScriptDecompiler::Stats m_stats;
+        };
+
+        ScriptDecompiler::Stats Structurer::run() {
+            m_lines.clear();
+            decodeAll();
+            buildBlocks();
+
+            const auto block = m_script.getBlock();
+            if (m_script.getTag() == tags::LSCR && block.size() > Chunk::HEADER_SIZE) {
+                emit(0, Chunk::HEADER_SIZE, "// Local script " + std::to_string(block[Chunk::HEADER_SIZE]));
+            }
+            region(0, m_blocks.size(), 0);
+            if (!m_stats.complete) {
+                char note[96];
+                std::snprintf(note, sizeof(note), "// 0x%02X at @%04X does not decode, the rest is not shown",
+                              block[m_codeEnd], m_codeEnd);
+                emit(0, m_codeEnd, note);
+            }
+            insertMarks();
+
+            // Closing lines and labels take the offset of the code before them
+            for (size_t i = 1; i < m_lines.size(); i++) {
+                m_lines[i].offset = std::max(m_lines[i].offset, m_lines[i - 1].offset);
+            }
+
+            m_stats.instructions = m_instructions.size();
+            m_stats.blocks = m_blocks.size();
+            return m_stats;
+        }
+
+        void Structurer::decodeAll() {
+            uint32_t offset = m_script.getCodeStart();
+            const uint32_t end = static_cast<uint32_t>(m_script.getBlock().size());
+            while (offset < end) {
+                Instruction instruction;
+                if (!m_script.decode(offset, instruction)) {
+                    m_stats.complete = false;
+                    break;
+                }
+                offset = instruction.end;
+                m_instructions.push_back(std::move(instruction));
+            }
+            m_codeEnd = offset;
+        }
+
+        void Structurer::buildBlocks() {
+            // Leaders: the first instruction, entry points, jump targets and whatever follows a jump
+            const size_t count = m_instructions.size();
+            std::vector<uint8_t> leaders(count, 0);
+            auto mark = [&](uint32_t offset) {
+                const auto it = std::lower_bound(m_instructions.begin(), m_instructions.end(), offset,
+                                                 [](const Instruction& instruction, uint32_t value) {
+                                                     return instruction.offset < value;
+                                                 });
+                if (it != m_instructions.end() && it->offset == offset) {
+                    leaders[it - m_instructions.begin()] = 1;
+                }
+            };
+
+            if (count > 0) {
+                leaders[0] = 1;
+            }
+            for (const auto& [verb, offset] : m_script.getEntryPoints()) {
+                mark(offset);
+            }
+            for (size_t i = 0; i < count; i++) {
+                const Instruction& instruction = m_instructions[i];
+                if (instruction.flow == Flow::Next) {
+                    continue;
+                }
+                if (i + 1 < count) {
+                    leaders[i + 1] = 1;
+                }
+                if (instruction.flow == Flow::Branch || instruction.flow == Flow::Jump) {
+                    mark(instruction.target);
+                }
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                if (leaders[i]) {
+                    m_blocks.push_back({m_instructions[i].offset, i, i});
+                } else {
+                    m_blocks.back().last = i;
+                }
+            }
+            m_consumed.assign(m_blocks.size(), 0);
+            m_loopTried.assign(m_blocks.size(), 0);
+            m_loopConditions.resize(m_blocks.size());
+        }
+
+        size_t Structurer::blockAt(uint32_t offset) const {
+            // Jumping to the end of the code is how a script returns
+            if (offset == m_codeEnd && m_stats.complete) {
+                return m_blocks.size();
+            }
+            const auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), offset, [](const BasicBlock& block, uint32_t value) {
+                return block.start < value;
+            });
+            return it != m_blocks.end() && it->start == offset ? static_cast<size_t>(it - m_blocks.begin()) : NO_BLOCK;
+        }
+
+        Structurer::BlockCode Structurer::blockCode(size_t index) const {
+            BlockCode code;
+            const BasicBlock& block = m_blocks[index];
+            if (m_script.getVersion() != ScriptVersion::V5) {
+                codeV6(block, code);
+                return code;
+            }
+
+            for (size_t i = block.first; i <= block.last; i++) {
+                const Instruction& instruction = m_instructions[i];
+                if (instruction.flow == Flow::Branch) {
+                    code.condition = conditionV5(instruction);
+                } else if (instruction.flow != Flow::Jump) {
+                    code.statements.push_back({instruction.offset, statementV5(instruction) + ";"});
+                }
+            }
+            return code;
+        }
+
+        void Structurer::codeV6(const BasicBlock& block, BlockCode& code) const {
+            // Pushes and operators fold into expressions; values whose consumer is not
+            // known (calls pop a number of them that depends on the opcode) are shown
+            // as the pushes they are
+            struct StackValue {
+                Condition value;
+                uint32_t offset;            // Of the first instruction that built it
+            };
+            std::vector<StackValue> stack;
+
+            auto flush = [&] {
+                for (const StackValue& item : stack) {
+                    code.statements.push_back({item.offset, "push(" + render(item.value) + ");"});
+                }
+                stack.clear();
+            };
+            auto statement = [&](uint32_t offset, const std::string& text) {
+                flush();
+                code.statements.push_back({offset, text + ";"});
+            };
+            auto pop = [&] {
+                Condition top = std::move(stack.back().value);
+                stack.pop_back();
+                return top;
+            };
+
+            for (size_t i = block.first; i <= block.last; i++) {
+                const Instruction& instruction = m_instructions[i];
+                const uint8_t opcode = instruction.opcode;
+                if (opcode <= 0x03) {
+                    stack.push_back({value(instruction.args), instruction.offset});
+                    continue;
+                }
+
+                const int pops = popsV6(opcode);
+                if (pops < 0 || stack.size() < static_cast<size_t>(pops)) {
+                    if (instruction.flow == Flow::Branch) {
+                        flush();
+                        code.condition = opcode == 0x5C ? negate(value("pop()")) : value("pop()");
+                    } else if (instruction.flow == Flow::Jump) {
+                        flush();
+                    } else {
+                        statement(instruction.offset, instruction.name + "(" + instruction.args + ")");
+                    }
+                    continue;
+                }
+
+                const uint32_t offset = pops > 0 ? stack[stack.size() - pops].offset : instruction.offset;
+                const std::string& array = instruction.args;
+                switch (opcode) {
+                    case 0x06: case 0x07: {
+                        const Condition index = pop();
+                        stack.push_back({value(array + "[" + render(index) + "]"), offset});
+                        break;
+                    }
+                    case 0x0A: case 0x0B: {
+                        const Condition base = pop();
+                        const Condition index = pop();
+                        stack.push_back({value(array + "[" + render(index) + ", " + render(base) + "]"), offset});
+                        break;
+                    }
+                    case 0x0C:
+                        stack.push_back(stack.back());
+                        break;
+                    case 0x0D:
+                        stack.back().value = negate(std::move(stack.back().value));
+                        break;
+                    case 0x1A: case 0xA7:
+                        statement(offset, "pop(" + render(pop()) + ")");
+                        break;
+                    case 0x42: case 0x43:
+                        statement(offset, array + " = " + render(pop()));
+                        break;
+                    case 0x46: case 0x47: {
+                        const Condition stored = pop();
+                        const Condition index = pop();
+                        statement(offset, array + "[" + render(index) + "] = " + render(stored));
+                        break;
+                    }
+                    case 0x4A: case 0x4B: {
+                        const Condition stored = pop();
+                        const Condition base = pop();
+                        const Condition index = pop();
+                        statement(offset, array + "[" + render(index) + ", " + render(base) + "] = " + render(stored));
+                        break;
+                    }
+                    case 0x4E: case 0x4F:
+                        statement(offset, array + "++");
+                        break;
+                    case 0x56: case 0x57:
+                        statement(offset, array + "--");
+                        break;
+                    case 0x52: case 0x53:
+                        statement(offset, array + "[" + render(pop()) + "]++");
+                        break;
+                    case 0x5A: case 0x5B:
+                        statement(offset, array + "[" + render(pop()) + "]--");
+                        break;
+                    case 0x5C:              // if: jumps when true
+                        code.condition = negate(pop());
+                        flush();
+                        break;
+                    case 0x5D:              // ifNot: jumps when false
+                        code.condition = pop();
+                        flush();
+                        break;
+                    default: {
+                        const Condition right = pop();
+                        const Condition left = pop();
+                        const char* op = binaryOperatorV6(opcode);
+                        if (opcode <= 0x13) {
+                            stack.push_back({{render(left, true), op, render(right, true)}, offset});
+                        } else {
+                            stack.push_back({value(render(left, true) + " " + op + " " + render(right, true)), offset});
+                        }
+                        break;
+                    }
+                }
+            }
+            flush();
+        }
+
+        void Structurer::region(size_t from, size_t to, int depth) {
+            size_t i = from;
+            while (i < to) {
+                // A branch back to this block from further down closes a do-while
+                if (!m_loopTried[i] && depth < MAX_NESTING) {
+                    m_loopTried[i] = 1;
+                    size_t last = NO_BLOCK;
+                    for (size_t j = to; j-- > i;) {
+                        const Instruction& branch = terminal(j);
+                        if (branch.flow == Flow::Branch && branch.target == m_blocks[i].start && !m_consumed[j]) {
+                            last = j;
+                            break;
+                        }
+                    }
+                    if (last != NO_BLOCK) {
+                        m_consumed[last] = 1;
+                        beginBlock(i, depth);
+                        emit(depth, m_blocks[i].start, "do {");
+                        region(i, last + 1, depth + 1);
+                        emitClose(depth, ("} while (" + render(negate(m_loopConditions[last])) + ");").c_str());
+                        m_stats.structures++;
+                        i = last + 1;
+                        continue;
+                    }
+                }
+
+                beginBlock(i, depth);
+                BlockCode code = blockCode(i);
+                for (Statement& statement : code.statements) {
+                    emit(depth, statement.offset, std::move(statement.text));
+                }
+
+                const Instruction& exit = terminal(i);
+                if (m_consumed[i]) {
+                    m_loopConditions[i] = std::move(code.condition);
+                    i++;
+                    continue;
+                }
+                if (exit.flow == Flow::Jump && blockAt(exit.target) != i + 1) {
+                    emitGoto(depth, exit.offset, "", exit.target);
+                }
+                if (exit.flow != Flow::Branch) {
+                    i++;
+                    continue;
+                }
+
+                const size_t skip = blockAt(exit.target);
+                if (skip == NO_BLOCK || skip <= i || skip > to || depth >= MAX_NESTING) {
+                    // Backwards or out of this region: stays a jump
+                    emitGoto(depth, exit.offset, "if (" + render(negate(code.condition)) + ") ", exit.target);
+                    i++;
+                    continue;
+                }
+
+                // The body's last block decides between if, if/else and while
+                const size_t tail = skip - 1;
+                const Instruction& tailExit = terminal(tail);
+                if (tail > i && tailExit.flow == Flow::Jump && !m_consumed[tail]) {
+                    if (tailExit.target == m_blocks[i].start && code.statements.empty()) {
+                        m_consumed[tail] = 1;
+                        emit(depth, exit.offset, "while (" + render(code.condition) + ") {");
+                        region(i + 1, skip, depth + 1);
+                        emitClose(depth);
+                        m_stats.structures++;
+                        i = skip;
+                        continue;
+                    }
+
+                    const size_t join = blockAt(tailExit.target);
+                    if (join != NO_BLOCK && join > skip && join <= to) {
+                        m_consumed[tail] = 1;
+                        emit(depth, exit.offset, "if (" + render(code.condition) + ") {");
+                        region(i + 1, skip, depth + 1);
+                        emit(depth, tailExit.offset, "} else {");
+                        region(skip, join, depth + 1);
+                        emitClose(depth);
+                        m_stats.structures++;
+                        i = join;
+                        continue;
+                    }
+                }
+
+                emit(depth, exit.offset, "if (" + render(code.condition) + ") {");
+                region(i + 1, skip, depth + 1);
+                emitClose(depth);
+                m_stats.structures++;
+                i = skip;
+            }
+        }
+
+        void Structurer::beginBlock(size_t block, int depth) {
+            if (m_blocks[block].firstLine == NO_BLOCK) {
+                m_blocks[block].firstLine = m_lines.size();
+                m_blocks[block].depth = depth;
+            }
+        }
+
+        void Structurer::emit(int depth, uint32_t offset, std::string text) {
+            m_lines.push_back({offset, std::string(static_cast<size_t>(depth) * 4, ' ') + text});
+        }
+
+        void Structurer::emitClose(int depth, const char* text) {
+            emit(depth, m_lines.empty() ? 0 : m_lines.back().offset, text);
+        }
+
+        void Structurer::emitGoto(int depth, uint32_t offset, const std::string& prefix, uint32_t target) {
+            char label[32];
+            std::snprintf(label, sizeof(label), "goto @%04X;", target);
+            std::string text = prefix + label;
+            if (blockAt(target) == NO_BLOCK) {
+                text += "  // not an instruction of this script";
+            } else {
+                m_gotoTargets.push_back(target);
+            }
+            emit(depth, offset, std::move(text));
+            m_stats.gotos++;
+        }
+
+        void Structurer::insertMarks() {
+            // Verb entry comments and goto labels go in front of their block's first line
+            struct Mark {
+                size_t position;
+                int order;
+                Line line;
+            };
+            std::vector<Mark> marks;
+            auto add = [&](size_t block, int order, const std::string& text) {
+                const bool atEnd = block == m_blocks.size();
+                const size_t position = atEnd ? m_lines.size() : m_blocks[block].firstLine;
+                const int depth = atEnd ? 0 : m_blocks[block].depth;
+                const uint32_t offset = atEnd ? m_codeEnd : m_blocks[block].start;
+                marks.push_back({position, order, {offset, std::string(static_cast<size_t>(depth) * 4, ' ') + text}});
+            };
+
+            for (const auto& [verb, offset] : m_script.getEntryPoints()) {
+                const size_t block = blockAt(offset);
+                if (block != NO_BLOCK && block < m_blocks.size()) {
+                    add(block, 0, "// Verb " + std::to_string(verb));
+                }
+            }
+            std::sort(m_gotoTargets.begin(), m_gotoTargets.end());
+            m_gotoTargets.erase(std::unique(m_gotoTargets.begin(), m_gotoTargets.end()), m_gotoTargets.end());
+            for (uint32_t target : m_gotoTargets) {
+                char label[16];
+                std::snprintf(label, sizeof(label), "@%04X:", target);
+                add(blockAt(target), 1, label);
+            }
+            if (marks.empty()) {
+                return;
+            }
+
+            std::stable_sort(marks.begin(), marks.end(), [](const Mark& a, const Mark& b) {
+                return a.position != b.position ? a.position < b.position : a.order < b.order;
+            });
+            std::vector<Line> merged;
+            merged.reserve(m_lines.size() + marks.size());
+            size_t next = 0;
+            for (size_t i = 0; i <= m_lines.size(); i++) {
+                while (next < marks.size() && marks[next].position == i) {
+                    merged.push_back(std::move(marks[next++].line));
+                }
+                if (i < m_lines.size()) {
+                    merged.push_back(std::move(m_lines[i]));
+                }
+            }
+            m_lines = std::move(merged);
+        }
+
+    } // namespace
+
+    ScriptDecompiler::Stats ScriptDecompiler::decompile(const ScriptDisassembler& script, std::vector<Line>& lines) {
+        return Structurer(script, lines).run();
+    }
+
+} // namespace scummredux
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ScriptDisassembler.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace scummredux {
+
+    // Turns a script back into structured, SCUMM-like source. The code is cut into
+    // basic blocks at jump targets and after every jump, and the control-flow graph
+    // over them (blocks in offset order, edges from the jump opcodes) is matched
+    // against the shapes the SCUMM compiler emits:
+    //     branch over a body                          if (...) { }
+    //     branch over a body that jumps past more     if (...) { } else { }
+    //     branch over a body that jumps back to it    while (...) { }
+    //     branch back to the start of a block         do { } while (...)
+    // Edges that fit none of them stay gotos to labels, so the output never claims a
+    // structure the code does not have. v6 conditions and assignments are rebuilt
+    // from the pushes and operators in front of them.
+    class ScriptDecompiler {
+    public:
+        using Line = ScriptDisassembler::Line;
+
+        struct Stats {
+            size_t instructions = 0;
+            size_t blocks = 0;
+            size_t structures = 0;          // if, if/else, while and do-while recovered
+            size_t gotos = 0;
+            bool complete = true;           // False if the code stops decoding part way
+        };
+
+        // The disassembler must have a block loaded. Lines carry the block offset they
+        // came from, never decreasing, like a disassembly listing.
+        static Stats decompile(const ScriptDisassembler& script, std::vector<Line>& lines);
+
+        // Part of every cache key: bump it when the output changes
+        static constexpr uint32_t VERSION = 2;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,719 @@
+#include "ScriptDisassembler.h"
+#include "ScriptOpcodes.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+
+namespace scummredux {
+
+    namespace {
+        using namespace bytecode;
+
+        constexpr int MAX_DEPTH = 4;        // Opcodes nested in v5 expressions
+
+        void appendHex(std::string& text, uint32_t value, const char* format) {
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), format, value);
+            text += buffer;
+        }
+
+        void appendItem(std::string& list, const std::string& item) {
+            if (!list.empty()) {
+                list += ", ";
+            }
+            list += item;
+        }
+
+        // Bit, local or global variable; v5 index flags are stripped by the caller
+        std::string formatVariable(uint16_t var) {
+            if (var & 0x8000) {
+                return "Bit[" + std::to_string(var & 0x7FFF) + "]";
+            }
+            if (var & 0x4000) {
+                return "Local[" + std::to_string(var & 0x3FFF) + "]";
+            }
+            return "Var[" + std::to_string(var & 0x3FFF) + "]";
+        }
+
+        bool symbolOf(char role, ScriptDisassembler::SymbolKind& kind) {
+            using SymbolKind = ScriptDisassembler::SymbolKind;
+            switch (role) {
+                case 'S': kind = SymbolKind::Script; return true;
+                case 'O': kind = SymbolKind::Object; return true;
+                case 'R': kind = SymbolKind::Room; return true;
+                default: return false;
+            }
+        }
+
+        // The parameter bits of one byte, taken from the top down
+        struct Params {
+            uint8_t byte = 0;
+            uint8_t next = 0x80;
+            uint8_t set = 0;                // Taken bits that were set
+
+            bool take() {
+                const uint8_t bit = next;
+                next >>= 1;
+                if (byte & bit) {
+                    set |= bit;
+                    return true;
+                }
+                return false;
+            }
+        };
+
+        // Reads one instruction at a time out of a block
+        class Decoder {
+        public:
+            Decoder(ScriptVersion version, std::span<const uint8_t> data, size_t position)
+                : m_version(version), m_data(data), m_position(position) {}
+
+            bool instruction(std::string& name, std::string& args) {
+                m_start = static_cast<uint32_t>(m_position);
+                m_stackRoles = nullptr;
+                const bool decoded = m_version == ScriptVersion::V5 ? decodeV5(name, args, 0) : decodeV6(name, args);
+                return decoded && !m_overrun;
+            }
+
+            bool instruction(std::string& text) {
+                std::string args;
+                if (!instruction(text, args)) {
+                    return false;
+                }
+                joinArgs(text, args);
+                return true;
+            }
+
+            size_t getPosition() const { return m_position; }
+
+            // Of the last instruction: its table entry, canonical encoding and where its
+            // jump target starts in args (npos without one)
+            const Opcode& getEntry() const { return *m_entry; }
+            uint8_t getCanonical() const { return m_canonical; }
+            uint32_t getTarget() const { return m_target; }
+            size_t getTargetItem() const { return m_targetItem; }
+
+            // References are collected while decoding once a list is set. v6 opcodes
+            // leave theirs to the caller, which knows what was pushed: the roles of the
+            // popped arguments, and the value of a push.
+            void setReferences(std::vector<ScriptDisassembler::Reference>* references) { m_references = references; }
+            const char* getStackRoles() const { return m_stackRoles; }
+            int32_t getConstant() const { return m_constant; }
+
+            static void joinArgs(std::string& text, const std::string& args) {
+                if (!args.empty()) {
+                    text += ' ';
+                    text += args;
+                }
+            }
+
+        private:
+            uint8_t byte() {
+                if (m_position >= m_data.size()) {
+                    m_overrun = true;
+                    return 0;
+                }
+                return m_data[m_position++];
+            }
+
+            uint16_t word() {
+                const uint8_t low = byte();
+                return static_cast<uint16_t>(low | (byte() << 8));
+            }
+
+            bool decodeV5(std::string& name, std::string& args, int depth);
+            bool decodeV6(std::string& name, std::string& args);
+            bool operands(const Opcode& entry, Params& params, std::string& args, int depth);
+            void reference(ScriptDisassembler::SymbolKind kind, uint16_t number);
+            std::string variableName(uint16_t var);
+            bool subOpcode(const SubOpcodes& subs, std::string& text, bool& last, int depth);
+
+            // Writes the encoding as #XX when the operands would not produce it, or the
+            // name alone would not tell it apart
+            static void appendName(std::string& text, const Opcode& entry, uint8_t raw, uint8_t canonical) {
+                text += entry.name;
+                if (raw != canonical || entry.alias) {
+                    appendHex(text, raw, "#%02X");
+                }
+            }
+
+            std::string variable();
+            std::string parameter(Params& params, bool isWord, char role = '.');
+            std::string target();
+            std::string string();
+            std::string list();
+            std::string expression(int depth);
+
+            ScriptVersion m_version;
+            std::span<const uint8_t> m_data;
+            size_t m_position;
+            bool m_overrun = false;
+
+            const Opcode* m_entry = nullptr;
+            uint8_t m_canonical = 0;
+            uint32_t m_target = 0;
+            size_t m_targetItem = std::string::npos;
+
+            std::vector<ScriptDisassembler::Reference>* m_references = nullptr;
+            uint32_t m_start = 0;           // Offset of the instruction being decoded
+            const char* m_stackRoles = nullptr;
+            int32_t m_constant = 0;
+        };
+
+        bool Decoder::decodeV5(std::string& name, std::string& args, int depth) {
+            const uint8_t raw = byte();
+            const Opcode& entry = V5_OPCODES[raw];
+            Params params{raw};
+            if (depth == 0) {
+                m_entry = &entry;
+                m_targetItem = std::string::npos;
+            }
+            if (!operands(entry, params, args, depth)) {
+                return false;
+            }
+            const uint8_t canonical = static_cast<uint8_t>(entry.code | params.set);
+            appendName(name, entry, raw, canonical);
+            if (depth == 0) {
+                m_canonical = entry.code;
+            }
+            return true;
+        }
+
+        bool Decoder::decodeV6(std::string& name, std::string& args) {
+            const uint8_t raw = byte();
+            const Opcode& entry = V6_OPCODES[raw];
+            if (entry.name == nullptr) {
+                return false;
+            }
+            m_entry = &entry;
+            m_canonical = entry.code;
+            m_targetItem = std::string::npos;
+            m_stackRoles = entry.roles;
+            Params params{raw};
+            if (!operands(entry, params, args, 0)) {
+                return false;
+            }
+            appendName(name, entry, raw, entry.code);
+            return true;
+        }
+
+        bool Decoder::operands(const Opcode& entry, Params& params, std::string& args, int depth) {
+            Params extra;
+            Params* current = &params;
+            for (const char* letter = entry.operands; *letter && !m_overrun; letter++) {
+                switch (*letter) {
+                    case 'p':
+                    case 'P': {
+                        const char role = m_version == ScriptVersion::V5 && entry.roles ? entry.roles[letter - entry.operands] : '.';
+                        appendItem(args, parameter(*current, *letter == 'P', role));
+                        break;
+                    }
+                    case '_':
+                        current->next >>= 1;
+                        break;
+                    case 'o': {
+                        extra = Params{byte()};
+                        current = &extra;
+                        std::string raw;
+                        appendHex(raw, extra.byte, "#%02X");
+                        appendItem(args, raw);
+                        break;
+                    }
+                    case 'r':
+                    case 'V':
+                        appendItem(args, variable());
+                        break;
+                    case 'B':
+                        appendItem(args, variableName(byte()));
+                        break;
+                    case 'W':
+                        appendItem(args, variableName(word()));
+                        break;
+                    case 'b':
+                        m_constant = byte();
+                        appendItem(args, std::to_string(m_constant));
+                        break;
+                    case 'w':
+                        m_constant = static_cast<int16_t>(word());
+                        appendItem(args, std::to_string(m_constant));
+                        break;
+                    case 'd': {
+                        const uint32_t low = word();
+                        appendItem(args, std::to_string(low | (static_cast<uint32_t>(byte()) << 16)));
+                        break;
+                    }
+                    case 'j':
+                        if (depth == 0) {
+                            m_targetItem = args.size();
+                        }
+                        appendItem(args, target());
+                        break;
+                    case 's':
+                        appendItem(args, string());
+                        break;
+                    case 'l':
+                        appendItem(args, list());
+                        break;
+                    case 'S': {
+                        std::string sub;
+                        bool last = false;
+                        if (!subOpcode(*entry.subs, sub, last, depth)) {
+                            return false;
+                        }
+                        appendItem(args, sub);
+                        break;
+                    }
+                    case 'L':
+                        while (!m_overrun) {
+                            if (m_position < m_data.size() && m_data[m_position] == 0xFF) {
+                                m_position++;
+                                break;
+                            }
+                            std::string sub;
+                            bool last = false;
+                            if (!subOpcode(*entry.subs, sub, last, depth)) {
+                                return false;
+                            }
+                            appendItem(args, sub);
+                            if (last) {
+                                break;
+                            }
+                        }
+                        break;
+                    case '!':
+                        break;
+                    case 'e': {
+                        if (depth >= MAX_DEPTH) {
+                            return false;
+                        }
+                        const std::string items = expression(depth);
+                        if (items.empty()) {
+                            return false;
+                        }
+                        appendItem(args, items);
+                        break;
+                    }
+                    case 'R': {
+                        // First variable, count, then that many constants (words with bit 0x80 of the opcode)
+                        appendItem(args, variable());
+                        const size_t count = byte();
+                        std::string values;
+                        for (size_t i = 0; i < (count ? count : 256) && !m_overrun; i++) {
+                            appendItem(values, std::to_string(params.byte & 0x80 ? static_cast<int16_t>(word()) : byte()));
+                        }
+                        appendItem(args, "[" + values + "]");
+                        break;
+                    }
+                    case 'Q': {
+                        appendItem(args, std::to_string(byte()));
+                        std::string rooms;
+                        for (uint8_t room = byte(); room != 0 && !m_overrun; room = byte()) {
+                            appendItem(rooms, std::to_string(room));
+                        }
+                        appendItem(args, "[" + rooms + "]");
+                        break;
+                    }
+                    case 'D': {
+                        // Verb 0xFE (a constant) stops the sentence and has no objects
+                        if (current->take()) {
+                            appendItem(args, variable());
+                        } else {
+                            const uint8_t verb = byte();
+                            appendItem(args, std::to_string(verb));
+                            if (verb == 0xFE) {
+                                break;
+                            }
+                        }
+                        appendItem(args, parameter(*current, true, 'O'));
+                        appendItem(args, parameter(*current, true, 'O'));
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            return !m_overrun;
+        }
+
+        bool Decoder::subOpcode(const SubOpcodes& subs, std::string& text, bool& last, int depth) {
+            const uint8_t raw = byte();
+            const Opcode& entry = subs.table[raw & subs.mask];
+            if (m_overrun || entry.name == nullptr) {
+                return false;
+            }
+            if (m_version == ScriptVersion::V6 && entry.roles) {
+                m_stackRoles = entry.roles;
+            }
+            Params params{raw};
+            std::string args;
+            if (!operands(entry, params, args, depth)) {
+                return false;
+            }
+            appendName(text, entry, raw, static_cast<uint8_t>(entry.code | params.set));
+            if (!args.empty()) {
+                text += "(" + args + ")";
+            }
+            last = std::strchr(entry.operands, '!') != nullptr;
+            return true;
+        }
+
+        std::string Decoder::variable() {
+            // v5: 0x2000 adds an index, a constant or (0x2000 again) a variable
+            const uint16_t var = word();
+            if (m_version != ScriptVersion::V5 || !(var & 0x2000)) {
+                return variableName(var);
+            }
+            std::string name = variableName(var & ~0x2000);
+            const uint16_t index = word();
+            name.pop_back();
+            name += " + ";
+            name += index & 0x2000 ? variableName(index & ~0x2000) : std::to_string(index);
+            name += "]";
+            return name;
+        }
+
+        void Decoder::reference(ScriptDisassembler::SymbolKind kind, uint16_t number) {
+            if (m_references) {
+                m_references->push_back({kind, number, m_start});
+            }
+        }
+
+        // Records globals and bit variables on the way; locals mean nothing outside the script
+        std::string Decoder::variableName(uint16_t var) {
+            using SymbolKind = ScriptDisassembler::SymbolKind;
+            if (var & 0x8000) {
+                reference(SymbolKind::BitVariable, var & 0x7FFF);
+            } else if (!(var & 0x4000)) {
+                reference(SymbolKind::Variable, var & 0x3FFF);
+            }
+            return formatVariable(var);
+        }
+
+        std::string Decoder::parameter(Params& params, bool isWord, char role) {
+            if (params.take()) {
+                return variable();
+            }
+            const int32_t value = isWord ? static_cast<int16_t>(word()) : byte();
+            ScriptDisassembler::SymbolKind kind;
+            if (symbolOf(role, kind) && !m_overrun) {
+                reference(kind, static_cast<uint16_t>(value));
+            }
+            return std::to_string(value);
+        }
+
+        std::string Decoder::target() {
+            const int16_t delta = static_cast<int16_t>(word());
+            m_target = static_cast<uint32_t>(static_cast<int64_t>(m_position) + delta);
+            std::string text = "@";
+            appendHex(text, m_target, "%04X");
+            return text;
+        }
+
+        std::string Decoder::string() {
+            // 0xFF escapes: codes 1, 2, 3 and 8 stand alone, the others carry a word. A
+            // plain 0xFE is just a character (extended charsets use it).
+            std::string text = "\"";
+            auto append = [&text](uint8_t c) {
+                if (c == '"' || c == '\\') {
+                    text += '\\';
+                    text += static_cast<char>(c);
+                } else if (c >= 0x20 && c < 0x7F) {
+                    text += static_cast<char>(c);
+                } else {
+                    appendHex(text, c, "\\x%02X");
+                }
+            };
+            for (uint8_t c = byte(); c != 0 && !m_overrun; c = byte()) {
+                append(c);
+                if (c == 0xFF) {
+                    const uint8_t code = byte();
+                    append(code);
+                    if (code != 1 && code != 2 && code != 3 && code != 8) {
+                        append(byte());
+                        append(byte());
+                    }
+                }
+            }
+            text += '"';
+            return text;
+        }
+
+        std::string Decoder::list() {
+            // Word parameters, each behind its own parameter byte (canonically 0x01)
+            std::string items;
+            for (uint8_t raw = byte(); raw != 0xFF && !m_overrun; raw = byte()) {
+                Params params{raw};
+                const std::string value = parameter(params, true);
+                std::string item;
+                if (raw != (0x01 | params.set)) {
+                    appendHex(item, raw, "#%02X ");
+                }
+                appendItem(items, item + value);
+            }
+            return "[" + items + "]";
+        }
+
+        std::string Decoder::expression(int depth) {
+            // Postfix: values, operators and nested opcodes whose result is pushed
+            static constexpr const char* OPERATORS[] = {"add", "sub", "mul", "div"};
+            std::string items;
+            for (uint8_t raw = byte(); raw != 0xFF && !m_overrun; raw = byte()) {
+                const uint8_t code = raw & 0x1F;
+                std::string item;
+                if (code == 1) {
+                    Params params{raw};
+                    const std::string value = parameter(params, true);
+                    if (raw != (0x01 | params.set)) {
+                        appendHex(item, raw, "#%02X ");
+                    }
+                    item += value;
+                } else if (code >= 2 && code <= 5) {
+                    if (raw != code) {
+                        appendHex(item, raw, "#%02X ");
+                    }
+                    item += OPERATORS[code - 2];
+                } else if (code == 6) {
+                    if (raw != code) {
+                        appendHex(item, raw, "#%02X ");
+                    }
+                    std::string nested;
+                    std::string nestedArgs;
+                    if (!decodeV5(nested, nestedArgs, depth + 1)) {
+                        return {};
+                    }
+                    joinArgs(nested, nestedArgs);
+                    item += "(" + nested + ")";
+                } else {
+                    return {};
+                }
+                appendItem(items, item);
+            }
+            return "[" + items + "]";
+        }
+
+        void appendLabel(std::string& text, uint32_t offset) {
+            appendHex(text, offset, "%04X: ");
+        }
+
+        ScriptDisassembler::Flow flowOf(ScriptVersion version, const Opcode& entry) {
+            using Flow = ScriptDisassembler::Flow;
+            if (version == ScriptVersion::V5) {
+                if (entry.code == 0x18) {
+                    return Flow::Jump;
+                }
+                if (entry.code == 0x00 || entry.code == 0xA0) {
+                    return Flow::Stop;
+                }
+            } else {
+                if (entry.code == 0x73) {
+                    return Flow::Jump;
+                }
+                if (entry.code == 0x65 || entry.code == 0x66) {
+                    return Flow::Stop;
+                }
+            }
+            // Sub-opcode targets (v6 waits) jump back to retry the instruction: not control flow
+            return std::strchr(entry.operands, 'j') != nullptr ? Flow::Branch : Flow::Next;
+        }
+
+        // Matches v6 argument roles against the values pushed in front of the call, from
+        // the top of the stack down; stops at the first list whose count is unknown
+        void popArguments(const char* roles, const std::vector<std::optional<int32_t>>& stack, uint32_t offset,
+                          std::vector<ScriptDisassembler::Reference>& references) {
+            size_t top = stack.size();
+            for (size_t i = std::strlen(roles); i-- > 0;) {
+                if (top == 0) {
+                    return;
+                }
+                if (roles[i] == 'L') {
+                    const std::optional<int32_t>& count = stack[top - 1];
+                    if (!count || *count < 0 || static_cast<size_t>(*count) >= top) {
+                        return;
+                    }
+                    top -= static_cast<size_t>(*count) + 1;
+                    continue;
+                }
+                const std::optional<int32_t>& value = stack[--top];
+                ScriptDisassembler::SymbolKind kind;
+                if (value && symbolOf(roles[i], kind)) {
+                    references.push_back({kind, static_cast<uint16_t>(*value), offset});
+                }
+            }
+        }
+    } // namespace
+
+    bool ScriptDisassembler::isScriptBlock(ChunkTag tag) {
+        return tag == tags::SCRP || tag == tags::LSCR || tag == tags::ENCD || tag == tags::EXCD || tag == tags::VERB;
+    }
+
+    bool ScriptDisassembler::load(ScriptVersion version, std::span<const uint8_t> block, std::string& error) {
+        m_block.clear();
+        m_position = m_codeStart = 0;
+        m_headerDone = m_failed = false;
+
+        if (block.size() < Chunk::HEADER_SIZE) {
+            error = "truncated script block";
+            return false;
+        }
+        m_tag = (static_cast<ChunkTag>(block[0]) << 24) | (block[1] << 16) | (block[2] << 8) | block[3];
+        if (!isScriptBlock(m_tag)) {
+            error = "not a script block (" + tagToString(m_tag) + ")";
+            return false;
+        }
+
+        m_version = version;
+        m_block.assign(block.begin(), block.end());
+        m_codeStart = Chunk::HEADER_SIZE;
+        if (m_tag == tags::LSCR) {
+            m_codeStart += 1;               // Local script number
+        } else if (m_tag == tags::VERB) {
+            // (verb, LE16 offset from the block start) entries up to a zero verb
+            while (m_codeStart < m_block.size() && m_block[m_codeStart] != 0) {
+                m_codeStart += 3;
+            }
+            m_codeStart += 1;
+        }
+        m_codeStart = std::min<uint32_t>(m_codeStart, static_cast<uint32_t>(m_block.size()));
+        m_position = Chunk::HEADER_SIZE;
+        return true;
+    }
+
+    void ScriptDisassembler::emitHeader(std::vector<Line>& lines) {
+        m_headerDone = true;
+        if (m_tag == tags::LSCR && m_block.size() > Chunk::HEADER_SIZE) {
+            std::string text;
+            appendLabel(text, Chunk::HEADER_SIZE);
+            text += ".localScript " + std::to_string(m_block[Chunk::HEADER_SIZE]);
+            lines.push_back({Chunk::HEADER_SIZE, std::move(text)});
+        } else if (m_tag == tags::VERB) {
+            for (uint32_t entry = Chunk::HEADER_SIZE; entry + 3 <= m_codeStart; entry += 3) {
+                std::string text;
+                appendLabel(text, entry);
+                text += ".verb " + std::to_string(m_block[entry]) + ", @";
+                appendHex(text, m_block[entry + 1] | (m_block[entry + 2] << 8), "%04X");
+                lines.push_back({entry, std::move(text)});
+            }
+        }
+        m_position = m_codeStart;
+    }
+
+    void ScriptDisassembler::emitBytes(std::vector<Line>& lines) {
+        const size_t count = std::min(BYTES_PER_LINE, m_block.size() - m_position);
+        std::string text;
+        appendLabel(text, m_position);
+        text += "db ";
+        for (size_t i = 0; i < count; i++) {
+            appendHex(text, m_block[m_position + i], i == 0 ? "0x%02X" : ", 0x%02X");
+        }
+        lines.push_back({m_position, std::move(text)});
+        m_position += static_cast<uint32_t>(count);
+    }
+
+    bool ScriptDisassembler::disassemble(uint32_t& offset, std::string& text) const {
+        Decoder decoder(m_version, m_block, offset);
+        const bool decoded = decoder.instruction(text);
+        offset = static_cast<uint32_t>(decoder.getPosition());
+        return decoded;
+    }
+
+    bool ScriptDisassembler::decode(uint32_t offset, Instruction& instruction) const {
+        Decoder decoder(m_version, m_block, offset);
+        instruction = Instruction{};
+        instruction.offset = offset;
+        if (!decoder.instruction(instruction.name, instruction.args)) {
+            return false;
+        }
+
+        const Opcode& entry = decoder.getEntry();
+        instruction.end = static_cast<uint32_t>(decoder.getPosition());
+        instruction.opcode = decoder.getCanonical();
+        instruction.flow = flowOf(m_version, entry);
+        instruction.hasResult = m_version == ScriptVersion::V5 && entry.operands[0] == 'r';
+        if (instruction.flow == Flow::Branch || instruction.flow == Flow::Jump) {
+            // The target is always the last operand
+            instruction.target = decoder.getTarget();
+            instruction.args.resize(std::min(instruction.args.size(), decoder.getTargetItem()));
+            if (instruction.args.ends_with(", ")) {
+                instruction.args.resize(instruction.args.size() - 2);
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::pair<uint8_t, uint32_t>> ScriptDisassembler::getEntryPoints() const {
+        std::vector<std::pair<uint8_t, uint32_t>> entries;
+        if (m_tag == tags::VERB) {
+            for (uint32_t entry = Chunk::HEADER_SIZE; entry + 3 <= m_codeStart; entry += 3) {
+                entries.emplace_back(m_block[entry], static_cast<uint32_t>(m_block[entry + 1] | (m_block[entry + 2] << 8)));
+            }
+        }
+        return entries;
+    }
+
+    bool ScriptDisassembler::collectReferences(std::vector<Reference>& references) const {
+        // v6: what the pushes since the last other instruction left, nullopt for a variable's value
+        std::vector<std::optional<int32_t>> stack;
+        uint32_t offset = m_codeStart;
+        while (offset < m_block.size()) {
+            const size_t count = references.size();
+            Decoder decoder(m_version, m_block, offset);
+            decoder.setReferences(&references);
+            std::string name;
+            std::string args;
+            if (!decoder.instruction(name, args)) {
+                references.resize(count);
+                return false;
+            }
+
+            if (m_version == ScriptVersion::V6) {
+                const uint8_t opcode = decoder.getCanonical();
+                if (opcode <= 0x01) {
+                    stack.push_back(decoder.getConstant());
+                } else if (opcode <= 0x03) {
+                    stack.push_back(std::nullopt);
+                } else {
+                    if (decoder.getStackRoles() != nullptr) {
+                        popArguments(decoder.getStackRoles(), stack, offset, references);
+                    }
+                    stack.clear();
+                }
+            }
+            offset = static_cast<uint32_t>(decoder.getPosition());
+        }
+        return true;
+    }
+
+    bool ScriptDisassembler::next(size_t maxLines, std::vector<Line>& lines) {
+        if (!m_headerDone) {
+            emitHeader(lines);
+        }
+
+        for (size_t count = 0; count < maxLines && m_position < m_block.size(); count++) {
+            if (m_failed) {
+                emitBytes(lines);
+                continue;
+            }
+
+            uint32_t end = m_position;
+            std::string text;
+            appendLabel(text, m_position);
+            if (disassemble(end, text)) {
+                lines.push_back({m_position, std::move(text)});
+                m_position = end;
+                continue;
+            }
+
+            // Bytecode has no resync points: list the rest as data
+            std::string note;
+            appendLabel(note, m_position);
+            appendHex(note, m_block[m_position], "; 0x%02X");
+            note += " does not decode, the rest is listed as bytes";
+            lines.push_back({m_position, std::move(note)});
+            m_failed = true;
+        }
+        return !isDone();
+    }
+
+} // namespace scummredux
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Chunk.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace scummredux {
+
+    // Bytecode flavour: v5 encodes operands inline (a parameter bit per operand says
+    // variable or constant), v6 pushes them on a stack
+    enum class ScriptVersion : uint8_t {
+        V5 = 5,
+        V6 = 6
+    };
+
+    // Disassembler for SCRP, LSCR, ENCD, EXCD and VERB blocks. Opcodes are decoded
+    // through 256-entry tables generated at compile time from per-opcode operand
+    // specs (v5 variants that differ only in parameter bits share one spec).
+    // Output is produced incrementally, one line per instruction, so a caller can
+    // show the start of a huge script before the rest is decoded.
+    //
+    // Each line starts with its offset from the block start (header included) as a
+    // label, which is also how jump targets are written:
+    //     0012: isEqual Var[5], 3, @0040
+    //     0019: actorOps 1, costume(12), talkColor(Var[3])
+    // A raw byte written as #XX marks an encoding its operands do not imply (unused
+    // parameter bits, startScript flags) or a second opcode with the same name, so
+    // the text keeps every byte and ScriptAssembler turns it back into the block.
+    class ScriptDisassembler {
+    public:
+        struct Line {
+            uint32_t offset = 0;            // Block-relative offset the line was decoded from
+            std::string text;
+        };
+
+        // How control leaves an instruction
+        enum class Flow : uint8_t {
+            Next,                           // Falls through
+            Branch,                         // Conditional jump, falls through otherwise
+            Jump,                           // Unconditional jump
+            Stop                            // Ends the script
+        };
+
+        // One instruction split up for analysis (the decompiler)
+        struct Instruction {
+            uint32_t offset = 0;
+            uint32_t end = 0;               // Offset of the next instruction
+            uint8_t opcode = 0;             // Canonical encoding (parameter bits cleared)
+            Flow flow = Flow::Next;
+            uint32_t target = 0;            // Of Branch and Jump
+            bool hasResult = false;         // v5: the first argument is the variable written
+            std::string name;               // Including a #XX encoding suffix
+            std::string args;               // Jump target left out
+        };
+
+        // What a reference names: a global or bit variable, or an object, room or
+        // script number. Locals are left out, they mean nothing outside the script.
+        enum class SymbolKind : uint8_t {
+            Variable,
+            BitVariable,
+            Object,
+            Room,
+            Script
+        };
+
+        struct Reference {
+            SymbolKind kind;
+            uint16_t number;
+            uint32_t offset;                // Of the instruction
+        };
+        static_assert(sizeof(Reference) == 8);
+
+        static bool isScriptBlock(ChunkTag tag);
+
+        // Whole block, header included; the bytes are copied
+        bool load(ScriptVersion version, std::span<const uint8_t> block, std::string& error);
+
+        // Appends up to maxLines more lines; false once the whole block is out
+        bool next(size_t maxLines, std::vector<Line>& lines);
+
+        bool isDone() const { return m_headerDone && m_position >= m_block.size(); }
+        float getProgress() const {
+            return m_block.empty() ? 1.0f : static_cast<float>(m_position) / static_cast<float>(m_block.size());
+        }
+
+        ScriptVersion getVersion() const { return m_version; }
+        ChunkTag getTag() const { return m_tag; }
+        uint32_t getCodeStart() const { return m_codeStart; }
+
+        // One instruction at offset (block-relative), without the label. Advances
+        // offset past it; false if it does not decode.
+        bool disassemble(uint32_t& offset, std::string& text) const;
+        bool decode(uint32_t offset, Instruction& instruction) const;
+
+        // Byte range of the code and the VERB entry points ((verb, offset) pairs)
+        std::span<const uint8_t> getBlock() const { return m_block; }
+        std::vector<std::pair<uint8_t, uint32_t>> getEntryPoints() const;
+
+        // Appends every reference of the code in offset order; false if part of it does
+        // not decode. Objects, rooms and scripts count where an opcode takes them as a
+        // constant (v6: pushed right in front of it), variables wherever they appear.
+        bool collectReferences(std::vector<Reference>& references) const;
+
+    private:
+        void emitHeader(std::vector<Line>& lines);
+        void emitBytes(std::vector<Line>& lines);
+
+        ScriptVersion m_version = ScriptVersion::V5;
+        ChunkTag m_tag = 0;
+        std::vector<uint8_t> m_block;
+        uint32_t m_codeStart = 0;
+        uint32_t m_position = 0;
+        bool m_headerDone = false;
+        bool m_failed = false;              // Rest of the block is listed as bytes
+
+        static constexpr size_t BYTES_PER_LINE = 16;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,533 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace scummredux {
+
+    // Opcode tables of the v5 and v6 bytecode, shared by ScriptDisassembler and
+    // ScriptAssembler so text and bytes are read and written from the same specs.
+    namespace bytecode {
+        struct SubOpcodes;
+
+        // Operand letters:
+        //     p/P      byte/word parameter, a variable if the next parameter bit is set
+        //     _        skips a parameter bit the engine ignores
+        //     o        byte whose bits are the following parameter bits (written as #XX)
+        //     r/V      result/read variable (v5, optionally indexed)
+        //     B/W      byte/word variable (v6)
+        //     b/w/d    8/16/24-bit constant
+        //     j        jump target         s   inline string
+        //     l        parameter list up to 0xFF, each with its own parameter byte
+        //     S        one sub-opcode      L   sub-opcodes up to 0xFF
+        //     !        (sub-opcode) ends the L list
+        //     e/R/Q/D  bodies of expression, setVarRange, pseudoRoom and doSentence
+        struct Opcode {
+            const char* name = nullptr;
+            const char* operands = "";
+            const SubOpcodes* subs = nullptr;
+            uint8_t code = 0;               // Encoding with no variant bit set
+            const char* roles = nullptr;    // See RoleSpec
+            bool alias = false;             // Name taken by an earlier spec: listed with its #XX
+        };
+
+        struct OpcodeSpec {
+            uint8_t code;
+            uint8_t variants;               // Parameter bits (or flags) that keep the meaning
+            const char* name;
+            const char* operands;
+            const SubOpcodes* subs = nullptr;
+        };
+
+        using OpcodeTable = std::array<Opcode, 256>;
+
+        struct SubOpcodes {
+            uint8_t mask;                   // Bits of the sub-opcode byte that name it
+            OpcodeTable table;
+        };
+
+        template<size_t N>
+        inline constexpr OpcodeTable buildTable(const OpcodeSpec (&specs)[N]) {
+            OpcodeTable table{};
+            for (size_t i = 0; i < N; i++) {
+                const OpcodeSpec& spec = specs[i];
+                bool alias = false;
+                for (size_t j = 0; j < i; j++) {
+                    alias |= std::string_view(specs[j].name) == spec.name;
+                }
+                // Every combination of the variant bits decodes the same way
+                for (unsigned bits = 0; bits < 256; bits++) {
+                    if ((bits & ~static_cast<unsigned>(spec.variants)) != 0) {
+                        continue;
+                    }
+                    Opcode& entry = table[spec.code | bits];
+                    if (entry.name != nullptr) {
+                        throw "two specs claim the same opcode";    // Fails the constant evaluation
+                    }
+                    entry = {spec.name, spec.operands, spec.subs, spec.code, nullptr, alias};
+                }
+            }
+            return table;
+        }
+
+        // What the numbers an opcode takes stand for: one letter per operand letter (v5),
+        // or per popped argument in push order (v6). S script, O object, R room, L a v6
+        // list (its count pushed last), '.' anything else.
+        struct RoleSpec {
+            uint8_t code;
+            const char* roles;
+        };
+
+        template<size_t N>
+        inline constexpr OpcodeTable withRoles(OpcodeTable table, const RoleSpec (&roles)[N], bool perOperand) {
+            for (const RoleSpec& role : roles) {
+                bool found = false;
+                for (Opcode& entry : table) {
+                    if (entry.name == nullptr || entry.code != role.code) {
+                        continue;
+                    }
+                    if (perOperand && std::char_traits<char>::length(entry.operands) != std::char_traits<char>::length(role.roles)) {
+                        throw "roles do not line up with the operands";
+                    }
+                    entry.roles = role.roles;
+                    found = true;
+                }
+                if (!found) {
+                    throw "roles for an opcode without a spec";
+                }
+            }
+            return table;
+        }
+
+        constexpr size_t countOpcodes(const OpcodeTable& table) {
+            return static_cast<size_t>(std::count_if(table.begin(), table.end(), [](const Opcode& entry) {
+                return entry.name != nullptr;
+            }));
+        }
+
+        // v5 sub-opcodes
+
+        inline constexpr OpcodeSpec V5_DRAW_OBJECT_SPECS[] = {
+            {0x01, 0, "setXY", "PP"},
+            {0x02, 0, "setImage", "P"},
+            {0x1F, 0, "draw", ""},
+        };
+
+        inline constexpr RoleSpec V5_RESOURCE_ROLES[] = {
+            {1, "S"}, {4, "R"}, {5, "S"}, {8, "R"}, {9, "S"}, {12, "R"}, {13, "S"}, {16, "R"}, {20, "RO"},
+        };
+
+        inline constexpr OpcodeSpec V5_RESOURCE_SPECS[] = {
+            {1, 0, "loadScript", "p"},      {2, 0, "loadSound", "p"},       {3, 0, "loadCostume", "p"},
+            {4, 0, "loadRoom", "p"},        {5, 0, "nukeScript", "p"},      {6, 0, "nukeSound", "p"},
+            {7, 0, "nukeCostume", "p"},     {8, 0, "nukeRoom", "p"},        {9, 0, "lockScript", "p"},
+            {10, 0, "lockSound", "p"},      {11, 0, "lockCostume", "p"},    {12, 0, "lockRoom", "p"},
+            {13, 0, "unlockScript", "p"},   {14, 0, "unlockSound", "p"},    {15, 0, "unlockCostume", "p"},
+            {16, 0, "unlockRoom", "p"},     {17, 0, "clearHeap", ""},       {18, 0, "loadCharset", "p"},
+            {19, 0, "nukeCharset", "p"},    {20, 0, "loadFlObject", "pP"},
+        };
+
+        inline constexpr OpcodeSpec V5_ACTOR_SPECS[] = {
+            {0, 0, "dummy", "p"},           {1, 0, "costume", "p"},         {2, 0, "stepDist", "pp"},
+            {3, 0, "sound", "p"},           {4, 0, "walkAnimation", "p"},   {5, 0, "talkAnimation", "pp"},
+            {6, 0, "standAnimation", "p"},  {7, 0, "animation", "ppp"},     {8, 0, "default", ""},
+            {9, 0, "elevation", "P"},       {10, 0, "animationDefault", ""}, {11, 0, "palette", "pp"},
+            {12, 0, "talkColor", "p"},      {13, 0, "name", "s"},           {14, 0, "initAnimation", "p"},
+            {16, 0, "width", "p"},          {17, 0, "scale", "pp"},         {18, 0, "neverZClip", ""},
+            {19, 0, "setZClip", "p"},       {20, 0, "ignoreBoxes", ""},     {21, 0, "followBoxes", ""},
+            {22, 0, "animationSpeed", "p"}, {23, 0, "shadow", "p"},
+        };
+
+        inline constexpr OpcodeSpec V5_PRINT_SPECS[] = {
+            {0, 0, "pos", "PP"},            {1, 0, "color", "p"},           {2, 0, "clipped", "P"},
+            {3, 0, "erase", "PP"},          {4, 0, "center", ""},           {6, 0, "left", ""},
+            {7, 0, "overhead", ""},         {8, 0, "say", "PP"},            {15, 0, "text", "s!"},
+        };
+
+        inline constexpr OpcodeSpec V5_STRING_SPECS[] = {
+            {1, 0, "putCodeInString", "ps"}, {2, 0, "copyString", "pp"},    {3, 0, "setStringChar", "ppp"},
+            {4, 0, "getStringChar", "rpp"},  {5, 0, "createString", "pp"},
+        };
+
+        inline constexpr OpcodeSpec V5_CURSOR_SPECS[] = {
+            {1, 0, "cursorOn", ""},         {2, 0, "cursorOff", ""},        {3, 0, "userputOn", ""},
+            {4, 0, "userputOff", ""},       {5, 0, "cursorSoftOn", ""},     {6, 0, "cursorSoftOff", ""},
+            {7, 0, "userputSoftOn", ""},    {8, 0, "userputSoftOff", ""},   {10, 0, "setCursorImg", "pp"},
+            {11, 0, "setCursorHotspot", "ppp"}, {12, 0, "initCursor", "p"}, {13, 0, "initCharset", "p"},
+            {14, 0, "charsetColors", "l"},
+        };
+
+        inline constexpr OpcodeSpec V5_MATRIX_SPECS[] = {
+            {1, 0, "setBoxFlags", "pp"},    {2, 0, "setBoxScale", "pp"},    {3, 0, "setBoxSlot", "pp"},
+            {4, 0, "createBoxMatrix", ""},
+        };
+
+        inline constexpr OpcodeSpec V5_ROOM_SPECS[] = {
+            {1, 0, "scroll", "PP"},         {2, 0, "roomColor", "PP"},      {3, 0, "screen", "PP"},
+            {4, 0, "palette", "PPPop"},     {5, 0, "shakeOn", ""},          {6, 0, "shakeOff", ""},
+            {7, 0, "scale", "ppoppo_p"},    {8, 0, "intensity", "ppp"},     {9, 0, "saveLoad", "pp"},
+            {10, 0, "screenEffect", "P"},   {11, 0, "rgbIntensity", "PPPopp"}, {12, 0, "shadow", "PPPopp"},
+            {13, 0, "saveString", "ps"},    {14, 0, "loadString", "ps"},    {15, 0, "palManipulate", "poppop"},
+            {16, 0, "colorCycleDelay", "pp"},
+        };
+
+        inline constexpr OpcodeSpec V5_OLD_ROOM_EFFECT_SPECS[] = {
+            {3, 0, "set", "P"},
+        };
+
+        inline constexpr OpcodeSpec V5_VERB_SPECS[] = {
+            {1, 0, "image", "P"},           {2, 0, "name", "s"},            {3, 0, "color", "p"},
+            {4, 0, "hicolor", "p"},         {5, 0, "setXY", "PP"},          {6, 0, "on", ""},
+            {7, 0, "off", ""},              {8, 0, "delete", ""},           {9, 0, "new", ""},
+            {16, 0, "dimColor", "p"},       {17, 0, "dim", ""},             {18, 0, "key", "p"},
+            {19, 0, "center", ""},          {20, 0, "setToString", "P"},    {22, 0, "setToObject", "Pp"},
+            {23, 0, "backColor", "p"},
+        };
+
+        inline constexpr RoleSpec V5_VERB_ROLES[] = {
+            {22, "OR"},
+        };
+
+        inline constexpr OpcodeSpec V5_SAVE_RESTORE_SPECS[] = {
+            {1, 0, "saveVerbs", "ppp"},     {2, 0, "restoreVerbs", "ppp"},  {3, 0, "deleteVerbs", "ppp"},
+        };
+
+        inline constexpr OpcodeSpec V5_WAIT_SPECS[] = {
+            {1, 0, "forActor", "p"},        {2, 0, "forMessage", ""},       {3, 0, "forCamera", ""},
+            {4, 0, "forSentence", ""},
+        };
+
+        inline constexpr SubOpcodes V5_DRAW_OBJECT{0x1F, buildTable(V5_DRAW_OBJECT_SPECS)};
+        inline constexpr SubOpcodes V5_RESOURCE{0x1F, withRoles(buildTable(V5_RESOURCE_SPECS), V5_RESOURCE_ROLES, true)};
+        inline constexpr SubOpcodes V5_ACTOR{0x1F, buildTable(V5_ACTOR_SPECS)};
+        inline constexpr SubOpcodes V5_PRINT{0x0F, buildTable(V5_PRINT_SPECS)};
+        inline constexpr SubOpcodes V5_STRING{0x1F, buildTable(V5_STRING_SPECS)};
+        inline constexpr SubOpcodes V5_CURSOR{0x1F, buildTable(V5_CURSOR_SPECS)};
+        inline constexpr SubOpcodes V5_MATRIX{0x1F, buildTable(V5_MATRIX_SPECS)};
+        inline constexpr SubOpcodes V5_ROOM{0x1F, buildTable(V5_ROOM_SPECS)};
+        inline constexpr SubOpcodes V5_OLD_ROOM_EFFECT{0x1F, buildTable(V5_OLD_ROOM_EFFECT_SPECS)};
+        inline constexpr SubOpcodes V5_VERB{0x1F, withRoles(buildTable(V5_VERB_SPECS), V5_VERB_ROLES, true)};
+        inline constexpr SubOpcodes V5_SAVE_RESTORE{0x1F, buildTable(V5_SAVE_RESTORE_SPECS)};
+        inline constexpr SubOpcodes V5_WAIT{0x1F, buildTable(V5_WAIT_SPECS)};
+
+        // v5 opcodes: bit 0x80/0x40/0x20 is the parameter bit of the first/second/third
+        // parameter, so most opcodes come in 2, 4 or 8 encodings
+        inline constexpr OpcodeSpec V5_SPECS[] = {
+            {0xA0, 0x00, "stopObjectCode", ""},     // First: the usual encoding keeps the bare name
+            {0x00, 0x00, "stopObjectCode", ""},
+            {0x01, 0xE0, "putActor", "pPP"},
+            {0x02, 0x80, "startMusic", "p"},
+            {0x03, 0x80, "getActorRoom", "rp"},
+            {0x04, 0x80, "isGreaterEqual", "VPj"},
+            {0x05, 0xC0, "drawObject", "PS", &V5_DRAW_OBJECT},
+            {0x06, 0x80, "getActorElevation", "rp"},
+            {0x07, 0xC0, "setState", "Pp"},
+            {0x08, 0x80, "isNotEqual", "VPj"},
+            {0x09, 0xC0, "faceActor", "pP"},
+            {0x0A, 0xE0, "startScript", "pl"},
+            {0x0B, 0xC0, "getVerbEntrypoint", "rPP"},
+            {0x0C, 0x80, "resourceRoutines", "S", &V5_RESOURCE},
+            {0x0D, 0xC0, "walkActorToActor", "ppb"},
+            {0x0E, 0xC0, "putActorAtObject", "pP"},
+            {0x0F, 0x80, "getObjectState", "rP"},
+            {0x10, 0x80, "getObjectOwner", "rP"},
+            {0x11, 0xC0, "animateActor", "pp"},
+            {0x12, 0x80, "panCameraTo", "P"},
+            {0x13, 0xC0, "actorOps", "pL", &V5_ACTOR},
+            {0x14, 0x80, "print", "pL", &V5_PRINT},
+            {0x15, 0xC0, "actorFromPos", "rPP"},
+            {0x16, 0x80, "getRandomNr", "rp"},
+            {0x17, 0x80, "and", "rP"},
+            {0x18, 0x00, "jumpRelative", "j"},
+            {0x19, 0xE0, "doSentence", "D"},
+            {0x1A, 0x80, "move", "rP"},
+            {0x1B, 0x80, "multiply", "rP"},
+            {0x1C, 0x80, "startSound", "p"},
+            {0x1D, 0x80, "ifClassOfIs", "Plj"},
+            {0x1E, 0xE0, "walkActorTo", "pPP"},
+            {0x1F, 0xC0, "isActorInBox", "ppj"},
+            {0x20, 0x00, "stopMusic", ""},
+            {0x22, 0x80, "getAnimCounter", "rp"},
+            {0x23, 0x80, "getActorY", "rP"},
+            {0x24, 0xC0, "loadRoomWithEgo", "Ppww"},
+            {0x25, 0xC0, "pickupObject", "Pp"},
+            {0x26, 0x80, "setVarRange", "R"},
+            {0x27, 0x00, "stringOps", "S", &V5_STRING},
+            {0x28, 0x00, "equalZero", "Vj"},
+            {0x29, 0xC0, "setOwnerOf", "Pp"},
+            {0x2B, 0x00, "delayVariable", "V"},
+            {0x2C, 0x00, "cursorCommand", "S", &V5_CURSOR},
+            {0x2D, 0xC0, "putActorInRoom", "pp"},
+            {0x2E, 0x00, "delay", "d"},
+            {0x2F, 0xC0, "ifNotState", "Ppj"},
+            {0x30, 0x80, "matrixOps", "S", &V5_MATRIX},
+            {0x31, 0x80, "getInventoryCount", "rp"},
+            {0x32, 0x80, "setCameraAt", "P"},
+            {0x33, 0xC0, "roomOps", "S", &V5_ROOM},
+            {0x34, 0xC0, "getDist", "rPP"},
+            {0x35, 0xC0, "findObject", "rPP"},
+            {0x36, 0xC0, "walkActorToObject", "pP"},
+            {0x37, 0xC0, "startObject", "Ppl"},
+            {0x38, 0x80, "isLessEqual", "VPj"},
+            {0x3A, 0x80, "subtract", "rP"},
+            {0x3B, 0x80, "getActorScale", "rp"},
+            {0x3C, 0x80, "stopSound", "p"},
+            {0x3D, 0xC0, "findInventory", "rpp"},
+            {0x3F, 0xC0, "drawBox", "PPoPPp"},
+            {0x40, 0x00, "cutscene", "l"},
+            {0x42, 0x80, "chainScript", "pl"},
+            {0x43, 0x80, "getActorX", "rP"},
+            {0x44, 0x80, "isLess", "VPj"},
+            {0x46, 0x00, "increment", "r"},
+            {0x48, 0x80, "isEqual", "VPj"},
+            {0x4C, 0x00, "soundKludge", "l"},
+            {0x4F, 0x80, "ifState", "Ppj"},
+            {0x50, 0x80, "pickupObjectOld", "P"},
+            {0x52, 0x80, "actorFollowCamera", "p"},
+            {0x54, 0x80, "setObjectName", "Ps"},
+            {0x56, 0x80, "getActorMoving", "rp"},
+            {0x57, 0x80, "or", "rP"},
+            {0x58, 0x00, "beginOverride", "b"},
+            {0x5A, 0x80, "add", "rP"},
+            {0x5B, 0x80, "divide", "rP"},
+            {0x5C, 0x80, "oldRoomEffect", "S", &V5_OLD_ROOM_EFFECT},
+            {0x5D, 0x80, "setClass", "Pl"},
+            {0x60, 0x80, "freezeScripts", "p"},
+            {0x62, 0x80, "stopScript", "p"},
+            {0x63, 0x80, "getActorFacing", "rp"},
+            {0x66, 0x80, "getClosestObjActor", "rP"},
+            {0x67, 0x80, "getStringWidth", "rp"},
+            {0x68, 0x80, "isScriptRunning", "rp"},
+            {0x6B, 0x80, "debug", "P"},
+            {0x6C, 0x80, "getActorWidth", "rp"},
+            {0x6E, 0x80, "stopObjectScript", "P"},
+            {0x70, 0x80, "lights", "pbb"},
+            {0x71, 0x80, "getActorCostume", "rp"},
+            {0x72, 0x80, "loadRoom", "p"},
+            {0x78, 0x80, "isGreater", "VPj"},
+            {0x7A, 0x80, "verbOps", "pL", &V5_VERB},
+            {0x7B, 0x80, "getActorWalkBox", "rp"},
+            {0x7C, 0x80, "isSoundRunning", "rp"},
+            {0x80, 0x00, "breakHere", ""},
+            {0x98, 0x00, "systemOps", "b"},
+            {0xA7, 0x00, "dummy", ""},
+            {0xA8, 0x00, "notEqualZero", "Vj"},
+            {0xAB, 0x00, "saveRestoreVerbs", "S", &V5_SAVE_RESTORE},
+            {0xAC, 0x00, "expression", "re"},
+            {0xAE, 0x00, "wait", "S", &V5_WAIT},
+            {0xC0, 0x00, "endCutscene", ""},
+            {0xC6, 0x00, "decrement", "r"},
+            {0xCC, 0x00, "pseudoRoom", "Q"},
+            {0xD8, 0x00, "printEgo", "L", &V5_PRINT},
+        };
+
+        inline constexpr RoleSpec V5_ROLES[] = {
+            {0x05, "O."},   {0x07, "O."},   {0x0A, "S."},   {0x0B, ".O."},  {0x0E, ".O"},   {0x0F, ".O"},
+            {0x10, ".O"},   {0x1D, "O.."},  {0x24, "OR.."}, {0x25, "OR"},   {0x29, "O."},   {0x2D, ".R"},
+            {0x2F, "O.."},  {0x36, ".O"},   {0x37, "O.."},  {0x42, "S."},   {0x4F, "O.."},  {0x50, "O"},
+            {0x54, "O."},   {0x5D, "O."},   {0x62, "S"},    {0x68, ".S"},   {0x6E, "O"},    {0x72, "R"},
+        };
+
+        inline constexpr OpcodeTable V5_OPCODES = withRoles(buildTable(V5_SPECS), V5_ROLES, true);
+        static_assert(countOpcodes(V5_OPCODES) == 256, "every v5 opcode byte has a meaning");
+
+        // v6 sub-opcodes: the byte names them directly
+
+        inline constexpr OpcodeSpec V6_CURSOR_SPECS[] = {
+            {0x90, 0, "cursorOn", ""},      {0x91, 0, "cursorOff", ""},     {0x92, 0, "userputOn", ""},
+            {0x93, 0, "userputOff", ""},    {0x94, 0, "cursorSoftOn", ""},  {0x95, 0, "cursorSoftOff", ""},
+            {0x96, 0, "userputSoftOn", ""}, {0x97, 0, "userputSoftOff", ""}, {0x99, 0, "setCursorImg", ""},
+            {0x9A, 0, "setCursorHotspot", ""}, {0x9C, 0, "initCharset", ""}, {0x9D, 0, "charsetColors", ""},
+            {0xD6, 0, "setCursorTransparency", ""},
+        };
+
+        inline constexpr OpcodeSpec V6_RESOURCE_SPECS[] = {
+            {100, 0, "loadScript", ""},     {101, 0, "loadSound", ""},      {102, 0, "loadCostume", ""},
+            {103, 0, "loadRoom", ""},       {104, 0, "nukeScript", ""},     {105, 0, "nukeSound", ""},
+            {106, 0, "nukeCostume", ""},    {107, 0, "nukeRoom", ""},       {108, 0, "lockScript", ""},
+            {109, 0, "lockSound", ""},      {110, 0, "lockCostume", ""},    {111, 0, "lockRoom", ""},
+            {112, 0, "unlockScript", ""},   {113, 0, "unlockSound", ""},    {114, 0, "unlockCostume", ""},
+            {115, 0, "unlockRoom", ""},     {116, 0, "clearHeap", ""},      {117, 0, "loadCharset", ""},
+            {118, 0, "nukeCharset", ""},    {119, 0, "loadFlObject", ""},
+        };
+
+        inline constexpr RoleSpec V6_RESOURCE_ROLES[] = {
+            {100, "S"}, {103, "R"}, {104, "S"}, {107, "R"}, {108, "S"}, {111, "R"}, {112, "S"}, {115, "R"},
+        };
+
+        inline constexpr OpcodeSpec V6_ROOM_SPECS[] = {
+            {172, 0, "scroll", ""},         {174, 0, "screen", ""},         {175, 0, "palette", ""},
+            {176, 0, "shakeOn", ""},        {177, 0, "shakeOff", ""},       {179, 0, "intensity", ""},
+            {180, 0, "saveLoad", ""},       {181, 0, "screenEffect", ""},   {182, 0, "rgbIntensity", ""},
+            {183, 0, "shadow", ""},         {184, 0, "saveString", ""},     {185, 0, "loadString", ""},
+            {186, 0, "palManipulate", ""},  {187, 0, "colorCycleDelay", ""}, {213, 0, "setPalette", ""},
+            {220, 0, "copyPalColor", ""},
+        };
+
+        inline constexpr OpcodeSpec V6_ACTOR_SPECS[] = {
+            {76, 0, "costume", ""},         {77, 0, "stepDist", ""},        {78, 0, "sound", ""},
+            {79, 0, "walkAnimation", ""},   {80, 0, "talkAnimation", ""},   {81, 0, "standAnimation", ""},
+            {82, 0, "animation", ""},       {83, 0, "default", ""},         {84, 0, "elevation", ""},
+            {85, 0, "animationDefault", ""}, {86, 0, "palette", ""},        {87, 0, "talkColor", ""},
+            {88, 0, "name", "s"},           {89, 0, "initAnimation", ""},   {91, 0, "width", ""},
+            {92, 0, "scale", ""},           {93, 0, "neverZClip", ""},      {94, 0, "setZClip", ""},
+            {95, 0, "ignoreBoxes", ""},     {96, 0, "followBoxes", ""},     {97, 0, "animationSpeed", ""},
+            {98, 0, "shadow", ""},          {99, 0, "textOffset", ""},      {197, 0, "setCurActor", ""},
+            {198, 0, "animationVar", ""},   {215, 0, "ignoreTurnsOn", ""},  {216, 0, "ignoreTurnsOff", ""},
+            {217, 0, "new", ""},            {227, 0, "layer", ""},          {228, 0, "walkScript", ""},
+            {229, 0, "stand", ""},          {230, 0, "direction", ""},      {231, 0, "turnToDirection", ""},
+            {233, 0, "freeze", ""},         {234, 0, "unfreeze", ""},       {235, 0, "talkScript", ""},
+        };
+
+        inline constexpr OpcodeSpec V6_VERB_SPECS[] = {
+            {124, 0, "image", ""},          {125, 0, "name", "s"},          {126, 0, "color", ""},
+            {127, 0, "hicolor", ""},        {128, 0, "setXY", ""},          {129, 0, "on", ""},
+            {130, 0, "off", ""},            {131, 0, "delete", ""},         {132, 0, "new", ""},
+            {133, 0, "dimColor", ""},       {134, 0, "dim", ""},            {135, 0, "key", ""},
+            {136, 0, "center", ""},         {137, 0, "setToString", ""},    {139, 0, "setToObject", ""},
+            {140, 0, "backColor", ""},      {196, 0, "setCurVerb", ""},     {255, 0, "end", ""},
+        };
+
+        inline constexpr OpcodeSpec V6_ARRAY_SPECS[] = {
+            {205, 0, "assignString", "Ws"}, {208, 0, "assignList", "W"},    {212, 0, "assign2dimList", "W"},
+        };
+
+        inline constexpr OpcodeSpec V6_SAVE_RESTORE_SPECS[] = {
+            {141, 0, "saveVerbs", ""},      {142, 0, "restoreVerbs", ""},   {143, 0, "deleteVerbs", ""},
+        };
+
+        inline constexpr OpcodeSpec V6_WAIT_SPECS[] = {
+            {168, 0, "forActor", "j"},      {169, 0, "forMessage", ""},     {170, 0, "forCamera", ""},
+            {171, 0, "forSentence", ""},    {226, 0, "forAnimation", "j"},  {232, 0, "forTurn", "j"},
+        };
+
+        inline constexpr OpcodeSpec V6_SYSTEM_SPECS[] = {
+            {158, 0, "restart", ""},        {159, 0, "pause", ""},          {160, 0, "quit", ""},
+        };
+
+        inline constexpr OpcodeSpec V6_PRINT_SPECS[] = {
+            {65, 0, "pos", ""},             {66, 0, "color", ""},           {67, 0, "clipped", ""},
+            {69, 0, "center", ""},          {71, 0, "left", ""},            {72, 0, "overhead", ""},
+            {74, 0, "mumble", ""},          {75, 0, "text", "s"},           {254, 0, "begin", ""},
+            {255, 0, "end", ""},
+        };
+
+        inline constexpr OpcodeSpec V6_DIM_SPECS[] = {
+            {199, 0, "int", "W"},           {200, 0, "bit", "W"},           {201, 0, "nibble", "W"},
+            {202, 0, "byte", "W"},          {203, 0, "string", "W"},        {204, 0, "nukeArray", "W"},
+        };
+
+        inline constexpr SubOpcodes V6_CURSOR{0xFF, buildTable(V6_CURSOR_SPECS)};
+        inline constexpr SubOpcodes V6_RESOURCE{0xFF, withRoles(buildTable(V6_RESOURCE_SPECS), V6_RESOURCE_ROLES, false)};
+        inline constexpr SubOpcodes V6_ROOM{0xFF, buildTable(V6_ROOM_SPECS)};
+        inline constexpr SubOpcodes V6_ACTOR{0xFF, buildTable(V6_ACTOR_SPECS)};
+        inline constexpr SubOpcodes V6_VERB{0xFF, buildTable(V6_VERB_SPECS)};
+        inline constexpr SubOpcodes V6_ARRAY{0xFF, buildTable(V6_ARRAY_SPECS)};
+        inline constexpr SubOpcodes V6_SAVE_RESTORE{0xFF, buildTable(V6_SAVE_RESTORE_SPECS)};
+        inline constexpr SubOpcodes V6_WAIT{0xFF, buildTable(V6_WAIT_SPECS)};
+        inline constexpr SubOpcodes V6_SYSTEM{0xFF, buildTable(V6_SYSTEM_SPECS)};
+        inline constexpr SubOpcodes V6_PRINT{0xFF, buildTable(V6_PRINT_SPECS)};
+        inline constexpr SubOpcodes V6_DIM{0xFF, buildTable(V6_DIM_SPECS)};
+
+        // v6 opcodes: only constants and variable numbers are inline, the rest is popped
+        inline constexpr OpcodeSpec V6_SPECS[] = {
+            {0x00, 0, "pushByte", "b"},             {0x01, 0, "pushWord", "w"},
+            {0x02, 0, "pushByteVar", "B"},          {0x03, 0, "pushWordVar", "W"},
+            {0x06, 0, "byteArrayRead", "B"},        {0x07, 0, "wordArrayRead", "W"},
+            {0x0A, 0, "byteArrayIndexedRead", "B"}, {0x0B, 0, "wordArrayIndexedRead", "W"},
+            {0x0C, 0, "dup", ""},                   {0x0D, 0, "not", ""},
+            {0x0E, 0, "eq", ""},                    {0x0F, 0, "neq", ""},
+            {0x10, 0, "gt", ""},                    {0x11, 0, "lt", ""},
+            {0x12, 0, "le", ""},                    {0x13, 0, "ge", ""},
+            {0x14, 0, "add", ""},                   {0x15, 0, "sub", ""},
+            {0x16, 0, "mul", ""},                   {0x17, 0, "div", ""},
+            {0x18, 0, "land", ""},                  {0x19, 0, "lor", ""},
+            {0x1A, 0, "pop", ""},
+            {0x42, 0, "writeByteVar", "B"},         {0x43, 0, "writeWordVar", "W"},
+            {0x46, 0, "byteArrayWrite", "B"},       {0x47, 0, "wordArrayWrite", "W"},
+            {0x4A, 0, "byteArrayIndexedWrite", "B"}, {0x4B, 0, "wordArrayIndexedWrite", "W"},
+            {0x4E, 0, "byteVarInc", "B"},           {0x4F, 0, "wordVarInc", "W"},
+            {0x52, 0, "byteArrayInc", "B"},         {0x53, 0, "wordArrayInc", "W"},
+            {0x56, 0, "byteVarDec", "B"},           {0x57, 0, "wordVarDec", "W"},
+            {0x5A, 0, "byteArrayDec", "B"},         {0x5B, 0, "wordArrayDec", "W"},
+            {0x5C, 0, "if", "j"},                   {0x5D, 0, "ifNot", "j"},
+            {0x5E, 0, "startScript", ""},           {0x5F, 0, "startScriptQuick", ""},
+            {0x60, 0, "startObject", ""},           {0x61, 0, "drawObject", ""},
+            {0x62, 0, "drawObjectAt", ""},          {0x63, 0, "drawBlastObject", ""},
+            {0x64, 0, "setBlastObjectWindow", ""},  {0x65, 0, "stopObjectCodeA", ""},
+            {0x66, 0, "stopObjectCodeB", ""},       {0x67, 0, "endCutscene", ""},
+            {0x68, 0, "cutscene", ""},              {0x69, 0, "stopMusic", ""},
+            {0x6A, 0, "freezeUnfreeze", ""},        {0x6B, 0, "cursorCommand", "S", &V6_CURSOR},
+            {0x6C, 0, "breakHere", ""},             {0x6D, 0, "ifClassOfIs", ""},
+            {0x6E, 0, "setClass", ""},              {0x6F, 0, "getState", ""},
+            {0x70, 0, "setState", ""},              {0x71, 0, "setOwner", ""},
+            {0x72, 0, "getOwner", ""},              {0x73, 0, "jump", "j"},
+            {0x74, 0, "startSound", ""},            {0x75, 0, "stopSound", ""},
+            {0x76, 0, "startMusic", ""},            {0x77, 0, "stopObjectScript", ""},
+            {0x78, 0, "panCameraTo", ""},           {0x79, 0, "actorFollowCamera", ""},
+            {0x7A, 0, "setCameraAt", ""},           {0x7B, 0, "loadRoom", ""},
+            {0x7C, 0, "stopScript", ""},            {0x7D, 0, "walkActorToObj", ""},
+            {0x7E, 0, "walkActorTo", ""},           {0x7F, 0, "putActorAtXY", ""},
+            {0x80, 0, "putActorAtObject", ""},      {0x81, 0, "faceActor", ""},
+            {0x82, 0, "animateActor", ""},          {0x83, 0, "doSentence", ""},
+            {0x84, 0, "pickupObject", ""},          {0x85, 0, "loadRoomWithEgo", ""},
+            {0x87, 0, "getRandomNumber", ""},       {0x88, 0, "getRandomNumberRange", ""},
+            {0x8A, 0, "getActorMoving", ""},        {0x8B, 0, "isScriptRunning", ""},
+            {0x8C, 0, "getActorRoom", ""},          {0x8D, 0, "getObjectX", ""},
+            {0x8E, 0, "getObjectY", ""},            {0x8F, 0, "getObjectOldDir", ""},
+            {0x90, 0, "getActorWalkBox", ""},       {0x91, 0, "getActorCostume", ""},
+            {0x92, 0, "findInventory", ""},         {0x93, 0, "getInventoryCount", ""},
+            {0x94, 0, "getVerbFromXY", ""},         {0x95, 0, "beginOverride", ""},
+            {0x96, 0, "endOverride", ""},           {0x97, 0, "setObjectName", "s"},
+            {0x98, 0, "isSoundRunning", ""},        {0x99, 0, "setBoxFlags", ""},
+            {0x9A, 0, "createBoxMatrix", ""},       {0x9B, 0, "resourceRoutines", "S", &V6_RESOURCE},
+            {0x9C, 0, "roomOps", "S", &V6_ROOM},    {0x9D, 0, "actorOps", "S", &V6_ACTOR},
+            {0x9E, 0, "verbOps", "S", &V6_VERB},    {0x9F, 0, "getActorFromXY", ""},
+            {0xA0, 0, "findObject", ""},            {0xA1, 0, "pseudoRoom", ""},
+            {0xA2, 0, "getActorElevation", ""},     {0xA3, 0, "getVerbEntrypoint", ""},
+            {0xA4, 0, "arrayOps", "S", &V6_ARRAY},  {0xA5, 0, "saveRestoreVerbs", "S", &V6_SAVE_RESTORE},
+            {0xA6, 0, "drawBox", ""},               {0xA7, 0, "pop", ""},
+            {0xA8, 0, "getActorWidth", ""},         {0xA9, 0, "wait", "S", &V6_WAIT},
+            {0xAA, 0, "getActorScaleX", ""},        {0xAB, 0, "getActorAnimCounter", ""},
+            {0xAC, 0, "soundKludge", ""},           {0xAD, 0, "isAnyOf", ""},
+            {0xAE, 0, "systemOps", "S", &V6_SYSTEM}, {0xAF, 0, "isActorInBox", ""},
+            {0xB0, 0, "delay", ""},                 {0xB1, 0, "delaySeconds", ""},
+            {0xB2, 0, "delayMinutes", ""},          {0xB3, 0, "stopSentence", ""},
+            {0xB4, 0, "printLine", "S", &V6_PRINT}, {0xB5, 0, "printText", "S", &V6_PRINT},
+            {0xB6, 0, "printDebug", "S", &V6_PRINT}, {0xB7, 0, "printSystem", "S", &V6_PRINT},
+            {0xB8, 0, "printActor", "S", &V6_PRINT}, {0xB9, 0, "printEgo", "S", &V6_PRINT},
+            {0xBA, 0, "talkActor", "s"},            {0xBB, 0, "talkEgo", "s"},
+            {0xBC, 0, "dimArray", "S", &V6_DIM},    {0xBD, 0, "dummy", ""},
+            {0xBE, 0, "startObjectQuick", ""},      {0xBF, 0, "startScriptQuick2", ""},
+            {0xC0, 0, "dim2dimArray", "S", &V6_DIM}, {0xC4, 0, "abs", ""},
+            {0xC5, 0, "distObjectObject", ""},      {0xC6, 0, "distObjectPt", ""},
+            {0xC7, 0, "distPtPt", ""},              {0xC8, 0, "kernelGetFunctions", ""},
+            {0xC9, 0, "kernelSetFunctions", ""},    {0xCA, 0, "delayFrames", ""},
+            {0xCB, 0, "pickOneOf", ""},             {0xCC, 0, "pickOneOfDefault", ""},
+            {0xCD, 0, "stampObject", ""},           {0xD0, 0, "getDateTime", ""},
+            {0xD1, 0, "stopTalking", ""},           {0xD2, 0, "getAnimateVariable", ""},
+            {0xD4, 0, "shuffle", "W"},              {0xD5, 0, "jumpToScript", ""},
+            {0xD6, 0, "band", ""},                  {0xD7, 0, "bor", ""},
+            {0xD8, 0, "isRoomScriptRunning", ""},   {0xDD, 0, "findAllObjects", ""},
+            {0xE1, 0, "getPixel", ""},              {0xE3, 0, "pickVarRandom", "W"},
+            {0xE4, 0, "setBoxSet", ""},             {0xEC, 0, "getActorLayer", ""},
+            {0xED, 0, "getObjectNewDir", ""},
+        };
+
+        inline constexpr RoleSpec V6_ROLES[] = {
+            {0x5E, ".SL"},  {0x5F, "SL"},   {0x60, ".O.L"}, {0x61, "O."},   {0x62, "O.."},  {0x6D, "OL"},
+            {0x6E, "OL"},   {0x6F, "O"},    {0x70, "O."},   {0x71, "O."},   {0x72, "O"},    {0x77, "O"},
+            {0x7B, "R"},    {0x7C, "S"},    {0x7D, ".O."},  {0x7F, "...R"}, {0x80, ".O"},   {0x83, "..OO"},
+            {0x84, "OR"},   {0x85, "OR.."}, {0x8B, "S"},    {0x8D, "O"},    {0x8E, "O"},    {0x8F, "O"},
+            {0x97, "O"},    {0xA3, "O."},   {0xBE, "O.L"},  {0xBF, "SL"},   {0xC5, "OO"},   {0xC6, "O.."},
+            {0xD5, ".SL"},  {0xED, "O"},
+        };
+
+        inline constexpr OpcodeTable V6_OPCODES = withRoles(buildTable(V6_SPECS), V6_ROLES, false);
+    } // namespace bytecode
+
+} // namespace scummredux
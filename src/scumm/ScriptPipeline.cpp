@@ -0,0 +1,400 @@
+#include "ScriptPipeline.h"
+#include "../core/TraceRecorder.h"
+#include "../views/ConsoleView.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace scummredux {
+
+    namespace {
+
+        constexpr char CACHE_MAGIC[4] = {'S', 'R', 'D', 'C'};
+
+        uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull) {
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ data[i]) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        ScriptPipeline::Listing decompileBlock(ScriptVersion version, std::span<const uint8_t> block,
+                                               ScriptPipeline::Result& result) {
+            ScriptDisassembler script;
+            if (!script.load(version, block, result.error)) {
+                return nullptr;
+            }
+            auto lines = std::make_shared<std::vector<ScriptDecompiler::Line>>();
+            const ScriptDecompiler::Stats stats = ScriptDecompiler::decompile(script, *lines);
+            result.complete = stats.complete;
+            result.gotos = stats.gotos;
+            return lines;
+        }
+
+        // Bounds-checked reads from the cache file
+        class Reader {
+        public:
+            explicit Reader(const std::vector<char>& data) : m_data(data) {}
+
+            template<typename T>
+            bool read(T& value) {
+                if (m_data.size() - m_position < sizeof(T)) {
+                    return false;
+                }
+                std::memcpy(&value, m_data.data() + m_position, sizeof(T));
+                m_position += sizeof(T);
+                return true;
+            }
+
+            bool read(std::string& text, size_t size) {
+                if (m_data.size() - m_position < size) {
+                    return false;
+                }
+                text.assign(m_data.data() + m_position, size);
+                m_position += size;
+                return true;
+            }
+
+            bool atEnd() const { return m_position == m_data.size(); }
+
+        private:
+            const std::vector<char>& m_data;
+            size_t m_position = 0;
+        };
+
+    } // namespace
+
+    ScriptPipeline::~ScriptPipeline() {
+        cancel();
+        waitForJobs();
+        JobSystem::getInstance().wait(m_cacheJobs);
+    }
+
+    uint64_t ScriptPipeline::hashScript(ScriptVersion version, std::span<const uint8_t> block) {
+        // The same bytes decompile differently as v5 and v6
+        const uint8_t salt = static_cast<uint8_t>(version);
+        return fnv1a(block.data(), block.size(), fnv1a(&salt, 1));
+    }
+
+    void ScriptPipeline::start(std::vector<Script> scripts, ScriptVersion version, const std::filesystem::path& cachePath) {
+        cancel();
+        waitForJobs();
+        useCache(cachePath);
+
+        auto state = std::make_shared<State>();
+        state->scripts = std::move(scripts);
+        state->version = version;
+        state->cache = m_cache;
+        state->load = m_load;
+        state->results.resize(state->scripts.size());
+        state->listings.resize(state->scripts.size());
+        state->start = std::chrono::steady_clock::now();
+        m_state = state;
+        m_running = true;
+        m_reportedQuarter = 0;
+
+        auto& jobs = JobSystem::getInstance();
+        ConsoleView::info("Decompiling " + std::to_string(state->scripts.size()) + " scripts on " +
+                          std::to_string(jobs.getWorkerCount()) + " workers");
+
+        // One job per script: each writes only its own result and listing slot
+        JobSystem::Options options;
+        options.counter = &state->counter;
+        options.token = &state->token;
+        if (m_load) {
+            options.dependencies = {m_load->job};
+        }
+        for (size_t i = 0; i < state->scripts.size(); i++) {
+            jobs.submit([state, i] {
+                SCUMM_TRACE_SCOPE("decompileScript", "scripts");
+                const Script& script = state->scripts[i];
+                Result& result = state->results[i];
+                result.fileIndex = script.fileIndex;
+                result.record = script.record;
+
+                const auto block = script.file->view(script.block.offset, script.block.size);
+                result.hash = hashScript(state->version, block);
+                if (state->cache.contains(result.hash) || (state->load && state->load->cache.contains(result.hash))) {
+                    result.cached = true;
+                    return;
+                }
+                state->listings[i] = decompileBlock(state->version, block, result);
+            }, options);
+        }
+    }
+
+    void ScriptPipeline::cancel() {
+        if (m_state) {
+            m_state->token.cancel();
+        }
+    }
+
+    void ScriptPipeline::reset() {
+        cancel();
+        waitForJobs();
+        m_state.reset();
+        m_results.clear();
+        m_running = false;
+        if (m_cacheDirty) {
+            finishCacheLoad();
+            saveCache();
+        }
+    }
+
+    void ScriptPipeline::waitForJobs() {
+        if (m_state) {
+            JobSystem::getInstance().wait(m_state->counter);
+        }
+    }
+
+    bool ScriptPipeline::poll() {
+        adoptCache();
+        if (!m_running) {
+            return false;
+        }
+
+        const size_t total = m_state->scripts.size();
+        const size_t completed = getCompleted();
+        if (!m_state->counter.isDone()) {
+            const size_t quarter = total ? completed * 4 / total : 0;
+            if (quarter > m_reportedQuarter && !m_state->token.isCancelled()) {
+                m_reportedQuarter = quarter;
+                ConsoleView::debug("Scripts: " + std::to_string(completed) + " of " + std::to_string(total));
+            }
+            return false;
+        }
+
+        m_running = false;
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_state->start).count();
+
+        // Whatever finished is worth keeping, even from a cancelled run
+        for (size_t i = 0; i < total; i++) {
+            if (m_state->listings[i]) {
+                m_cache[m_state->results[i].hash] = std::move(m_state->listings[i]);
+                m_cacheDirty = true;
+            }
+        }
+        if (m_state->token.isCancelled()) {
+            ConsoleView::warning("Script decompiling cancelled");
+            return true;
+        }
+
+        // A full run knows every live script: entries of edited or removed ones go
+        m_results = std::move(m_state->results);
+        Cache live;
+        for (const Result& result : m_results) {
+            const auto it = m_cache.find(result.hash);
+            if (it != m_cache.end()) {
+                live.emplace(it->first, it->second);
+            }
+        }
+        m_cacheDirty |= live.size() != m_cache.size();
+        m_cache = std::move(live);
+        if (m_cacheDirty && !saveCache()) {
+            ConsoleView::warning("Failed to write the script cache: " + m_cachePath.string());
+        }
+
+        size_t cached = 0;
+        size_t partial = 0;
+        size_t failed = 0;
+        for (const Result& result : m_results) {
+            cached += result.cached ? 1 : 0;
+            partial += result.complete ? 0 : 1;
+            failed += result.error.empty() ? 0 : 1;
+        }
+
+        char message[160];
+        std::snprintf(message, sizeof(message), "Decompiled %zu scripts in %.1f ms (%zu unchanged from the cache, %zu partly, %zu failed)",
+                      m_results.size(), ms, cached, partial, failed);
+        if (partial == 0 && failed == 0) {
+            ConsoleView::success(message);
+        } else {
+            ConsoleView::warning(message);
+        }
+        return true;
+    }
+
+    void ScriptPipeline::decompile(const ScriptDisassembler& script, const std::filesystem::path& cachePath,
+                                   std::function<void(Listing)> done) {
+        const ScriptVersion version = script.getVersion();
+        const uint64_t hash = hashScript(version, script.getBlock());
+        std::shared_ptr<const CacheLoad> load;
+        if (!cachePath.empty()) {
+            useCache(cachePath);
+            adoptCache();
+            const auto it = m_cache.find(hash);
+            if (it != m_cache.end()) {
+                done(it->second);
+                return;
+            }
+            load = m_load;
+        }
+
+        // The job works on a copy of the block: the tab or the game may go meanwhile
+        struct Request {
+            std::vector<uint8_t> block;
+            Listing lines;
+            bool decompiled = false;
+        };
+        auto request = std::make_shared<Request>();
+        request->block.assign(script.getBlock().begin(), script.getBlock().end());
+
+        auto& jobs = JobSystem::getInstance();
+        JobSystem::Options options;
+        options.priority = JobPriority::Interactive;
+        if (load) {
+            options.dependencies = {load->job};
+        }
+        const JobSystem::Handle job = jobs.submit([request, load, version, hash] {
+            SCUMM_TRACE_SCOPE("decompileSource", "scripts");
+            if (load) {
+                const auto it = load->cache.find(hash);
+                if (it != load->cache.end()) {
+                    request->lines = it->second;
+                    return;
+                }
+            }
+            Result result;
+            request->lines = decompileBlock(version, request->block, result);
+            if (!request->lines) {
+                request->lines = std::make_shared<std::vector<ScriptDecompiler::Line>>(
+                    std::vector<ScriptDecompiler::Line>{{0, "// " + result.error}});
+            }
+            request->decompiled = true;
+        }, std::move(options));
+
+        jobs.continueOnMainThread(job, [this, request, hash, cachePath, done = std::move(done)] {
+            if (request->decompiled && !cachePath.empty() && cachePath == m_cachePath) {
+                m_cache.emplace(hash, request->lines);
+                m_cacheDirty = true;
+            }
+            done(request->lines);
+        });
+    }
+
+    void ScriptPipeline::useCache(const std::filesystem::path& path) {
+        if (path == m_cachePath) {
+            return;
+        }
+        if (m_cacheDirty) {
+            finishCacheLoad();
+            saveCache();
+        }
+        m_cache.clear();
+        m_cacheDirty = false;
+        m_cachePath = path;
+
+        auto load = std::make_shared<CacheLoad>();
+        load->path = path;
+        JobSystem::Options options;
+        options.priority = JobPriority::Interactive;
+        options.counter = &m_cacheJobs;
+        load->job = JobSystem::getInstance().submit([load] {
+            SCUMM_TRACE_SCOPE("loadScriptCache", "scripts");
+            loadCache(load->path, load->cache);
+        }, std::move(options));
+        m_load = std::move(load);
+    }
+
+    void ScriptPipeline::adoptCache() {
+        if (!m_load || !m_load->job->isFinished()) {
+            return;
+        }
+
+        // Entries decompiled while it loaded stay; jobs may still read the loaded ones
+        for (const auto& [hash, lines] : m_load->cache) {
+            m_cache.emplace(hash, lines);
+        }
+        m_load.reset();
+    }
+
+    void ScriptPipeline::finishCacheLoad() {
+        JobSystem::getInstance().wait(m_cacheJobs);
+        adoptCache();
+    }
+
+    bool ScriptPipeline::loadCache(const std::filesystem::path& path, Cache& cache) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        const std::vector<char> data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+        // Entries: hash, line count, then (offset, length, text) per line
+        Reader reader(data);
+        CacheHeader header;
+        if (!reader.read(header) || std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+            header.version != CACHE_VERSION || header.decompilerVersion != ScriptDecompiler::VERSION) {
+            return false;
+        }
+
+        Cache entries;
+        for (uint32_t entry = 0; entry < header.count; entry++) {
+            uint64_t hash = 0;
+            uint32_t count = 0;
+            if (!reader.read(hash) || !reader.read(count) || count > data.size()) {
+                return false;
+            }
+            auto lines = std::make_shared<std::vector<ScriptDecompiler::Line>>(count);
+            for (ScriptDecompiler::Line& line : *lines) {
+                uint32_t length = 0;
+                if (!reader.read(line.offset) || !reader.read(length) || !reader.read(line.text, length)) {
+                    return false;
+                }
+            }
+            entries.emplace(hash, std::move(lines));
+        }
+        if (!reader.atEnd()) {
+            return false;
+        }
+        cache = std::move(entries);
+        return true;
+    }
+
+    bool ScriptPipeline::saveCache() {
+        if (m_cachePath.empty()) {
+            return false;
+        }
+        m_cacheDirty = false;
+
+        CacheHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.decompilerVersion = ScriptDecompiler::VERSION;
+        header.count = static_cast<uint32_t>(m_cache.size());
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_cachePath.parent_path(), ec);
+
+        // Written aside and renamed, so a crash never leaves half a cache behind
+        std::filesystem::path temporary = m_cachePath;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                return false;
+            }
+            auto write = [&out](const auto& value) {
+                out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            };
+            write(header);
+            for (const auto& [hash, lines] : m_cache) {
+                write(hash);
+                write(static_cast<uint32_t>(lines->size()));
+                for (const ScriptDecompiler::Line& line : *lines) {
+                    write(line.offset);
+                    write(static_cast<uint32_t>(line.text.size()));
+                    out.write(line.text.data(), static_cast<std::streamsize>(line.text.size()));
+                }
+            }
+            if (!out) {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, m_cachePath, ec);
+        return !ec;
+    }
+
+} // namespace scummredux
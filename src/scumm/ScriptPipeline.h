@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ResourceFile.h"
+#include "ScriptDecompiler.h"
+#include "../core/JobSystem.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // Decompiles every script of a game in the background, one job per script on the
+    // JobSystem (like RoomPipeline does for rooms). Output is cached by a hash of the
+    // script's bytes, in memory and in a cache file per game, so a repeat run only
+    // decompiles the scripts that changed; the editor reads the same cache. The cache
+    // file is read by a job too: nothing here blocks the main thread on it.
+    class ScriptPipeline {
+    public:
+        using Listing = std::shared_ptr<const std::vector<ScriptDecompiler::Line>>;
+
+        struct Script {
+            ResourceFile* file;
+            size_t fileIndex;
+            uint32_t record;            // In the file's BlockIndex
+            Chunk block;
+        };
+
+        struct Result {
+            size_t fileIndex = 0;
+            uint32_t record = 0;
+            uint64_t hash = 0;
+            bool cached = false;        // Skipped: the cache had this script
+            bool complete = true;       // Decoded to the end (scripts decompiled by this run)
+            size_t gotos = 0;           // Jumps left unstructured (likewise)
+            std::string error;
+        };
+
+        ScriptPipeline() = default;
+        ~ScriptPipeline();
+
+        ScriptPipeline(const ScriptPipeline&) = delete;
+        ScriptPipeline& operator=(const ScriptPipeline&) = delete;
+
+        void start(std::vector<Script> scripts, ScriptVersion version, const std::filesystem::path& cachePath);
+        void cancel();
+
+        // Cancels, waits for the in-flight jobs, saves new cache entries and drops all results
+        void reset();
+
+        // Main thread: reports completion; returns true on the frame the run finished
+        bool poll();
+
+        bool isRunning() const { return m_running; }
+        size_t getTotal() const { return m_state ? m_state->scripts.size() : 0; }
+        size_t getCompleted() const { return m_state ? m_state->scripts.size() - m_state->counter.getPending() : 0; }
+        float getProgress() const { return getTotal() ? float(getCompleted()) / float(getTotal()) : 0.0f; }
+
+        // Results of the last finished (not cancelled) run
+        const std::vector<Result>& getResults() const { return m_results; }
+
+        // Main thread: the source of one script. A cache hit calls done at once, anything
+        // else is decompiled by an Interactive job and done runs on the main thread once
+        // it finished. An empty cache path skips the cache (the script's game is closed).
+        void decompile(const ScriptDisassembler& script, const std::filesystem::path& cachePath,
+                       std::function<void(Listing)> done);
+
+        static uint64_t hashScript(ScriptVersion version, std::span<const uint8_t> block);
+
+    private:
+        using Cache = std::unordered_map<uint64_t, Listing>;
+
+        // Cache file being read by a job; jobs that look up in it depend on the job
+        struct CacheLoad {
+            std::filesystem::path path;
+            Cache cache;
+            JobSystem::Handle job;
+        };
+
+        struct State {
+            std::vector<Script> scripts;
+            ScriptVersion version = ScriptVersion::V5;
+            Cache cache;                // Snapshot the jobs look up in
+            std::shared_ptr<const CacheLoad> load;  // And in this, if it was still loading
+            std::vector<Result> results;
+            std::vector<Listing> listings;  // New output, merged into the cache by poll()
+            CancellationToken token;
+            JobCounter counter;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        struct CacheHeader {
+            char magic[4];
+            uint32_t version;
+            uint32_t decompilerVersion;
+            uint32_t count;
+        };
+        static_assert(sizeof(CacheHeader) == 16);
+
+        void waitForJobs();
+        void useCache(const std::filesystem::path& path);
+        void adoptCache();
+        void finishCacheLoad();
+        static bool loadCache(const std::filesystem::path& path, Cache& cache);
+        bool saveCache();
+
+        std::shared_ptr<State> m_state;
+        std::vector<Result> m_results;
+        Cache m_cache;
+        std::filesystem::path m_cachePath;
+        std::shared_ptr<CacheLoad> m_load;      // Merged into m_cache once finished
+        JobCounter m_cacheJobs;                 // Cache loads still running
+        bool m_cacheDirty = false;
+        bool m_running = false;
+        size_t m_reportedQuarter = 0;
+
+        static constexpr uint32_t CACHE_VERSION = 1;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,561 @@
+#include "SmapDecoder.h"
+#include "Chunk.h"
+#include "../core/JobSystem.h"
+#include "../utils/Simd.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+namespace scummredux {
+
+    namespace {
+
+        constexpr size_t STRIP_WIDTH = SmapDecoder::STRIP_WIDTH;
+
+        // Fills may overshoot by up to one vector, runs by up to 256 pixels
+        constexpr size_t SCRATCH_SLACK = 256 + 16;
+
+        uint32_t readLE32(const uint8_t* data) {
+            return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                   (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        }
+
+        // Writes at least count bytes, rounded up to whole vectors
+        inline void fill(uint8_t* out, uint8_t color, size_t count) {
+#if defined(SCUMMREDUX_SIMD_X86)
+            const __m128i value = _mm_set1_epi8(static_cast<char>(color));
+            for (size_t i = 0; i < count; i += 16) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), value);
+            }
+#elif defined(SCUMMREDUX_SIMD_NEON)
+            const uint8x16_t value = vdupq_n_u8(color);
+            for (size_t i = 0; i < count; i += 16) {
+                vst1q_u8(out + i, value);
+            }
+#else
+            std::memset(out, color, count);
+#endif
+        }
+
+        // LSB-first bit buffer over a strip. Reading past the end yields zero bits;
+        // overrun() tells whether the decoder actually needed them.
+        class BitReader {
+        public:
+            BitReader(const uint8_t* data, const uint8_t* end) : m_data(data), m_begin(data), m_end(end) {}
+
+            // Afterwards at least 56 bits are buffered
+            void refill() {
+                if (m_end - m_data >= 8) {
+                    uint64_t word;
+                    std::memcpy(&word, m_data, sizeof(word));     // Little-endian targets only
+                    m_bits |= word << m_count;
+                    m_data += (63 - m_count) >> 3;
+                    m_count |= 56;
+                    return;
+                }
+                while (m_count <= 56) {
+                    const uint64_t byte = m_data < m_end ? *m_data++ : (m_padding++, 0);
+                    m_bits |= byte << m_count;
+                    m_count += 8;
+                }
+            }
+
+            uint64_t peek() const { return m_bits; }
+            void skip(uint32_t count) {
+                m_bits >>= count;
+                m_count -= count;
+            }
+            uint32_t read(uint32_t count) {
+                const uint32_t value = static_cast<uint32_t>(m_bits & ((1u << count) - 1));
+                skip(count);
+                return value;
+            }
+
+            // The last code may be fetched a byte early, like the original decoder does
+            bool overrun() const {
+                const size_t consumed = static_cast<size_t>(m_data - m_begin) + m_padding - m_count / 8;
+                return consumed > static_cast<size_t>(m_end - m_begin) + 1;
+            }
+
+        private:
+            const uint8_t* m_data;
+            const uint8_t* m_begin;
+            const uint8_t* m_end;
+            uint64_t m_bits = 0;
+            uint32_t m_count = 0;
+            size_t m_padding = 0;
+        };
+
+        enum Op : uint8_t {
+            OP_SAME,                // Repeat the current color
+            OP_NEW_COLOR,           // Literal color of shift bits
+            OP_DELTA,               // Complex: color += delta
+            OP_RUN,                 // Complex: 8-bit repeat count (0 = 256)
+            OP_INCREMENT,           // Basic: color += increment
+            OP_FLIP_INCREMENT       // Basic: negate the increment, then apply it
+        };
+
+        struct PrefixEntry {
+            Op op;
+            uint8_t length;
+            int8_t delta;
+        };
+
+        // Complex codes: 0 same, 10 + color, 11 + 3-bit delta (4 means a run follows)
+        constexpr std::array<PrefixEntry, 32> makeComplexTable() {
+            std::array<PrefixEntry, 32> table{};
+            for (uint32_t bits = 0; bits < 32; bits++) {
+                if (!(bits & 1)) {
+                    table[bits] = {OP_SAME, 1, 0};
+                } else if (!(bits & 2)) {
+                    table[bits] = {OP_NEW_COLOR, 2, 0};
+                } else {
+                    const int delta = static_cast<int>((bits >> 2) & 7) - 4;
+                    table[bits] = delta ? PrefixEntry{OP_DELTA, 5, static_cast<int8_t>(delta)} : PrefixEntry{OP_RUN, 5, 0};
+                }
+            }
+            return table;
+        }
+
+        // Basic codes: 0 same, 10 + color, 110 step, 111 reverse and step
+        constexpr std::array<PrefixEntry, 8> makeBasicTable() {
+            std::array<PrefixEntry, 8> table{};
+            for (uint32_t bits = 0; bits < 8; bits++) {
+                if (!(bits & 1)) {
+                    table[bits] = {OP_SAME, 1, 0};
+                } else if (!(bits & 2)) {
+                    table[bits] = {OP_NEW_COLOR, 2, 0};
+                } else {
+                    table[bits] = {(bits & 4) ? OP_FLIP_INCREMENT : OP_INCREMENT, 3, 0};
+                }
+            }
+            return table;
+        }
+
+        constexpr auto COMPLEX_TABLE = makeComplexTable();
+        constexpr auto BASIC_TABLE = makeBasicTable();
+
+        constexpr std::array<SmapDecoder::CodecInfo, 256> makeCodecTable() {
+            std::array<SmapDecoder::CodecInfo, 256> table{};
+            table[1] = {SmapDecoder::Codec::Raw, 8, false};
+            table[2] = {SmapDecoder::Codec::RunLength, 8, false};
+            for (uint8_t shift = 4; shift <= 8; shift++) {
+                table[10 + shift] = {SmapDecoder::Codec::BasicVertical, shift, false};
+                table[20 + shift] = {SmapDecoder::Codec::BasicHorizontal, shift, false};
+                table[30 + shift] = {SmapDecoder::Codec::BasicVertical, shift, true};
+                table[40 + shift] = {SmapDecoder::Codec::BasicHorizontal, shift, true};
+                table[60 + shift] = {SmapDecoder::Codec::Complex, shift, false};
+                table[80 + shift] = {SmapDecoder::Codec::Complex, shift, true};
+                table[100 + shift] = {SmapDecoder::Codec::Complex, shift, false};
+                table[120 + shift] = {SmapDecoder::Codec::Complex, shift, true};
+            }
+            return table;
+        }
+
+        constexpr auto CODEC_TABLE = makeCodecTable();
+
+        // Zero bits are by far the most common code: each repeats the color once, so a
+        // whole group is emitted with one fill
+        inline bool emitSameRun(BitReader& reader, uint8_t*& out, const uint8_t* end, uint8_t color) {
+            const uint64_t bits = reader.peek();
+            if (bits & 1) {
+                return false;
+            }
+            const size_t zeros = std::min<size_t>(std::countr_zero(bits | (1ull << 56)), static_cast<size_t>(end - out));
+            fill(out, color, zeros);
+            out += zeros;
+            reader.skip(static_cast<uint32_t>(zeros));
+            return true;
+        }
+
+        bool decodeComplex(const uint8_t* data, const uint8_t* dataEnd, uint8_t* out, size_t pixels, uint32_t shift) {
+            const uint8_t* const end = out + pixels;
+            BitReader reader(data + 1, dataEnd);
+            uint8_t color = data[0];
+            *out++ = color;
+
+            while (out < end) {
+                reader.refill();
+                if (emitSameRun(reader, out, end, color)) {
+                    continue;
+                }
+
+                const PrefixEntry& entry = COMPLEX_TABLE[reader.peek() & 31];
+                reader.skip(entry.length);
+                switch (entry.op) {
+                    case OP_NEW_COLOR:
+                        color = static_cast<uint8_t>(reader.read(shift));
+                        *out++ = color;
+                        break;
+                    case OP_DELTA:
+                        color = static_cast<uint8_t>(color + entry.delta);
+                        *out++ = color;
+                        break;
+                    case OP_RUN: {
+                        const uint32_t reps = reader.read(8);
+                        const size_t count = std::min<size_t>(reps ? reps : 256, static_cast<size_t>(end - out));
+                        fill(out, color, count);
+                        out += count;
+                        break;
+                    }
+                    default:
+                        *out++ = color;
+                        break;
+                }
+            }
+            return !reader.overrun();
+        }
+
+        bool decodeBasic(const uint8_t* data, const uint8_t* dataEnd, uint8_t* out, size_t pixels, uint32_t shift) {
+            const uint8_t* const end = out + pixels;
+            BitReader reader(data + 1, dataEnd);
+            uint8_t color = data[0];
+            int8_t increment = -1;
+            *out++ = color;
+
+            while (out < end) {
+                reader.refill();
+                if (emitSameRun(reader, out, end, color)) {
+                    continue;
+                }
+
+                const PrefixEntry& entry = BASIC_TABLE[reader.peek() & 7];
+                reader.skip(entry.length);
+                switch (entry.op) {
+                    case OP_NEW_COLOR:
+                        color = static_cast<uint8_t>(reader.read(shift));
+                        increment = -1;
+                        break;
+                    case OP_FLIP_INCREMENT:
+                        increment = static_cast<int8_t>(-increment);
+                        color = static_cast<uint8_t>(color + increment);
+                        break;
+                    case OP_INCREMENT:
+                        color = static_cast<uint8_t>(color + increment);
+                        break;
+                    default:
+                        break;
+                }
+                *out++ = color;
+            }
+            return !reader.overrun();
+        }
+
+        // (count - 1, color) byte pairs
+        bool decodeRunLength(const uint8_t* data, const uint8_t* dataEnd, uint8_t* out, size_t pixels) {
+            const uint8_t* const end = out + pixels;
+            while (out < end) {
+                if (dataEnd - data < 2) {
+                    return false;
+                }
+                const size_t count = std::min<size_t>(data[0] + 1u, static_cast<size_t>(end - out));
+                fill(out, data[1], count);
+                out += count;
+                data += 2;
+            }
+            return true;
+        }
+
+        // One 8-pixel row; transparent pixels keep what the image already has
+        inline void storeRow(uint8_t* destination, const uint8_t* source, bool transparent, uint8_t transparentColor) {
+            if (!transparent) {
+                std::memcpy(destination, source, STRIP_WIDTH);
+                return;
+            }
+#if defined(SCUMMREDUX_SIMD_X86)
+            const __m128i pixels = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source));
+            const __m128i background = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(destination));
+            const __m128i mask = _mm_cmpeq_epi8(pixels, _mm_set1_epi8(static_cast<char>(transparentColor)));
+            const __m128i blended = _mm_or_si128(_mm_and_si128(mask, background), _mm_andnot_si128(mask, pixels));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), blended);
+#elif defined(SCUMMREDUX_SIMD_NEON)
+            const uint8x8_t pixels = vld1_u8(source);
+            const uint8x8_t mask = vceq_u8(pixels, vdup_n_u8(transparentColor));
+            vst1_u8(destination, vbsl_u8(mask, vld1_u8(destination), pixels));
+#else
+            for (size_t i = 0; i < STRIP_WIDTH; i++) {
+                if (source[i] != transparentColor) {
+                    destination[i] = source[i];
+                }
+            }
+#endif
+        }
+
+        void storeRows(const uint8_t* rows, IndexedImage& image, size_t x, bool transparent, uint8_t transparentColor) {
+            for (size_t y = 0; y < image.height; y++) {
+                storeRow(image.row(y) + x, rows + y * STRIP_WIDTH, transparent, transparentColor);
+            }
+        }
+
+        // Column-major strips (8 columns of image.height pixels) are transposed in
+        // 8x8 blocks in registers, then stored row by row
+        void storeColumns(const uint8_t* columns, IndexedImage& image, size_t x, bool transparent, uint8_t transparentColor) {
+            const size_t height = image.height;
+            alignas(16) uint8_t block[STRIP_WIDTH * 8];
+
+            size_t y = 0;
+            for (; y + 8 <= height; y += 8) {
+#if defined(SCUMMREDUX_SIMD_X86)
+                auto column = [&](size_t c) {
+                    return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(columns + c * height + y));
+                };
+                const __m128i t0 = _mm_unpacklo_epi8(column(0), column(1));
+                const __m128i t1 = _mm_unpacklo_epi8(column(2), column(3));
+                const __m128i t2 = _mm_unpacklo_epi8(column(4), column(5));
+                const __m128i t3 = _mm_unpacklo_epi8(column(6), column(7));
+                const __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+                const __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+                const __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+                const __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+                _mm_store_si128(reinterpret_cast<__m128i*>(block + 0), _mm_unpacklo_epi32(u0, u2));
+                _mm_store_si128(reinterpret_cast<__m128i*>(block + 16), _mm_unpackhi_epi32(u0, u2));
+                _mm_store_si128(reinterpret_cast<__m128i*>(block + 32), _mm_unpacklo_epi32(u1, u3));
+                _mm_store_si128(reinterpret_cast<__m128i*>(block + 48), _mm_unpackhi_epi32(u1, u3));
+#elif defined(SCUMMREDUX_SIMD_NEON)
+                auto column = [&](size_t c) { return vld1_u8(columns + c * height + y); };
+                const uint8x8x2_t t01 = vtrn_u8(column(0), column(1));
+                const uint8x8x2_t t23 = vtrn_u8(column(2), column(3));
+                const uint8x8x2_t t45 = vtrn_u8(column(4), column(5));
+                const uint8x8x2_t t67 = vtrn_u8(column(6), column(7));
+                const uint16x4x2_t u02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]), vreinterpret_u16_u8(t23.val[0]));
+                const uint16x4x2_t u13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]), vreinterpret_u16_u8(t23.val[1]));
+                const uint16x4x2_t u46 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]), vreinterpret_u16_u8(t67.val[0]));
+                const uint16x4x2_t u57 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]), vreinterpret_u16_u8(t67.val[1]));
+                const uint32x2x2_t w04 = vtrn_u32(vreinterpret_u32_u16(u02.val[0]), vreinterpret_u32_u16(u46.val[0]));
+                const uint32x2x2_t w15 = vtrn_u32(vreinterpret_u32_u16(u13.val[0]), vreinterpret_u32_u16(u57.val[0]));
+                const uint32x2x2_t w26 = vtrn_u32(vreinterpret_u32_u16(u02.val[1]), vreinterpret_u32_u16(u46.val[1]));
+                const uint32x2x2_t w37 = vtrn_u32(vreinterpret_u32_u16(u13.val[1]), vreinterpret_u32_u16(u57.val[1]));
+                vst1_u8(block + 0, vreinterpret_u8_u32(w04.val[0]));
+                vst1_u8(block + 8, vreinterpret_u8_u32(w15.val[0]));
+                vst1_u8(block + 16, vreinterpret_u8_u32(w26.val[0]));
+                vst1_u8(block + 24, vreinterpret_u8_u32(w37.val[0]));
+                vst1_u8(block + 32, vreinterpret_u8_u32(w04.val[1]));
+                vst1_u8(block + 40, vreinterpret_u8_u32(w15.val[1]));
+                vst1_u8(block + 48, vreinterpret_u8_u32(w26.val[1]));
+                vst1_u8(block + 56, vreinterpret_u8_u32(w37.val[1]));
+#else
+                for (size_t row = 0; row < 8; row++) {
+                    for (size_t c = 0; c < STRIP_WIDTH; c++) {
+                        block[row * STRIP_WIDTH + c] = columns[c * height + y + row];
+                    }
+                }
+#endif
+                for (size_t row = 0; row < 8; row++) {
+                    storeRow(image.row(y + row) + x, block + row * STRIP_WIDTH, transparent, transparentColor);
+                }
+            }
+
+            for (; y < height; y++) {
+                for (size_t c = 0; c < STRIP_WIDTH; c++) {
+                    block[c] = columns[c * height + y];
+                }
+                storeRow(image.row(y) + x, block, transparent, transparentColor);
+            }
+        }
+
+        void writeBE32(std::vector<uint8_t>& out, uint32_t value) {
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                out.push_back(static_cast<uint8_t>(value >> shift));
+            }
+        }
+
+    } // namespace
+
+    SmapDecoder::CodecInfo SmapDecoder::getCodecInfo(uint8_t id) {
+        return CODEC_TABLE[id];
+    }
+
+    const char* SmapDecoder::getCodecName(Codec codec) {
+        switch (codec) {
+            case Codec::Raw:             return "raw";
+            case Codec::RunLength:       return "RLE";
+            case Codec::BasicVertical:   return "basic V";
+            case Codec::BasicHorizontal: return "basic H";
+            case Codec::Complex:         return "complex";
+            default:                     return "unsupported";
+        }
+    }
+
+    bool SmapDecoder::decodeStrip(std::span<const uint8_t> strip, IndexedImage& image, size_t x, uint8_t transparentColor) {
+        if (strip.size() < 2 || x + STRIP_WIDTH > image.width) {
+            return false;
+        }
+
+        const CodecInfo info = getCodecInfo(strip[0]);
+        const uint8_t* data = strip.data() + 1;
+        const uint8_t* const end = strip.data() + strip.size();
+        const size_t pixels = STRIP_WIDTH * image.height;
+
+        // Per-thread scratch: strips of one room run on several workers at once
+        thread_local std::vector<uint8_t> scratch;
+        scratch.resize(pixels + SCRATCH_SLACK);
+        uint8_t* const out = scratch.data();
+
+        bool ok = false;
+        bool columnMajor = false;
+        switch (info.codec) {
+            case Codec::Raw:
+                ok = static_cast<size_t>(end - data) >= pixels;
+                if (ok) {
+                    std::memcpy(out, data, pixels);
+                }
+                break;
+            case Codec::RunLength:
+                ok = decodeRunLength(data, end, out, pixels);
+                columnMajor = true;
+                break;
+            case Codec::BasicVertical:
+                ok = decodeBasic(data, end, out, pixels, info.shift);
+                columnMajor = true;
+                break;
+            case Codec::BasicHorizontal:
+                ok = decodeBasic(data, end, out, pixels, info.shift);
+                break;
+            case Codec::Complex:
+                ok = decodeComplex(data, end, out, pixels, info.shift);
+                break;
+            default:
+                return false;
+        }
+        if (!ok) {
+            return false;
+        }
+
+        if (columnMajor) {
+            storeColumns(out, image, x, info.transparent, transparentColor);
+        } else {
+            storeRows(out, image, x, info.transparent, transparentColor);
+        }
+        return true;
+    }
+
+    SmapDecoder::Result SmapDecoder::decode(std::span<const uint8_t> smap, IndexedImage& image, bool parallel,
+                                            uint8_t transparentColor) {
+        Result result;
+        const size_t strips = image.width / STRIP_WIDTH;
+        if (image.pixels.size() != static_cast<size_t>(image.width) * image.height) {
+            result.error = "image not sized";
+            return result;
+        }
+        if (smap.size() < Chunk::HEADER_SIZE + strips * 4) {
+            result.error = "truncated strip table";
+            return result;
+        }
+
+        // Strips are not necessarily stored in order, so each one may run to the block end
+        result.codecs.resize(strips);
+        std::atomic<size_t> failed = 0;
+        auto decodeOne = [&](size_t strip) {
+            const uint32_t offset = readLE32(smap.data() + Chunk::HEADER_SIZE + strip * 4);
+            if (offset >= smap.size()) {
+                failed.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            result.codecs[strip] = smap[offset];
+            if (!decodeStrip(smap.subspan(offset), image, strip * STRIP_WIDTH, transparentColor)) {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+
+        if (parallel && strips > 1) {
+            JobSystem::getInstance().parallelFor(strips, decodeOne, JobPriority::Interactive);
+        } else {
+            for (size_t strip = 0; strip < strips; strip++) {
+                decodeOne(strip);
+            }
+        }
+        result.failedStrips = failed.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    SmapDecoder::BenchmarkResult SmapDecoder::benchmark(const std::vector<BenchmarkRoom>& corpus, int iterations) {
+        BenchmarkResult result;
+        result.rooms = corpus.size();
+        if (corpus.empty() || iterations <= 0) {
+            return result;
+        }
+
+        std::vector<IndexedImage> images(corpus.size());
+        size_t pixels = 0;
+        for (size_t i = 0; i < corpus.size(); i++) {
+            images[i].resize(corpus[i].width, corpus[i].height);
+            pixels += images[i].pixels.size();
+            result.strips += corpus[i].width / STRIP_WIDTH;
+        }
+
+        auto measure = [&](bool parallel) {
+            for (size_t i = 0; i < corpus.size(); i++) {
+                decode(corpus[i].smap, images[i], parallel);     // Warm up
+            }
+            const auto start = std::chrono::steady_clock::now();
+            for (int iteration = 0; iteration < iterations; iteration++) {
+                for (size_t i = 0; i < corpus.size(); i++) {
+                    decode(corpus[i].smap, images[i], parallel);
+                }
+            }
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        const double serialSeconds = measure(false);
+        const double parallelSeconds = measure(true);
+        const double runs = static_cast<double>(corpus.size()) * iterations;
+        result.serialMs = serialSeconds * 1000.0 / runs;
+        result.parallelMs = parallelSeconds * 1000.0 / runs;
+        result.megapixelsPerSecond = serialSeconds > 0.0 ? static_cast<double>(pixels) * iterations / serialSeconds / 1e6 : 0.0;
+        return result;
+    }
+
+    std::vector<SmapDecoder::BenchmarkRoom> SmapDecoder::makeSyntheticCorpus(size_t rooms, uint16_t width, uint16_t height) {
+        static constexpr uint8_t CODECS[] = {1, 2, 14, 18, 24, 28, 44, 64, 68, 84, 104, 108, 124};
+
+        std::mt19937 random(1234);
+        const size_t strips = width / STRIP_WIDTH;
+        const size_t pixels = STRIP_WIDTH * height;
+
+        std::vector<BenchmarkRoom> corpus(rooms);
+        for (BenchmarkRoom& room : corpus) {
+            room.width = width;
+            room.height = height;
+
+            std::vector<uint8_t> body(strips * 4);
+            for (size_t strip = 0; strip < strips; strip++) {
+                const uint32_t offset = static_cast<uint32_t>(Chunk::HEADER_SIZE + body.size());
+                for (int i = 0; i < 4; i++) {
+                    body[strip * 4 + i] = static_cast<uint8_t>(offset >> (8 * i));
+                }
+
+                const uint8_t codec = CODECS[random() % std::size(CODECS)];
+                body.push_back(codec);
+                if (codec == 1) {
+                    for (size_t i = 0; i < pixels; i++) {
+                        body.push_back(static_cast<uint8_t>(random()));
+                    }
+                } else if (codec == 2) {
+                    for (size_t covered = 0; covered < pixels; covered += body[body.size() - 2] + 1u) {
+                        body.push_back(static_cast<uint8_t>(random() % 32));
+                        body.push_back(static_cast<uint8_t>(random()));
+                    }
+                } else {
+                    // Sparse one bits: mostly repeats, like real backgrounds
+                    body.push_back(static_cast<uint8_t>(random()));
+                    for (size_t i = 0; i < pixels / 2; i++) {
+                        body.push_back(static_cast<uint8_t>(random() & random()));
+                    }
+                }
+            }
+
+            room.smap.reserve(Chunk::HEADER_SIZE + body.size());
+            const ChunkTag tag = tags::SMAP;
+            const std::string name = tagToString(tag);
+            room.smap.insert(room.smap.end(), name.begin(), name.end());
+            writeBE32(room.smap, static_cast<uint32_t>(Chunk::HEADER_SIZE + body.size()));
+            room.smap.insert(room.smap.end(), body.begin(), body.end());
+        }
+        return corpus;
+    }
+
+} // namespace scummredux
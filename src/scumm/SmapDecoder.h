@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // 8-bit palette indices, row-major
+    struct IndexedImage {
+        uint16_t width = 0;
+        uint16_t height = 0;
+        std::vector<uint8_t> pixels;
+
+        void resize(uint16_t newWidth, uint16_t newHeight, uint8_t fill = 0) {
+            width = newWidth;
+            height = newHeight;
+            pixels.assign(static_cast<size_t>(width) * height, fill);
+        }
+
+        uint8_t* row(size_t y) { return pixels.data() + y * width; }
+        const uint8_t* row(size_t y) const { return pixels.data() + y * width; }
+    };
+
+    // Rows [first, first + count) of an image, e.g. the ones a change touched
+    struct RowRange {
+        uint16_t first = 0;
+        uint16_t count = 0;
+
+        bool empty() const { return count == 0; }
+
+        // Smallest range covering both
+        void merge(const RowRange& other) {
+            if (other.empty()) {
+                return;
+            }
+            if (empty()) {
+                *this = other;
+                return;
+            }
+            const int last = std::max(first + count, other.first + other.count);
+            first = std::min(first, other.first);
+            count = static_cast<uint16_t>(last - first);
+        }
+    };
+
+    // Decoder for SMAP room backgrounds (v5/v6). The block is a table of strip
+    // offsets followed by one independently compressed 8-pixel-wide strip per entry;
+    // the first byte of each strip selects its codec:
+    //     1            uncompressed, row by row
+    //     2            "unkRLE": (count, color) runs, column by column
+    //     14-18/24-28  basic bit stream, vertical/horizontal
+    //     64-68/104-108 major/minor ("complex") bit stream
+    //     +20 (34-48, 84-88, 124-128) the same with a transparent color
+    // The bit streams are read through a 64-bit LSB-first buffer and prefix lookup
+    // tables; runs and vertical strips go through SIMD fills and transposes.
+    class SmapDecoder {
+    public:
+        static constexpr size_t STRIP_WIDTH = 8;
+
+        enum class Codec : uint8_t {
+            Unsupported,
+            Raw,
+            RunLength,
+            BasicVertical,
+            BasicHorizontal,
+            Complex
+        };
+
+        struct CodecInfo {
+            Codec codec = Codec::Unsupported;
+            uint8_t shift = 0;              // Bits per literal color
+            bool transparent = false;
+        };
+
+        struct Result {
+            std::vector<uint8_t> codecs;    // Codec byte of every strip
+            size_t failedStrips = 0;        // Unsupported or truncated; left untouched
+            std::string error;              // Block-level problem, nothing was decoded
+
+            bool ok() const { return error.empty() && failedStrips == 0; }
+        };
+
+        static CodecInfo getCodecInfo(uint8_t id);
+        static const char* getCodecName(Codec codec);
+
+        // Decodes a whole SMAP block (header included) into an image that is already
+        // sized to the room. Strips are decoded on the JobSystem when parallel is set;
+        // callers that are jobs themselves should pass false.
+        static Result decode(std::span<const uint8_t> smap, IndexedImage& image, bool parallel = true,
+                             uint8_t transparentColor = 0);
+
+        // One strip (codec byte first) into columns [x, x + 8) of the image.
+        // Transparent codecs leave the image's pixels where the strip is transparent.
+        static bool decodeStrip(std::span<const uint8_t> strip, IndexedImage& image, size_t x, uint8_t transparentColor = 0);
+
+        // Benchmark over a corpus of SMAP blocks; times are per room
+        struct BenchmarkRoom {
+            std::vector<uint8_t> smap;
+            uint16_t width = 0;
+            uint16_t height = 0;
+        };
+        struct BenchmarkResult {
+            size_t rooms = 0;
+            size_t strips = 0;
+            double serialMs = 0.0;
+            double parallelMs = 0.0;
+            double megapixelsPerSecond = 0.0;   // Serial
+        };
+        static BenchmarkResult benchmark(const std::vector<BenchmarkRoom>& corpus, int iterations);
+
+        // Random strips of every supported codec (random bits are always valid streams)
+        static std::vector<BenchmarkRoom> makeSyntheticCorpus(size_t rooms, uint16_t width = 320, uint16_t height = 200);
+    };
+
+} // namespace scummredux
@@ -0,0 +1,230 @@
+#include "XorCipher.h"
+#include "../utils/Simd.h"
+#include <chrono>
+
+// Keep the baseline honest: the compiler would otherwise vectorize it at -O3
+#if defined(__GNUC__) && !defined(__clang__)
+#define SCUMMREDUX_NO_VECTORIZE __attribute__((optimize("no-tree-vectorize")))
+#else
+#define SCUMMREDUX_NO_VECTORIZE
+#endif
+
+namespace scummredux {
+
+    namespace {
+
+        SCUMMREDUX_NO_VECTORIZE
+        void xorScalar(uint8_t* data, size_t size, uint8_t key) {
+#ifdef __clang__
+#pragma clang loop vectorize(disable) interleave(disable)
+#endif
+            for (size_t i = 0; i < size; i++) {
+                data[i] ^= key;
+            }
+        }
+
+        SCUMMREDUX_NO_VECTORIZE
+        void xorScalarCopy(const uint8_t* source, uint8_t* destination, size_t size, uint8_t key) {
+#ifdef __clang__
+#pragma clang loop vectorize(disable) interleave(disable)
+#endif
+            for (size_t i = 0; i < size; i++) {
+                destination[i] = source[i] ^ key;
+            }
+        }
+
+#ifdef SCUMMREDUX_SIMD_X86
+
+        void xorSSE2Copy(const uint8_t* source, uint8_t* destination, size_t size, uint8_t key) {
+            const __m128i mask = _mm_set1_epi8(static_cast<char>(key));
+            size_t i = 0;
+            for (; i + 64 <= size; i += 64) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 32));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 48));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_xor_si128(a, mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 16), _mm_xor_si128(b, mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 32), _mm_xor_si128(c, mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 48), _mm_xor_si128(d, mask));
+            }
+            for (; i + 16 <= size; i += 16) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_xor_si128(a, mask));
+            }
+            xorScalarCopy(source + i, destination + i, size - i, key);
+        }
+
+        void xorSSE2(uint8_t* data, size_t size, uint8_t key) {
+            xorSSE2Copy(data, data, size, key);
+        }
+
+        SCUMMREDUX_TARGET_AVX2
+        void xorAVX2Copy(const uint8_t* source, uint8_t* destination, size_t size, uint8_t key) {
+            const __m256i mask = _mm256_set1_epi8(static_cast<char>(key));
+            size_t i = 0;
+            for (; i + 128 <= size; i += 128) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 32));
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 64));
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 96));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_xor_si256(a, mask));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 32), _mm256_xor_si256(b, mask));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 64), _mm256_xor_si256(c, mask));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 96), _mm256_xor_si256(d, mask));
+            }
+            for (; i + 32 <= size; i += 32) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_xor_si256(a, mask));
+            }
+            xorScalarCopy(source + i, destination + i, size - i, key);
+        }
+
+        SCUMMREDUX_TARGET_AVX2
+        void xorAVX2(uint8_t* data, size_t size, uint8_t key) {
+            xorAVX2Copy(data, data, size, key);
+        }
+
+#endif
+
+#ifdef SCUMMREDUX_SIMD_NEON
+
+        void xorNEONCopy(const uint8_t* source, uint8_t* destination, size_t size, uint8_t key) {
+            const uint8x16_t mask = vdupq_n_u8(key);
+            size_t i = 0;
+            for (; i + 64 <= size; i += 64) {
+                const uint8x16_t a = vld1q_u8(source + i);
+                const uint8x16_t b = vld1q_u8(source + i + 16);
+                const uint8x16_t c = vld1q_u8(source + i + 32);
+                const uint8x16_t d = vld1q_u8(source + i + 48);
+                vst1q_u8(destination + i, veorq_u8(a, mask));
+                vst1q_u8(destination + i + 16, veorq_u8(b, mask));
+                vst1q_u8(destination + i + 32, veorq_u8(c, mask));
+                vst1q_u8(destination + i + 48, veorq_u8(d, mask));
+            }
+            for (; i + 16 <= size; i += 16) {
+                vst1q_u8(destination + i, veorq_u8(vld1q_u8(source + i), mask));
+            }
+            xorScalarCopy(source + i, destination + i, size - i, key);
+        }
+
+        void xorNEON(uint8_t* data, size_t size, uint8_t key) {
+            xorNEONCopy(data, data, size, key);
+        }
+
+#endif
+
+    } // namespace
+
+    XorCipher::Kernel XorCipher::s_kernel = XorCipher::detectKernel();
+    XorCipher::InPlaceFn XorCipher::s_inPlace = XorCipher::getInPlace(XorCipher::s_kernel);
+    XorCipher::CopyFn XorCipher::s_copy = XorCipher::getCopy(XorCipher::s_kernel);
+
+    XorCipher::Kernel XorCipher::detectKernel() {
+        if (isSupported(Kernel::AVX2)) {
+            return Kernel::AVX2;
+        }
+        if (isSupported(Kernel::SSE2)) {
+            return Kernel::SSE2;
+        }
+        if (isSupported(Kernel::NEON)) {
+            return Kernel::NEON;
+        }
+        return Kernel::Scalar;
+    }
+
+    bool XorCipher::isSupported(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Scalar:
+                return true;
+#ifdef SCUMMREDUX_SIMD_X86
+            case Kernel::SSE2:
+                return true;    // Baseline on x86-64 (and every x86 CPU we'd run on)
+            case Kernel::AVX2:
+                return cpuHasAVX2();
+#endif
+#ifdef SCUMMREDUX_SIMD_NEON
+            case Kernel::NEON:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    XorCipher::InPlaceFn XorCipher::getInPlace(Kernel kernel) {
+        if (!isSupported(kernel)) {
+            return xorScalar;
+        }
+        switch (kernel) {
+#ifdef SCUMMREDUX_SIMD_X86
+            case Kernel::SSE2: return xorSSE2;
+            case Kernel::AVX2: return xorAVX2;
+#endif
+#ifdef SCUMMREDUX_SIMD_NEON
+            case Kernel::NEON: return xorNEON;
+#endif
+            default:           return xorScalar;
+        }
+    }
+
+    XorCipher::CopyFn XorCipher::getCopy(Kernel kernel) {
+        if (!isSupported(kernel)) {
+            return xorScalarCopy;
+        }
+        switch (kernel) {
+#ifdef SCUMMREDUX_SIMD_X86
+            case Kernel::SSE2: return xorSSE2Copy;
+            case Kernel::AVX2: return xorAVX2Copy;
+#endif
+#ifdef SCUMMREDUX_SIMD_NEON
+            case Kernel::NEON: return xorNEONCopy;
+#endif
+            default:           return xorScalarCopy;
+        }
+    }
+
+    const char* XorCipher::getKernelName(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Scalar: return "scalar";
+            case Kernel::SSE2:   return "SSE2";
+            case Kernel::AVX2:   return "AVX2";
+            case Kernel::NEON:   return "NEON";
+            default:             return "unknown";
+        }
+    }
+
+    std::vector<XorCipher::BenchmarkResult> XorCipher::benchmark(size_t bytes, int iterations) {
+        std::vector<uint8_t> source(bytes);
+        std::vector<uint8_t> destination(bytes);
+        for (size_t i = 0; i < bytes; i++) {
+            source[i] = static_cast<uint8_t>(i * 131 + 7);
+        }
+
+        auto measure = [&](auto&& pass) {
+            pass();     // Warm up (page faults, caches)
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++) {
+                pass();
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return seconds > 0.0 ? static_cast<double>(bytes) * iterations / seconds / 1e9 : 0.0;
+        };
+
+        std::vector<BenchmarkResult> results;
+        for (Kernel kernel : {Kernel::Scalar, Kernel::SSE2, Kernel::AVX2, Kernel::NEON}) {
+            if (!isSupported(kernel)) {
+                continue;
+            }
+            const InPlaceFn inPlace = getInPlace(kernel);
+            const CopyFn copy = getCopy(kernel);
+
+            BenchmarkResult result{kernel, 0.0, 0.0};
+            result.inPlaceGBps = measure([&] { inPlace(source.data(), bytes, 0x69); });
+            result.copyGBps = measure([&] { copy(source.data(), destination.data(), bytes, 0x69); });
+            results.push_back(result);
+        }
+        return results;
+    }
+
+} // namespace scummredux
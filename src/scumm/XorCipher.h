@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Single-byte XOR (de)obfuscation used by SCUMM resource files. The widest kernel
+    // the CPU supports (AVX2/SSE2 on x86, NEON on ARM) is picked once at startup;
+    // the scalar loop is the fallback and the benchmark baseline.
+    class XorCipher {
+    public:
+        enum class Kernel : uint8_t {
+            Scalar,
+            SSE2,
+            AVX2,
+            NEON
+        };
+
+        using InPlaceFn = void (*)(uint8_t* data, size_t size, uint8_t key);
+        using CopyFn = void (*)(const uint8_t* source, uint8_t* destination, size_t size, uint8_t key);
+
+        static void apply(uint8_t* data, size_t size, uint8_t key) { s_inPlace(data, size, key); }
+        static void apply(const uint8_t* source, uint8_t* destination, size_t size, uint8_t key) {
+            s_copy(source, destination, size, key);
+        }
+
+        // Streaming: resolve the kernel once, then call it per page/block
+        static InPlaceFn getInPlace(Kernel kernel);
+        static CopyFn getCopy(Kernel kernel);
+
+        static Kernel getKernel() { return s_kernel; }
+        static bool isSupported(Kernel kernel);
+        static const char* getKernelName(Kernel kernel);
+
+        // Throughput of every supported kernel over a buffer of the given size
+        struct BenchmarkResult {
+            Kernel kernel;
+            double inPlaceGBps;
+            double copyGBps;
+        };
+        static std::vector<BenchmarkResult> benchmark(size_t bytes, int iterations);
+
+    private:
+        static Kernel detectKernel();
+
+        static Kernel s_kernel;
+        static InPlaceFn s_inPlace;
+        static CopyFn s_copy;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,99 @@
+#include "ZPlane.h"
+#include <algorithm>
+
+namespace scummredux {
+
+    namespace {
+        constexpr size_t HEADER_SIZE = 8;
+
+        // "ZP01" -> 1; the number is hexadecimal like the IMnn one
+        int getPlaneNumber(ChunkTag tag) {
+            if ((tag >> 16) != (makeTag("ZP00") >> 16)) {
+                return -1;
+            }
+            auto digit = [](char c) {
+                return c >= '0' && c <= '9' ? c - '0' : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+            };
+            const int high = digit(static_cast<char>((tag >> 8) & 0xFF));
+            const int low = digit(static_cast<char>(tag & 0xFF));
+            return high < 0 || low < 0 ? -1 : high * 16 + low;
+        }
+
+        bool decodeStrip(std::span<const uint8_t> data, size_t offset, BitMask& mask, size_t strip) {
+            uint8_t* destination = mask.bits.data() + strip;
+            const size_t stride = mask.stride();
+            size_t rows = mask.height;
+            while (rows > 0) {
+                if (offset >= data.size()) {
+                    return false;
+                }
+                const uint8_t code = data[offset++];
+                // Like the engine's do/while on a byte counter, 0 stands for 256
+                size_t count = std::min<size_t>((code & 0x7F) ? (code & 0x7F) : 256, rows);
+                rows -= count;
+                if (code & 0x80) {
+                    if (offset >= data.size()) {
+                        return false;
+                    }
+                    const uint8_t value = data[offset++];
+                    for (; count > 0; count--, destination += stride) {
+                        *destination = value;
+                    }
+                } else {
+                    if (offset + count > data.size()) {
+                        return false;
+                    }
+                    for (; count > 0; count--, destination += stride) {
+                        *destination = data[offset++];
+                    }
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    bool ZPlaneDecoder::decode(std::span<const uint8_t> zplane, BitMask& mask) {
+        const size_t strips = mask.stride();
+        if (zplane.size() < HEADER_SIZE + strips * 2) {
+            return false;
+        }
+
+        bool ok = true;
+        for (size_t strip = 0; strip < strips; strip++) {
+            const uint8_t* entry = zplane.data() + HEADER_SIZE + strip * 2;
+            const size_t offset = entry[0] | (entry[1] << 8);
+            if (offset != 0) {
+                ok &= decodeStrip(zplane, offset, mask, strip);
+            }
+        }
+        return ok;
+    }
+
+    std::vector<BitMask> ZPlaneDecoder::loadAll(ResourceFile& file, const Chunk& image, uint16_t width, uint16_t height) {
+        std::vector<BitMask> planes;
+        file.forEachChild(image, [&](const Chunk& chunk) {
+            const int number = getPlaneNumber(chunk.tag);
+            if (number < 1) {
+                return;
+            }
+            if (planes.size() < static_cast<size_t>(number)) {
+                planes.resize(number);
+            }
+
+            BitMask& plane = planes[number - 1];
+            plane.resize(width, height);
+            if (!decode(file.view(chunk.offset, chunk.size), plane)) {
+                plane.resize(width, height);
+            }
+        });
+
+        // Gaps in the numbering stay as empty planes
+        for (BitMask& plane : planes) {
+            if (plane.bits.empty()) {
+                plane.resize(width, height);
+            }
+        }
+        return planes;
+    }
+
+} // namespace scummredux
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ResourceFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace scummredux {
+
+    // One bit per pixel, most significant bit first: the layout of SCUMM z-planes,
+    // so mask bytes decode straight into place and 8 pixels are handled at once
+    struct BitMask {
+        uint16_t width = 0;
+        uint16_t height = 0;
+        std::vector<uint8_t> bits;
+
+        size_t stride() const { return (static_cast<size_t>(width) + 7) / 8; }
+
+        void resize(uint16_t newWidth, uint16_t newHeight, bool set = false) {
+            width = newWidth;
+            height = newHeight;
+            bits.assign(stride() * height, set ? 0xFF : 0x00);
+        }
+
+        uint8_t* row(size_t y) { return bits.data() + y * stride(); }
+        const uint8_t* row(size_t y) const { return bits.data() + y * stride(); }
+        bool test(size_t x, size_t y) const { return (row(y)[x >> 3] & (0x80 >> (x & 7))) != 0; }
+    };
+
+    // Decoder for ZPnn blocks, the masks that put actors behind parts of a room or
+    // object image. The block holds a little-endian offset per 8-pixel strip (0 for
+    // an empty strip), each pointing at a column of RLE mask bytes:
+    //     0x80 | n, byte   the byte n times
+    //     n, bytes...      n literal bytes
+    class ZPlaneDecoder {
+    public:
+        // Whole block (header included) into a mask already sized to the image
+        static bool decode(std::span<const uint8_t> zplane, BitMask& mask);
+
+        // ZP01..ZPnn of an image block (RMIM's IM00 or an object's IMnn); missing
+        // or broken planes are left empty
+        static std::vector<BitMask> loadAll(ResourceFile& file, const Chunk& image, uint16_t width, uint16_t height);
+    };
+
+} // namespace scummredux
@@ -0,0 +1,497 @@
+#include "FontManager.h"
+#include "../res/icons/MaterialSymbols.h"
+#include "../views/ConsoleView.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// Generated by CMake from the ICON_MS_* names used in src/ (nullptr terminated)
+#if __has_include("UsedIcons.h")
+#include "UsedIcons.h"
+#else
+static constexpr const char* USED_ICON_GLYPHS[] = { nullptr };
+#endif
+
+namespace scummredux {
+
+    namespace {
+        // Basic Latin, Latin-1 Supplement, Latin Extended-A and General Punctuation
+        constexpr ImWchar TEXT_RANGES[] = {
+            0x0020, 0x017F,
+            0x2000, 0x206F,
+            0
+        };
+
+        const char* decodeUtf8(const char* text, uint32_t& codepoint) {
+            const auto c = static_cast<unsigned char>(*text);
+            int length = 1;
+            if (c < 0x80) {
+                codepoint = c;
+            } else if ((c & 0xE0) == 0xC0) {
+                codepoint = c & 0x1F;
+                length = 2;
+            } else if ((c & 0xF0) == 0xE0) {
+                codepoint = c & 0x0F;
+                length = 3;
+            } else if ((c & 0xF8) == 0xF0) {
+                codepoint = c & 0x07;
+                length = 4;
+            } else {
+                codepoint = 0xFFFD;
+                return text + 1;
+            }
+
+            for (int i = 1; i < length; i++) {
+                const auto next = static_cast<unsigned char>(text[i]);
+                if ((next & 0xC0) != 0x80) {
+                    codepoint = 0xFFFD;
+                    return text + i;
+                }
+                codepoint = (codepoint << 6) | (next & 0x3F);
+            }
+            return text + length;
+        }
+
+        bool isIconCodepoint(uint32_t codepoint) {
+            return codepoint >= ICON_MIN_MS && codepoint <= ICON_MAX_MS;
+        }
+
+        bool inTextRanges(uint32_t codepoint) {
+            for (const ImWchar* range = TEXT_RANGES; range[0]; range += 2) {
+                if (codepoint >= range[0] && codepoint <= range[1]) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void insertSorted(std::vector<ImWchar>& set, ImWchar codepoint) {
+            auto it = std::lower_bound(set.begin(), set.end(), codepoint);
+            if (it == set.end() || *it != codepoint) {
+                set.insert(it, codepoint);
+            }
+        }
+
+        // FNV-1a, only used to detect stale caches
+        void hashBytes(uint64_t& hash, const void* data, size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+            }
+        }
+
+        template<typename T>
+        void hashValue(uint64_t& hash, const T& value) {
+            hashBytes(hash, &value, sizeof(T));
+        }
+
+        void hashFile(uint64_t& hash, const std::string& path) {
+            hashBytes(hash, path.data(), path.size());
+
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(path, ec);
+            hashValue(hash, ec ? uint64_t(0) : uint64_t(size));
+            const auto time = std::filesystem::last_write_time(path, ec);
+            hashValue(hash, ec ? int64_t(0) : int64_t(time.time_since_epoch().count()));
+        }
+
+        struct CachedGlyph {
+            uint32_t codepoint;
+            uint32_t flags; // bit 0: visible, bit 1: colored
+            float advanceX;
+            float x0, y0, x1, y1;
+            float u0, v0, u1, v1;
+        };
+
+        struct CachedFont {
+            std::string name;
+            float fontSize = 0.0f;
+            float ascent = 0.0f;
+            float descent = 0.0f;
+            std::vector<CachedGlyph> glyphs;
+        };
+
+        template<typename T>
+        void writeValue(std::ofstream& file, const T& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        bool readValue(std::ifstream& file, T& value) {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+    }
+
+    FontManager& FontManager::getInstance() {
+        static FontManager instance;
+        return instance;
+    }
+
+    FontManager::FontManager() {
+        addFont("GeistRegular", std::string(FONT_DIRECTORY) + "Geist-Regular.ttf");
+        addFont("GeistLight", std::string(FONT_DIRECTORY) + "Geist-Light.ttf");
+        addFont("GeistMedium", std::string(FONT_DIRECTORY) + "Geist-Medium.ttf");
+        addFont("GeistSemiBold", std::string(FONT_DIRECTORY) + "Geist-SemiBold.ttf");
+        addFont("GeistBold", std::string(FONT_DIRECTORY) + "Geist-Bold.ttf");
+
+        m_iconFontPath = std::string(FONT_DIRECTORY) + FONT_ICON_FILE_NAME_MSR;
+
+        // Icons referenced in the sources
+        for (const char* const* icon = USED_ICON_GLYPHS; *icon; icon++) {
+            uint32_t codepoint = 0;
+            decodeUtf8(*icon, codepoint);
+            if (isIconCodepoint(codepoint)) {
+                insertSorted(m_iconCodepoints, static_cast<ImWchar>(codepoint));
+            }
+        }
+    }
+
+    void FontManager::addFont(const std::string& name, const std::string& path, float size) {
+        for (auto& spec : m_specs) {
+            if (spec.name == name) {
+                spec.path = path;
+                spec.size = size;
+                m_dirty = true;
+                return;
+            }
+        }
+
+        m_specs.push_back({name, path, size});
+        m_dirty = true;
+    }
+
+    void FontManager::setFontSize(float size) {
+        if (size != m_fontSize) {
+            m_fontSize = size;
+            m_dirty = true;
+        }
+    }
+
+    void FontManager::setScale(float scale) {
+        if (scale != m_scale) {
+            m_scale = scale;
+            m_dirty = true;
+        }
+    }
+
+    void FontManager::build() {
+        m_iconFontAvailable = std::filesystem::exists(m_iconFontPath);
+        rebuildRanges();
+
+        const uint64_t key = computeCacheKey();
+        m_loadedFromCache = loadCache(key);
+        if (!m_loadedFromCache) {
+            buildFromFiles();
+            saveCache(key);
+        }
+
+        ImGui::GetIO().FontDefault = m_loaded.empty() ? nullptr : m_loaded.front().font;
+        m_dirty = false;
+    }
+
+    bool FontManager::rebuildIfNeeded() {
+        if (!m_dirty) {
+            return false;
+        }
+
+        for (ImWchar codepoint : m_pendingCodepoints) {
+            insertSorted(isIconCodepoint(codepoint) ? m_iconCodepoints : m_extraCodepoints, codepoint);
+        }
+        m_pendingCodepoints.clear();
+
+        build();
+        return true;
+    }
+
+    void FontManager::requestGlyphs(const char* text) {
+        while (text && *text) {
+            uint32_t codepoint = 0;
+            text = decodeUtf8(text, codepoint);
+
+            if (codepoint > IM_UNICODE_CODEPOINT_MAX || hasGlyph(static_cast<ImWchar>(codepoint))) {
+                continue;
+            }
+            if (isIconCodepoint(codepoint) && !m_iconFontAvailable) {
+                continue;
+            }
+
+            insertSorted(m_pendingCodepoints, static_cast<ImWchar>(codepoint));
+            m_dirty = true;
+        }
+    }
+
+    bool FontManager::hasGlyph(ImWchar codepoint) const {
+        if (isIconCodepoint(codepoint)) {
+            return std::binary_search(m_iconCodepoints.begin(), m_iconCodepoints.end(), codepoint);
+        }
+        return inTextRanges(codepoint) ||
+               std::binary_search(m_extraCodepoints.begin(), m_extraCodepoints.end(), codepoint);
+    }
+
+    ImFont* FontManager::getFont(const std::string& name) const {
+        for (const auto& loaded : m_loaded) {
+            if (loaded.name == name) {
+                return loaded.font;
+            }
+        }
+        return m_loaded.empty() ? nullptr : m_loaded.front().font;
+    }
+
+    void FontManager::rebuildRanges() {
+        ImFontGlyphRangesBuilder textBuilder;
+        textBuilder.AddRanges(TEXT_RANGES);
+        for (ImWchar codepoint : m_extraCodepoints) {
+            textBuilder.AddChar(codepoint);
+        }
+        m_textRanges.clear();
+        textBuilder.BuildRanges(&m_textRanges);
+
+        ImFontGlyphRangesBuilder iconBuilder;
+        for (ImWchar codepoint : m_iconCodepoints) {
+            iconBuilder.AddChar(codepoint);
+        }
+        m_iconRanges.clear();
+        iconBuilder.BuildRanges(&m_iconRanges);
+    }
+
+    void FontManager::buildFromFiles() {
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        atlas->Clear();
+        m_loaded.clear();
+
+        ImFontConfig textConfig;
+        textConfig.OversampleH = 2;
+        textConfig.OversampleV = 1;
+        textConfig.PixelSnapH = true;
+
+        const float fontSize = m_fontSize * m_scale;
+        const float iconSize = fontSize * 1.15f;
+        ImFontConfig iconConfig;
+        iconConfig.MergeMode = true;
+        iconConfig.PixelSnapH = true;
+        iconConfig.GlyphMinAdvanceX = iconSize;
+        iconConfig.GlyphOffset = ImVec2(0.0f, fontSize * 0.2f);
+
+        auto mergeIcons = [&]() {
+            if (m_iconFontAvailable && m_iconRanges.Size > 1) {
+                atlas->AddFontFromFileTTF(m_iconFontPath.c_str(), iconSize, &iconConfig, m_iconRanges.Data);
+            }
+        };
+
+        for (const auto& spec : m_specs) {
+            if (!std::filesystem::exists(spec.path)) {
+                ConsoleView::warning("Font not found: " + spec.path);
+                continue;
+            }
+
+            const float size = (spec.size > 0.0f ? spec.size : m_fontSize) * m_scale;
+            ImFont* font = atlas->AddFontFromFileTTF(spec.path.c_str(), size, &textConfig, m_textRanges.Data);
+            if (!font) {
+                ConsoleView::error("Failed to load font: " + spec.path);
+                continue;
+            }
+            mergeIcons();
+            m_loaded.push_back({spec.name, font});
+        }
+
+        // Fall back to ImGui's embedded font so the UI still renders
+        if (m_loaded.empty()) {
+            textConfig.SizePixels = fontSize;
+            textConfig.GlyphRanges = m_textRanges.Data;
+            ImFont* font = atlas->AddFontDefault(&textConfig);
+            mergeIcons();
+            m_loaded.push_back({m_specs.empty() ? "Default" : m_specs.front().name, font});
+        }
+
+        if (!m_iconFontAvailable) {
+            ConsoleView::warning("Icon font not found: " + m_iconFontPath);
+        }
+
+        atlas->Build();
+    }
+
+    uint64_t FontManager::computeCacheKey() const {
+        uint64_t hash = 0xCBF29CE484222325ull;
+
+        hashValue(hash, CACHE_VERSION);
+        hashValue(hash, static_cast<uint32_t>(IMGUI_VERSION_NUM));
+        hashValue(hash, m_fontSize);
+        hashValue(hash, m_scale);
+
+        for (const auto& spec : m_specs) {
+            hashBytes(hash, spec.name.data(), spec.name.size());
+            hashValue(hash, spec.size);
+            hashFile(hash, spec.path);
+        }
+
+        hashFile(hash, m_iconFontPath);
+        hashBytes(hash, m_textRanges.Data, m_textRanges.Size * sizeof(ImWchar));
+        hashBytes(hash, m_iconRanges.Data, m_iconRanges.Size * sizeof(ImWchar));
+
+        return hash;
+    }
+
+    bool FontManager::loadCache(uint64_t key) {
+        std::ifstream file(CACHE_PATH, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        char magic[4] = {};
+        uint32_t version = 0;
+        uint64_t storedKey = 0;
+        file.read(magic, sizeof(magic));
+        if (!readValue(file, version) || !readValue(file, storedKey) ||
+            std::memcmp(magic, "SRFA", 4) != 0 || version != CACHE_VERSION || storedKey != key) {
+            return false;
+        }
+
+        // Read everything first so a truncated cache leaves the atlas untouched
+        int32_t width = 0, height = 0;
+        ImVec2 whitePixel;
+        ImVec4 uvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+        uint32_t fontCount = 0;
+        if (!readValue(file, width) || !readValue(file, height) || !readValue(file, whitePixel) ||
+            !readValue(file, uvLines) || !readValue(file, fontCount) ||
+            width <= 0 || height <= 0 || fontCount == 0 || fontCount > 64) {
+            return false;
+        }
+
+        std::vector<CachedFont> fonts(fontCount);
+        for (auto& font : fonts) {
+            uint32_t nameLength = 0, glyphCount = 0;
+            if (!readValue(file, nameLength) || nameLength > 256) {
+                return false;
+            }
+            font.name.resize(nameLength);
+            file.read(font.name.data(), nameLength);
+
+            if (!readValue(file, font.fontSize) || !readValue(file, font.ascent) ||
+                !readValue(file, font.descent) || !readValue(file, glyphCount) || glyphCount > 0x10000) {
+                return false;
+            }
+            font.glyphs.resize(glyphCount);
+            if (!file.read(reinterpret_cast<char*>(font.glyphs.data()), glyphCount * sizeof(CachedGlyph))) {
+                return false;
+            }
+        }
+
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        auto* pixels = static_cast<unsigned char*>(IM_ALLOC(pixelCount));
+        if (!file.read(reinterpret_cast<char*>(pixels), pixelCount)) {
+            IM_FREE(pixels);
+            return false;
+        }
+
+        // Restore the atlas exactly as ImFontAtlas::Build() left it
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        atlas->Clear();
+        m_loaded.clear();
+
+        atlas->TexPixelsAlpha8 = pixels;
+        atlas->TexWidth = width;
+        atlas->TexHeight = height;
+        atlas->TexUvScale = ImVec2(1.0f / width, 1.0f / height);
+        atlas->TexUvWhitePixel = whitePixel;
+        std::memcpy(atlas->TexUvLines, uvLines, sizeof(uvLines));
+
+        m_cachedConfigs.assign(fonts.size(), ImFontConfig());
+        for (size_t i = 0; i < fonts.size(); i++) {
+            const auto& cached = fonts[i];
+
+            ImFontConfig& config = m_cachedConfigs[i];
+            config.SizePixels = cached.fontSize;
+            config.FontDataOwnedByAtlas = false;
+            std::snprintf(config.Name, sizeof(config.Name), "%s", cached.name.c_str());
+
+            ImFont* font = IM_NEW(ImFont)();
+            font->FontSize = cached.fontSize;
+            font->Ascent = cached.ascent;
+            font->Descent = cached.descent;
+            font->ContainerAtlas = atlas;
+            font->ConfigData = &config;
+            font->ConfigDataCount = 1;
+
+            font->Glyphs.resize(static_cast<int>(cached.glyphs.size()));
+            for (size_t g = 0; g < cached.glyphs.size(); g++) {
+                const CachedGlyph& src = cached.glyphs[g];
+                ImFontGlyph& dst = font->Glyphs[static_cast<int>(g)];
+                dst.Codepoint = src.codepoint;
+                dst.Visible = src.flags & 1;
+                dst.Colored = (src.flags >> 1) & 1;
+                dst.AdvanceX = src.advanceX;
+                dst.X0 = src.x0; dst.Y0 = src.y0; dst.X1 = src.x1; dst.Y1 = src.y1;
+                dst.U0 = src.u0; dst.V0 = src.v0; dst.U1 = src.u1; dst.V1 = src.v1;
+            }
+            font->BuildLookupTable();
+
+            atlas->Fonts.push_back(font);
+            m_loaded.push_back({cached.name, font});
+        }
+
+        atlas->TexReady = true;
+        return true;
+    }
+
+    void FontManager::saveCache(uint64_t key) const {
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+        if (!pixels || m_loaded.empty()) {
+            return;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(CACHE_PATH).parent_path(), ec);
+
+        // Write to a temporary file so an interrupted save never leaves a corrupt cache
+        const std::string tempPath = std::string(CACHE_PATH) + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return;
+            }
+
+            file.write("SRFA", 4);
+            writeValue(file, CACHE_VERSION);
+            writeValue(file, key);
+            writeValue(file, static_cast<int32_t>(width));
+            writeValue(file, static_cast<int32_t>(height));
+            writeValue(file, atlas->TexUvWhitePixel);
+            writeValue(file, atlas->TexUvLines);
+            writeValue(file, static_cast<uint32_t>(m_loaded.size()));
+
+            std::vector<CachedGlyph> glyphs;
+            for (const auto& loaded : m_loaded) {
+                const ImFont* font = loaded.font;
+
+                writeValue(file, static_cast<uint32_t>(loaded.name.size()));
+                file.write(loaded.name.data(), loaded.name.size());
+                writeValue(file, font->FontSize);
+                writeValue(file, font->Ascent);
+                writeValue(file, font->Descent);
+
+                glyphs.clear();
+                for (const ImFontGlyph& glyph : font->Glyphs) {
+                    glyphs.push_back({glyph.Codepoint, static_cast<uint32_t>(glyph.Visible | (glyph.Colored << 1)), glyph.AdvanceX,
+                                      glyph.X0, glyph.Y0, glyph.X1, glyph.Y1,
+                                      glyph.U0, glyph.V0, glyph.U1, glyph.V1});
+                }
+                writeValue(file, static_cast<uint32_t>(glyphs.size()));
+                file.write(reinterpret_cast<const char*>(glyphs.data()), glyphs.size() * sizeof(CachedGlyph));
+            }
+
+            file.write(reinterpret_cast<const char*>(pixels), static_cast<size_t>(width) * height);
+            if (!file.good()) {
+                return;
+            }
+        }
+
+        std::filesystem::rename(tempPath, CACHE_PATH, ec);
+    }
+
+} // namespace scummredux
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <imgui.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Owns the font atlas: Geist weights from res/fonts with only the Material Symbols
+    // glyphs the sources reference (collected by CMake into UsedIcons.h) merged in.
+    // Glyphs needed at runtime are queued and added between frames, and the built atlas
+    // is cached to disk so a normal startup skips rasterization.
+    class FontManager {
+    public:
+        static FontManager& getInstance();
+
+        // Font registration (every font gets the icon glyphs merged in, size 0 = UI font size)
+        void addFont(const std::string& name, const std::string& path, float size = 0.0f);
+        void setFontSize(float size);
+        float getFontSize() const { return m_fontSize; }
+
+        // Fonts are rasterized at size * scale pixels
+        void setScale(float scale);
+        float getScale() const { return m_scale; }
+
+        // Builds the atlas, restoring it from the disk cache when it is still valid
+        void build();
+
+        // Rebuilds the atlas if glyphs were requested or fonts changed since the last build.
+        // Must be called between frames; returns true when the renderer has to re-upload it.
+        bool rebuildIfNeeded();
+
+        // Queues any codepoint of the UTF-8 text that is not in the atlas yet
+        void requestGlyphs(const char* text);
+        bool hasGlyph(ImWchar codepoint) const;
+
+        ImFont* getFont(const std::string& name) const;
+
+        // Statistics
+        size_t getIconGlyphCount() const { return m_iconCodepoints.size(); }
+        bool isIconFontAvailable() const { return m_iconFontAvailable; }
+        bool wasLoadedFromCache() const { return m_loadedFromCache; }
+
+    private:
+        FontManager();
+
+        struct FontSpec {
+            std::string name;
+            std::string path;
+            float size = 0.0f;
+        };
+
+        struct LoadedFont {
+            std::string name;
+            ImFont* font = nullptr;
+        };
+
+        void rebuildRanges();
+        void buildFromFiles();
+        uint64_t computeCacheKey() const;
+        bool loadCache(uint64_t key);
+        void saveCache(uint64_t key) const;
+
+        std::vector<FontSpec> m_specs;
+        std::vector<LoadedFont> m_loaded;
+        float m_fontSize = 14.0f;
+        float m_scale = 1.0f;
+
+        // Glyph sets (sorted, unique) and the ImGui ranges built from them
+        std::vector<ImWchar> m_iconCodepoints;
+        std::vector<ImWchar> m_extraCodepoints;
+        std::vector<ImWchar> m_pendingCodepoints;
+        ImVector<ImWchar> m_textRanges;
+        ImVector<ImWchar> m_iconRanges;
+
+        std::string m_iconFontPath;
+        bool m_iconFontAvailable = false;
+        bool m_dirty = false;
+        bool m_loadedFromCache = false;
+
+        // Font configs referenced by fonts restored from the cache
+        std::vector<ImFontConfig> m_cachedConfigs;
+
+        static constexpr const char* FONT_DIRECTORY = "res/fonts/";
+        static constexpr const char* CACHE_PATH = "cache/fonts.atlas";
+        static constexpr uint32_t CACHE_VERSION = 1;
+    };
+
+} // namespace scummredux
@@ -0,0 +1,62 @@
+#include "ScaleManager.h"
+#include "FontManager.h"
+#include "StyleManager.h"
+#include "ThemeRegistry.h"
+#include "../utils/Events.hpp"
+#include "../views/ConsoleView.h"
+#include <algorithm>
+#include <cmath>
+
+namespace scummredux {
+
+    ScaleManager& ScaleManager::getInstance() {
+        static ScaleManager instance;
+        return instance;
+    }
+
+    void ScaleManager::initialize(float contentScale) {
+        s_factor = sanitize(contentScale);
+        m_pendingScale = s_factor;
+
+        FontManager::getInstance().setScale(s_factor);
+        ThemeRegistry::getInstance().setScale(s_factor);
+
+        if (!m_subscribed) {
+            // Only record the new scale here; the rebuild happens between frames
+            EventContentScaleChanged::subscribe([this](const ContentScaleChangedEvent& event) {
+                m_pendingScale = sanitize(std::max(event.xScale, event.yScale));
+            });
+            m_subscribed = true;
+        }
+    }
+
+    bool ScaleManager::update() {
+        if (m_pendingScale == s_factor) {
+            return false;
+        }
+
+        s_factor = m_pendingScale;
+
+        // Fonts are re-rasterized at the new pixel size by FontManager::rebuildIfNeeded()
+        FontManager::getInstance().setScale(s_factor);
+        ThemeRegistry::getInstance().setScale(s_factor);
+        StyleManager::getInstance().applyCurrentTheme();
+
+        ConsoleView::info("UI scale changed to " + std::to_string(static_cast<int>(s_factor * 100.0f)) + "%");
+        return true;
+    }
+
+    float ScaleManager::sanitize(float scale) {
+#ifdef __APPLE__
+        // macOS reports Retina as content scale, which ImGui handles through the framebuffer scale
+        return 1.0f;
+#else
+        // Snap to 1/8 steps so tiny reported differences never trigger a rebuild
+        if (!std::isfinite(scale) || scale <= 0.0f) {
+            return 1.0f;
+        }
+        return std::clamp(std::round(scale * 8.0f) / 8.0f, 0.5f, 4.0f);
+#endif
+    }
+
+} // namespace scummredux
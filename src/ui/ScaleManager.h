@@ -0,0 +1,32 @@
+#pragma once
+
+namespace scummredux {
+
+    // Global UI scale derived from the window content scale (monitor DPI).
+    // Scale changes are only recorded when they arrive and applied between frames,
+    // so fonts and style are rebuilt once per real change, never per resize event.
+    class ScaleManager {
+    public:
+        static ScaleManager& getInstance();
+
+        // Sets the initial scale before fonts and style are first built
+        void initialize(float contentScale);
+
+        // Applies a pending scale change; returns true if the UI was rescaled
+        bool update();
+
+        // Cached global factor used by operator""_scaled
+        static float getFactor() { return s_factor; }
+
+    private:
+        ScaleManager() = default;
+
+        static float sanitize(float scale);
+
+        float m_pendingScale = 1.0f;
+        bool m_subscribed = false;
+
+        static inline float s_factor = 1.0f;
+    };
+
+} // namespace scummredux
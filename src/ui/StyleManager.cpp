@@ -1,7 +1,8 @@
 #include "StyleManager.h"
+#include "FontManager.h"
 #include "../core/Settings.h"
 #include "../utils/Events.hpp"
-#include <iostream>
+#include "../views/ConsoleView.h"
 
 namespace scummredux {
 
@@ -10,235 +11,114 @@ namespace scummredux {
         return instance;
     }
 
-    void StyleManager::setTheme(const std::string& themeName) {
-        m_currentTheme = themeName;
+    void StyleManager::setTheme(ThemeId theme) {
+        loadThemes();
+
+        auto& registry = ThemeRegistry::getInstance();
+        if (theme >= registry.getThemeCount()) {
+            ConsoleView::warning("Unknown theme id: " + std::to_string(theme));
+            return;
+        }
+        if (theme == m_currentTheme) {
+            return;
+        }
+
+        m_currentTheme = theme;
         applyCurrentTheme();
 
-        // Save to settings
+        // Settings store the name: ids depend on the theme files present
+        const std::string& name = registry.getName(theme);
         auto& settings = Settings::getInstance();
-        settings.set(Settings::UI::DARK_THEME, themeName == "Dark");
+        settings.set(Settings::UI::THEME, name);
+        settings.set(Settings::UI::DARK_THEME, name == "Dark");
 
-        EventThemeChanged::post({themeName});
+        EventThemeChanged::post({theme});
     }
 
     void StyleManager::applyCurrentTheme() {
-        if (m_currentTheme == "Dark") {
-            setupDarkTheme();
-        } else if (m_currentTheme == "Light") {
-            setupLightTheme();
-        } else if (m_currentTheme == "ImHex") {
-            setupImHexTheme();
-        } else {
-            setupDarkTheme(); // Default fallback
-        }
+        loadThemes();
 
-        applyCustomizations();
+        // Compiled snapshot: one struct copy
+        ImGui::GetStyle() = ThemeRegistry::getInstance().getStyle(m_currentTheme);
     }
 
-    void StyleManager::setupDarkTheme() {
-        ImGui::StyleColorsDark();
-        ImGuiStyle& style = ImGui::GetStyle();
-
-        // Enhanced dark theme colors
-        auto& colors = style.Colors;
-        colors[ImGuiCol_WindowBg] = ImVec4(0.13f, 0.13f, 0.16f, 1.00f);
-        colors[ImGuiCol_ChildBg] = ImVec4(0.11f, 0.11f, 0.14f, 1.00f);
-        colors[ImGuiCol_PopupBg] = ImVec4(0.15f, 0.15f, 0.18f, 1.00f);
-        colors[ImGuiCol_Border] = ImVec4(0.25f, 0.25f, 0.28f, 1.00f);
-        colors[ImGuiCol_FrameBg] = ImVec4(0.18f, 0.18f, 0.21f, 1.00f);
-        colors[ImGuiCol_FrameBgHovered] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_FrameBgActive] = ImVec4(0.27f, 0.27f, 0.30f, 1.00f);
-        colors[ImGuiCol_TitleBg] = ImVec4(0.08f, 0.08f, 0.09f, 1.00f);
-        colors[ImGuiCol_TitleBgActive] = ImVec4(0.08f, 0.08f, 0.09f, 1.00f);
-        colors[ImGuiCol_TitleBgCollapsed] = ImVec4(0.08f, 0.08f, 0.09f, 1.00f);
-        colors[ImGuiCol_MenuBarBg] = ImVec4(0.08f, 0.08f, 0.09f, 1.00f);
-        colors[ImGuiCol_ScrollbarBg] = ImVec4(0.02f, 0.02f, 0.02f, 0.53f);
-        colors[ImGuiCol_ScrollbarGrab] = ImVec4(0.31f, 0.31f, 0.31f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrabHovered] = ImVec4(0.41f, 0.41f, 0.41f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrabActive] = ImVec4(0.51f, 0.51f, 0.51f, 1.00f);
-        colors[ImGuiCol_CheckMark] = ImVec4(0.86f, 0.93f, 0.89f, 1.00f);
-        colors[ImGuiCol_SliderGrab] = ImVec4(0.54f, 0.54f, 0.54f, 1.00f);
-        colors[ImGuiCol_SliderGrabActive] = ImVec4(0.67f, 0.67f, 0.67f, 1.00f);
-        colors[ImGuiCol_Button] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_ButtonHovered] = ImVec4(0.30f, 0.30f, 0.33f, 1.00f);
-        colors[ImGuiCol_ButtonActive] = ImVec4(0.27f, 0.27f, 0.30f, 1.00f);
-        colors[ImGuiCol_Header] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_HeaderHovered] = ImVec4(0.30f, 0.30f, 0.33f, 1.00f);
-        colors[ImGuiCol_HeaderActive] = ImVec4(0.27f, 0.27f, 0.30f, 1.00f);
-        colors[ImGuiCol_Separator] = ImVec4(0.25f, 0.25f, 0.28f, 1.00f);
-        colors[ImGuiCol_SeparatorHovered] = ImVec4(0.41f, 0.42f, 0.44f, 1.00f);
-        colors[ImGuiCol_SeparatorActive] = ImVec4(0.50f, 0.51f, 0.53f, 1.00f);
-        colors[ImGuiCol_ResizeGrip] = ImVec4(0.26f, 0.59f, 0.98f, 0.20f);
-        colors[ImGuiCol_ResizeGripHovered] = ImVec4(0.26f, 0.59f, 0.98f, 0.67f);
-        colors[ImGuiCol_ResizeGripActive] = ImVec4(0.26f, 0.59f, 0.98f, 0.95f);
-        colors[ImGuiCol_Tab] = ImVec4(0.12f, 0.12f, 0.15f, 1.00f);
-        colors[ImGuiCol_TabHovered] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_TabActive] = ImVec4(0.18f, 0.18f, 0.21f, 1.00f);
-        colors[ImGuiCol_TabUnfocused] = ImVec4(0.12f, 0.12f, 0.15f, 1.00f);
-        colors[ImGuiCol_TabUnfocusedActive] = ImVec4(0.16f, 0.16f, 0.19f, 1.00f);
-        colors[ImGuiCol_DockingPreview] = ImVec4(0.26f, 0.59f, 0.98f, 0.70f);
-        colors[ImGuiCol_DockingEmptyBg] = ImVec4(0.20f, 0.20f, 0.20f, 1.00f);
-        colors[ImGuiCol_PlotLines] = ImVec4(0.61f, 0.61f, 0.61f, 1.00f);
-        colors[ImGuiCol_PlotLinesHovered] = ImVec4(1.00f, 0.43f, 0.35f, 1.00f);
-        colors[ImGuiCol_PlotHistogram] = ImVec4(0.90f, 0.70f, 0.00f, 1.00f);
-        colors[ImGuiCol_PlotHistogramHovered] = ImVec4(1.00f, 0.60f, 0.00f, 1.00f);
-        colors[ImGuiCol_TableHeaderBg] = ImVec4(0.19f, 0.19f, 0.20f, 1.00f);
-        colors[ImGuiCol_TableBorderStrong] = ImVec4(0.31f, 0.31f, 0.35f, 1.00f);
-        colors[ImGuiCol_TableBorderLight] = ImVec4(0.23f, 0.23f, 0.25f, 1.00f);
-        colors[ImGuiCol_TableRowBg] = ImVec4(0.00f, 0.00f, 0.00f, 0.00f);
-        colors[ImGuiCol_TableRowBgAlt] = ImVec4(1.00f, 1.00f, 1.00f, 0.06f);
-        colors[ImGuiCol_TextSelectedBg] = ImVec4(0.26f, 0.59f, 0.98f, 0.35f);
-        colors[ImGuiCol_DragDropTarget] = ImVec4(1.00f, 1.00f, 0.00f, 0.90f);
-        colors[ImGuiCol_NavHighlight] = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
-        colors[ImGuiCol_NavWindowingHighlight] = ImVec4(1.00f, 1.00f, 1.00f, 0.70f);
-        colors[ImGuiCol_NavWindowingDimBg] = ImVec4(0.80f, 0.80f, 0.80f, 0.20f);
-        colors[ImGuiCol_ModalWindowDimBg] = ImVec4(0.80f, 0.80f, 0.80f, 0.35f);
-    }
+    void StyleManager::loadThemes() {
+        if (m_themesLoaded) {
+            return;
+        }
+        m_themesLoaded = true;
 
-    void StyleManager::setupLightTheme() {
-        ImGui::StyleColorsLight();
-        // Additional light theme customizations can be added here
-    }
+        auto& registry = ThemeRegistry::getInstance();
+        registry.loadDirectory();
+
+        // Customizations and theme from settings
+        auto& settings = Settings::getInstance();
+        ThemeCustomizations customizations;
+        customizations.accentColor = settings.get<ImVec4>(Settings::UI::ACCENT_COLOR, customizations.accentColor);
+        customizations.windowRounding = settings.get<float>(Settings::UI::WINDOW_ROUNDING, customizations.windowRounding);
+        customizations.frameRounding = settings.get<float>(Settings::UI::FRAME_ROUNDING, customizations.frameRounding);
+        registry.setCustomizations(customizations);
+
+        m_currentTheme = registry.find(settings.get<std::string>(Settings::UI::THEME, "Dark"));
+        if (m_currentTheme == INVALID_THEME) {
+            m_currentTheme = 0;
+        }
 
-    void StyleManager::setupImHexTheme() {
-        // ImHex-style theme (similar to the reference code)
-        setupDarkTheme(); // Start with dark base
-
-        ImGuiStyle& style = ImGui::GetStyle();
-        auto& colors = style.Colors;
-
-        // ImHex specific colors
-        colors[ImGuiCol_WindowBg] = ImVec4(0.11f, 0.11f, 0.14f, 1.00f);
-        colors[ImGuiCol_TitleBg] = ImVec4(0.08f, 0.08f, 0.09f, 1.00f);
-        colors[ImGuiCol_TitleBgActive] = ImVec4(0.08f, 0.08f, 0.09f, 1.00f);
-        colors[ImGuiCol_Button] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_ButtonHovered] = ImVec4(0.30f, 0.30f, 0.33f, 1.00f);
-        colors[ImGuiCol_ButtonActive] = ImVec4(0.27f, 0.27f, 0.30f, 1.00f);
-        colors[ImGuiCol_Header] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_HeaderHovered] = ImVec4(0.30f, 0.30f, 0.33f, 1.00f);
-        colors[ImGuiCol_HeaderActive] = ImVec4(0.27f, 0.27f, 0.30f, 1.00f);
-        colors[ImGuiCol_Tab] = ImVec4(0.12f, 0.12f, 0.15f, 1.00f);
-        colors[ImGuiCol_TabHovered] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_TabActive] = ImVec4(0.18f, 0.18f, 0.21f, 1.00f);
-        colors[ImGuiCol_PopupBg] = ImVec4(0.15f, 0.15f, 0.18f, 1.00f);
-        colors[ImGuiCol_Border] = ImVec4(0.25f, 0.25f, 0.28f, 1.00f);
-        colors[ImGuiCol_FrameBg] = ImVec4(0.18f, 0.18f, 0.21f, 1.00f);
-        colors[ImGuiCol_FrameBgHovered] = ImVec4(0.23f, 0.23f, 0.26f, 1.00f);
-        colors[ImGuiCol_FrameBgActive] = ImVec4(0.27f, 0.27f, 0.30f, 1.00f);
+        ConsoleView::debug("Loaded " + std::to_string(registry.getThemeCount()) + " themes");
     }
 
     void StyleManager::setupFonts() {
-        setupDefaultFonts();
-
-        // Load custom fonts from settings
+        // Font size comes from settings so the atlas is only built once
         auto& settings = Settings::getInstance();
-        float fontSize = settings.get<float>(Settings::UI::FONT_SIZE, 14.0f);
+        m_fontSize = settings.get<float>(Settings::UI::FONT_SIZE, m_fontSize);
 
-        // Apply font size
-        setFontSize(fontSize);
+        setupDefaultFonts();
     }
 
     void StyleManager::setupDefaultFonts() {
-        // This would load fonts from embedded resources
-        // For now, we'll use the default ImGui font
-
-        ImGuiIO& io = ImGui::GetIO();
-
-        // Add default font
-        ImFontConfig config;
-        config.SizePixels = m_fontSize;
-        config.OversampleH = 2;
-        config.OversampleV = 1;
-        config.PixelSnapH = true;
-
-        ImFont* defaultFont = io.Fonts->AddFontDefault(&config);
-
-        // Store font info
-        FontInfo fontInfo;
-        fontInfo.font = defaultFont;
-        fontInfo.size = m_fontSize;
-        fontInfo.path = "default";
-        m_fonts[m_defaultFontName] = fontInfo;
-
-        // TODO: Load Geist fonts and Material Symbols from embedded resources
-        // loadFont("GeistRegular", "res/fonts/Geist-Regular.ttf", 14.0f);
-        // loadFont("GeistBold", "res/fonts/Geist-Bold.ttf", 14.0f);
-        // loadFont("MaterialSymbols", "res/fonts/MaterialSymbols.ttf", 16.0f);
+        auto& fontManager = FontManager::getInstance();
+        fontManager.setFontSize(m_fontSize);
+        fontManager.build();
+
+        ConsoleView::debug(std::string("Font atlas ") + (fontManager.wasLoadedFromCache() ? "loaded from cache" : "built") +
+                           " with " + std::to_string(fontManager.getIconGlyphCount()) + " icon glyphs");
     }
 
     void StyleManager::loadFont(const std::string& name, const std::string& path, float size) {
-        ImGuiIO& io = ImGui::GetIO();
-
-        ImFont* font = io.Fonts->AddFontFromFileTTF(path.c_str(), size);
-        if (font) {
-            FontInfo fontInfo;
-            fontInfo.font = font;
-            fontInfo.size = size;
-            fontInfo.path = path;
-            m_fonts[name] = fontInfo;
-
-            std::cout << "Loaded font: " << name << " (" << path << ")" << std::endl;
-        } else {
-            std::cerr << "Failed to load font: " << path << std::endl;
-        }
+        // Added to the atlas at the next rebuild (between frames)
+        FontManager::getInstance().addFont(name, path, size);
     }
 
     ImFont* StyleManager::getFont(const std::string& name) {
-        auto it = m_fonts.find(name);
-        if (it != m_fonts.end()) {
-            return it->second.font;
-        }
-
-        // Return default font if not found
-        auto defaultIt = m_fonts.find(m_defaultFontName);
-        if (defaultIt != m_fonts.end()) {
-            return defaultIt->second.font;
-        }
-
-        // Fallback to ImGui's default font
-        ImGuiIO& io = ImGui::GetIO();
-        return io.Fonts->Fonts.empty() ? nullptr : io.Fonts->Fonts[0];
+        return FontManager::getInstance().getFont(name);
     }
 
     void StyleManager::setDefaultFont(const std::string& name) {
-        if (m_fonts.find(name) != m_fonts.end()) {
-            m_defaultFontName = name;
-        }
+        m_defaultFontName = name;
+        ImGui::GetIO().FontDefault = FontManager::getInstance().getFont(name);
     }
 
-    void StyleManager::applyCustomizations() {
-        ImGuiStyle& style = ImGui::GetStyle();
+    void StyleManager::setCustomizations(const ThemeCustomizations& customizations) {
+        loadThemes();
 
-        // Apply custom values from settings
-        auto& settings = Settings::getInstance();
+        auto& registry = ThemeRegistry::getInstance();
+        if (customizations == registry.getCustomizations()) {
+            return;
+        }
 
-        style.WindowRounding = settings.get<float>(Settings::UI::WINDOW_ROUNDING, m_windowRounding);
-        style.FrameRounding = settings.get<float>(Settings::UI::FRAME_ROUNDING, m_frameRounding);
-        style.ScrollbarRounding = 6.0f;
-        style.GrabRounding = 4.0f;
-        style.TabRounding = 4.0f;
-        style.WindowPadding = ImVec2(8, 8);
-        style.ItemSpacing = ImVec2(8, 4);
-        style.ItemInnerSpacing = ImVec2(4, 4);
-        style.FramePadding = ImVec2(6, 3);
-
-        // Apply accent color
-        ImVec4 accentColor = settings.get<ImVec4>(Settings::UI::ACCENT_COLOR, m_accentColor);
-        setAccentColor(accentColor);
+        registry.setCustomizations(customizations);
+        applyCurrentTheme();
     }
 
     void StyleManager::setAccentColor(const ImVec4& color) {
-        m_accentColor = color;
-
-        // Apply accent color to relevant UI elements
-        ImGuiStyle& style = ImGui::GetStyle();
-        style.Colors[ImGuiCol_CheckMark] = color;
-        style.Colors[ImGuiCol_SliderGrab] = color;
-        style.Colors[ImGuiCol_SliderGrabActive] = colorWithAlpha(color, 0.8f);
-        style.Colors[ImGuiCol_ResizeGrip] = colorWithAlpha(color, 0.2f);
-        style.Colors[ImGuiCol_ResizeGripHovered] = colorWithAlpha(color, 0.67f);
-        style.Colors[ImGuiCol_ResizeGripActive] = colorWithAlpha(color, 0.95f);
-        style.Colors[ImGuiCol_DockingPreview] = colorWithAlpha(color, 0.7f);
+        ThemeCustomizations customizations = ThemeRegistry::getInstance().getCustomizations();
+        if (customizations.accentColor.x == color.x && customizations.accentColor.y == color.y &&
+            customizations.accentColor.z == color.z && customizations.accentColor.w == color.w) {
+            return;
+        }
+
+        customizations.accentColor = color;
+        setCustomizations(customizations);
 
         // Save to settings
         auto& settings = Settings::getInstance();
@@ -246,32 +126,46 @@ namespace scummredux {
     }
 
     void StyleManager::setWindowRounding(float rounding) {
-        m_windowRounding = rounding;
-        ImGui::GetStyle().WindowRounding = rounding;
+        ThemeCustomizations customizations = ThemeRegistry::getInstance().getCustomizations();
+        if (customizations.windowRounding == rounding) {
+            return;
+        }
+
+        customizations.windowRounding = rounding;
+        setCustomizations(customizations);
 
         auto& settings = Settings::getInstance();
         settings.set(Settings::UI::WINDOW_ROUNDING, rounding);
     }
 
     void StyleManager::setFrameRounding(float rounding) {
-        m_frameRounding = rounding;
-        ImGui::GetStyle().FrameRounding = rounding;
+        ThemeCustomizations customizations = ThemeRegistry::getInstance().getCustomizations();
+        if (customizations.frameRounding == rounding) {
+            return;
+        }
+
+        customizations.frameRounding = rounding;
+        setCustomizations(customizations);
 
         auto& settings = Settings::getInstance();
         settings.set(Settings::UI::FRAME_ROUNDING, rounding);
     }
 
     void StyleManager::setFontSize(float size) {
+        if (size == m_fontSize) {
+            return;
+        }
         m_fontSize = size;
 
         auto& settings = Settings::getInstance();
         settings.set(Settings::UI::FONT_SIZE, size);
 
-        // TODO: Rebuild font atlas with new size
+        // Atlas is rebuilt between frames
+        FontManager::getInstance().setFontSize(size);
     }
 
     ImVec4 StyleManager::getAccentColor() const {
-        return m_accentColor;
+        return ThemeRegistry::getInstance().getCustomizations().accentColor;
     }
 
     // Static utility functions
@@ -1,8 +1,8 @@
 #pragma once
 
+#include "ThemeRegistry.h"
 #include <imgui.h>
 #include <string>
-#include <unordered_map>
 
 namespace scummredux {
 
@@ -10,23 +10,12 @@ namespace scummredux {
     public:
         static StyleManager& getInstance();
 
-        // Theme management
-        void setTheme(const std::string& themeName);
+        // Theme management (themes are data files, see ThemeRegistry)
+        void setTheme(ThemeId theme);
         void applyCurrentTheme();
         void setupFonts();
         
-        // Predefined themes
-        void setupDarkTheme();
-        void setupLightTheme();
-        void setupImHexTheme(); // Similar to the ImHex style
-        
-        // Font management
-        struct FontInfo {
-            ImFont* font = nullptr;
-            float size = 14.0f;
-            std::string path;
-        };
-        
+        // Font management (atlas is owned by FontManager)
         void loadFont(const std::string& name, const std::string& path, float size);
         ImFont* getFont(const std::string& name);
         void setDefaultFont(const std::string& name);
@@ -38,7 +27,8 @@ namespace scummredux {
         void setFontSize(float size);
         
         // Getters
-        std::string getCurrentTheme() const { return m_currentTheme; }
+        ThemeId getCurrentThemeId() const { return m_currentTheme; }
+        const std::string& getCurrentTheme() const { return ThemeRegistry::getInstance().getName(m_currentTheme); }
         ImVec4 getAccentColor() const;
         
         // Style helpers
@@ -48,17 +38,13 @@ namespace scummredux {
     private:
         StyleManager() = default;
         
-        void applyCustomizations();
+        void loadThemes();
+        void setCustomizations(const ThemeCustomizations& customizations);
         void setupDefaultFonts();
         
-        std::string m_currentTheme = "Dark";
-        std::unordered_map<std::string, FontInfo> m_fonts;
+        ThemeId m_currentTheme = INVALID_THEME;
+        bool m_themesLoaded = false;
         std::string m_defaultFontName = "GeistRegular";
-        
-        // Style customizations
-        ImVec4 m_accentColor = ImVec4(0.43f, 0.43f, 0.50f, 1.0f);
-        float m_windowRounding = 6.0f;
-        float m_frameRounding = 3.0f;
         float m_fontSize = 14.0f;
     };
 
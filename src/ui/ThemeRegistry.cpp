@@ -0,0 +1,246 @@
+#include "ThemeRegistry.h"
+#include "StyleManager.h"
+#include "../views/ConsoleView.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace scummredux {
+
+    namespace {
+        std::string trim(const std::string& str) {
+            const auto first = str.find_first_not_of(" \t\r");
+            if (first == std::string::npos) {
+                return "";
+            }
+            const auto last = str.find_last_not_of(" \t\r");
+            return str.substr(first, last - first + 1);
+        }
+
+        bool equals(const ImVec4& a, const ImVec4& b) {
+            return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+        }
+
+        ImGuiCol findColor(const std::string& name) {
+            for (ImGuiCol i = 0; i < ImGuiCol_COUNT; i++) {
+                if (name == ImGui::GetStyleColorName(i)) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+    }
+
+    bool ThemeCustomizations::operator==(const ThemeCustomizations& other) const {
+        return equals(accentColor, other.accentColor) &&
+               windowRounding == other.windowRounding &&
+               frameRounding == other.frameRounding;
+    }
+
+    ThemeRegistry& ThemeRegistry::getInstance() {
+        static ThemeRegistry instance;
+        return instance;
+    }
+
+    size_t ThemeRegistry::loadDirectory(const std::string& directory) {
+        std::unordered_map<std::string, ThemeFile> files;
+
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            if (entry.path().extension() != ".theme") {
+                continue;
+            }
+
+            ThemeFile file;
+            if (parseFile(entry.path().string(), file)) {
+                files[file.name] = std::move(file);
+            }
+        }
+
+        // Resolve in name order so IDs are stable between runs
+        std::vector<std::string> names;
+        for (const auto& [name, file] : files) {
+            names.push_back(name);
+        }
+        std::sort(names.begin(), names.end());
+
+        for (const auto& name : names) {
+            std::vector<std::string> resolving;
+            resolve(name, files, resolving);
+        }
+
+        // Keep the UI usable without the resource directory
+        if (m_themes.empty()) {
+            ConsoleView::warning("No themes found in " + directory + ", using built-in Dark");
+            ImGuiStyle style;
+            ImGui::StyleColorsDark(&style);
+            registerTheme("Dark", style);
+        }
+
+        return m_themes.size();
+    }
+
+    ThemeId ThemeRegistry::find(const std::string& name) const {
+        auto it = m_ids.find(name);
+        return it != m_ids.end() ? it->second : INVALID_THEME;
+    }
+
+    const std::string& ThemeRegistry::getName(ThemeId id) const {
+        static const std::string empty;
+        return id < m_names.size() ? m_names[id] : empty;
+    }
+
+    void ThemeRegistry::setCustomizations(const ThemeCustomizations& customizations) {
+        if (customizations == m_customizations) {
+            return;
+        }
+
+        m_customizations = customizations;
+        m_generation++;
+    }
+
+    void ThemeRegistry::setScale(float scale) {
+        if (scale == m_scale) {
+            return;
+        }
+
+        m_scale = scale;
+        m_generation++;
+    }
+
+    const ImGuiStyle& ThemeRegistry::getStyle(ThemeId id) {
+        Theme& theme = m_themes[id < m_themes.size() ? id : 0];
+        if (theme.generation != m_generation) {
+            compile(theme);
+            theme.generation = m_generation;
+        }
+        return theme.compiled;
+    }
+
+    bool ThemeRegistry::parseFile(const std::string& path, ThemeFile& file) const {
+        std::ifstream stream(path);
+        if (!stream.is_open()) {
+            ConsoleView::error("Failed to open theme: " + path);
+            return false;
+        }
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(stream, line)) {
+            lineNumber++;
+            line = trim(line);
+            if (line.empty() || line[0] == '#') continue;
+
+            const auto pos = line.find('=');
+            if (pos == std::string::npos) continue;
+
+            const std::string key = trim(line.substr(0, pos));
+            const std::string value = trim(line.substr(pos + 1));
+
+            if (key == "name") {
+                file.name = value;
+            } else if (key == "base") {
+                file.base = value;
+            } else if (key.starts_with("color.")) {
+                const ImGuiCol index = findColor(key.substr(6));
+                ImVec4 color;
+                std::istringstream values(value);
+                if (index < 0 || !(values >> color.x >> color.y >> color.z >> color.w)) {
+                    ConsoleView::warning(path + ":" + std::to_string(lineNumber) + ": invalid color '" + key + "'");
+                    continue;
+                }
+                file.colors.emplace_back(index, color);
+            }
+        }
+
+        if (file.name.empty()) {
+            ConsoleView::warning("Theme without a name: " + path);
+            return false;
+        }
+        return true;
+    }
+
+    bool ThemeRegistry::resolve(const std::string& name, std::unordered_map<std::string, ThemeFile>& files,
+                                std::vector<std::string>& resolving) {
+        if (find(name) != INVALID_THEME) {
+            return true;
+        }
+
+        auto it = files.find(name);
+        if (it == files.end()) {
+            return false;
+        }
+        if (std::find(resolving.begin(), resolving.end(), name) != resolving.end()) {
+            ConsoleView::error("Theme inherits from itself: " + name);
+            return false;
+        }
+        resolving.push_back(name);
+
+        const ThemeFile& file = it->second;
+        ImGuiStyle style;
+
+        if (file.base.empty() || file.base == "dark") {
+            ImGui::StyleColorsDark(&style);
+        } else if (file.base == "light") {
+            ImGui::StyleColorsLight(&style);
+        } else if (file.base == "classic") {
+            ImGui::StyleColorsClassic(&style);
+        } else if (resolve(file.base, files, resolving)) {
+            style = m_themes[find(file.base)].base;
+        } else {
+            ConsoleView::warning("Theme '" + name + "' has unknown base '" + file.base + "'");
+            ImGui::StyleColorsDark(&style);
+        }
+
+        for (const auto& [index, color] : file.colors) {
+            style.Colors[index] = color;
+        }
+
+        registerTheme(name, style);
+        return true;
+    }
+
+    ThemeId ThemeRegistry::registerTheme(const std::string& name, const ImGuiStyle& base) {
+        const auto id = static_cast<ThemeId>(m_themes.size());
+
+        Theme theme;
+        theme.base = base;
+        m_themes.push_back(theme);
+        m_names.push_back(name);
+        m_ids[name] = id;
+
+        return id;
+    }
+
+    void ThemeRegistry::compile(Theme& theme) const {
+        ImGuiStyle& style = theme.compiled;
+        style = theme.base;
+
+        // Layout shared by all themes
+        style.WindowRounding = m_customizations.windowRounding;
+        style.FrameRounding = m_customizations.frameRounding;
+        style.ScrollbarRounding = 6.0f;
+        style.GrabRounding = 4.0f;
+        style.TabRounding = 4.0f;
+        style.WindowPadding = ImVec2(8, 8);
+        style.ItemSpacing = ImVec2(8, 4);
+        style.ItemInnerSpacing = ImVec2(4, 4);
+        style.FramePadding = ImVec2(6, 3);
+
+        // Accent color
+        const ImVec4& accent = m_customizations.accentColor;
+        style.Colors[ImGuiCol_CheckMark] = accent;
+        style.Colors[ImGuiCol_SliderGrab] = accent;
+        style.Colors[ImGuiCol_SliderGrabActive] = StyleManager::colorWithAlpha(accent, 0.8f);
+        style.Colors[ImGuiCol_ResizeGrip] = StyleManager::colorWithAlpha(accent, 0.2f);
+        style.Colors[ImGuiCol_ResizeGripHovered] = StyleManager::colorWithAlpha(accent, 0.67f);
+        style.Colors[ImGuiCol_ResizeGripActive] = StyleManager::colorWithAlpha(accent, 0.95f);
+        style.Colors[ImGuiCol_DockingPreview] = StyleManager::colorWithAlpha(accent, 0.7f);
+
+        if (m_scale != 1.0f) {
+            style.ScaleAllSizes(m_scale);
+        }
+    }
+
+} // namespace scummredux
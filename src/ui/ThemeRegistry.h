@@ -0,0 +1,80 @@
+#pragma once
+
+#include <imgui.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    using ThemeId = uint32_t;
+    static constexpr ThemeId INVALID_THEME = UINT32_MAX;
+
+    // User customizations layered on top of every theme
+    struct ThemeCustomizations {
+        ImVec4 accentColor = ImVec4(0.43f, 0.43f, 0.50f, 1.0f);
+        float windowRounding = 6.0f;
+        float frameRounding = 3.0f;
+
+        bool operator==(const ThemeCustomizations& other) const;
+    };
+
+    // Themes loaded from res/themes/*.theme, interned by ID. Each theme is compiled
+    // (base colors + customizations) into an ImGuiStyle snapshot once, so applying a
+    // theme is a single struct copy with no lookups or allocations.
+    class ThemeRegistry {
+    public:
+        static ThemeRegistry& getInstance();
+
+        // Loads every theme file in the directory; returns the number of themes registered
+        size_t loadDirectory(const std::string& directory = THEME_DIRECTORY);
+
+        ThemeId find(const std::string& name) const;
+        const std::string& getName(ThemeId id) const;
+        const std::vector<std::string>& getNames() const { return m_names; }
+        size_t getThemeCount() const { return m_themes.size(); }
+
+        // Invalidates compiled snapshots only when the customizations actually change
+        void setCustomizations(const ThemeCustomizations& customizations);
+        const ThemeCustomizations& getCustomizations() const { return m_customizations; }
+
+        // UI scale applied to all style sizes
+        void setScale(float scale);
+
+        // Compiled snapshot (recompiled lazily after customizations change)
+        const ImGuiStyle& getStyle(ThemeId id);
+
+    private:
+        ThemeRegistry() = default;
+
+        struct ThemeFile {
+            std::string name;
+            std::string base;
+            std::vector<std::pair<ImGuiCol, ImVec4>> colors;
+        };
+
+        struct Theme {
+            ImGuiStyle base;        // Theme colors on default ImGui metrics
+            ImGuiStyle compiled;    // base + customizations
+            uint32_t generation = 0;
+        };
+
+        bool parseFile(const std::string& path, ThemeFile& file) const;
+        bool resolve(const std::string& name, std::unordered_map<std::string, ThemeFile>& files,
+                     std::vector<std::string>& resolving);
+        ThemeId registerTheme(const std::string& name, const ImGuiStyle& base);
+        void compile(Theme& theme) const;
+
+        std::vector<Theme> m_themes;
+        std::vector<std::string> m_names;
+        std::unordered_map<std::string, ThemeId> m_ids;
+
+        ThemeCustomizations m_customizations;
+        float m_scale = 1.0f;
+        uint32_t m_generation = 1;
+
+        static constexpr const char* THEME_DIRECTORY = "res/themes/";
+    };
+
+} // namespace scummredux
@@ -32,6 +32,7 @@ namespace scummredux {
         // Title management
         void setTitle(const std::string& title);
         void setSubtitle(const std::string& subtitle);
+        // Kept on the open game every frame; the marker shows while it has unsaved edits
         void setProjectInfo(const std::string& projectName, bool hasUnsavedChanges = false);
 
         // Configuration
@@ -1,13 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <vector>
 #include <unordered_map>
 #include <typeindex>
 #include <memory>
+#include <typeinfo>
+#include "../core/TraceRecorder.h"
 
 namespace scummredux {
 
+    struct FileChange;
+
     // Sistema simples de eventos inspirado no ImHex
     template<typename T>
     class Event {
@@ -26,6 +31,7 @@ namespace scummredux {
         }
 
         static void post(const T& event) {
+            TraceScope trace(typeid(Event<T>).name(), "event", true);
             for (const auto& [handle, callback] : s_callbacks) {
                 callback(event);
             }
@@ -49,8 +55,12 @@ namespace scummredux {
         bool maximized;
     };
 
+    struct ContentScaleChangedEvent {
+        float xScale, yScale;
+    };
+
     struct ThemeChangedEvent {
-        std::string themeName;
+        uint32_t theme;     // ThemeId, see ui/ThemeRegistry.h
     };
 
     struct ViewOpenedEvent {
@@ -61,6 +71,27 @@ namespace scummredux {
         std::string viewName;
     };
 
+    // Coalesced changes to files inside the open project
+    struct FilesChangedEvent {
+        const std::vector<FileChange>& changes;
+    };
+
+    struct ObjectImage;
+
+    // The room shown in the Rooms view (objects empty when none)
+    struct RoomSelectedEvent {
+        uint16_t room;
+        const std::vector<ObjectImage>& objects;
+    };
+
+    class ResourceOverlay;
+
+    // The open game was saved and opened again; the overlay that was written says
+    // where the blocks of the old files are now
+    struct GameSavedEvent {
+        const ResourceOverlay& saved;
+    };
+
     struct FrameBeginEvent {};
     struct FrameEndEvent {};
 
@@ -68,9 +99,13 @@ namespace scummredux {
     using EventWindowResize = Event<WindowResizeEvent>;
     using EventWindowClose = Event<WindowCloseEvent>;
     using EventWindowMaximize = Event<WindowMaximizeEvent>;
+    using EventContentScaleChanged = Event<ContentScaleChangedEvent>;
     using EventThemeChanged = Event<ThemeChangedEvent>;
     using EventViewOpened = Event<ViewOpenedEvent>;
     using EventViewClosed = Event<ViewClosedEvent>;
+    using EventFilesChanged = Event<FilesChangedEvent>;
+    using EventRoomSelected = Event<RoomSelectedEvent>;
+    using EventGameSaved = Event<GameSavedEvent>;
     using EventFrameBegin = Event<FrameBeginEvent>;
     using EventFrameEnd = Event<FrameEndEvent>;
 
@@ -0,0 +1,51 @@
+#pragma once
+
+// Instruction sets every build of an architecture can use unconditionally: SSE2 on
+// x86 (part of x86-64), NEON on ARM64. Wider sets such as AVX2 are compiled per
+// function with SCUMMREDUX_TARGET_AVX2 and must be selected at runtime.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SCUMMREDUX_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define SCUMMREDUX_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(SCUMMREDUX_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SCUMMREDUX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SCUMMREDUX_TARGET_AVX2
+#endif
+
+#ifdef SCUMMREDUX_SIMD_X86
+namespace scummredux {
+
+    // AVX2 kernels need the CPU feature and the OS saving the YMM registers
+    inline bool cpuHasAVX2() {
+#ifdef _MSC_VER
+        static const bool supported = [] {
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        }();
+#else
+        static const bool supported = __builtin_cpu_supports("avx2");
+#endif
+        return supported;
+    }
+
+} // namespace scummredux
+#endif
@@ -1,4 +1,5 @@
 #include "Utils.h"
+#include "../ui/FontManager.h"
 #include <algorithm>
 #include <sstream>
 
@@ -95,14 +96,13 @@ namespace scummredux::utils {
         return ImGui::GetStyleColorVec4(idx);
     }
 
-    // Font management - placeholder implementation
+    // Font management (size is fixed per atlas font, so it is ignored for now)
     void pushFont(const char* fontName, float size) {
-        // TODO: Implement font management with StyleManager
-        // For now, just use default font
+        ImGui::PushFont(FontManager::getInstance().getFont(fontName));
     }
 
     void popFont() {
-        // TODO: Implement font popping
+        ImGui::PopFont();
     }
 
 } // namespace scummredux::utils
\ No newline at end of file
@@ -1,17 +1,18 @@
 #pragma once
 
+#include "../ui/ScaleManager.h"
 #include <string>
 #include <imgui.h>
 
 namespace scummredux::utils {
 
-    // Scaling helpers
-    constexpr float operator""_scaled(long double value) {
-        return float(value); // TODO: Implement proper DPI scaling
+    // Scaling helpers (multiply by the cached UI scale factor)
+    inline float operator""_scaled(long double value) {
+        return float(value) * ScaleManager::getFactor();
     }
 
-    constexpr float operator""_scaled(unsigned long long value) {
-        return float(value); // TODO: Implement proper DPI scaling
+    inline float operator""_scaled(unsigned long long value) {
+        return float(value) * ScaleManager::getFactor();
     }
 
     // String utilities
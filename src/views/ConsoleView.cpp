@@ -1,6 +1,17 @@
 #include "ConsoleView.h"
 #include "../res/icons/MaterialSymbols.h"
+#include "../core/TraceRecorder.h"
+#include "../core/InputRecorder.h"
+#include "../scumm/GameArchive.h"
+#include "../scumm/GameManager.h"
+#include "../scumm/SmapDecoder.h"
+#include "../scumm/XorCipher.h"
+#include "../ui/FontManager.h"
+#include "ExplorerView.h"
+#include "ViewManager.h"
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
@@ -38,19 +49,19 @@ namespace scummredux {
     }
 
     void ConsoleView::draw() {
-        std::cout << "ConsoleView::draw() start" << std::endl;
+        verboseOut() << "ConsoleView::draw() start" << std::endl;
 
         try {
             if (ImGui::Begin(getWindowName().c_str(), &getWindowOpenState())) {
-                std::cout << "ConsoleView window created successfully" << std::endl;
+                verboseOut() << "ConsoleView window created successfully" << std::endl;
 
                 drawToolbar();
                 drawLogEntries();
                 drawCommandInput();
 
-                std::cout << "ConsoleView content drawn successfully" << std::endl;
+                verboseOut() << "ConsoleView content drawn successfully" << std::endl;
             } else {
-                std::cout << "ConsoleView window failed to create" << std::endl;
+                verboseOut() << "ConsoleView window failed to create" << std::endl;
             }
             ImGui::End();
         } catch (const std::exception& e) {
@@ -59,11 +70,11 @@ namespace scummredux {
             std::cout << "Unknown exception in ConsoleView::draw()" << std::endl;
         }
 
-        std::cout << "ConsoleView::draw() end" << std::endl;
+        verboseOut() << "ConsoleView::draw() end" << std::endl;
     }
 
     void ConsoleView::drawToolbar() {
-        std::cout << "ConsoleView::drawToolbar() start" << std::endl;
+        verboseOut() << "ConsoleView::drawToolbar() start" << std::endl;
 
         // Clear button
         if (ImGui::Button(ICON_MS_CLEAR_ALL "##clear")) {
@@ -101,7 +112,7 @@ namespace scummredux {
         drawFilters();
         ImGui::Separator();
 
-        std::cout << "ConsoleView::drawToolbar() end" << std::endl;
+        verboseOut() << "ConsoleView::drawToolbar() end" << std::endl;
     }
 
     void ConsoleView::drawFilters() {
@@ -129,7 +140,7 @@ namespace scummredux {
     }
 
     void ConsoleView::drawLogEntries() {
-        std::cout << "ConsoleView::drawLogEntries() start" << std::endl;
+        verboseOut() << "ConsoleView::drawLogEntries() start" << std::endl;
 
         // Calculate available space for log entries
         ImVec2 logRegionSize = ImGui::GetContentRegionAvail();
@@ -147,10 +158,10 @@ namespace scummredux {
         logRegionSize.x = std::max(100.0f, logRegionSize.x);
         logRegionSize.y = std::max(50.0f, logRegionSize.y);
 
-        std::cout << "Using log region size: " << logRegionSize.x << "x" << logRegionSize.y << std::endl;
+        verboseOut() << "Using log region size: " << logRegionSize.x << "x" << logRegionSize.y << std::endl;
 
         if (ImGui::BeginChild("LogRegion", logRegionSize, true, ImGuiWindowFlags_HorizontalScrollbar)) {
-            std::cout << "LogRegion child created successfully" << std::endl;
+            verboseOut() << "LogRegion child created successfully" << std::endl;
 
             // Filter and display log entries
             bool hasSearchFilter = strlen(m_searchBuffer) > 0;
@@ -221,11 +232,11 @@ namespace scummredux {
         }
         ImGui::EndChild();
 
-        std::cout << "ConsoleView::drawLogEntries() end" << std::endl;
+        verboseOut() << "ConsoleView::drawLogEntries() end" << std::endl;
     }
 
     void ConsoleView::drawCommandInput() {
-        std::cout << "ConsoleView::drawCommandInput() start" << std::endl;
+        verboseOut() << "ConsoleView::drawCommandInput() start" << std::endl;
 
         ImGui::Separator();
 
@@ -250,7 +261,7 @@ namespace scummredux {
             ImGui::SetKeyboardFocusHere(-1);
         }
 
-        std::cout << "ConsoleView::drawCommandInput() end" << std::endl;
+        verboseOut() << "ConsoleView::drawCommandInput() end" << std::endl;
     }
 
     // Static callback for ImGui
@@ -306,9 +317,17 @@ namespace scummredux {
     }
 
     void ConsoleView::processCommand(const std::string& command) {
-        std::string cmd = command;
+        // First word is the (case-insensitive) command, the rest are arguments
+        std::istringstream stream(command);
+        std::string cmd;
+        stream >> cmd;
         std::transform(cmd.begin(), cmd.end(), cmd.begin(), ::tolower);
 
+        std::vector<std::string> args;
+        for (std::string arg; stream >> arg;) {
+            args.push_back(arg);
+        }
+
         if (cmd == "help") {
             log("Available commands:", LogLevel::Info);
             log("  help       - Show this help message", LogLevel::Info);
@@ -316,6 +335,15 @@ namespace scummredux {
             log("  version    - Show application version", LogLevel::Info);
             log("  test       - Run test command", LogLevel::Info);
             log("  settings   - Show current settings", LogLevel::Info);
+            log("  trace      - start [file] | stop | status (Chrome trace recording)", LogLevel::Info);
+            log("  record     - start [file] | stop | status (input recording for --replay)", LogLevel::Info);
+            log("  open       - <path> (open a project folder in the Explorer)", LogLevel::Info);
+            log("  resource   - <file> [depth] (list the blocks of a game's index and data files)", LogLevel::Info);
+            log("  bench      - xor [MB] | smap [rooms] (decoder throughput)", LogLevel::Info);
+            log("  rooms      - decode | cancel | status (decode every room of the open game)", LogLevel::Info);
+            log("  scripts    - decompile | cancel | status (decompile every script of the open game)", LogLevel::Info);
+            log("  refs       - var | bit | object | room | script <number> (scripts that use it)", LogLevel::Info);
+            log("  save       - Write the open game's unsaved edits to its files", LogLevel::Info);
         } else if (cmd == "clear") {
             clear();
         } else if (cmd == "version") {
@@ -331,12 +359,326 @@ namespace scummredux {
         } else if (cmd == "settings") {
             log("Current application settings:", LogLevel::Info);
             // TODO: Display current settings
+        } else if (cmd == "trace") {
+            processTraceCommand(args);
+        } else if (cmd == "record") {
+            processRecordCommand(args);
+        } else if (cmd == "rooms") {
+            processRoomsCommand(args);
+        } else if (cmd == "scripts") {
+            processScriptsCommand(args);
+        } else if (cmd == "refs") {
+            processRefsCommand(args);
+        } else if (cmd == "save") {
+            GameManager::getInstance().save();
+        } else if (cmd == "bench") {
+            processBenchCommand(args);
+        } else if (cmd == "resource") {
+            processResourceCommand(args);
+        } else if (cmd == "open") {
+            // Paths may contain spaces: use the raw remainder of the command
+            const auto start = command.find_first_not_of(" \t", command.find_first_of(" \t"));
+            auto* explorer = ViewManager::getInstance().getView<ExplorerView>("Explorer");
+            if (args.empty() || start == std::string::npos) {
+                error("Usage: open <path>");
+            } else if (explorer) {
+                explorer->openProject(command.substr(start));
+            }
         } else {
             error("Unknown command: " + command);
             log("Type 'help' for available commands", LogLevel::Info);
         }
     }
 
+    void ConsoleView::processTraceCommand(const std::vector<std::string>& args) {
+        auto& recorder = TraceRecorder::getInstance();
+        const std::string action = args.empty() ? "status" : args[0];
+
+        if (action == "start") {
+            const std::string path = args.size() > 1 ? args[1] : "scummredux_trace.json";
+            if (recorder.isRecording()) {
+                warning("Trace already recording to " + recorder.getPath());
+            } else if (recorder.start(path)) {
+                success("Trace recording started: " + path);
+            } else {
+                error("Failed to start trace recording: " + path);
+            }
+        } else if (action == "stop") {
+            if (!recorder.isRecording()) {
+                warning("No trace is being recorded");
+                return;
+            }
+            recorder.stop();
+            success("Trace saved to " + recorder.getPath() + " (" + std::to_string(recorder.getEventCount()) + " events)");
+        } else if (action == "status") {
+            if (recorder.isRecording()) {
+                info("Trace recording to " + recorder.getPath() + " (" + std::to_string(recorder.getEventCount()) + " events written)");
+            } else {
+                info("Trace recording is off");
+            }
+        } else {
+            error("Usage: trace start [file] | trace stop | trace status");
+        }
+    }
+
+    void ConsoleView::processRecordCommand(const std::vector<std::string>& args) {
+        auto& recorder = InputRecorder::getInstance();
+        const std::string action = args.empty() ? "status" : args[0];
+
+        if (action == "start") {
+            const std::string path = args.size() > 1 ? args[1] : "scummredux_input.srin";
+            if (recorder.isRecording()) {
+                warning("Input already recording to " + recorder.getPath());
+            } else if (recorder.start(path, ImGui::GetIO().DisplaySize)) {
+                success("Input recording started: " + path);
+            } else {
+                error("Failed to start input recording: " + path);
+            }
+        } else if (action == "stop") {
+            if (!recorder.isRecording()) {
+                warning("No input is being recorded");
+                return;
+            }
+            recorder.stop();
+            success("Input saved to " + recorder.getPath() + " (" + std::to_string(recorder.getEventCount()) +
+                    " events, " + std::to_string(recorder.getFrameCount()) + " frames)");
+        } else if (action == "status") {
+            if (recorder.isRecording()) {
+                info("Input recording to " + recorder.getPath() + " (" + std::to_string(recorder.getFrameCount()) + " frames)");
+            } else {
+                info("Input recording is off");
+            }
+        } else {
+            error("Usage: record start [file] | record stop | record status");
+        }
+    }
+
+    void ConsoleView::processResourceCommand(const std::vector<std::string>& args) {
+        if (args.empty()) {
+            error("Usage: resource <file> [depth]");
+            return;
+        }
+        const int maxDepth = args.size() > 1 ? std::max(0, std::atoi(args[1].c_str())) : 1;
+
+        const auto start = std::chrono::steady_clock::now();
+        GameArchive archive;
+        ResourceFile single;
+        std::vector<ResourceFile*> files;
+        if (GameArchive::isResourcePath(args[0]) && archive.open(args[0])) {
+            files.push_back(&archive.getIndex());
+            for (size_t disk = 1; disk <= archive.getDiskCount(); disk++) {
+                files.push_back(archive.getDisk(disk));
+            }
+        } else if (single.open(args[0])) {
+            files.push_back(&single);
+        } else {
+            error("Failed to open resource file: " + args[0]);
+            return;
+        }
+        const double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::ostringstream summary;
+        summary << "Opened " << files.size() << " file(s) in " << std::fixed << std::setprecision(2) << openMs << " ms";
+        success(summary.str());
+
+        // Headers only: listing touches (and decrypts) just the pages they live on
+        size_t lines = 0;
+        for (ResourceFile* file : files) {
+            std::ostringstream header;
+            header << file->getPath().filename().string() << ": " << file->size() << " bytes, key 0x"
+                   << std::hex << std::setw(2) << std::setfill('0') << int(file->getKey());
+            info(header.str());
+
+            auto list = [&](auto&& self, const Chunk& chunk, int depth) -> void {
+                if (lines++ >= MAX_RESOURCE_LINES) {
+                    return;
+                }
+                std::ostringstream line;
+                line << std::string(2 + depth * 2, ' ') << tagToString(chunk.tag) << "  @" << chunk.offset << "  " << chunk.size;
+                log(line.str(), LogLevel::Info);
+
+                if (depth < maxDepth && ResourceFile::isContainer(chunk.tag)) {
+                    file->forEachChild(chunk, [&](const Chunk& child) {
+                        self(self, child, depth + 1);
+                    });
+                }
+            };
+            for (const Chunk& chunk : file->getTopLevel()) {
+                list(list, chunk, 0);
+            }
+            debug("Decoded " + std::to_string(file->getDecodedPageCount()) + " of " +
+                  std::to_string(file->getPageCount()) + " pages");
+        }
+
+        if (lines > MAX_RESOURCE_LINES) {
+            warning("Output truncated to " + std::to_string(MAX_RESOURCE_LINES) + " blocks");
+        }
+    }
+
+    void ConsoleView::processRoomsCommand(const std::vector<std::string>& args) {
+        auto& game = GameManager::getInstance();
+        auto& rooms = game.getRoomPipeline();
+        const std::string action = args.empty() ? "status" : args[0];
+
+        if (action == "decode") {
+            game.decodeRooms();
+        } else if (action == "cancel") {
+            if (!rooms.isRunning()) {
+                warning("No rooms are being decoded");
+                return;
+            }
+            rooms.cancel();
+        } else if (action == "status") {
+            if (rooms.isRunning()) {
+                info("Decoding rooms: " + std::to_string(rooms.getCompleted()) + " of " + std::to_string(rooms.getTotal()));
+            } else {
+                info(std::to_string(rooms.getRooms().size()) + " rooms decoded");
+            }
+        } else {
+            error("Usage: rooms decode | rooms cancel | rooms status");
+        }
+    }
+
+    void ConsoleView::processScriptsCommand(const std::vector<std::string>& args) {
+        auto& game = GameManager::getInstance();
+        auto& scripts = game.getScriptPipeline();
+        const std::string action = args.empty() ? "status" : args[0];
+
+        if (action == "decompile") {
+            game.decompileScripts();
+        } else if (action == "cancel") {
+            if (!scripts.isRunning()) {
+                warning("No scripts are being decompiled");
+                return;
+            }
+            scripts.cancel();
+        } else if (action == "status") {
+            if (scripts.isRunning()) {
+                info("Decompiling scripts: " + std::to_string(scripts.getCompleted()) + " of " + std::to_string(scripts.getTotal()));
+            } else {
+                info(std::to_string(scripts.getResults().size()) + " scripts decompiled");
+            }
+        } else {
+            error("Usage: scripts decompile | scripts cancel | scripts status");
+        }
+    }
+
+    void ConsoleView::processRefsCommand(const std::vector<std::string>& args) {
+        ReferenceIndex::SymbolKind kind;
+        char* end = nullptr;
+        const unsigned long number = args.size() == 2 ? std::strtoul(args[1].c_str(), &end, 0) : 0;
+        if (args.size() != 2 || !ReferenceIndex::parseKind(args[0], kind) || *end != '\0' || number > UINT16_MAX) {
+            error("Usage: refs var | bit | object | room | script <number>");
+            return;
+        }
+
+        auto& game = GameManager::getInstance();
+        if (!game.isOpen()) {
+            error("No game is open");
+            return;
+        }
+        if (!game.areReferencesReady()) {
+            warning("Script references are still being indexed");
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto references = game.findReferences(kind, static_cast<uint16_t>(number));
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        size_t scripts = 0;
+        for (size_t i = 0; i < references.size(); i++) {
+            scripts += i == 0 || references[i].file != references[i - 1].file || references[i].record != references[i - 1].record ? 1 : 0;
+        }
+        std::ostringstream summary;
+        summary << ReferenceIndex::formatSymbol(kind, static_cast<uint16_t>(number)) << ": " << references.size()
+                << " uses in " << scripts << " scripts (" << std::fixed << std::setprecision(3) << ms << " ms)";
+        success(summary.str());
+
+        for (size_t i = 0; i < references.size() && i < MAX_REFERENCE_LINES; i++) {
+            const auto& reference = references[i];
+            const BlockIndex::Record& block = game.getBlockIndex(reference.file).get(reference.record);
+            char line[192];
+            std::snprintf(line, sizeof(line), "  %s @0x%08X (room %u, %s)  +%04X", tagToString(block.tag).c_str(),
+                          block.offset, static_cast<unsigned>(block.room),
+                          game.getFile(reference.file).getPath().filename().string().c_str(),
+                          static_cast<unsigned>(reference.offset));
+            log(line, LogLevel::Info);
+        }
+        if (references.size() > MAX_REFERENCE_LINES) {
+            warning("Output truncated to " + std::to_string(MAX_REFERENCE_LINES) + " uses; the References view lists them all");
+        }
+    }
+
+    void ConsoleView::processBenchCommand(const std::vector<std::string>& args) {
+        if (!args.empty() && args[0] == "smap") {
+            processSmapBenchmark(args);
+            return;
+        }
+        if (args.empty() || args[0] != "xor") {
+            error("Usage: bench xor [MB] | bench smap [rooms]");
+            return;
+        }
+
+        const int megabytes = args.size() > 1 ? std::clamp(std::atoi(args[1].c_str()), 1, 1024) : 64;
+        const size_t bytes = static_cast<size_t>(megabytes) << 20;
+        info("XOR kernels over " + std::to_string(megabytes) + " MB (active: " +
+             XorCipher::getKernelName(XorCipher::getKernel()) + ")");
+
+        const auto results = XorCipher::benchmark(bytes, 8);
+        const double baseline = results.empty() ? 0.0 : results.front().inPlaceGBps;
+        for (const auto& result : results) {
+            std::ostringstream line;
+            line << std::fixed << std::setprecision(2) << "  " << std::left << std::setw(8)
+                 << XorCipher::getKernelName(result.kernel) << std::right << std::setw(8) << result.inPlaceGBps
+                 << " GB/s in place  " << std::setw(8) << result.copyGBps << " GB/s copy";
+            if (baseline > 0.0) {
+                line << "  (" << std::setprecision(1) << result.inPlaceGBps / baseline << "x)";
+            }
+            log(line.str(), LogLevel::Info);
+        }
+    }
+
+    void ConsoleView::processSmapBenchmark(const std::vector<std::string>& args) {
+        const size_t limit = args.size() > 1 ? static_cast<size_t>(std::clamp(std::atoi(args[1].c_str()), 1, 10000)) : 100;
+
+        // Backgrounds of the open game, otherwise synthetic 320x200 rooms
+        std::vector<SmapDecoder::BenchmarkRoom> corpus;
+        auto& game = GameManager::getInstance();
+        for (size_t file = 0; game.isOpen() && file < game.getFileCount() && corpus.size() < limit; file++) {
+            ResourceFile& resource = game.getFile(file);
+            uint16_t width = 0;
+            uint16_t height = 0;
+            for (const auto& record : game.getBlockIndex(file).getRecords()) {
+                if (record.tag == tags::RMHD) {
+                    const auto header = resource.data(record.toChunk());
+                    width = header.size() >= 4 ? static_cast<uint16_t>(header[0] | (header[1] << 8)) : 0;
+                    height = header.size() >= 4 ? static_cast<uint16_t>(header[2] | (header[3] << 8)) : 0;
+                } else if (record.tag == tags::SMAP && width >= SmapDecoder::STRIP_WIDTH && height > 0) {
+                    const auto block = resource.view(record.offset, record.size);
+                    corpus.push_back({{block.begin(), block.end()}, width, height});
+                    width = 0;      // Object images (OBIM) have their own SMAPs and sizes
+                    if (corpus.size() >= limit) {
+                        break;
+                    }
+                }
+            }
+        }
+
+        const bool synthetic = corpus.empty();
+        if (synthetic) {
+            corpus = SmapDecoder::makeSyntheticCorpus(limit);
+        }
+
+        const auto result = SmapDecoder::benchmark(corpus, 10);
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(3) << "SMAP: " << result.rooms << (synthetic ? " synthetic" : "")
+             << " rooms, " << result.strips << " strips: " << result.serialMs << " ms/room serial, "
+             << result.parallelMs << " ms/room parallel (" << std::setprecision(0) << result.megapixelsPerSecond
+             << " Mpixel/s)";
+        info(line.str());
+    }
+
     ImVec4 ConsoleView::getLogLevelColor(LogLevel level) const {
         switch (level) {
             case LogLevel::Info:    return ImVec4(0.8f, 0.8f, 0.8f, 1.0f);
@@ -371,6 +713,7 @@ namespace scummredux {
     // Static logging functions
     void ConsoleView::log(const std::string& message, LogLevel level) {
         s_logEntries.emplace_back(message, level);
+        FontManager::getInstance().requestGlyphs(message.c_str());
 
         // Also log to cout for debugging
         std::cout << "[LOG " << static_cast<int>(level) << "] " << message << std::endl;
@@ -53,6 +53,14 @@ namespace scummredux {
         const char* getLogLevelIcon(LogLevel level) const;
         void scrollToBottom();
         void processCommand(const std::string& command);
+        void processTraceCommand(const std::vector<std::string>& args);
+        void processRecordCommand(const std::vector<std::string>& args);
+        void processResourceCommand(const std::vector<std::string>& args);
+        void processBenchCommand(const std::vector<std::string>& args);
+        void processSmapBenchmark(const std::vector<std::string>& args);
+        void processRoomsCommand(const std::vector<std::string>& args);
+        void processScriptsCommand(const std::vector<std::string>& args);
+        void processRefsCommand(const std::vector<std::string>& args);
 
         // Static callback for ImGui
         static int handleInputCallback(ImGuiInputTextCallbackData* data);
@@ -85,6 +93,10 @@ namespace scummredux {
         std::vector<std::string> m_commandHistory;
         int m_historyIndex = -1;
         static constexpr size_t MAX_HISTORY = 50;
+
+        // Block listing limit for the resource command
+        static constexpr size_t MAX_RESOURCE_LINES = 200;
+        static constexpr size_t MAX_REFERENCE_LINES = 50;
     };
 
 } // namespace scummredux
\ No newline at end of file
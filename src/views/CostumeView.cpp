@@ -0,0 +1,275 @@
+#include "CostumeView.h"
+#include "../core/TraceRecorder.h"
+#include "../scumm/GameManager.h"
+#include "../utils/Events.hpp"
+#include "../res/icons/MaterialSymbols.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace scummredux {
+
+    CostumeView::CostumeView() : View("Costumes") {
+        m_frameHandle = EventFrameBegin::subscribe([this](const FrameBeginEvent&) {
+            update();
+        });
+    }
+
+    CostumeView::~CostumeView() {
+        EventFrameBegin::unsubscribe(m_frameHandle);
+    }
+
+    void CostumeView::draw() {
+        try {
+            if (ImGui::Begin(getWindowName().c_str(), &getWindowOpenState())) {
+                if (m_costumes.empty()) {
+                    ImGui::TextDisabled("Open a game to browse its costumes");
+                } else {
+                    ImGui::BeginChild("##costumeList", ImVec2(ImGui::GetFontSize() * 12.0f, 0), true);
+                    drawCostumeList();
+                    ImGui::EndChild();
+
+                    ImGui::SameLine();
+                    ImGui::BeginChild("##costumeCanvas", ImVec2(0, 0));
+                    if (m_selected == NO_COSTUME) {
+                        ImGui::TextDisabled("Select a costume");
+                    } else if (!m_loaded) {
+                        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), ICON_MS_ERROR " %s", m_error.c_str());
+                    } else {
+                        drawToolbar();
+                        ImGui::Separator();
+                        drawCanvas();
+                    }
+                    ImGui::EndChild();
+                }
+            }
+            ImGui::End();
+        } catch (const std::exception& e) {
+            std::cout << "Exception in CostumeView::draw(): " << e.what() << std::endl;
+        } catch (...) {
+            std::cout << "Unknown exception in CostumeView::draw()" << std::endl;
+        }
+    }
+
+    void CostumeView::update() {
+        if (GameManager::getInstance().getGeneration() != m_generation) {
+            reload();
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - m_lastUpdate).count();
+        m_lastUpdate = now;
+        if (!m_loaded) {
+            return;
+        }
+
+        // A slow frame catches up a few steps at most instead of fast-forwarding
+        if (m_playing) {
+            m_pendingSteps = std::min(m_pendingSteps + seconds * m_fps, static_cast<double>(MAX_STEPS_PER_FRAME));
+            for (; m_pendingSteps >= 1.0; m_pendingSteps -= 1.0) {
+                m_player.step();
+                m_dirty = true;
+            }
+        }
+        if (m_dirty) {
+            compose();
+        }
+    }
+
+    void CostumeView::reload() {
+        TextureCache::getInstance().remove(m_textureKey);
+        m_costumes.clear();
+        m_selected = NO_COSTUME;
+        m_loaded = false;
+        m_frames.reset(nullptr);
+
+        auto& game = GameManager::getInstance();
+        m_generation = game.getGeneration();
+        if (!game.isOpen()) {
+            return;
+        }
+        for (const RoomPipeline::Room& room : game.getRooms()) {
+            room.file->forEachChild(room.block, [&](const Chunk& chunk) {
+                if (chunk.tag == tags::COST || chunk.tag == tags::AKOS) {
+                    m_costumes.push_back({room.file, chunk, room.block, room.number});
+                }
+            });
+        }
+    }
+
+    void CostumeView::select(size_t index) {
+        if (index >= m_costumes.size() || index == m_selected) {
+            return;
+        }
+        SCUMM_TRACE_SCOPE("loadCostume", "costumes");
+        m_selected = index;
+        m_error.clear();
+
+        const Entry& entry = m_costumes[index];
+        m_loaded = m_costume.load(entry.file->view(entry.block.offset, entry.block.size), m_error);
+        m_frames.reset(m_loaded ? &m_costume : nullptr);
+        if (!m_loaded) {
+            return;
+        }
+
+        // The costume palette maps to the room's colors; frames are cached per room palette
+        const Chunk room = entry.file->findChild(entry.room, tags::ROOM);
+        if (!room.valid() || !Palette::load(*entry.file, room, m_palette)) {
+            for (size_t color = 0; color < Palette::SIZE; color++) {
+                const uint8_t gray = static_cast<uint8_t>(color);
+                m_palette.colors[color] = Palette::pack(gray, gray, gray);
+            }
+        }
+        m_paletteId = entry.roomNumber;
+        m_animation = 0;
+        startAnimation();
+    }
+
+    void CostumeView::startAnimation() {
+        m_player.start(m_costume, static_cast<size_t>(m_animation));
+        m_pendingSteps = 0.0;
+
+        // Bounds of every frame the animation can show, decoding them on the way
+        int left = INT_MAX, top = INT_MAX, right = INT_MIN, bottom = INT_MIN;
+        for (const CostumePlayer::LimbFrame& limbFrame : m_player.getAllFrames()) {
+            const CostumeFrameCache::Frame* frame = m_frames.get(limbFrame.limb, limbFrame.frame, m_paletteId, m_palette);
+            if (!frame) {
+                continue;
+            }
+            left = std::min<int>(left, frame->info.relX);
+            top = std::min<int>(top, frame->info.relY);
+            right = std::max<int>(right, frame->info.relX + frame->info.width);
+            bottom = std::max<int>(bottom, frame->info.relY + frame->info.height);
+        }
+        if (left > right) {
+            left = top = 0;
+            right = bottom = 32;
+        }
+
+        const uint16_t width = static_cast<uint16_t>(std::clamp(right - left + CANVAS_MARGIN * 2, 16, MAX_CANVAS));
+        const uint16_t height = static_cast<uint16_t>(std::clamp(bottom - top + CANVAS_MARGIN * 2, 16, MAX_CANVAS));
+        if (width != m_canvasWidth || height != m_canvasHeight || m_textureKey == 0) {
+            TextureCache::getInstance().remove(m_textureKey);
+            m_textureKey = TEXTURE_KEY_BIT | ++m_textureSerial;
+            m_canvasWidth = width;
+            m_canvasHeight = height;
+        }
+        m_originX = CANVAS_MARGIN - left;
+        m_originY = CANVAS_MARGIN - top;
+        m_canvas.assign(static_cast<size_t>(width) * height, 0);
+        m_dirty = true;
+    }
+
+    void CostumeView::compose() {
+        SCUMM_TRACE_SCOPE("composeCostume", "costumes");
+        std::fill(m_canvas.begin(), m_canvas.end(), 0);
+
+        // Limbs draw in order, each shifting the next by its move offsets like the engine
+        int moveX = 0;
+        int moveY = 0;
+        for (const CostumePlayer::LimbFrame& limbFrame : m_player.getFrames()) {
+            const CostumeFrameCache::Frame* frame = m_frames.get(limbFrame.limb, limbFrame.frame, m_paletteId, m_palette);
+            if (!frame) {
+                continue;
+            }
+            const Costume::FrameInfo& info = frame->info;
+            const int x = m_originX + moveX + info.relX;
+            const int y = m_originY + moveY + info.relY;
+            moveX += info.moveX;
+            moveY -= info.moveY;
+
+            const int left = std::max(x, 0);
+            const int right = std::min<int>(x + info.width, m_canvasWidth);
+            const int top = std::max(y, 0);
+            const int bottom = std::min<int>(y + info.height, m_canvasHeight);
+            for (int row = top; row < bottom; row++) {
+                const uint32_t* source = frame->pixels.data() + static_cast<size_t>(row - y) * info.width + (left - x);
+                uint32_t* destination = m_canvas.data() + static_cast<size_t>(row) * m_canvasWidth + left;
+                for (int column = left; column < right; column++, source++, destination++) {
+                    if (*source >> 24) {
+                        *destination = *source;
+                    }
+                }
+            }
+        }
+
+        // Uploaded right away once the texture exists, queued before that; a queued
+        // texture is updated in place so it keeps its turn while the costume animates
+        auto& textures = TextureCache::getInstance();
+        if (!textures.updateRows(m_textureKey, 0, m_canvasHeight, m_canvas.data()) &&
+            !textures.updatePending(m_textureKey, m_canvasWidth, m_canvasHeight, m_canvas.data())) {
+            textures.submit(m_textureKey, m_canvasWidth, m_canvasHeight, m_canvas);
+        }
+        m_dirty = false;
+    }
+
+    void CostumeView::drawToolbar() {
+        if (ImGui::Button(m_playing ? ICON_MS_PAUSE "##playCostume" : ICON_MS_PLAY_ARROW "##playCostume")) {
+            m_playing = !m_playing;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button(ICON_MS_SKIP_NEXT "##stepCostume")) {
+            m_playing = false;
+            m_player.step();
+            m_dirty = true;
+        }
+        ImGui::SameLine();
+
+        const int last = std::max(static_cast<int>(m_costume.getAnimationCount()) - 1, 0);
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 12.0f);
+        if (ImGui::SliderInt("##animation", &m_animation, 0, last, "Animation %d")) {
+            startAnimation();
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+        ImGui::SliderInt("##fps", &m_fps, 1, 60, "%d fps");
+
+        const CostumeFrameCache::Stats stats = m_frames.getStats();
+        const bool akos = m_costume.getFormat() == Costume::Format::Akos;
+        ImGui::TextDisabled("%s codec %u, %zu colors, %zu animations  |  %zu frames cached, %.1f of %.0f MB, %llu hits, "
+                            "%llu misses%s",
+                            akos ? "AKOS" : "COST", static_cast<unsigned>(m_costume.getCodec()),
+                            m_costume.getColorCount(), m_costume.getAnimationCount(), stats.frames,
+                            stats.bytes / (1024.0 * 1024.0), stats.budget / (1024.0 * 1024.0),
+                            (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+                            m_player.hasUnsupported() ? "  |  unsupported sequence commands" : "");
+    }
+
+    void CostumeView::drawCostumeList() {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_costumes.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const Entry& entry = m_costumes[row];
+                char label[64];
+                std::snprintf(label, sizeof(label), ICON_MS_ACCESSIBILITY_NEW " %s %d (room %u)##%d",
+                              entry.block.tag == tags::AKOS ? "AKOS" : "COST", row,
+                              static_cast<unsigned>(entry.roomNumber), row);
+                if (ImGui::Selectable(label, static_cast<size_t>(row) == m_selected)) {
+                    select(static_cast<size_t>(row));
+                }
+            }
+        }
+        clipper.End();
+    }
+
+    void CostumeView::drawCanvas() {
+        TextureCache::Texture texture;
+        if (!TextureCache::getInstance().get(m_textureKey, texture)) {
+            ImGui::TextDisabled(ICON_MS_HOURGLASS_EMPTY " Uploading...");
+            return;
+        }
+
+        // Whole-number scales keep the pixels square
+        const ImVec2 available = ImGui::GetContentRegionAvail();
+        float scale = std::min(available.x / texture.width, available.y / texture.height);
+        scale = scale >= 1.0f ? std::floor(scale) : std::max(scale, 0.1f);
+
+        const ImVec2 size(texture.width * scale, texture.height * scale);
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + std::max(0.0f, (available.x - size.x) * 0.5f));
+        ImGui::Image(texture.id, size);
+    }
+
+} // namespace scummredux
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "View.h"
+#include "../core/TextureCache.h"
+#include "../scumm/Costume.h"
+#include "../scumm/CostumeFrameCache.h"
+#include "../scumm/Palette.h"
+#include "../scumm/ResourceFile.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Plays the animations of every COST/AKOS costume of the open game. Limb frames
+    // come from a per-costume CostumeFrameCache (decoded once, bounded memory) and
+    // are composed into one canvas texture that is re-uploaded on every step.
+    class CostumeView : public View {
+    public:
+        CostumeView();
+        ~CostumeView() override;
+
+        void draw() override;
+
+    private:
+        struct Entry {
+            ResourceFile* file = nullptr;
+            Chunk block;                    // COST or AKOS
+            Chunk room;                     // LFLF the costume ships in, for its palette
+            uint16_t roomNumber = 0;
+        };
+
+        // Runs every frame: follows the open game, steps the animation
+        void update();
+        void reload();
+        void select(size_t index);
+        void startAnimation();
+        void compose();
+
+        void drawToolbar();
+        void drawCostumeList();
+        void drawCanvas();
+
+        std::vector<Entry> m_costumes;
+        uint32_t m_generation = 0;
+        size_t m_selected = NO_COSTUME;
+        size_t m_frameHandle = 0;
+
+        Costume m_costume;
+        bool m_loaded = false;
+        std::string m_error;
+        Palette m_palette;
+        uint32_t m_paletteId = 0;
+
+        CostumePlayer m_player;
+        CostumeFrameCache m_frames;
+        int m_animation = 0;
+        bool m_playing = true;
+        int m_fps = 10;
+        double m_pendingSteps = 0.0;
+        std::chrono::steady_clock::time_point m_lastUpdate = std::chrono::steady_clock::now();
+
+        // Canvas sized to the animation's bounds; the actor's origin is at m_originX/Y
+        uint16_t m_canvasWidth = 0;
+        uint16_t m_canvasHeight = 0;
+        int m_originX = 0;
+        int m_originY = 0;
+        std::vector<uint32_t> m_canvas;
+        TextureCache::Key m_textureKey = 0;
+        uint32_t m_textureSerial = 0;
+        bool m_dirty = false;
+
+        static constexpr size_t NO_COSTUME = SIZE_MAX;
+        static constexpr int CANVAS_MARGIN = 4;
+        static constexpr int MAX_CANVAS = 512;
+        static constexpr int MAX_STEPS_PER_FRAME = 4;
+        // Keys with the top bit set cannot collide with RoomView's (generation << 32 | room)
+        static constexpr TextureCache::Key TEXTURE_KEY_BIT = 1ull << 63;
+    };
+
+} // namespace scummredux
@@ -1,12 +1,55 @@
 #include "EditorView.h"
+#include "ConsoleView.h"
 #include "../res/icons/MaterialSymbols.h"
 #include "../core/Settings.h"
+#include "../scumm/GameManager.h"
+#include "../scumm/ScriptAssembler.h"
+#include "../scumm/ScriptDecompiler.h"
+#include "../utils/Events.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
 namespace scummredux {
 
+    namespace {
+        bool isWithin(const std::string& path, const std::string& directory) {
+            return path.size() > directory.size() && path.starts_with(directory) &&
+                   (path[directory.size()] == '/' || path[directory.size()] == '\\');
+        }
+
+        // Lets InputTextMultiline grow a std::string
+        int resizeText(ImGuiInputTextCallbackData* data) {
+            if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+                auto* text = static_cast<std::string*>(data->UserData);
+                text->resize(static_cast<size_t>(data->BufTextLen));
+                data->Buf = text->data();
+            }
+            return 0;
+        }
+
+        // Tabs are keyed by a pseudo path, so opening the same block again switches to it
+        std::string getScriptPath(size_t file, uint32_t offset) {
+            char path[64];
+            std::snprintf(path, sizeof(path), "game:%zu:%08X", file, offset);
+            return path;
+        }
+
+        std::string getScriptName(const BlockIndex::Record& block) {
+            char name[48];
+            if (block.room != 0) {
+                std::snprintf(name, sizeof(name), "%s %08X (room %u)", tagToString(block.tag).c_str(), block.offset, block.room);
+            } else {
+                std::snprintf(name, sizeof(name), "%s %08X", tagToString(block.tag).c_str(), block.offset);
+            }
+            return name;
+        }
+    }
+
     EditorView::EditorView() : View("Editor") {
         std::cout << "EditorView constructor called" << std::endl;
 
@@ -34,22 +77,44 @@ namespace scummredux {
 
         m_currentFileName = "main.cpp";
         m_totalLines = std::count(m_content.begin(), m_content.end(), '\n') + 1;
+
+        m_filesChangedHandle = EventFilesChanged::subscribe([this](const FilesChangedEvent& event) {
+            onFilesChanged(event.changes);
+        });
+        m_frameHandle = EventFrameBegin::subscribe([this](const FrameBeginEvent&) {
+            streamListings();
+        });
+        m_gameSavedHandle = EventGameSaved::subscribe([this](const GameSavedEvent& event) {
+            onGameSaved(event.saved);
+        });
+    }
+
+    EditorView::~EditorView() {
+        EventFilesChanged::unsubscribe(m_filesChangedHandle);
+        EventFrameBegin::unsubscribe(m_frameHandle);
+        EventGameSaved::unsubscribe(m_gameSavedHandle);
     }
 
     void EditorView::draw() {
-        std::cout << "EditorView::draw() start" << std::endl;
+        verboseOut() << "EditorView::draw() start" << std::endl;
 
         try {
             if (ImGui::Begin(getWindowName().c_str(), &getWindowOpenState())) {
-                std::cout << "EditorView window created successfully" << std::endl;
-
-                // MINIMAL VERSION - just text for now
-                ImGui::Text("Editor View - Coming Soon!");
-                ImGui::Text("File: %s", m_currentFileName.c_str());
+                verboseOut() << "EditorView window created successfully" << std::endl;
+
+                drawTabBar();
+                const bool hasTab = m_activeTabIndex >= 0 && static_cast<size_t>(m_activeTabIndex) < m_tabs.size();
+                if (hasTab && m_tabs[m_activeTabIndex].listing) {
+                    drawListing(*m_tabs[m_activeTabIndex].listing);
+                } else {
+                    // MINIMAL VERSION - just text for now
+                    ImGui::Text("Editor View - Coming Soon!");
+                    ImGui::Text("File: %s", m_currentFileName.c_str());
+                }
 
-                std::cout << "EditorView content drawn successfully" << std::endl;
+                verboseOut() << "EditorView content drawn successfully" << std::endl;
             } else {
-                std::cout << "EditorView window failed to create" << std::endl;
+                verboseOut() << "EditorView window failed to create" << std::endl;
             }
             ImGui::End();
         } catch (const std::exception& e) {
@@ -58,7 +123,7 @@ namespace scummredux {
             std::cout << "Unknown exception in EditorView::draw()" << std::endl;
         }
 
-        std::cout << "EditorView::draw() end" << std::endl;
+        verboseOut() << "EditorView::draw() end" << std::endl;
     }
 
     void EditorView::drawToolbar() {
@@ -305,11 +370,7 @@ namespace scummredux {
         // Check if file is already open
         for (size_t i = 0; i < m_tabs.size(); i++) {
             if (m_tabs[i].path == filePath) {
-                m_activeTabIndex = i;
-                m_content = m_tabs[i].content;
-                m_currentFileName = m_tabs[i].name;
-                m_currentFilePath = m_tabs[i].path;
-                m_hasUnsavedChanges = m_tabs[i].hasUnsavedChanges;
+                activateTab(i);
                 return;
             }
         }
@@ -328,6 +389,9 @@ namespace scummredux {
             tab.hasUnsavedChanges = false;
             tab.isActive = true;
 
+            std::error_code ec;
+            tab.diskTime = std::filesystem::last_write_time(filePath, ec);
+
             m_tabs.push_back(tab);
             m_activeTabIndex = m_tabs.size() - 1;
 
@@ -340,7 +404,380 @@ namespace scummredux {
         }
     }
 
+    void EditorView::activateTab(size_t index) {
+        const EditorTab& tab = m_tabs[index];
+        m_activeTabIndex = static_cast<int>(index);
+        m_content = tab.content;
+        m_currentFileName = tab.name;
+        m_currentFilePath = tab.path;
+        m_hasUnsavedChanges = tab.hasUnsavedChanges;
+    }
+
+    void EditorView::openScript(size_t file, uint32_t record, uint32_t offset) {
+        auto& game = GameManager::getInstance();
+        if (!game.isOpen() || file >= game.getFileCount() || record >= game.getBlockIndex(file).size()) {
+            return;
+        }
+        const BlockIndex::Record& block = game.getBlockIndex(file).get(record);
+
+        const std::string path = getScriptPath(file, block.offset);
+        for (size_t i = 0; i < m_tabs.size(); i++) {
+            if (m_tabs[i].path == path) {
+                if (m_tabs[i].listing) {
+                    m_tabs[i].listing->pendingOffset = offset;
+                }
+                activateTab(i);
+                return;
+            }
+        }
+
+        // The listing keeps its own copy, so it outlives the game
+        auto listing = std::make_shared<ScriptListing>();
+        const std::span<const uint8_t> bytes = game.readBlock(file, record);
+        std::string error = "block is out of range";
+        if (bytes.empty() || !loadListing(*listing, game.getScriptVersion(), bytes, error)) {
+            ConsoleView::error("Cannot disassemble " + tagToString(block.tag) + ": " + error);
+            return;
+        }
+        listing->blockOffset = block.offset;
+        listing->pendingOffset = offset;
+        listing->file = file;
+        listing->filePath = game.getFile(file).getPath();
+
+        EditorTab tab;
+        tab.path = path;
+        tab.name = getScriptName(block);
+        tab.isActive = true;
+        tab.listing = std::move(listing);
+        m_tabs.push_back(std::move(tab));
+        activateTab(m_tabs.size() - 1);
+    }
+
+    bool EditorView::loadListing(ScriptListing& listing, ScriptVersion version, std::span<const uint8_t> block, std::string& error) {
+        if (!listing.disassembler.load(version, block, error)) {
+            return false;
+        }
+        listing.document.clear();
+        listing.source.clear();
+        listing.sourceLines.reset();
+        listing.sourceStreamed = 0;
+        listing.sourceRequested = false;
+        listing.generation++;
+        listing.document.setComplete(false);
+        appendLines(listing, FIRST_PAGE_LINES);
+        return true;
+    }
+
+    void EditorView::appendLines(ScriptListing& listing, size_t maxLines) {
+        m_lineBuffer.clear();
+        const bool more = listing.disassembler.next(maxLines, m_lineBuffer);
+        for (const ScriptDisassembler::Line& line : m_lineBuffer) {
+            listing.document.appendLine(line.text, line.offset);
+        }
+        listing.document.setComplete(!more);
+    }
+
+    void EditorView::appendSourceLines(ScriptListing& listing, size_t maxLines) {
+        if (!listing.sourceLines) {
+            return;
+        }
+        const std::vector<ScriptDecompiler::Line>& lines = *listing.sourceLines;
+        const size_t end = std::min(lines.size(), listing.sourceStreamed + maxLines);
+        for (; listing.sourceStreamed < end; listing.sourceStreamed++) {
+            listing.source.appendLine(lines[listing.sourceStreamed].text, lines[listing.sourceStreamed].offset);
+        }
+        if (listing.sourceStreamed == lines.size()) {
+            listing.source.setComplete(true);
+            listing.sourceLines.reset();
+        }
+    }
+
+    void EditorView::streamListings() {
+        // A chunk at a time until the frame's budget is spent, the active tab first
+        const auto start = std::chrono::steady_clock::now();
+        auto withinBudget = [&start] {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() < STREAM_BUDGET_MS;
+        };
+        auto stream = [&](EditorTab& tab) {
+            while (tab.listing && !tab.listing->document.isComplete() && withinBudget()) {
+                appendLines(*tab.listing, STREAM_CHUNK_LINES);
+            }
+            while (tab.listing && tab.listing->sourceLines && withinBudget()) {
+                appendSourceLines(*tab.listing, STREAM_CHUNK_LINES);
+            }
+        };
+
+        if (m_activeTabIndex >= 0 && static_cast<size_t>(m_activeTabIndex) < m_tabs.size()) {
+            stream(m_tabs[m_activeTabIndex]);
+        }
+        for (EditorTab& tab : m_tabs) {
+            stream(tab);
+        }
+    }
+
+    void EditorView::showSource(ScriptListing& listing, bool source) {
+        if (listing.showSource == source) {
+            return;
+        }
+        if (source && !listing.sourceRequested) {
+            // Decompiled by a job unless cached; the lines stream in like the disassembly
+            listing.sourceRequested = true;
+            listing.source.setComplete(false);
+            const std::weak_ptr<ScriptListing> target = listing.weak_from_this();
+            const uint32_t generation = listing.generation;
+            GameManager::getInstance().decompileScript(listing.disassembler, [target, generation](ScriptPipeline::Listing lines) {
+                const auto current = target.lock();
+                if (current && current->generation == generation) {
+                    current->sourceLines = std::move(lines);
+                }
+            });
+            appendSourceLines(listing, FIRST_PAGE_LINES);
+        }
+
+        // Both views carry block offsets, so the selection follows the code across once
+        // its line is listed there
+        const TextDocument& from = source ? listing.document : listing.source;
+        if (listing.selectedLine >= 0 && static_cast<size_t>(listing.selectedLine) < from.getLineCount()) {
+            listing.pendingOffset = from.getLineOffset(listing.selectedLine);
+            listing.selectedLine = -1;
+        }
+        listing.showSource = source;
+    }
+
+    void EditorView::drawListing(ScriptListing& listing) {
+        const ScriptDisassembler& disassembler = listing.disassembler;
+
+        ImGui::Text(ICON_MS_CODE " %s, v%d bytecode", tagToString(disassembler.getTag()).c_str(),
+                    static_cast<int>(disassembler.getVersion()));
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Disassembly", !listing.showSource)) {
+            showSource(listing, false);
+        }
+        ImGui::SameLine();
+        ImGui::BeginDisabled(listing.editing);
+        if (ImGui::RadioButton("Source", listing.showSource)) {
+            showSource(listing, true);
+        }
+        ImGui::EndDisabled();
+
+        TextDocument& document = listing.showSource ? listing.source : listing.document;
+        ImGui::SameLine();
+        ImGui::TextDisabled("%zu lines", document.getLineCount());
+        if (!document.isComplete()) {
+            ImGui::SameLine();
+            if (!listing.showSource) {
+                ImGui::ProgressBar(disassembler.getProgress(), ImVec2(160.0f, 0.0f), "Disassembling");
+            } else {
+                // Empty until the decompile job hands its lines over
+                const float progress = listing.sourceLines && !listing.sourceLines->empty()
+                                           ? float(listing.sourceStreamed) / float(listing.sourceLines->size()) : 0.0f;
+                ImGui::ProgressBar(progress, ImVec2(160.0f, 0.0f), "Decompiling");
+            }
+        }
+
+        // An offset from openScript() or showSource() is selected once the line after it is listed
+        const size_t lineCount = document.getLineCount();
+        if (listing.pendingOffset != TextDocument::NO_OFFSET &&
+            (document.isComplete() || (lineCount > 0 && document.getLineOffset(lineCount - 1) > listing.pendingOffset))) {
+            const size_t line = document.findLine(listing.pendingOffset);
+            if (line != TextDocument::NO_LINE) {
+                listing.selectedLine = static_cast<int>(line);
+                listing.scrollToSelected = true;
+            }
+            listing.pendingOffset = TextDocument::NO_OFFSET;
+        }
+
+        // Jump to the instruction containing a block offset
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::CalcTextSize("00000000").x + ImGui::GetStyle().FramePadding.x * 2.0f);
+        if (ImGui::InputTextWithHint("##gotoOffset", "Offset", m_gotoOffset, sizeof(m_gotoOffset),
+                                     ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue)) {
+            const size_t line = document.findLine(static_cast<uint32_t>(std::strtoul(m_gotoOffset, nullptr, 16)));
+            if (line != TextDocument::NO_LINE) {
+                listing.selectedLine = static_cast<int>(line);
+                listing.scrollToSelected = true;
+            }
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Go to block offset (hex)");
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button(listing.editing ? ICON_MS_EDIT_OFF " Discard" : ICON_MS_EDIT " Edit")) {
+            editListing(listing, !listing.editing);
+        }
+        if (listing.editing) {
+            ImGui::SameLine();
+            if (ImGui::Button(ICON_MS_BUILD " Assemble")) {
+                applyListing(static_cast<size_t>(m_activeTabIndex));
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Assemble the listing into the game's unsaved edits (Ctrl+S also saves the game)");
+            }
+        }
+        ImGui::Separator();
+
+        const float statusBarHeight = ImGui::GetFrameHeightWithSpacing();
+        if (listing.editing) {
+            // Same text as the listing: the offsets in front are labels the jumps follow
+            ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.12f, 0.12f, 0.15f, 1.0f));
+            if (ImGui::InputTextMultiline("##script", listing.editText.data(), listing.editText.capacity() + 1,
+                                          ImVec2(-FLT_MIN, -statusBarHeight),
+                                          ImGuiInputTextFlags_AllowTabInput | ImGuiInputTextFlags_CallbackResize, resizeText,
+                                          &listing.editText)) {
+                m_hasUnsavedChanges = true;
+                if (m_activeTabIndex >= 0 && static_cast<size_t>(m_activeTabIndex) < m_tabs.size()) {
+                    m_tabs[m_activeTabIndex].hasUnsavedChanges = true;
+                }
+            }
+            ImGui::PopStyleColor();
+            if (ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows) && ImGui::GetIO().KeyCtrl &&
+                ImGui::IsKeyPressed(ImGuiKey_S, false)) {
+                saveCurrentFile();
+            }
+
+            if (!listing.editError.empty()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), ICON_MS_ERROR " %s", listing.editError.c_str());
+            } else {
+                ImGui::TextDisabled("Editing; lines without an offset are new, jumps follow the offsets they name");
+            }
+            return;
+        }
+
+        ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.12f, 0.12f, 0.15f, 1.0f));
+        if (ImGui::BeginChild("Listing", ImVec2(0, -statusBarHeight), true, ImGuiWindowFlags_HorizontalScrollbar)) {
+            const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+            if (listing.scrollToSelected) {
+                ImGui::SetScrollY(std::max(0.0f, listing.selectedLine * rowHeight - ImGui::GetContentRegionAvail().y * 0.5f));
+                listing.scrollToSelected = false;
+            }
+
+            std::string label;
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(document.getLineCount()), rowHeight);
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                    const std::string_view line = document.getLine(static_cast<size_t>(row));
+                    label.assign(line);
+                    label += "##";
+                    label += std::to_string(row);
+                    if (ImGui::Selectable(label.c_str(), row == listing.selectedLine)) {
+                        listing.selectedLine = row;
+                    }
+                }
+            }
+            clipper.End();
+        }
+        ImGui::EndChild();
+        ImGui::PopStyleColor();
+
+        // Where the selected line came from
+        if (listing.selectedLine >= 0 && static_cast<size_t>(listing.selectedLine) < document.getLineCount()) {
+            const uint32_t offset = document.getLineOffset(listing.selectedLine);
+            m_cursorLine = listing.selectedLine + 1;
+            ImGui::TextDisabled("Line %d  |  block offset 0x%04X  |  file offset 0x%08X", m_cursorLine, offset,
+                                listing.blockOffset + offset);
+        } else {
+            ImGui::TextDisabled("Select a line to see its offset, or edit the listing to change the script");
+        }
+    }
+
+    void EditorView::editListing(ScriptListing& listing, bool editing) {
+        if (editing) {
+            // The whole listing, so nothing is left out of what gets assembled
+            while (!listing.document.isComplete()) {
+                appendLines(listing, STREAM_CHUNK_LINES);
+            }
+            showSource(listing, false);
+            listing.editText = listing.document.getText();
+        } else {
+            listing.editText.clear();
+            m_hasUnsavedChanges = false;
+            if (m_activeTabIndex >= 0 && static_cast<size_t>(m_activeTabIndex) < m_tabs.size()) {
+                m_tabs[m_activeTabIndex].hasUnsavedChanges = false;
+            }
+        }
+        listing.editError.clear();
+        listing.editing = editing;
+    }
+
+    bool EditorView::applyListing(size_t index) {
+        EditorTab& tab = m_tabs[index];
+        ScriptListing& listing = *tab.listing;
+        if (!listing.editing) {
+            return true;
+        }
+
+        const ScriptDisassembler& disassembler = listing.disassembler;
+        ScriptAssembler assembler;
+        std::vector<uint8_t> block;
+        std::string error;
+        if (!assembler.assemble(disassembler.getVersion(), disassembler.getTag(), listing.editText, block, error)) {
+            listing.editError = error;
+            ConsoleView::error("Cannot assemble " + tab.name + ", " + error);
+            return false;
+        }
+
+        // Only over the bytes the listing was made from, edits included
+        auto& game = GameManager::getInstance();
+        const bool sameFile = game.isOpen() && listing.file < game.getFileCount() &&
+                              game.getFile(listing.file).getPath() == listing.filePath;
+        const uint32_t record = sameFile ? game.getBlockIndex(listing.file).findByOffset(listing.blockOffset) : BlockIndex::INVALID_INDEX;
+        const std::span<const uint8_t> original = disassembler.getBlock();
+        const std::span<const uint8_t> current = record != BlockIndex::INVALID_INDEX ? game.readBlock(listing.file, record)
+                                                                                     : std::span<const uint8_t>();
+        if (record == BlockIndex::INVALID_INDEX || !std::equal(current.begin(), current.end(), original.begin(), original.end())) {
+            listing.editError = "The block is no longer in the open game as it was listed; reopen it to edit";
+            ConsoleView::error("Cannot assemble " + tab.name + ": the block changed or the game was closed");
+            return false;
+        }
+        if (!game.editBlock(listing.file, record, block, error)) {
+            listing.editError = error;
+            ConsoleView::error("Cannot edit " + tab.name + ": " + error);
+            return false;
+        }
+
+        // List what the game holds now; the title bar shows it is unsaved
+        if (!loadListing(listing, disassembler.getVersion(), block, error)) {
+            ConsoleView::error("Cannot disassemble " + tab.name + ": " + error);
+        }
+        listing.editing = false;
+        listing.editText.clear();
+        listing.editError.clear();
+        tab.hasUnsavedChanges = false;
+        if (static_cast<size_t>(m_activeTabIndex) == index) {
+            m_hasUnsavedChanges = false;
+        }
+        return true;
+    }
+
+    void EditorView::onGameSaved(const ResourceOverlay& saved) {
+        // Script tabs follow their blocks to where the save moved them
+        auto& game = GameManager::getInstance();
+        for (EditorTab& tab : m_tabs) {
+            if (!tab.listing || tab.listing->file >= game.getFileCount() ||
+                game.getFile(tab.listing->file).getPath() != tab.listing->filePath) {
+                continue;
+            }
+            ScriptListing& listing = *tab.listing;
+            listing.blockOffset = saved.relocate(listing.file, listing.blockOffset);
+            tab.path = getScriptPath(listing.file, listing.blockOffset);
+            const uint32_t record = game.getBlockIndex(listing.file).findByOffset(listing.blockOffset);
+            if (record != BlockIndex::INVALID_INDEX) {
+                tab.name = getScriptName(game.getBlockIndex(listing.file).get(record));
+            }
+        }
+        syncActiveTab();
+    }
+
     void EditorView::saveCurrentFile() {
+        if (m_activeTabIndex >= 0 && static_cast<size_t>(m_activeTabIndex) < m_tabs.size() && m_tabs[m_activeTabIndex].listing) {
+            // Scripts are saved with the rest of the game's edits
+            if (applyListing(static_cast<size_t>(m_activeTabIndex))) {
+                GameManager::getInstance().save();
+            }
+            return;
+        }
         if (m_currentFilePath.empty()) {
             // TODO: Show save dialog
             return;
@@ -349,11 +786,14 @@ namespace scummredux {
         std::ofstream file(m_currentFilePath);
         if (file.is_open()) {
             file << m_content;
+            file.close();
             m_hasUnsavedChanges = false;
 
-            // Update tab state
+            // Update tab state (remember the write time so the watcher echo is ignored)
             if (m_activeTabIndex >= 0 && static_cast<size_t>(m_activeTabIndex) < m_tabs.size()) {
+                std::error_code ec;
                 m_tabs[m_activeTabIndex].hasUnsavedChanges = false;
+                m_tabs[m_activeTabIndex].diskTime = std::filesystem::last_write_time(m_currentFilePath, ec);
             }
         }
     }
@@ -380,4 +820,102 @@ namespace scummredux {
         }
     }
 
+    void EditorView::onFilesChanged(const std::vector<FileChange>& changes) {
+        if (m_tabs.empty()) {
+            return;
+        }
+
+        auto markDeleted = [](EditorTab& tab) {
+            if (!tab.hasUnsavedChanges) {
+                tab.hasUnsavedChanges = true;
+                ConsoleView::warning(tab.name + " was deleted on disk; save to keep it");
+            }
+        };
+
+        for (const auto& change : changes) {
+            const std::string path = change.path.string();
+
+            switch (change.type) {
+                case FileChange::Type::Renamed: {
+                    // Follow the file (or a parent directory) to its new location
+                    const std::string from = change.oldPath.string();
+                    for (auto& tab : m_tabs) {
+                        if (tab.path == from || isWithin(tab.path, from)) {
+                            tab.path = path + tab.path.substr(from.size());
+                            tab.name = std::filesystem::path(tab.path).filename().string();
+                        }
+                    }
+                    break;
+                }
+                case FileChange::Type::Deleted:
+                    for (auto& tab : m_tabs) {
+                        if (tab.path == path || isWithin(tab.path, path)) {
+                            markDeleted(tab);
+                        }
+                    }
+                    break;
+                case FileChange::Type::Created:
+                case FileChange::Type::Modified:
+                    for (size_t i = 0; i < m_tabs.size(); i++) {
+                        if (m_tabs[i].path == path) {
+                            reloadTab(i);
+                        }
+                    }
+                    break;
+                case FileChange::Type::Rescan:
+                case FileChange::Type::Overflow:
+                    // Individual events were dropped, so check every tab below the directory
+                    for (size_t i = 0; i < m_tabs.size(); i++) {
+                        if (isWithin(m_tabs[i].path, path) && !reloadTab(i)) {
+                            markDeleted(m_tabs[i]);
+                        }
+                    }
+                    break;
+            }
+        }
+
+        syncActiveTab();
+    }
+
+    bool EditorView::reloadTab(size_t index) {
+        EditorTab& tab = m_tabs[index];
+
+        std::error_code ec;
+        const auto diskTime = std::filesystem::last_write_time(tab.path, ec);
+        if (ec) {
+            return false;
+        }
+        if (diskTime == tab.diskTime) {
+            return true;    // Our own save, or nothing changed
+        }
+        tab.diskTime = diskTime;
+
+        if (tab.hasUnsavedChanges) {
+            ConsoleView::warning(tab.name + " changed on disk; keeping the unsaved edits");
+            return true;
+        }
+
+        std::ifstream file(tab.path);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        tab.content = buffer.str();
+        return true;
+    }
+
+    void EditorView::syncActiveTab() {
+        if (m_activeTabIndex < 0 || static_cast<size_t>(m_activeTabIndex) >= m_tabs.size()) {
+            return;
+        }
+
+        const EditorTab& tab = m_tabs[m_activeTabIndex];
+        m_content = tab.content;
+        m_currentFileName = tab.name;
+        m_currentFilePath = tab.path;
+        m_hasUnsavedChanges = tab.hasUnsavedChanges;
+        m_totalLines = std::count(m_content.begin(), m_content.end(), '\n') + 1;
+    }
+
 } // namespace scummredux
\ No newline at end of file
@@ -1,15 +1,25 @@
 #pragma once
 
 #include "View.h"
+#include "../core/FileWatcher.h"
+#include "../core/TextDocument.h"
+#include "../scumm/ScriptDisassembler.h"
+#include "../scumm/ScriptPipeline.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace scummredux {
 
+    class ResourceOverlay;
+
     class EditorView : public View {
     public:
         EditorView();
-        ~EditorView() override = default;
+        ~EditorView() override;
 
         void draw() override;
 
@@ -18,6 +28,12 @@ namespace scummredux {
         void saveCurrentFile();
         void closeCurrentFile();
 
+        // Opens a script block of the loaded game (SCRP, LSCR, ENCD, EXCD, VERB) as a
+        // listing; the first page is there at once, the rest streams in. A block offset
+        // selects its instruction once it has streamed in. Edited listings are
+        // assembled into the game's unsaved edits; saveCurrentFile() saves the game.
+        void openScript(size_t file, uint32_t record, uint32_t offset = TextDocument::NO_OFFSET);
+
         // Editor state
         bool hasUnsavedChanges() const { return m_hasUnsavedChanges; }
         std::string getCurrentFileName() const { return m_currentFileName; }
@@ -28,6 +44,47 @@ namespace scummredux {
         void drawStatusBar();
         void drawTabBar();
 
+        // Disassembly listing of a script block
+        struct ScriptListing : std::enable_shared_from_this<ScriptListing> {
+            ScriptDisassembler disassembler;
+            TextDocument document;          // Line offsets are relative to the block
+            TextDocument source;            // Decompiled, requested when first shown
+            ScriptPipeline::Listing sourceLines;    // Decompiled, still streaming into source
+            size_t sourceStreamed = 0;
+            bool sourceRequested = false;
+            uint32_t generation = 0;        // Bumped by loadListing(): older sources are dropped
+            uint32_t blockOffset = 0;       // File offset of the block
+            int selectedLine = -1;
+            bool scrollToSelected = false;
+            bool showSource = false;
+            uint32_t pendingOffset = TextDocument::NO_OFFSET;     // To select, see openScript()
+
+            // Where the block lives, to write it back
+            size_t file = 0;
+            std::filesystem::path filePath;
+
+            // Edited disassembly, and why it did not assemble
+            bool editing = false;
+            std::string editText;
+            std::string editError;
+        };
+
+        void drawListing(ScriptListing& listing);
+        void appendLines(ScriptListing& listing, size_t maxLines);
+        void appendSourceLines(ScriptListing& listing, size_t maxLines);
+        void showSource(ScriptListing& listing, bool source);
+        void streamListings();
+        void editListing(ScriptListing& listing, bool editing);
+        bool applyListing(size_t index);
+        void onGameSaved(const ResourceOverlay& saved);
+        bool loadListing(ScriptListing& listing, ScriptVersion version, std::span<const uint8_t> block, std::string& error);
+        void activateTab(size_t index);
+
+        // Keeps open tabs in sync with files renamed, deleted or rewritten on disk
+        void onFilesChanged(const std::vector<FileChange>& changes);
+        bool reloadTab(size_t index);
+        void syncActiveTab();
+
         // Editor content
         std::string m_content;
         std::string m_currentFileName;
@@ -47,8 +104,10 @@ namespace scummredux {
             std::string content;
             bool hasUnsavedChanges = false;
             bool isActive = false;
+            std::filesystem::file_time_type diskTime;   // Last write time we loaded or saved
+            std::shared_ptr<ScriptListing> listing;     // Script tabs only
         };
-        
+
         std::vector<EditorTab> m_tabs;
         int m_activeTabIndex = -1;
 
@@ -57,6 +116,18 @@ namespace scummredux {
         int m_cursorLine = 1;
         int m_cursorColumn = 1;
         int m_totalLines = 1;
+
+        size_t m_filesChangedHandle = 0;
+        size_t m_gameSavedHandle = 0;
+        size_t m_frameHandle = 0;
+
+        // Listing streaming
+        std::vector<ScriptDisassembler::Line> m_lineBuffer;
+        char m_gotoOffset[16] = {};
+
+        static constexpr size_t FIRST_PAGE_LINES = 256;
+        static constexpr size_t STREAM_CHUNK_LINES = 512;
+        static constexpr double STREAM_BUDGET_MS = 2.0;
     };
 
 } // namespace scummredux
\ No newline at end of file
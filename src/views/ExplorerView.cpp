@@ -1,78 +1,402 @@
 #include "ExplorerView.h"
+#include "EditorView.h"
+#include "ConsoleView.h"
+#include "ViewManager.h"
+#include "../core/Settings.h"
+#include "../scumm/GameManager.h"
+#include "../ui/FontManager.h"
+#include "../utils/Events.hpp"
 #include "../res/icons/MaterialSymbols.h"
-#include <functional>
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 
 namespace scummredux {
 
     ExplorerView::ExplorerView() : View("Explorer") {
-        std::cout << "ExplorerView minimal constructor" << std::endl;
+        // Reopen the last project
+        const std::string projectRoot = Settings::getInstance().get<std::string>(Settings::App::PROJECT_ROOT, "");
+        if (!projectRoot.empty() && std::filesystem::is_directory(projectRoot)) {
+            m_tree.open(projectRoot);
+            m_watcher.start(projectRoot);
+        }
 
-        // Initialize with minimal data to avoid crashes
-        m_projectFiles = {};
-        m_selectedFile = "";
-        m_showHiddenFiles = false;
+        m_frameHandle = EventFrameBegin::subscribe([this](const FrameBeginEvent&) {
+            update();
+        });
     }
 
-    void ExplorerView::draw() {
-        std::cout << "ExplorerView::draw() start" << std::endl;
+    ExplorerView::~ExplorerView() {
+        EventFrameBegin::unsubscribe(m_frameHandle);
+    }
 
+    void ExplorerView::draw() {
         try {
             if (ImGui::Begin(getWindowName().c_str(), &getWindowOpenState())) {
-                std::cout << "ExplorerView window created successfully" << std::endl;
-
-                // MINIMAL VERSION - just text for now to avoid crashes
-                ImGui::Text(ICON_MS_FOLDER " SCUMM Redux Project");
+                drawToolbar();
                 ImGui::Separator();
 
-                // Simple buttons without functionality
-                if (ImGui::Button(ICON_MS_REFRESH "##refresh")) {
-                    std::cout << "Refresh clicked" << std::endl;
+                if (GameManager::getInstance().isOpen()) {
+                    if (ImGui::BeginTabBar("##explorerTabs")) {
+                        if (ImGui::BeginTabItem(ICON_MS_FOLDER " Files")) {
+                            drawFileTree();
+                            ImGui::EndTabItem();
+                        }
+                        if (ImGui::BeginTabItem(ICON_MS_DATABASE " Resources")) {
+                            drawResourceTree();
+                            ImGui::EndTabItem();
+                        }
+                        ImGui::EndTabBar();
+                    }
+                } else {
+                    drawFileTree();
                 }
-                ImGui::SameLine();
+            }
+            ImGui::End();
+        } catch (const std::exception& e) {
+            std::cout << "Exception in ExplorerView::draw(): " << e.what() << std::endl;
+        } catch (...) {
+            std::cout << "Unknown exception in ExplorerView::draw()" << std::endl;
+        }
+    }
 
-                if (ImGui::Button(ICON_MS_CREATE_NEW_FOLDER "##newfolder")) {
-                    std::cout << "New folder clicked" << std::endl;
-                }
-                ImGui::SameLine();
+    void ExplorerView::drawAlwaysVisibleContent() {
+        m_quickOpen.draw();
+    }
 
-                if (ImGui::Button(ICON_MS_NOTE_ADD "##newfile")) {
-                    std::cout << "New file clicked" << std::endl;
-                }
-                ImGui::SameLine();
+    void ExplorerView::openProject(const std::string& path) {
+        std::error_code ec;
+        const auto root = std::filesystem::absolute(path, ec);
+        if (ec || !std::filesystem::is_directory(root, ec)) {
+            ConsoleView::error("Not a directory: " + path);
+            return;
+        }
 
-                ImGui::Checkbox("Hidden", &m_showHiddenFiles);
+        m_tree.open(root);
+        m_watcher.start(root);
+        resetViewState();
 
-                ImGui::Separator();
+        Settings::getInstance().set(Settings::App::PROJECT_ROOT, root.string());
+        ConsoleView::info("Opened project: " + root.string());
+    }
+
+    void ExplorerView::refresh() {
+        m_tree.rescan();
+        if (m_tree.isOpen()) {
+            m_watcher.start(m_tree.getRoot());
+        }
+        resetViewState();
+    }
+
+    void ExplorerView::resetViewState() {
+        m_expanded.clear();
+        m_visibleRows.clear();
+        m_rowsDirty = true;
+        m_selected = FileTree::INVALID_INDEX;
+    }
+
+    void ExplorerView::update() {
+        GameManager::getInstance().update();
 
-                // Simple file list without complex tree
-                ImGui::Text("Project Files:");
-                ImGui::BulletText("src/main.cpp");
-                ImGui::BulletText("src/core/Application.cpp");
-                ImGui::BulletText("CMakeLists.txt");
+        if (!m_tree.isOpen()) {
+            return;
+        }
+
+        std::vector<FileChange> changes = m_watcher.poll();
+        if (!changes.empty()) {
+            const bool overflow = std::any_of(changes.begin(), changes.end(), [](const FileChange& change) {
+                return change.type == FileChange::Type::Overflow;
+            });
 
-                std::cout << "ExplorerView content drawn successfully" << std::endl;
+            EventFilesChanged::post({changes});
+
+            if (overflow) {
+                ConsoleView::warning("File watcher lost events, rescanning the project");
+                refresh();
             } else {
-                std::cout << "ExplorerView window failed to create" << std::endl;
+                m_tree.applyChanges(std::move(changes));
             }
-            ImGui::End();
-        } catch (const std::exception& e) {
-            std::cout << "Exception in ExplorerView::draw(): " << e.what() << std::endl;
-        } catch (...) {
-            std::cout << "Unknown exception in ExplorerView::draw()" << std::endl;
         }
 
-        std::cout << "ExplorerView::draw() end" << std::endl;
+        const FileTree::Update& update = m_tree.poll();
+        m_pathIndex.update(m_tree, update);
+        m_expanded.resize(m_tree.size(), 0);
+
+        // Carry view state over to entries whose child range was rebuilt
+        for (const auto& [from, to] : update.moved) {
+            m_expanded[to] = m_expanded[from];
+            m_expanded[from] = 0;
+            if (m_selected == from) {
+                m_selected = to;
+            }
+        }
+        for (uint32_t index : update.removed) {
+            m_expanded[index] = 0;
+            if (m_selected == index) {
+                m_selected = FileTree::INVALID_INDEX;
+            }
+        }
+
+        // New listings get watched; only directories that are on screen invalidate the rows
+        for (uint32_t directory : update.directories) {
+            m_watcher.watchDirectory(m_tree.getPath(directory));
+            if (directory == FileTree::ROOT_INDEX || m_expanded[directory]) {
+                m_rowsDirty = true;
+            }
+        }
+    }
+
+    void ExplorerView::drawToolbar() {
+        if (m_tree.isOpen()) {
+            ImGui::Text(ICON_MS_FOLDER " %s", m_tree.get(FileTree::ROOT_INDEX).name.c_str());
+        } else {
+            ImGui::Text(ICON_MS_FOLDER " No project open");
+        }
+
+        if (ImGui::Button(ICON_MS_REFRESH "##refresh")) {
+            refresh();
+        }
+        ImGui::SameLine();
+
+        if (ImGui::Button(ICON_MS_CREATE_NEW_FOLDER "##newfolder")) {
+            std::cout << "New folder clicked" << std::endl;
+        }
+        ImGui::SameLine();
+
+        if (ImGui::Button(ICON_MS_NOTE_ADD "##newfile")) {
+            std::cout << "New file clicked" << std::endl;
+        }
+        ImGui::SameLine();
+
+        if (ImGui::Button(ICON_MS_SEARCH "##quickopen")) {
+            m_quickOpen.open();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Go to File (Ctrl+P)");
+        }
+        ImGui::SameLine();
+
+        if (ImGui::Checkbox("Hidden", &m_showHiddenFiles)) {
+            m_rowsDirty = true;
+        }
+
+        if (m_tree.isScanning()) {
+            ImGui::TextDisabled(ICON_MS_HOURGLASS_EMPTY " Scanning... %zu entries", m_tree.size());
+        } else if (m_watcher.isRunning() && m_watcher.isPolling()) {
+            ImGui::TextDisabled(ICON_MS_SCHEDULE " Polling for changes");
+        }
     }
 
     void ExplorerView::drawFileTree() {
-        // Minimal implementation - just text
-        ImGui::Text("File tree placeholder");
+        if (!m_tree.isOpen()) {
+            ImGui::TextDisabled("Use 'open <path>' in the console to open a project");
+            return;
+        }
+
+        if (m_rowsDirty) {
+            rebuildVisibleRows();
+        }
+
+        if (ImGui::BeginChild("##fileTree", ImVec2(0, 0), false)) {
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_visibleRows.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                    drawTreeRow(m_visibleRows[row]);
+                }
+            }
+            clipper.End();
+
+            drawContextMenu();
+        }
+        ImGui::EndChild();
+    }
+
+    void ExplorerView::drawTreeRow(uint32_t index) {
+        const FileTree::Entry& entry = m_tree.get(index);
+        const bool expanded = m_expanded[index] != 0;
+
+        ImGui::PushID(static_cast<int>(index));
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + (entry.depth - 1) * ImGui::GetStyle().IndentSpacing);
+
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen |
+                                   ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
+        if (!entry.isDirectory) {
+            flags |= ImGuiTreeNodeFlags_Leaf;
+        }
+        if (index == m_selected) {
+            flags |= ImGuiTreeNodeFlags_Selected;
+        }
+
+        const char* icon = entry.isDirectory ? (expanded ? ICON_MS_FOLDER_OPEN : ICON_MS_FOLDER) : ICON_MS_DESCRIPTION;
+        if (entry.isDirectory) {
+            ImGui::SetNextItemOpen(expanded);
+        }
+        // Names may use any script: missing glyphs are added to the atlas next frame
+        FontManager::getInstance().requestGlyphs(entry.name.c_str());
+        const bool open = ImGui::TreeNodeEx("##node", flags, "%s %s", icon, entry.name.c_str());
+
+        if (entry.isDirectory && open != expanded) {
+            m_expanded[index] = open ? 1 : 0;
+            m_rowsDirty = true;
+            if (open && !entry.scanned) {
+                m_tree.prioritize(index);
+            }
+        }
+
+        if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
+            m_selected = index;
+        }
+
+        if (!entry.isDirectory && ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+            const std::filesystem::path path = m_tree.getPath(index);
+            if (GameArchive::isResourcePath(path)) {
+                if (GameManager::getInstance().open(path)) {
+                    m_selectedBlock = BlockIndex::INVALID_INDEX;
+                }
+            } else if (auto* editor = ViewManager::getInstance().getView<EditorView>("Editor")) {
+                editor->openFile(path.string());
+            }
+        }
+
+        ImGui::PopID();
+    }
+
+    void ExplorerView::rebuildVisibleRows() {
+        m_visibleRows.clear();
+        m_rowsDirty = false;
+
+        // Depth-first walk over expanded directories, children in stored order
+        std::vector<uint32_t> stack;
+        auto pushChildren = [&](uint32_t directory) {
+            const FileTree::Entry& entry = m_tree.get(directory);
+            if (!entry.scanned) {
+                return;
+            }
+            for (uint32_t i = entry.childCount; i > 0; i--) {
+                const uint32_t child = entry.firstChild + i - 1;
+                if (m_showHiddenFiles || !m_tree.get(child).isHidden) {
+                    stack.push_back(child);
+                }
+            }
+        };
+
+        pushChildren(FileTree::ROOT_INDEX);
+        while (!stack.empty()) {
+            const uint32_t index = stack.back();
+            stack.pop_back();
+
+            m_visibleRows.push_back(index);
+            if (m_tree.get(index).isDirectory && m_expanded[index]) {
+                pushChildren(index);
+            }
+        }
     }
 
-    void ExplorerView::drawProjectFiles() {
-        // Minimal implementation
-        ImGui::Text("Project files placeholder");
+    void ExplorerView::drawResourceTree() {
+        auto& game = GameManager::getInstance();
+        auto& rooms = game.getRoomPipeline();
+
+        if (rooms.isRunning()) {
+            char overlay[64];
+            std::snprintf(overlay, sizeof(overlay), "%zu / %zu rooms", rooms.getCompleted(), rooms.getTotal());
+            ImGui::ProgressBar(rooms.getProgress(), ImVec2(-ImGui::GetFrameHeight() * 3.0f, 0), overlay);
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel##rooms")) {
+                rooms.cancel();
+            }
+        } else {
+            if (ImGui::Button(ICON_MS_PLAY_ARROW " Decode rooms")) {
+                game.decodeRooms();
+            }
+            if (!rooms.getRooms().empty()) {
+                ImGui::SameLine();
+                ImGui::TextDisabled("%zu rooms decoded", rooms.getRooms().size());
+            }
+        }
+
+        auto& scripts = game.getScriptPipeline();
+        if (scripts.isRunning()) {
+            char overlay[64];
+            std::snprintf(overlay, sizeof(overlay), "%zu / %zu scripts", scripts.getCompleted(), scripts.getTotal());
+            ImGui::ProgressBar(scripts.getProgress(), ImVec2(-ImGui::GetFrameHeight() * 3.0f, 0), overlay);
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel##scripts")) {
+                scripts.cancel();
+            }
+        } else {
+            if (ImGui::Button(ICON_MS_CODE " Decompile scripts")) {
+                game.decompileScripts();
+            }
+            if (!scripts.getResults().empty()) {
+                ImGui::SameLine();
+                ImGui::TextDisabled("%zu scripts decompiled", scripts.getResults().size());
+            }
+        }
+
+        if (ImGui::BeginChild("##resourceTree", ImVec2(0, 0), false)) {
+            for (size_t file = 0; file < game.getFileCount(); file++) {
+                const BlockIndex& index = game.getBlockIndex(file);
+                const std::string name = game.getFile(file).getPath().filename().string();
+
+                ImGui::PushID(static_cast<int>(file));
+                const ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAvailWidth |
+                                                 (file > 0 ? ImGuiTreeNodeFlags_DefaultOpen : ImGuiTreeNodeFlags_None);
+                if (ImGui::TreeNodeEx("##file", flags, ICON_MS_DESCRIPTION " %s (%zu blocks)", name.c_str(), index.size())) {
+                    for (uint32_t record = index.size() > 0 ? 0 : BlockIndex::INVALID_INDEX; record != BlockIndex::INVALID_INDEX;
+                         record = index.get(record).nextSibling) {
+                        drawResourceNode(file, record);
+                    }
+                    ImGui::TreePop();
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndChild();
+    }
+
+    void ExplorerView::drawResourceNode(size_t file, uint32_t record) {
+        const BlockIndex& index = GameManager::getInstance().getBlockIndex(file);
+        const BlockIndex::Record& block = index.get(record);
+        const uint32_t firstChild = index.getFirstChild(record);
+
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnArrow |
+                                   ImGuiTreeNodeFlags_OpenOnDoubleClick;
+        if (firstChild == BlockIndex::INVALID_INDEX) {
+            flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+        }
+        if (file == m_selectedFile && record == m_selectedBlock) {
+            flags |= ImGuiTreeNodeFlags_Selected;
+        }
+
+        ImGui::PushID(static_cast<int>(record));
+        const std::string tag = tagToString(block.tag);
+        bool open;
+        if (block.tag == tags::LFLF && block.room != 0) {
+            open = ImGui::TreeNodeEx("##block", flags, "%s  room %u", tag.c_str(), block.room);
+        } else {
+            open = ImGui::TreeNodeEx("##block", flags, "%s", tag.c_str());
+        }
+        if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
+            m_selectedFile = file;
+            m_selectedBlock = record;
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Offset %u, %u bytes", block.offset, block.size);
+            if (ScriptDisassembler::isScriptBlock(block.tag) && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+                if (auto* editor = ViewManager::getInstance().getView<EditorView>("Editor")) {
+                    editor->openScript(file, record);
+                }
+            }
+        }
+
+        if (open && firstChild != BlockIndex::INVALID_INDEX) {
+            for (uint32_t child = firstChild; child != BlockIndex::INVALID_INDEX; child = index.get(child).nextSibling) {
+                drawResourceNode(file, child);
+            }
+            ImGui::TreePop();
+        }
+        ImGui::PopID();
     }
 
     void ExplorerView::drawContextMenu() {
@@ -80,4 +404,4 @@ namespace scummredux {
         // Context menus can sometimes cause ID conflicts
     }
 
-} // namespace scummredux
\ No newline at end of file
+} // namespace scummredux
@@ -1,35 +1,66 @@
 #pragma once
 
 #include "View.h"
-#include <vector>
+#include "../core/FileTree.h"
+#include "../core/FileWatcher.h"
+#include "../core/PathIndex.h"
+#include "QuickOpenPalette.h"
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace scummredux {
 
     class ExplorerView : public View {
     public:
         ExplorerView();
-        ~ExplorerView() override = default;
+        ~ExplorerView() override;
 
         void draw() override;
+        void drawAlwaysVisibleContent() override;
+
+        // Project management
+        void openProject(const std::string& path);
+        void refresh();
+        const FileTree& getFileTree() const { return m_tree; }
+        const PathIndex& getPathIndex() const { return m_pathIndex; }
+        void openQuickOpen() { m_quickOpen.open(); }
 
     private:
+        // Runs every frame (even while the window is hidden): streams scanner results and
+        // applies file watcher deltas
+        void update();
+        void resetViewState();
+
+        void drawToolbar();
         void drawFileTree();
-        void drawProjectFiles();
+        void drawTreeRow(uint32_t index);
         void drawContextMenu();
 
-        // File tree state
-        struct FileNode {
-            std::string name;
-            std::string path;
-            bool isDirectory;
-            bool isExpanded;
-            std::vector<FileNode> children;
-        };
-
-        std::vector<FileNode> m_projectFiles;
-        std::string m_selectedFile;
+        // Blocks of the open game, straight from its block indices
+        void drawResourceTree();
+        void drawResourceNode(size_t file, uint32_t record);
+
+        // Rebuilds the flattened list of visible rows (only when expansion or contents change)
+        void rebuildVisibleRows();
+
+        FileTree m_tree;
+        FileWatcher m_watcher;
+        PathIndex m_pathIndex;
+        QuickOpenPalette m_quickOpen{m_tree, m_pathIndex};
+        size_t m_frameHandle = 0;
+
+        // Per-entry view state, indexed like the tree
+        std::vector<uint8_t> m_expanded;
+        std::vector<uint32_t> m_visibleRows;
+        bool m_rowsDirty = true;
+
+        uint32_t m_selected = FileTree::INVALID_INDEX;
         bool m_showHiddenFiles = false;
+
+        // Selected block in the resource tree
+        size_t m_selectedFile = 0;
+        uint32_t m_selectedBlock = UINT32_MAX;
     };
 
-} // namespace scummredux
\ No newline at end of file
+} // namespace scummredux
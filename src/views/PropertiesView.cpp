@@ -2,6 +2,12 @@
 #include "../res/icons/MaterialSymbols.h"
 #include "../core/Settings.h"
 #include "../ui/StyleManager.h"
+#include "../core/DrawStats.h"
+#include "../core/JobSystem.h"
+#include "../core/TextureCache.h"
+#include "../scumm/GameManager.h"
+#include "../utils/Events.hpp"
+#include <cstdio>
 #include <iostream>
 
 namespace scummredux {
@@ -15,14 +21,26 @@ namespace scummredux {
         m_showProject = true;
         m_showPerformance = false;
         m_settingsChanged = false;
+
+        m_roomSelectedHandle = EventRoomSelected::subscribe([this](const RoomSelectedEvent& event) {
+            m_room = event.room;
+            m_roomObjects.clear();
+            for (const ObjectImage& object : event.objects) {
+                m_roomObjects.push_back({object.id, object.name, static_cast<uint16_t>(object.states.size())});
+            }
+        });
+    }
+
+    PropertiesView::~PropertiesView() {
+        EventRoomSelected::unsubscribe(m_roomSelectedHandle);
     }
 
     void PropertiesView::draw() {
-        std::cout << "PropertiesView::draw() start" << std::endl;
+        verboseOut() << "PropertiesView::draw() start" << std::endl;
 
         try {
             if (ImGui::Begin(getWindowName().c_str(), &getWindowOpenState())) {
-                std::cout << "PropertiesView window created successfully" << std::endl;
+                verboseOut() << "PropertiesView window created successfully" << std::endl;
 
                 // MINIMAL VERSION - just text for now to avoid crashes
                 ImGui::Text(ICON_MS_SETTINGS " Settings");
@@ -31,8 +49,7 @@ namespace scummredux {
                 // Simple expandable sections without complex widgets
                 if (ImGui::CollapsingHeader(ICON_MS_PALETTE " Appearance")) {
                     ImGui::Indent();
-                    ImGui::Text("Theme settings will go here");
-                    ImGui::Text("Font settings will go here");
+                    drawAppearanceSettings();
                     ImGui::Unindent();
                 }
 
@@ -50,10 +67,15 @@ namespace scummredux {
                     ImGui::Unindent();
                 }
 
+                if (ImGui::CollapsingHeader(ICON_MS_LAYERS " Room Objects")) {
+                    ImGui::Indent();
+                    drawRoomObjects();
+                    ImGui::Unindent();
+                }
+
                 if (ImGui::CollapsingHeader(ICON_MS_SPEED " Performance")) {
                     ImGui::Indent();
-                    ImGui::Text("Performance settings will go here");
-                    ImGui::Text("FPS limits, VSync, etc.");
+                    drawPerformanceSettings();
                     ImGui::Unindent();
                 }
 
@@ -69,9 +91,9 @@ namespace scummredux {
                     std::cout << "Reset clicked" << std::endl;
                 }
 
-                std::cout << "PropertiesView content drawn successfully" << std::endl;
+                verboseOut() << "PropertiesView content drawn successfully" << std::endl;
             } else {
-                std::cout << "PropertiesView window failed to create" << std::endl;
+                verboseOut() << "PropertiesView window failed to create" << std::endl;
             }
             ImGui::End();
         } catch (const std::exception& e) {
@@ -80,11 +102,42 @@ namespace scummredux {
             std::cout << "Unknown exception in PropertiesView::draw()" << std::endl;
         }
 
-        std::cout << "PropertiesView::draw() end" << std::endl;
+        verboseOut() << "PropertiesView::draw() end" << std::endl;
     }
 
     void PropertiesView::drawAppearanceSettings() {
-        ImGui::Text("Appearance settings placeholder");
+        auto& styleManager = StyleManager::getInstance();
+
+        // Theme switching applies a precompiled style, so it is cheap to preview
+        const ThemeId currentTheme = styleManager.getCurrentThemeId();
+        if (ImGui::BeginCombo("Theme", styleManager.getCurrentTheme().c_str())) {
+            const auto& names = ThemeRegistry::getInstance().getNames();
+            for (ThemeId theme = 0; theme < names.size(); theme++) {
+                const bool selected = theme == currentTheme;
+                if (ImGui::Selectable(names[theme].c_str(), selected)) {
+                    styleManager.setTheme(theme);
+                }
+                if (selected) {
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        ImVec4 accentColor = styleManager.getAccentColor();
+        if (ImGui::ColorEdit4("Accent", &accentColor.x, ImGuiColorEditFlags_NoInputs)) {
+            styleManager.setAccentColor(accentColor);
+        }
+
+        const ThemeCustomizations& customizations = ThemeRegistry::getInstance().getCustomizations();
+        float windowRounding = customizations.windowRounding;
+        if (ImGui::SliderFloat("Window Rounding", &windowRounding, 0.0f, 12.0f, "%.0f")) {
+            styleManager.setWindowRounding(windowRounding);
+        }
+        float frameRounding = customizations.frameRounding;
+        if (ImGui::SliderFloat("Frame Rounding", &frameRounding, 0.0f, 12.0f, "%.0f")) {
+            styleManager.setFrameRounding(frameRounding);
+        }
     }
 
     void PropertiesView::drawEditorSettings() {
@@ -95,8 +148,102 @@ namespace scummredux {
         ImGui::Text("Project settings placeholder");
     }
 
+    void PropertiesView::drawRoomObjects() {
+        if (m_roomObjects.empty()) {
+            ImGui::TextDisabled("Select a room with objects in the Rooms view");
+            return;
+        }
+
+        // States go straight to the game; the Rooms view redraws only the changed layers
+        auto& game = GameManager::getInstance();
+        ImGui::Text("Room %u: %zu objects", static_cast<unsigned>(m_room), m_roomObjects.size());
+        for (const RoomObject& object : m_roomObjects) {
+            ImGui::PushID(object.id);
+            int state = game.getObjectState(object.id);
+            const bool visible = state > 0 && state <= object.imageCount;
+            ImGui::TextUnformatted(visible ? ICON_MS_VISIBILITY : ICON_MS_VISIBILITY_OFF);
+            ImGui::SameLine();
+
+            char label[64];
+            if (object.name.empty()) {
+                std::snprintf(label, sizeof(label), "Object %u", static_cast<unsigned>(object.id));
+            } else {
+                std::snprintf(label, sizeof(label), "%s (%u)", object.name.c_str(), static_cast<unsigned>(object.id));
+            }
+            if (object.imageCount == 0) {
+                ImGui::TextDisabled("%s: no image", label);
+            } else {
+                ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+                if (ImGui::SliderInt(label, &state, 0, object.imageCount, state == 0 ? "Hidden" : "IM%02X")) {
+                    game.setObjectState(object.id, static_cast<uint16_t>(state));
+                }
+            }
+            ImGui::PopID();
+        }
+    }
+
     void PropertiesView::drawPerformanceSettings() {
-        ImGui::Text("Performance settings placeholder");
+        const ImGuiIO& io = ImGui::GetIO();
+        ImGui::Text("%.1f FPS (%.2f ms)", io.Framerate, io.Framerate > 0.0f ? 1000.0f / io.Framerate : 0.0f);
+
+        // Draw data of the previous frame (the current one is still being built)
+        const auto& drawStats = DrawStats::getInstance();
+        const auto& frame = drawStats.getFrame();
+
+        const auto jobs = JobSystem::getInstance().getStats();
+        ImGui::SeparatorText("Jobs");
+        char utilization[32];
+        std::snprintf(utilization, sizeof(utilization), "%.0f%% of %zu workers", jobs.utilization * 100.0f, jobs.workers);
+        ImGui::ProgressBar(jobs.utilization, ImVec2(-FLT_MIN, 0), utilization);
+        ImGui::Text("Queued: %zu interactive, %zu batch", jobs.queuedInteractive, jobs.queuedBatch);
+        ImGui::Text("Waiting on dependencies: %zu  Main thread: %zu", jobs.waiting, jobs.mainThreadQueued);
+        ImGui::Text("Completed: %llu", (unsigned long long)jobs.completed);
+
+        const TextureCache::Stats textures = TextureCache::getInstance().getStats();
+        ImGui::SeparatorText("Textures");
+        char memory[48];
+        std::snprintf(memory, sizeof(memory), "%.1f of %.0f MB", textures.residentBytes / (1024.0 * 1024.0),
+                      textures.memoryBudget / (1024.0 * 1024.0));
+        ImGui::ProgressBar(textures.memoryBudget ? float(textures.residentBytes) / float(textures.memoryBudget) : 0.0f,
+                           ImVec2(-FLT_MIN, 0), memory);
+        ImGui::Text("Textures: %zu  Pending uploads: %zu  Evicted: %llu", textures.textures, textures.pendingUploads,
+                    (unsigned long long)textures.evictions);
+        ImGui::Text("Uploaded last frame: %zu of %zu KB", textures.uploadedLastFrame / 1024, textures.uploadBudget / 1024);
+
+        ImGui::SeparatorText("Draw Lists");
+        ImGui::Text("Lists: %llu  Commands: %llu", (unsigned long long)frame.drawLists, (unsigned long long)frame.commands);
+        ImGui::Text("Vertices: %llu  Indices: %llu", (unsigned long long)frame.vertices, (unsigned long long)frame.indices);
+        ImGui::Text("Texture switches: %llu", (unsigned long long)frame.textureSwitches);
+
+        const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                           ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY;
+        const float tableHeight = ImGui::GetTextLineHeightWithSpacing() * 10;
+
+        if (ImGui::BeginTable("##drawLists", 5, tableFlags, ImVec2(0, tableHeight))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Window", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Cmds");
+            ImGui::TableSetupColumn("Vtx");
+            ImGui::TableSetupColumn("Idx");
+            ImGui::TableSetupColumn("Tex");
+            ImGui::TableHeadersRow();
+
+            for (const auto& list : drawStats.getLists()) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(list.owner.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", list.commands);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", list.vertices);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", list.indices);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", list.textureSwitches);
+            }
+
+            ImGui::EndTable();
+        }
     }
 
 } // namespace scummredux
\ No newline at end of file
@@ -1,14 +1,16 @@
 #pragma once
 
 #include "View.h"
+#include "../scumm/RoomPipeline.h"
 #include <string>
+#include <vector>
 
 namespace scummredux {
 
     class PropertiesView : public View {
     public:
         PropertiesView();
-        ~PropertiesView() override = default;
+        ~PropertiesView() override;
 
         void draw() override;
 
@@ -17,6 +19,7 @@ namespace scummredux {
         void drawEditorSettings();
         void drawProjectSettings();
         void drawPerformanceSettings();
+        void drawRoomObjects();
 
         // Settings categories
         bool m_showAppearance = true;
@@ -51,6 +54,11 @@ namespace scummredux {
 
         // Flags for changes
         bool m_settingsChanged = false;
+
+        // Objects of the room shown in the Rooms view (imageCount = states)
+        uint16_t m_room = 0;
+        std::vector<RoomObject> m_roomObjects;
+        size_t m_roomSelectedHandle = 0;
     };
 
 } // namespace scummredux
\ No newline at end of file
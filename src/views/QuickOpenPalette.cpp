@@ -0,0 +1,134 @@
+#include "QuickOpenPalette.h"
+#include "EditorView.h"
+#include "ViewManager.h"
+#include "../ui/ScaleManager.h"
+#include "../res/icons/MaterialSymbols.h"
+#include <algorithm>
+#include <string>
+
+namespace scummredux {
+
+    QuickOpenPalette::QuickOpenPalette(const FileTree& tree, const PathIndex& index)
+        : m_tree(tree), m_index(index) {
+    }
+
+    void QuickOpenPalette::draw() {
+        if (ImGui::GetIO().KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_P, false) && m_tree.isOpen()) {
+            m_requestOpen = true;
+        }
+
+        if (m_requestOpen) {
+            m_requestOpen = false;
+            m_query[0] = '\0';
+            m_selected = 0;
+            m_resultsGeneration = UINT32_MAX;
+            ImGui::OpenPopup(POPUP_ID);
+        }
+
+        const ImGuiViewport* viewport = ImGui::GetMainViewport();
+        const float scale = ScaleManager::getFactor();
+        const float width = std::min(640.0f * scale, viewport->WorkSize.x * 0.8f);
+        ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x * 0.5f, viewport->WorkPos.y + 48.0f * scale),
+                                ImGuiCond_Always, ImVec2(0.5f, 0.0f));
+        ImGui::SetNextWindowSize(ImVec2(width, 0.0f));
+
+        if (!ImGui::BeginPopup(POPUP_ID, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove |
+                                         ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoSavedSettings)) {
+            return;
+        }
+
+        if (ImGui::IsWindowAppearing()) {
+            ImGui::SetKeyboardFocusHere();
+        }
+        ImGui::SetNextItemWidth(-1.0f);
+        const bool changed = ImGui::InputTextWithHint("##query", ICON_MS_SEARCH " Go to file", m_query, sizeof(m_query));
+
+        // Re-run when the text or the index changes (files are still streaming in)
+        if (changed) {
+            m_selected = 0;
+        }
+        if (changed || m_resultsGeneration != m_index.getGeneration()) {
+            runQuery();
+        }
+
+        // Keyboard navigation
+        if (!m_results.empty()) {
+            if (ImGui::IsKeyPressed(ImGuiKey_DownArrow)) {
+                m_selected = (m_selected + 1) % m_results.size();
+                m_scrollToSelected = true;
+            }
+            if (ImGui::IsKeyPressed(ImGuiKey_UpArrow)) {
+                m_selected = (m_selected + m_results.size() - 1) % m_results.size();
+                m_scrollToSelected = true;
+            }
+            if (ImGui::IsKeyPressed(ImGuiKey_Enter)) {
+                accept(m_selected);
+            }
+        }
+        if (ImGui::IsKeyPressed(ImGuiKey_Escape)) {
+            ImGui::CloseCurrentPopup();
+        }
+
+        ImGui::TextDisabled("%zu of %zu files", m_results.size(), m_index.size());
+
+        const float height = VISIBLE_ROWS * ImGui::GetTextLineHeightWithSpacing();
+        if (ImGui::BeginChild("##results", ImVec2(0, height), false)) {
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_results.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                    const auto& match = m_results[row];
+                    const std::string_view path = m_index.getPath(match.slot);
+                    const std::string_view name = m_index.getFileName(match.slot);
+                    const std::string label = std::string(name) + "##" + std::to_string(row);
+
+                    ImGui::PushID(row);
+                    if (ImGui::Selectable(label.c_str(), static_cast<size_t>(row) == m_selected)) {
+                        accept(row);
+                    }
+                    if (m_scrollToSelected && static_cast<size_t>(row) == m_selected) {
+                        ImGui::SetScrollHereY();
+                        m_scrollToSelected = false;
+                    }
+
+                    // Containing directory, dimmed
+                    if (path.size() > name.size()) {
+                        const std::string_view directory = path.substr(0, path.size() - name.size() - 1);
+                        ImGui::SameLine();
+                        ImGui::TextDisabled("%.*s", static_cast<int>(directory.size()), directory.data());
+                    }
+                    ImGui::PopID();
+                }
+            }
+            clipper.End();
+
+            // The selection can be outside the clipped range
+            if (m_scrollToSelected) {
+                ImGui::SetScrollY(m_selected * ImGui::GetTextLineHeightWithSpacing());
+                m_scrollToSelected = false;
+            }
+        }
+        ImGui::EndChild();
+
+        ImGui::EndPopup();
+    }
+
+    void QuickOpenPalette::runQuery() {
+        m_results = m_index.query(m_query, PathIndex::DEFAULT_MAX_RESULTS);
+        m_resultsGeneration = m_index.getGeneration();
+        m_selected = std::min(m_selected, m_results.empty() ? 0 : m_results.size() - 1);
+    }
+
+    void QuickOpenPalette::accept(size_t row) {
+        if (row >= m_results.size()) {
+            return;
+        }
+
+        if (auto* editor = ViewManager::getInstance().getView<EditorView>("Editor")) {
+            editor->openFile(m_tree.getPath(m_results[row].entry).string());
+            ViewManager::getInstance().showView("Editor");
+        }
+        ImGui::CloseCurrentPopup();
+    }
+
+} // namespace scummredux
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../core/FileTree.h"
+#include "../core/PathIndex.h"
+#include <cstdint>
+#include <vector>
+
+namespace scummredux {
+
+    // Ctrl+P palette: fuzzy-finds a file in the open project and opens it in the Editor
+    class QuickOpenPalette {
+    public:
+        QuickOpenPalette(const FileTree& tree, const PathIndex& index);
+
+        void open() { m_requestOpen = true; }
+
+        // Call every frame (handles the shortcut even while hidden)
+        void draw();
+
+    private:
+        void runQuery();
+        void accept(size_t row);
+
+        const FileTree& m_tree;
+        const PathIndex& m_index;
+
+        char m_query[256] = {};
+        std::vector<PathIndex::Match> m_results;
+        uint32_t m_resultsGeneration = UINT32_MAX;
+        size_t m_selected = 0;
+        bool m_requestOpen = false;
+        bool m_scrollToSelected = false;
+
+        static constexpr const char* POPUP_ID = "##QuickOpen";
+        static constexpr int VISIBLE_ROWS = 14;
+    };
+
+} // namespace scummredux
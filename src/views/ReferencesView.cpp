@@ -0,0 +1,145 @@
+#include "ReferencesView.h"
+#include "EditorView.h"
+#include "ViewManager.h"
+#include "../res/icons/MaterialSymbols.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+namespace scummredux {
+
+    namespace {
+
+        constexpr ReferenceIndex::SymbolKind KINDS[] = {
+            ReferenceIndex::SymbolKind::Variable, ReferenceIndex::SymbolKind::BitVariable, ReferenceIndex::SymbolKind::Object,
+            ReferenceIndex::SymbolKind::Room, ReferenceIndex::SymbolKind::Script,
+        };
+
+        constexpr const char* KIND_LABELS[] = {"Variable", "Bit variable", "Object", "Room", "Script"};
+
+    } // namespace
+
+    ReferencesView::ReferencesView() : View("References") {
+    }
+
+    void ReferencesView::draw() {
+        try {
+            if (ImGui::Begin(getWindowName().c_str(), &getWindowOpenState())) {
+                // Results point into the game they were found in
+                auto& game = GameManager::getInstance();
+                if (game.getGeneration() != m_generation) {
+                    m_generation = game.getGeneration();
+                    m_references.clear();
+                    m_summary.clear();
+                    m_selected = NO_SELECTION;
+                }
+
+                if (!game.isOpen()) {
+                    ImGui::TextDisabled("Open a game to search its scripts");
+                } else {
+                    drawQuery();
+                    ImGui::Separator();
+                    drawResults();
+                }
+            }
+            ImGui::End();
+        } catch (const std::exception& e) {
+            std::cout << "Exception in ReferencesView::draw(): " << e.what() << std::endl;
+        } catch (...) {
+            std::cout << "Unknown exception in ReferencesView::draw()" << std::endl;
+        }
+    }
+
+    void ReferencesView::drawQuery() {
+        const bool ready = GameManager::getInstance().areReferencesReady();
+
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+        bool changed = ImGui::Combo("##kind", &m_kind, KIND_LABELS, IM_ARRAYSIZE(KIND_LABELS));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 7.0f);
+        changed |= ImGui::InputInt("##number", &m_number);
+        m_number = std::clamp(m_number, 0, static_cast<int>(UINT16_MAX));
+
+        ImGui::SameLine();
+        ImGui::BeginDisabled(!ready);
+        if (ImGui::Button(ICON_MS_SEARCH " Find") || (changed && ready)) {
+            find();
+        }
+        ImGui::EndDisabled();
+
+        ImGui::SameLine();
+        if (!ready) {
+            ImGui::TextDisabled(ICON_MS_HOURGLASS_EMPTY " Indexing script references...");
+        } else if (!m_summary.empty()) {
+            ImGui::TextDisabled("%s", m_summary.c_str());
+        }
+    }
+
+    void ReferencesView::find() {
+        const ReferenceIndex::SymbolKind kind = KINDS[std::clamp(m_kind, 0, static_cast<int>(IM_ARRAYSIZE(KINDS)) - 1)];
+        const auto start = std::chrono::steady_clock::now();
+        m_references = GameManager::getInstance().findReferences(kind, static_cast<uint16_t>(m_number));
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        m_selected = NO_SELECTION;
+
+        size_t scripts = 0;
+        for (size_t i = 0; i < m_references.size(); i++) {
+            const bool sameScript = i > 0 && m_references[i].file == m_references[i - 1].file &&
+                                    m_references[i].record == m_references[i - 1].record;
+            scripts += sameScript ? 0 : 1;
+        }
+
+        char summary[128];
+        std::snprintf(summary, sizeof(summary), "%s: %zu uses in %zu scripts (%.3f ms)",
+                      ReferenceIndex::formatSymbol(kind, static_cast<uint16_t>(m_number)).c_str(), m_references.size(), scripts, ms);
+        m_summary = summary;
+    }
+
+    void ReferencesView::drawResults() {
+        auto& game = GameManager::getInstance();
+        const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                           ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY;
+        if (!ImGui::BeginTable("##references", 4, tableFlags, ImVec2(0, 0))) {
+            return;
+        }
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Script", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Room");
+        ImGui::TableSetupColumn("File");
+        ImGui::TableSetupColumn("Offset");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_references.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const GameManager::ScriptReference& reference = m_references[static_cast<size_t>(row)];
+                const BlockIndex::Record& block = game.getBlockIndex(reference.file).get(reference.record);
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                char label[64];
+                std::snprintf(label, sizeof(label), ICON_MS_CODE " %s %08X##%d", tagToString(block.tag).c_str(), block.offset, row);
+                if (ImGui::Selectable(label, static_cast<size_t>(row) == m_selected, ImGuiSelectableFlags_SpanAllColumns)) {
+                    m_selected = static_cast<size_t>(row);
+                }
+                if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+                    if (auto* editor = ViewManager::getInstance().getView<EditorView>("Editor")) {
+                        editor->openScript(reference.file, reference.record, reference.offset);
+                    }
+                }
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", static_cast<unsigned>(block.room));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(game.getFile(reference.file).getPath().filename().string().c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("0x%04X", reference.offset);
+            }
+        }
+        clipper.End();
+        ImGui::EndTable();
+    }
+
+} // namespace scummredux
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "View.h"
+#include "../scumm/GameManager.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scummredux {
+
+    // Lists the script instructions that use a variable, object, room or script
+    // number, answered from the game's reference indices. Double-clicking a use
+    // opens its script in the editor at that instruction.
+    class ReferencesView : public View {
+    public:
+        ReferencesView();
+
+        void draw() override;
+
+    private:
+        void drawQuery();
+        void drawResults();
+        void find();
+
+        int m_kind = 0;                     // ReferenceIndex::SymbolKind
+        int m_number = 0;
+        std::vector<GameManager::ScriptReference> m_references;
+        std::string m_summary;
+        size_t m_selected = NO_SELECTION;
+        uint32_t m_generation = 0;
+
+        static constexpr size_t NO_SELECTION = SIZE_MAX;
+    };
+
+} // namespace scummredux
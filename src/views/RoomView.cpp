@@ -0,0 +1,382 @@
+#include "RoomView.h"
+#include "../core/TraceRecorder.h"
+#include "../scumm/GameManager.h"
+#include "../utils/Events.hpp"
+#include "../res/icons/MaterialSymbols.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace scummredux {
+
+    RoomView::RoomView() : View("Rooms") {
+        m_frameHandle = EventFrameBegin::subscribe([this](const FrameBeginEvent&) {
+            update();
+        });
+    }
+
+    RoomView::~RoomView() {
+        EventFrameBegin::unsubscribe(m_frameHandle);
+        for (auto& [room, request] : m_requests) {
+            request->token.cancel();
+        }
+    }
+
+    void RoomView::draw() {
+        try {
+            if (ImGui::Begin(getWindowName().c_str(), &getWindowOpenState())) {
+                if (m_rooms.empty()) {
+                    ImGui::TextDisabled("Open a game to browse its rooms");
+                } else {
+                    if (ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows) && m_selected < m_rooms.size()) {
+                        if (ImGui::IsKeyPressed(ImGuiKey_UpArrow) || ImGui::IsKeyPressed(ImGuiKey_LeftArrow)) {
+                            select(m_selected > 0 ? m_selected - 1 : 0);
+                        } else if (ImGui::IsKeyPressed(ImGuiKey_DownArrow) || ImGui::IsKeyPressed(ImGuiKey_RightArrow)) {
+                            select(m_selected + 1);
+                        } else if (ImGui::IsKeyPressed(ImGuiKey_PageUp)) {
+                            select(m_selected > 10 ? m_selected - 10 : 0);
+                        } else if (ImGui::IsKeyPressed(ImGuiKey_PageDown)) {
+                            select(m_selected + 10);
+                        }
+                    }
+
+                    drawToolbar();
+                    ImGui::Separator();
+
+                    ImGui::BeginChild("##roomList", ImVec2(ImGui::GetFontSize() * 10.0f, 0), true);
+                    drawRoomList();
+                    ImGui::EndChild();
+
+                    ImGui::SameLine();
+                    ImGui::BeginChild("##roomImage", ImVec2(0, 0));
+                    drawRoomImage();
+                    ImGui::EndChild();
+                }
+            }
+            ImGui::End();
+        } catch (const std::exception& e) {
+            std::cout << "Exception in RoomView::draw(): " << e.what() << std::endl;
+        } catch (...) {
+            std::cout << "Unknown exception in RoomView::draw()" << std::endl;
+        }
+    }
+
+    void RoomView::update() {
+        if (GameManager::getInstance().getGeneration() != m_generation) {
+            reload();
+        }
+        if (m_rooms.empty()) {
+            return;
+        }
+
+        auto& textures = TextureCache::getInstance();
+        for (auto it = m_requests.begin(); it != m_requests.end();) {
+            Request& request = *it->second;
+            if (!request.done.load(std::memory_order_acquire)) {
+                ++it;
+                continue;
+            }
+            if (request.error.empty()) {
+                const IndexedImage& image = request.background.image;
+                textures.submit(makeKey(it->first), image.width, image.height, std::move(request.pixels));
+                m_backgrounds[it->first] = std::make_shared<const RoomBackground>(std::move(request.background));
+            } else {
+                m_errors[it->first] = request.error;
+            }
+            it = m_requests.erase(it);
+        }
+
+        // Rooms the user has scrolled past are not worth finishing
+        for (auto it = m_requests.begin(); it != m_requests.end();) {
+            const size_t distance = it->first > m_selected ? it->first - m_selected : m_selected - it->first;
+            if (distance > PREFETCH_RADIUS * 2) {
+                it->second->token.cancel();
+                it = m_requests.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::erase_if(m_backgrounds, [this](const auto& entry) {
+            const size_t distance = entry.first > m_selected ? entry.first - m_selected : m_selected - entry.first;
+            return distance > PREFETCH_RADIUS * 2;
+        });
+
+        request(m_selected, JobPriority::Interactive);
+        for (size_t distance = 1; distance <= PREFETCH_RADIUS; distance++) {
+            request(m_selected + distance, JobPriority::Batch);
+            if (m_selected >= distance) {
+                request(m_selected - distance, JobPriority::Batch);
+            }
+        }
+        updateScene();
+    }
+
+    void RoomView::updateScene() {
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - m_lastCycle).count();
+        m_lastCycle = now;
+
+        TextureCache::Texture texture;
+        const auto background = m_backgrounds.find(m_selected);
+        if (background == m_backgrounds.end() || !TextureCache::getInstance().get(makeKey(m_selected), texture)) {
+            m_sceneRoom = NO_ROOM;
+            return;
+        }
+
+        // The texture may hold another composite or palette step: start over and redraw it whole
+        auto& game = GameManager::getInstance();
+        const RoomBackground& room = *background->second;
+        if (m_sceneRoom != m_selected || m_cyclingApplied != m_cycleColors || m_zplaneApplied != m_zplane) {
+            if (m_compositor.getBackground() != &room) {
+                m_compositor.reset(background->second);
+                EventRoomSelected::post({m_rooms[m_selected].number, room.objects});
+            }
+            applyObjectStates();
+            m_compositor.compose();
+            m_cycler.reset(room.palette, m_cycleColors ? room.cycles : std::vector<ColorCycle>{}, m_compositor.getImage());
+            m_sceneRoom = m_selected;
+            m_cyclingApplied = m_cycleColors;
+            m_zplaneApplied = m_zplane;
+            refreshRows({0, room.image.height});
+            return;
+        }
+
+        // Object state edits only redraw the layers from the changed object on
+        RowRange dirty;
+        if (m_stateRevision != game.getObjectStateRevision()) {
+            applyObjectStates();
+            dirty = m_compositor.compose();
+            if (!dirty.empty()) {
+                m_cycler.rescan(m_compositor.getImage());
+            }
+        }
+        if (m_cycler.isActive()) {
+            dirty.merge(m_cycler.advance(seconds * PaletteCycler::TICKS_PER_SECOND));
+        }
+        refreshRows(dirty);
+    }
+
+    void RoomView::applyObjectStates() {
+        auto& game = GameManager::getInstance();
+        const auto& objects = m_compositor.getBackground()->objects;
+        for (size_t object = 0; object < objects.size(); object++) {
+            m_compositor.setState(object, game.getObjectState(objects[object].id));
+        }
+        m_stateRevision = game.getObjectStateRevision();
+    }
+
+    void RoomView::refreshRows(RowRange rows) {
+        if (rows.empty()) {
+            return;
+        }
+        SCUMM_TRACE_SCOPE("refreshRoomRows", "rooms");
+        const IndexedImage& image = m_compositor.getImage();
+        const size_t width = image.width;
+        m_scenePixels.resize(width * rows.count);
+        m_cycler.getPalette().toRGBA(image.row(rows.first), m_scenePixels.data(), m_scenePixels.size());
+
+        const auto& zplanes = m_compositor.getZPlanes();
+        if (m_zplane > 0 && static_cast<size_t>(m_zplane) <= zplanes.size()) {
+            const BitMask& mask = zplanes[m_zplane - 1];
+            for (size_t y = 0; y < rows.count; y++) {
+                RoomCompositor::tintRow(m_scenePixels.data() + y * width, mask.row(rows.first + y), width, ZPLANE_TINT);
+            }
+        }
+        TextureCache::getInstance().updateRows(makeKey(m_selected), rows.first, rows.count, m_scenePixels.data());
+    }
+
+    void RoomView::reload() {
+        for (auto& [room, request] : m_requests) {
+            request->token.cancel();
+        }
+        m_requests.clear();
+        m_errors.clear();
+        m_backgrounds.clear();
+        m_sceneRoom = NO_ROOM;
+        if (m_compositor.getBackground()) {
+            m_compositor.clear();
+            EventRoomSelected::post({0, {}});
+        }
+
+        // Textures of the previous game are keyed by its generation and age out of the cache
+        auto& game = GameManager::getInstance();
+        m_rooms = game.isOpen() ? game.getRooms() : std::vector<RoomPipeline::Room>{};
+        m_generation = game.getGeneration();
+        m_selected = 0;
+        m_scrollToSelected = true;
+    }
+
+    void RoomView::request(size_t room, JobPriority priority) {
+        auto& textures = TextureCache::getInstance();
+        if (room >= m_rooms.size() || m_requests.count(room) || m_errors.count(room) || textures.contains(makeKey(room))) {
+            return;
+        }
+
+        // Evicted texture of a resident room: converting again is cheaper than a job
+        const auto background = m_backgrounds.find(room);
+        if (background != m_backgrounds.end()) {
+            const IndexedImage& image = background->second->image;
+            std::vector<uint32_t> pixels(image.pixels.size());
+            background->second->palette.toRGBA(image.pixels.data(), pixels.data(), pixels.size());
+            textures.submit(makeKey(room), image.width, image.height, std::move(pixels));
+            return;
+        }
+        if (priority != JobPriority::Interactive && m_requests.size() >= MAX_REQUESTS) {
+            return;
+        }
+
+        auto& game = GameManager::getInstance();
+        auto request = std::make_shared<Request>();
+
+        JobSystem::Options options;
+        options.priority = priority;
+        options.counter = &game.getFileJobs();
+        options.token = &request->token;
+        JobSystem::getInstance().submit([request, target = m_rooms[room], closed = game.getCloseToken()] {
+            if (!closed.isCancelled()) {
+                SCUMM_TRACE_SCOPE("decodeRoomImage", "rooms");
+                RoomBackground& background = request->background;
+                if (RoomPipeline::decodeBackground(target, background, request->error)) {
+                    request->pixels.resize(background.image.pixels.size());
+                    background.palette.toRGBA(background.image.pixels.data(), request->pixels.data(),
+                                              request->pixels.size());
+                }
+            }
+            request->done.store(true, std::memory_order_release);
+        }, std::move(options));
+
+        m_requests[room] = std::move(request);
+    }
+
+    void RoomView::select(size_t room) {
+        if (!m_rooms.empty()) {
+            m_selected = std::min(room, m_rooms.size() - 1);
+            m_scrollToSelected = true;
+        }
+    }
+
+    TextureCache::Key RoomView::makeKey(size_t room) const {
+        return (static_cast<TextureCache::Key>(m_generation) << 32) | static_cast<uint32_t>(room);
+    }
+
+    void RoomView::drawToolbar() {
+        if (ImGui::Button(ICON_MS_CHEVRON_LEFT "##previousRoom")) {
+            select(m_selected > 0 ? m_selected - 1 : 0);
+        }
+        ImGui::SameLine();
+
+        char format[32];
+        std::snprintf(format, sizeof(format), "Room %u", static_cast<unsigned>(m_rooms[m_selected].number));
+        int index = static_cast<int>(m_selected);
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16.0f);
+        if (ImGui::SliderInt("##room", &index, 0, static_cast<int>(m_rooms.size()) - 1, format)) {
+            select(static_cast<size_t>(index));
+        }
+        ImGui::SameLine();
+
+        if (ImGui::Button(ICON_MS_CHEVRON_RIGHT "##nextRoom")) {
+            select(m_selected + 1);
+        }
+        ImGui::SameLine();
+
+        ImGui::Checkbox(ICON_MS_ANIMATION " Cycle colors", &m_cycleColors);
+        ImGui::SameLine();
+
+        // Tints the pixels a z-plane puts in front of actors
+        const RoomBackground* background = m_compositor.getBackground();
+        const size_t zplanes = background && m_sceneRoom == m_selected ? background->zplanes.size() : 0;
+        if (zplanes > 0) {
+            char preview[16] = "None";
+            if (m_zplane > 0) {
+                std::snprintf(preview, sizeof(preview), "ZP%02d", m_zplane);
+            }
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+            if (ImGui::BeginCombo("##zplane", preview)) {
+                for (int plane = 0; plane <= static_cast<int>(zplanes); plane++) {
+                    char label[16] = "None";
+                    if (plane > 0) {
+                        std::snprintf(label, sizeof(label), "ZP%02d", plane);
+                    }
+                    if (ImGui::Selectable(label, plane == m_zplane)) {
+                        m_zplane = plane;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::SameLine();
+        }
+
+        const TextureCache::Stats stats = TextureCache::getInstance().getStats();
+        ImGui::TextDisabled("%zu of %zu rooms  |  %zu textures, %.1f MB", m_selected + 1, m_rooms.size(), stats.textures,
+                            stats.residentBytes / (1024.0 * 1024.0));
+    }
+
+    void RoomView::drawRoomList() {
+        const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+        if (m_scrollToSelected) {
+            const float top = static_cast<float>(m_selected) * rowHeight;
+            const float visible = ImGui::GetContentRegionAvail().y;
+            if (top < ImGui::GetScrollY()) {
+                ImGui::SetScrollY(top);
+            } else if (top + rowHeight > ImGui::GetScrollY() + visible) {
+                ImGui::SetScrollY(top + rowHeight - visible);
+            }
+            m_scrollToSelected = false;
+        }
+
+        auto& textures = TextureCache::getInstance();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_rooms.size()), rowHeight);
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const size_t room = static_cast<size_t>(row);
+                const char* icon = ICON_MS_CIRCLE;
+                if (m_errors.count(room)) {
+                    icon = ICON_MS_ERROR;
+                } else if (textures.contains(makeKey(room))) {
+                    icon = ICON_MS_IMAGE;
+                } else if (m_requests.count(room)) {
+                    icon = ICON_MS_HOURGLASS_EMPTY;
+                }
+
+                char label[48];
+                std::snprintf(label, sizeof(label), "%s Room %u##%zu", icon, static_cast<unsigned>(m_rooms[room].number), room);
+                if (ImGui::Selectable(label, room == m_selected)) {
+                    m_selected = room;
+                }
+            }
+        }
+        clipper.End();
+    }
+
+    void RoomView::drawRoomImage() {
+        const RoomPipeline::Room& room = m_rooms[m_selected];
+        TextureCache::Texture texture;
+        if (!TextureCache::getInstance().get(makeKey(m_selected), texture)) {
+            const auto error = m_errors.find(m_selected);
+            if (error != m_errors.end()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), ICON_MS_ERROR " Room %u: %s",
+                                   static_cast<unsigned>(room.number), error->second.c_str());
+            } else {
+                ImGui::TextDisabled(ICON_MS_HOURGLASS_EMPTY " Decoding room %u...", static_cast<unsigned>(room.number));
+            }
+            return;
+        }
+
+        const RoomBackground* background = m_sceneRoom == m_selected ? m_compositor.getBackground() : nullptr;
+        ImGui::Text("Room %u  %ux%u  %zu objects  (disk %zu, offset 0x%X)", static_cast<unsigned>(room.number),
+                    static_cast<unsigned>(texture.width), static_cast<unsigned>(texture.height),
+                    background ? background->objects.size() : 0, room.fileIndex, room.block.offset);
+
+        // Fit to the pane; whole-number scales keep the pixels square
+        const ImVec2 available = ImGui::GetContentRegionAvail();
+        float scale = std::min(available.x / texture.width, available.y / texture.height);
+        scale = scale >= 1.0f ? std::floor(scale) : std::max(scale, 0.1f);
+
+        const ImVec2 size(texture.width * scale, texture.height * scale);
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + std::max(0.0f, (available.x - size.x) * 0.5f));
+        ImGui::Image(texture.id, size);
+    }
+
+} // namespace scummredux
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "View.h"
+#include "../core/JobSystem.h"
+#include "../core/TextureCache.h"
+#include "../scumm/PaletteCycler.h"
+#include "../scumm/RoomCompositor.h"
+#include "../scumm/RoomPipeline.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scummredux {
+
+    // Browses the background of every room of the open game. Rooms are decoded on the
+    // JobSystem (the selected one at interactive priority, its neighbours as batch
+    // prefetch) and shown through the TextureCache, so scrubbing through the list
+    // only ever draws what is ready; requests left behind are cancelled. Indexed
+    // backgrounds of nearby rooms stay resident. The selected one is composited with
+    // its objects in their current states and color cycled; object state edits and
+    // cycling steps re-convert and re-upload only the rows they touched.
+    class RoomView : public View {
+    public:
+        RoomView();
+        ~RoomView() override;
+
+        void draw() override;
+
+    private:
+        // Written by the decode job, read on the main thread once done is set
+        struct Request {
+            CancellationToken token;
+            std::atomic<bool> done = false;
+            RoomBackground background;
+            std::vector<uint32_t> pixels;       // background in RGBA, base palette
+            std::string error;
+        };
+
+        // Runs every frame: follows the open game, collects finished decodes, prefetches
+        void update();
+        void reload();
+        void request(size_t room, JobPriority priority);
+        void select(size_t room);
+        void updateScene();
+        void applyObjectStates();
+        void refreshRows(RowRange rows);
+        TextureCache::Key makeKey(size_t room) const;
+
+        void drawToolbar();
+        void drawRoomList();
+        void drawRoomImage();
+
+        std::vector<RoomPipeline::Room> m_rooms;
+        uint32_t m_generation = 0;
+        size_t m_selected = 0;
+        bool m_scrollToSelected = false;
+
+        std::unordered_map<size_t, std::shared_ptr<Request>> m_requests;
+        std::unordered_map<size_t, std::string> m_errors;
+        std::unordered_map<size_t, std::shared_ptr<const RoomBackground>> m_backgrounds;
+
+        // The selected room as shown: objects composited, palette cycled
+        RoomCompositor m_compositor;
+        PaletteCycler m_cycler;
+        size_t m_sceneRoom = NO_ROOM;       // Room the scene was set up for
+        uint32_t m_stateRevision = 0;
+        bool m_cycleColors = true;
+        bool m_cyclingApplied = true;       // m_cycleColors as of the last setup
+        int m_zplane = 0;                   // Tinted z-plane, 0 for none
+        int m_zplaneApplied = 0;
+        std::chrono::steady_clock::time_point m_lastCycle = std::chrono::steady_clock::now();
+        std::vector<uint32_t> m_scenePixels;
+        size_t m_frameHandle = 0;
+
+        static constexpr size_t PREFETCH_RADIUS = 3;
+        static constexpr size_t MAX_REQUESTS = 8;
+        static constexpr size_t NO_ROOM = SIZE_MAX;
+        static constexpr uint32_t ZPLANE_TINT = Palette::pack(0xFF, 0x30, 0xC0);
+    };
+
+} // namespace scummredux
@@ -9,13 +9,19 @@ namespace scummredux {
         std::cout << "View created: " << m_name << std::endl;
     }
 
+    std::ostream& View::verboseOut() {
+        // No stream buffer: everything written is dropped
+        static std::ostream discard(nullptr);
+        return s_verbose ? std::cout : discard;
+    }
+
     std::string View::getWindowName() const {
         return toWindowName(m_name);
     }
 
     std::string View::toWindowName(const std::string& viewName) {
         std::string windowName = viewName + "##ScummRedux";
-        std::cout << "Generated window name: " << windowName << std::endl;
+        verboseOut() << "Generated window name: " << windowName << std::endl;
         return windowName;
     }
 
@@ -46,7 +52,7 @@ namespace scummredux {
 
     // Helper functions for derived classes
     void View::beginChild(const char* id, const ImVec2& size, bool border, ImGuiWindowFlags flags) {
-        std::cout << "View::beginChild called with id: " << (id ? id : "nullptr") << std::endl;
+        verboseOut() << "View::beginChild called with id: " << (id ? id : "nullptr") << std::endl;
 
         // Defensive check for ID
         if (id == nullptr || strlen(id) == 0) {
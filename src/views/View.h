@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ostream>
 #include <string>
 #include <imgui.h>
 
@@ -44,6 +45,10 @@ namespace scummredux {
         // Helper for creating unique window names
         static std::string toWindowName(const std::string& viewName);
 
+        // Per-frame debug output of the views: std::cout with --verbose, discarded otherwise
+        static void setVerbose(bool verbose) { s_verbose = verbose; }
+        static std::ostream& verboseOut();
+
     protected:
         // Helper functions for derived classes
         void beginChild(const char* id, const ImVec2& size = ImVec2(0, 0), bool border = false, ImGuiWindowFlags flags = 0);
@@ -67,6 +72,8 @@ namespace scummredux {
         // Window state tracking
         bool m_previousOpenState = false;
         bool m_windowJustOpened = false;
+
+        static inline bool s_verbose = false;
     };
 
 } // namespace scummredux
\ No newline at end of file